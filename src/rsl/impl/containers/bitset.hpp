@@ -0,0 +1,254 @@
+#pragma once
+
+#include "../util/assert.hpp"
+#include "../util/primitives.hpp"
+#include "../util/utilities.hpp"
+#include "array.hpp"
+
+#if defined(RYTHE_AVX2_ENABLED)
+	#include <immintrin.h>
+#endif
+
+/**
+ * @file bitset.hpp
+ */
+
+namespace rsl
+{
+	namespace internal::bitset_words
+	{
+		using word_type = uint64;
+		constexpr size_type bits_per_word = 64ull;
+
+		[[nodiscard]] [[rythe_always_inline]] constexpr size_type words_for_bits(size_type bitCount) noexcept
+		{
+			return (bitCount + bits_per_word - 1ull) / bits_per_word;
+		}
+
+		// Bulk word operations, each is vectorized 256 bits at a time when AVX2 is available.
+		[[rythe_always_inline]] inline void and_assign(word_type* dst, const word_type* src, size_type wordCount) noexcept;
+		[[rythe_always_inline]] inline void or_assign(word_type* dst, const word_type* src, size_type wordCount) noexcept;
+		[[rythe_always_inline]] inline void xor_assign(word_type* dst, const word_type* src, size_type wordCount) noexcept;
+		[[rythe_always_inline]] inline void and_not_assign(word_type* dst, const word_type* src, size_type wordCount) noexcept;
+
+		[[nodiscard]] [[rythe_always_inline]] inline size_type count(const word_type* words, size_type wordCount) noexcept;
+		[[nodiscard]] [[rythe_always_inline]] inline bool
+		intersects(const word_type* lhs, const word_type* rhs, size_type wordCount) noexcept;
+		[[nodiscard]] [[rythe_always_inline]] inline bool
+		is_subset(const word_type* lhs, const word_type* rhs, size_type wordCount) noexcept;
+
+		[[nodiscard]] [[rythe_always_inline]] inline size_type
+		find_set(const word_type* words, size_type wordCount, size_type bitIndex) noexcept;
+		[[nodiscard]] [[rythe_always_inline]] inline size_type
+		find_unset(const word_type* words, size_type wordCount, size_type bitCount, size_type bitIndex) noexcept;
+
+		[[rythe_always_inline]] inline void set_range(word_type* words, size_type first, size_type count) noexcept;
+		[[rythe_always_inline]] inline void reset_range(word_type* words, size_type first, size_type count) noexcept;
+	} // namespace internal::bitset_words
+
+	/**@class bitset_base
+	 * @brief Shared interface of static_bitset and basic_dynamic_bitset. Bits are packed into 64-bit words, and all bulk
+	 * operations work on whole words at a time. Bits past size() in the last word are always kept at 0.
+	 * @tparam Derived Bitset type that provides size(), word_count() and data().
+	 */
+	template <typename Derived>
+	class bitset_base
+	{
+	public:
+		using word_type = internal::bitset_words::word_type;
+		constexpr static size_type bits_per_word = internal::bitset_words::bits_per_word;
+
+		[[nodiscard]] [[rythe_always_inline]] bool test(size_type index) const noexcept;
+		[[nodiscard]] [[rythe_always_inline]] bool operator[](size_type index) const noexcept { return test(index); }
+
+		[[rythe_always_inline]] Derived& set(size_type index) noexcept;
+		[[rythe_always_inline]] Derived& set(size_type index, bool value) noexcept;
+		[[rythe_always_inline]] Derived& reset(size_type index) noexcept;
+		[[rythe_always_inline]] Derived& flip(size_type index) noexcept;
+
+		/**@brief Sets count bits starting at first, whole words in the range are written at once.
+		 */
+		Derived& set_range(size_type first, size_type count) noexcept;
+
+		/**@brief Clears count bits starting at first, whole words in the range are written at once.
+		 */
+		Derived& reset_range(size_type first, size_type count) noexcept;
+
+		Derived& set_all() noexcept;
+		Derived& reset_all() noexcept;
+		Derived& flip_all() noexcept;
+
+		/**@brief Amount of set bits.
+		 */
+		[[nodiscard]] size_type count() const noexcept;
+		[[nodiscard]] bool any() const noexcept;
+		[[nodiscard]] bool none() const noexcept { return !any(); }
+		[[nodiscard]] bool all() const noexcept;
+
+		/**@brief Index of the first set bit, or npos if no bits are set.
+		 */
+		[[nodiscard]] size_type find_first_set() const noexcept;
+
+		/**@brief Index of the first set bit after index, or npos if there are none.
+		 */
+		[[nodiscard]] size_type find_next_set(size_type index) const noexcept;
+
+		/**@brief Index of the first bit that is not set, or npos if all bits are set.
+		 */
+		[[nodiscard]] size_type find_first_unset() const noexcept;
+
+		/**@brief Index of the first bit after index that is not set, or npos if there are none.
+		 */
+		[[nodiscard]] size_type find_next_unset(size_type index) const noexcept;
+
+		/**@brief Calls func with the index of every set bit in ascending order.
+		 */
+		template <typename Func>
+		void for_each_set(Func&& func) const;
+
+		template <typename OtherDerived>
+		Derived& operator&=(const bitset_base<OtherDerived>& other) noexcept;
+		template <typename OtherDerived>
+		Derived& operator|=(const bitset_base<OtherDerived>& other) noexcept;
+		template <typename OtherDerived>
+		Derived& operator^=(const bitset_base<OtherDerived>& other) noexcept;
+
+		/**@brief Clears every bit that is set in other, this &= ~other.
+		 */
+		template <typename OtherDerived>
+		Derived& and_not(const bitset_base<OtherDerived>& other) noexcept;
+
+		/**@brief Whether any bit is set in both bitsets, without creating the intersection.
+		 */
+		template <typename OtherDerived>
+		[[nodiscard]] bool intersects(const bitset_base<OtherDerived>& other) const noexcept;
+
+		/**@brief Whether every bit set in this bitset is also set in other.
+		 */
+		template <typename OtherDerived>
+		[[nodiscard]] bool is_subset_of(const bitset_base<OtherDerived>& other) const noexcept;
+
+		template <typename OtherDerived>
+		[[nodiscard]] bool operator==(const bitset_base<OtherDerived>& other) const noexcept;
+
+		[[nodiscard]] friend Derived operator&(const Derived& lhs, const Derived& rhs) noexcept
+		{
+			Derived result = lhs;
+			result &= rhs;
+			return result;
+		}
+
+		[[nodiscard]] friend Derived operator|(const Derived& lhs, const Derived& rhs) noexcept
+		{
+			Derived result = lhs;
+			result |= rhs;
+			return result;
+		}
+
+		[[nodiscard]] friend Derived operator^(const Derived& lhs, const Derived& rhs) noexcept
+		{
+			Derived result = lhs;
+			result ^= rhs;
+			return result;
+		}
+
+		[[nodiscard]] Derived operator~() const noexcept;
+
+	protected:
+		[[rythe_always_inline]] void clear_unused_bits() noexcept;
+
+	private:
+		[[nodiscard]] [[rythe_always_inline]] Derived& self() noexcept { return static_cast<Derived&>(*this); }
+		[[nodiscard]] [[rythe_always_inline]] const Derived& self() const noexcept
+		{
+			return static_cast<const Derived&>(*this);
+		}
+	};
+
+	/**@class static_bitset
+	 * @brief Fixed size bitset with its words stored inline.
+	 * @tparam BitCount Amount of bits.
+	 */
+	template <size_type BitCount>
+	class static_bitset : public bitset_base<static_bitset<BitCount>>
+	{
+		static_assert(BitCount != 0ull, "static_bitset needs at least 1 bit.");
+
+	public:
+		using base_type = bitset_base<static_bitset<BitCount>>;
+		using word_type = typename base_type::word_type;
+
+		constexpr static size_type static_word_count = internal::bitset_words::words_for_bits(BitCount);
+
+		constexpr static_bitset() noexcept = default;
+
+		[[nodiscard]] [[rythe_always_inline]] constexpr static size_type size() noexcept { return BitCount; }
+		[[nodiscard]] [[rythe_always_inline]] constexpr static size_type word_count() noexcept { return static_word_count; }
+
+		[[nodiscard]] [[rythe_always_inline]] constexpr word_type* data() noexcept { return m_words; }
+		[[nodiscard]] [[rythe_always_inline]] constexpr const word_type* data() const noexcept { return m_words; }
+
+	private:
+		word_type m_words[static_word_count] = {};
+	};
+
+	/**@class basic_dynamic_bitset
+	 * @brief Resizable bitset. Words are stored in a hybrid_array, so sets up to StaticCapacity bits do not allocate.
+	 * @tparam Alloc Allocator used once the bits no longer fit in the static capacity.
+	 * @tparam StaticCapacity Amount of bits stored inline, rounded up to whole words.
+	 */
+	template <allocator_type Alloc = default_allocator, size_type StaticCapacity = 0ull>
+	class basic_dynamic_bitset : public bitset_base<basic_dynamic_bitset<Alloc, StaticCapacity>>
+	{
+	public:
+		using base_type = bitset_base<basic_dynamic_bitset<Alloc, StaticCapacity>>;
+		using word_type = typename base_type::word_type;
+		using allocator_storage_type = allocator_storage<Alloc>;
+		using allocator_t = Alloc;
+		using word_storage_type = basic_dynamic_array<
+			word_type, Alloc, default_factory<word_type>, internal::bitset_words::words_for_bits(StaticCapacity)>;
+
+		constexpr static size_type bits_per_word = base_type::bits_per_word;
+
+		basic_dynamic_bitset() = default;
+		explicit basic_dynamic_bitset(const allocator_storage_type& allocStorage);
+		explicit basic_dynamic_bitset(size_type bitCount, bool value = false);
+		basic_dynamic_bitset(size_type bitCount, bool value, const allocator_storage_type& allocStorage);
+
+		/**@brief Changes the amount of bits, new bits are initialized to value.
+		 */
+		void resize(size_type bitCount, bool value = false);
+		void reserve(size_type bitCount);
+		void push_back(bool value);
+		void pop_back() noexcept;
+		void clear() noexcept;
+
+		[[nodiscard]] [[rythe_always_inline]] size_type size() const noexcept { return m_size; }
+		[[nodiscard]] [[rythe_always_inline]] bool empty() const noexcept { return m_size == 0ull; }
+		[[nodiscard]] [[rythe_always_inline]] size_type capacity() const noexcept
+		{
+			return m_words.capacity() * bits_per_word;
+		}
+		[[nodiscard]] [[rythe_always_inline]] size_type word_count() const noexcept { return m_words.size(); }
+
+		[[nodiscard]] [[rythe_always_inline]] word_type* data() noexcept { return m_words.data(); }
+		[[nodiscard]] [[rythe_always_inline]] const word_type* data() const noexcept { return m_words.data(); }
+
+		[[nodiscard]] [[rythe_always_inline]] allocator_t& get_allocator() noexcept { return m_words.get_allocator(); }
+		[[nodiscard]] [[rythe_always_inline]] const allocator_t& get_allocator() const noexcept
+		{
+			return m_words.get_allocator();
+		}
+
+	private:
+		word_storage_type m_words;
+		size_type m_size = 0ull;
+	};
+
+	using dynamic_bitset = basic_dynamic_bitset<>;
+
+	template <size_type StaticCapacity, allocator_type Alloc = default_allocator>
+	using hybrid_bitset = basic_dynamic_bitset<Alloc, StaticCapacity>;
+} // namespace rsl
+
+#include "bitset.inl"
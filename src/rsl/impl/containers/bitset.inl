@@ -0,0 +1,599 @@
+#pragma once
+#include "bitset.hpp"
+
+namespace rsl
+{
+	namespace internal::bitset_words
+	{
+		[[nodiscard]] [[rythe_always_inline]] constexpr word_type first_word_mask(const size_type first) noexcept
+		{
+			return ~0ull << (first % bits_per_word);
+		}
+
+		[[nodiscard]] [[rythe_always_inline]] constexpr word_type last_word_mask(const size_type last) noexcept
+		{
+			return ~0ull >> ((bits_per_word - 1ull) - (last % bits_per_word));
+		}
+
+#if defined(RYTHE_AVX2_ENABLED)
+	#define RYTHE_BITSET_AVX2_LOOP(dst, src, wordCount, op)                                                                   \
+		for (; i + 4ull <= wordCount; i += 4ull)                                                                                \
+		{                                                                                                                       \
+			const __m256i lhs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));                                 \
+			const __m256i rhs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));                                 \
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), op);                                                      \
+		}
+#else
+	#define RYTHE_BITSET_AVX2_LOOP(dst, src, wordCount, op)
+#endif
+
+		inline void and_assign(word_type* dst, const word_type* src, const size_type wordCount) noexcept
+		{
+			size_type i = 0ull;
+			RYTHE_BITSET_AVX2_LOOP(dst, src, wordCount, _mm256_and_si256(lhs, rhs))
+			for (; i < wordCount; i++)
+			{
+				dst[i] &= src[i];
+			}
+		}
+
+		inline void or_assign(word_type* dst, const word_type* src, const size_type wordCount) noexcept
+		{
+			size_type i = 0ull;
+			RYTHE_BITSET_AVX2_LOOP(dst, src, wordCount, _mm256_or_si256(lhs, rhs))
+			for (; i < wordCount; i++)
+			{
+				dst[i] |= src[i];
+			}
+		}
+
+		inline void xor_assign(word_type* dst, const word_type* src, const size_type wordCount) noexcept
+		{
+			size_type i = 0ull;
+			RYTHE_BITSET_AVX2_LOOP(dst, src, wordCount, _mm256_xor_si256(lhs, rhs))
+			for (; i < wordCount; i++)
+			{
+				dst[i] ^= src[i];
+			}
+		}
+
+		inline void and_not_assign(word_type* dst, const word_type* src, const size_type wordCount) noexcept
+		{
+			size_type i = 0ull;
+			// _mm256_andnot_si256 negates its first operand.
+			RYTHE_BITSET_AVX2_LOOP(dst, src, wordCount, _mm256_andnot_si256(rhs, lhs))
+			for (; i < wordCount; i++)
+			{
+				dst[i] &= ~src[i];
+			}
+		}
+
+#undef RYTHE_BITSET_AVX2_LOOP
+
+		inline size_type count(const word_type* words, const size_type wordCount) noexcept
+		{
+			size_type result = 0ull;
+			size_type i = 0ull;
+
+#if defined(RYTHE_AVX2_ENABLED)
+			// Nibble lookup popcount, per byte counts are summed into 64-bit lanes with sad_epu8.
+			const __m256i lookup =
+				_mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+			const __m256i lowMask = _mm256_set1_epi8(0x0f);
+			__m256i accumulator = _mm256_setzero_si256();
+			for (; i + 4ull <= wordCount; i += 4ull)
+			{
+				const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+				const __m256i low = _mm256_and_si256(value, lowMask);
+				const __m256i high = _mm256_and_si256(_mm256_srli_epi16(value, 4), lowMask);
+				const __m256i byteCounts = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, low), _mm256_shuffle_epi8(lookup, high));
+				accumulator = _mm256_add_epi64(accumulator, _mm256_sad_epu8(byteCounts, _mm256_setzero_si256()));
+			}
+
+			result += static_cast<size_type>(_mm256_extract_epi64(accumulator, 0)) +
+					  static_cast<size_type>(_mm256_extract_epi64(accumulator, 1)) +
+					  static_cast<size_type>(_mm256_extract_epi64(accumulator, 2)) +
+					  static_cast<size_type>(_mm256_extract_epi64(accumulator, 3));
+#endif
+
+			for (; i < wordCount; i++)
+			{
+				result += popcount(words[i]);
+			}
+
+			return result;
+		}
+
+		inline bool intersects(const word_type* lhs, const word_type* rhs, const size_type wordCount) noexcept
+		{
+			size_type i = 0ull;
+
+#if defined(RYTHE_AVX2_ENABLED)
+			for (; i + 4ull <= wordCount; i += 4ull)
+			{
+				const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i));
+				const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i));
+				if (!_mm256_testz_si256(a, b))
+				{
+					return true;
+				}
+			}
+#endif
+
+			for (; i < wordCount; i++)
+			{
+				if ((lhs[i] & rhs[i]) != 0ull)
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		inline bool is_subset(const word_type* lhs, const word_type* rhs, const size_type wordCount) noexcept
+		{
+			size_type i = 0ull;
+
+#if defined(RYTHE_AVX2_ENABLED)
+			for (; i + 4ull <= wordCount; i += 4ull)
+			{
+				const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i));
+				const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i));
+				// testc returns 1 when (~b & a) == 0.
+				if (!_mm256_testc_si256(b, a))
+				{
+					return false;
+				}
+			}
+#endif
+
+			for (; i < wordCount; i++)
+			{
+				if ((lhs[i] & ~rhs[i]) != 0ull)
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		inline size_type find_set(const word_type* words, const size_type wordCount, const size_type bitIndex) noexcept
+		{
+			size_type wordIndex = bitIndex / bits_per_word;
+			if (wordIndex >= wordCount)
+			{
+				return npos;
+			}
+
+			word_type word = words[wordIndex] & first_word_mask(bitIndex);
+			while (word == 0ull)
+			{
+				if (++wordIndex == wordCount)
+				{
+					return npos;
+				}
+
+				word = words[wordIndex];
+			}
+
+			return wordIndex * bits_per_word + count_trailing_zeros(word);
+		}
+
+		inline size_type find_unset(
+			const word_type* words, const size_type wordCount, const size_type bitCount, const size_type bitIndex
+		) noexcept
+		{
+			size_type wordIndex = bitIndex / bits_per_word;
+			if (bitIndex >= bitCount)
+			{
+				return npos;
+			}
+
+			word_type word = ~words[wordIndex] & first_word_mask(bitIndex);
+			while (word == 0ull)
+			{
+				if (++wordIndex == wordCount)
+				{
+					return npos;
+				}
+
+				word = ~words[wordIndex];
+			}
+
+			const size_type result = wordIndex * bits_per_word + count_trailing_zeros(word);
+			return result < bitCount ? result : npos;
+		}
+
+		inline void set_range(word_type* words, const size_type first, const size_type count) noexcept
+		{
+			if (count == 0ull)
+			{
+				return;
+			}
+
+			const size_type last = first + count - 1ull;
+			const size_type firstWord = first / bits_per_word;
+			const size_type lastWord = last / bits_per_word;
+
+			if (firstWord == lastWord)
+			{
+				words[firstWord] |= first_word_mask(first) & last_word_mask(last);
+				return;
+			}
+
+			words[firstWord] |= first_word_mask(first);
+			for (size_type i = firstWord + 1ull; i < lastWord; i++)
+			{
+				words[i] = ~0ull;
+			}
+			words[lastWord] |= last_word_mask(last);
+		}
+
+		inline void reset_range(word_type* words, const size_type first, const size_type count) noexcept
+		{
+			if (count == 0ull)
+			{
+				return;
+			}
+
+			const size_type last = first + count - 1ull;
+			const size_type firstWord = first / bits_per_word;
+			const size_type lastWord = last / bits_per_word;
+
+			if (firstWord == lastWord)
+			{
+				words[firstWord] &= ~(first_word_mask(first) & last_word_mask(last));
+				return;
+			}
+
+			words[firstWord] &= ~first_word_mask(first);
+			for (size_type i = firstWord + 1ull; i < lastWord; i++)
+			{
+				words[i] = 0ull;
+			}
+			words[lastWord] &= ~last_word_mask(last);
+		}
+	} // namespace internal::bitset_words
+
+	template <typename Derived>
+	bool bitset_base<Derived>::test(const size_type index) const noexcept
+	{
+		rsl_assert_out_of_range(index < self().size());
+		return (self().data()[index / bits_per_word] >> (index % bits_per_word)) & 1ull;
+	}
+
+	template <typename Derived>
+	Derived& bitset_base<Derived>::set(const size_type index) noexcept
+	{
+		rsl_assert_out_of_range(index < self().size());
+		self().data()[index / bits_per_word] |= 1ull << (index % bits_per_word);
+		return self();
+	}
+
+	template <typename Derived>
+	Derived& bitset_base<Derived>::set(const size_type index, const bool value) noexcept
+	{
+		return value ? set(index) : reset(index);
+	}
+
+	template <typename Derived>
+	Derived& bitset_base<Derived>::reset(const size_type index) noexcept
+	{
+		rsl_assert_out_of_range(index < self().size());
+		self().data()[index / bits_per_word] &= ~(1ull << (index % bits_per_word));
+		return self();
+	}
+
+	template <typename Derived>
+	Derived& bitset_base<Derived>::flip(const size_type index) noexcept
+	{
+		rsl_assert_out_of_range(index < self().size());
+		self().data()[index / bits_per_word] ^= 1ull << (index % bits_per_word);
+		return self();
+	}
+
+	template <typename Derived>
+	Derived& bitset_base<Derived>::set_range(const size_type first, const size_type count) noexcept
+	{
+		rsl_assert_out_of_range(first + count <= self().size());
+		internal::bitset_words::set_range(self().data(), first, count);
+		return self();
+	}
+
+	template <typename Derived>
+	Derived& bitset_base<Derived>::reset_range(const size_type first, const size_type count) noexcept
+	{
+		rsl_assert_out_of_range(first + count <= self().size());
+		internal::bitset_words::reset_range(self().data(), first, count);
+		return self();
+	}
+
+	template <typename Derived>
+	Derived& bitset_base<Derived>::set_all() noexcept
+	{
+		word_type* words = self().data();
+		const size_type wordCount = self().word_count();
+		for (size_type i = 0ull; i < wordCount; i++)
+		{
+			words[i] = ~0ull;
+		}
+
+		clear_unused_bits();
+		return self();
+	}
+
+	template <typename Derived>
+	Derived& bitset_base<Derived>::reset_all() noexcept
+	{
+		word_type* words = self().data();
+		const size_type wordCount = self().word_count();
+		for (size_type i = 0ull; i < wordCount; i++)
+		{
+			words[i] = 0ull;
+		}
+
+		return self();
+	}
+
+	template <typename Derived>
+	Derived& bitset_base<Derived>::flip_all() noexcept
+	{
+		word_type* words = self().data();
+		const size_type wordCount = self().word_count();
+		for (size_type i = 0ull; i < wordCount; i++)
+		{
+			words[i] = ~words[i];
+		}
+
+		clear_unused_bits();
+		return self();
+	}
+
+	template <typename Derived>
+	size_type bitset_base<Derived>::count() const noexcept
+	{
+		return internal::bitset_words::count(self().data(), self().word_count());
+	}
+
+	template <typename Derived>
+	bool bitset_base<Derived>::any() const noexcept
+	{
+		const word_type* words = self().data();
+		const size_type wordCount = self().word_count();
+		for (size_type i = 0ull; i < wordCount; i++)
+		{
+			if (words[i] != 0ull)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	template <typename Derived>
+	bool bitset_base<Derived>::all() const noexcept
+	{
+		return find_first_unset() == npos;
+	}
+
+	template <typename Derived>
+	size_type bitset_base<Derived>::find_first_set() const noexcept
+	{
+		return internal::bitset_words::find_set(self().data(), self().word_count(), 0ull);
+	}
+
+	template <typename Derived>
+	size_type bitset_base<Derived>::find_next_set(const size_type index) const noexcept
+	{
+		return internal::bitset_words::find_set(self().data(), self().word_count(), index + 1ull);
+	}
+
+	template <typename Derived>
+	size_type bitset_base<Derived>::find_first_unset() const noexcept
+	{
+		return internal::bitset_words::find_unset(self().data(), self().word_count(), self().size(), 0ull);
+	}
+
+	template <typename Derived>
+	size_type bitset_base<Derived>::find_next_unset(const size_type index) const noexcept
+	{
+		return internal::bitset_words::find_unset(self().data(), self().word_count(), self().size(), index + 1ull);
+	}
+
+	template <typename Derived>
+	template <typename Func>
+	void bitset_base<Derived>::for_each_set(Func&& func) const
+	{
+		const word_type* words = self().data();
+		const size_type wordCount = self().word_count();
+		for (size_type i = 0ull; i < wordCount; i++)
+		{
+			word_type word = words[i];
+			while (word != 0ull)
+			{
+				func(i * bits_per_word + count_trailing_zeros(word));
+				word &= word - 1ull;
+			}
+		}
+	}
+
+	template <typename Derived>
+	template <typename OtherDerived>
+	Derived& bitset_base<Derived>::operator&=(const bitset_base<OtherDerived>& other) noexcept
+	{
+		const OtherDerived& rhs = static_cast<const OtherDerived&>(other);
+		rsl_assert_invalid_parameters(self().size() == rhs.size());
+		internal::bitset_words::and_assign(self().data(), rhs.data(), self().word_count());
+		return self();
+	}
+
+	template <typename Derived>
+	template <typename OtherDerived>
+	Derived& bitset_base<Derived>::operator|=(const bitset_base<OtherDerived>& other) noexcept
+	{
+		const OtherDerived& rhs = static_cast<const OtherDerived&>(other);
+		rsl_assert_invalid_parameters(self().size() == rhs.size());
+		internal::bitset_words::or_assign(self().data(), rhs.data(), self().word_count());
+		return self();
+	}
+
+	template <typename Derived>
+	template <typename OtherDerived>
+	Derived& bitset_base<Derived>::operator^=(const bitset_base<OtherDerived>& other) noexcept
+	{
+		const OtherDerived& rhs = static_cast<const OtherDerived&>(other);
+		rsl_assert_invalid_parameters(self().size() == rhs.size());
+		internal::bitset_words::xor_assign(self().data(), rhs.data(), self().word_count());
+		return self();
+	}
+
+	template <typename Derived>
+	template <typename OtherDerived>
+	Derived& bitset_base<Derived>::and_not(const bitset_base<OtherDerived>& other) noexcept
+	{
+		const OtherDerived& rhs = static_cast<const OtherDerived&>(other);
+		rsl_assert_invalid_parameters(self().size() == rhs.size());
+		internal::bitset_words::and_not_assign(self().data(), rhs.data(), self().word_count());
+		return self();
+	}
+
+	template <typename Derived>
+	template <typename OtherDerived>
+	bool bitset_base<Derived>::intersects(const bitset_base<OtherDerived>& other) const noexcept
+	{
+		const OtherDerived& rhs = static_cast<const OtherDerived&>(other);
+		rsl_assert_invalid_parameters(self().size() == rhs.size());
+		return internal::bitset_words::intersects(self().data(), rhs.data(), self().word_count());
+	}
+
+	template <typename Derived>
+	template <typename OtherDerived>
+	bool bitset_base<Derived>::is_subset_of(const bitset_base<OtherDerived>& other) const noexcept
+	{
+		const OtherDerived& rhs = static_cast<const OtherDerived&>(other);
+		rsl_assert_invalid_parameters(self().size() == rhs.size());
+		return internal::bitset_words::is_subset(self().data(), rhs.data(), self().word_count());
+	}
+
+	template <typename Derived>
+	template <typename OtherDerived>
+	bool bitset_base<Derived>::operator==(const bitset_base<OtherDerived>& other) const noexcept
+	{
+		const OtherDerived& rhs = static_cast<const OtherDerived&>(other);
+		if (self().size() != rhs.size())
+		{
+			return false;
+		}
+
+		const word_type* lhsWords = self().data();
+		const word_type* rhsWords = rhs.data();
+		const size_type wordCount = self().word_count();
+		for (size_type i = 0ull; i < wordCount; i++)
+		{
+			if (lhsWords[i] != rhsWords[i])
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	template <typename Derived>
+	Derived bitset_base<Derived>::operator~() const noexcept
+	{
+		Derived result = self();
+		result.flip_all();
+		return result;
+	}
+
+	template <typename Derived>
+	void bitset_base<Derived>::clear_unused_bits() noexcept
+	{
+		const size_type usedBits = self().size() % bits_per_word;
+		if (usedBits != 0ull)
+		{
+			self().data()[self().word_count() - 1ull] &= (1ull << usedBits) - 1ull;
+		}
+	}
+
+	template <allocator_type Alloc, size_type StaticCapacity>
+	basic_dynamic_bitset<Alloc, StaticCapacity>::basic_dynamic_bitset(const allocator_storage_type& allocStorage)
+		: m_words(allocStorage) {}
+
+	template <allocator_type Alloc, size_type StaticCapacity>
+	basic_dynamic_bitset<Alloc, StaticCapacity>::basic_dynamic_bitset(const size_type bitCount, const bool value)
+	{
+		resize(bitCount, value);
+	}
+
+	template <allocator_type Alloc, size_type StaticCapacity>
+	basic_dynamic_bitset<Alloc, StaticCapacity>::basic_dynamic_bitset(
+		const size_type bitCount, const bool value, const allocator_storage_type& allocStorage
+	)
+		: m_words(allocStorage)
+	{
+		resize(bitCount, value);
+	}
+
+	template <allocator_type Alloc, size_type StaticCapacity>
+	void basic_dynamic_bitset<Alloc, StaticCapacity>::resize(const size_type bitCount, const bool value)
+	{
+		const size_type oldSize = m_size;
+		m_words.resize(internal::bitset_words::words_for_bits(bitCount), 0ull);
+		m_size = bitCount;
+
+		if (bitCount < oldSize)
+		{
+			this->clear_unused_bits();
+		}
+		else if (value)
+		{
+			internal::bitset_words::set_range(m_words.data(), oldSize, bitCount - oldSize);
+		}
+	}
+
+	template <allocator_type Alloc, size_type StaticCapacity>
+	void basic_dynamic_bitset<Alloc, StaticCapacity>::reserve(const size_type bitCount)
+	{
+		m_words.reserve(internal::bitset_words::words_for_bits(bitCount));
+	}
+
+	template <allocator_type Alloc, size_type StaticCapacity>
+	void basic_dynamic_bitset<Alloc, StaticCapacity>::push_back(const bool value)
+	{
+		if (m_size % bits_per_word == 0ull)
+		{
+			m_words.push_back(0ull);
+		}
+
+		m_size++;
+		if (value)
+		{
+			this->set(m_size - 1ull);
+		}
+	}
+
+	template <allocator_type Alloc, size_type StaticCapacity>
+	void basic_dynamic_bitset<Alloc, StaticCapacity>::pop_back() noexcept
+	{
+		rsl_assert_out_of_range(m_size != 0ull);
+		this->reset(m_size - 1ull);
+		m_size--;
+
+		if (m_size % bits_per_word == 0ull)
+		{
+			m_words.pop_back();
+		}
+	}
+
+	template <allocator_type Alloc, size_type StaticCapacity>
+	void basic_dynamic_bitset<Alloc, StaticCapacity>::clear() noexcept
+	{
+		m_words.clear();
+		m_size = 0ull;
+	}
+} // namespace rsl
@@ -597,7 +597,7 @@ namespace rsl
         }
 
         rsl_ensure(maybe_grow());
-        emplace_unsafe_impl(m_size, m_size + 1, move(value));
+        emplace_unsafe_impl(m_size, m_size + 1, rsl::move(value));
         ++m_size;
 
         if constexpr (use_post_fix)
@@ -885,7 +885,7 @@ namespace rsl
                 m_size == m_capacity ? m_capacity * 2 : m_size + 1
                 );
 
-        mem_rsc::construct(1, pos, move(value));
+        mem_rsc::construct(1, pos, rsl::move(value));
 
         return pos;
     }
@@ -1037,7 +1037,7 @@ namespace rsl
 
         for (size_type i = 0; i < count; ++i)
         {
-            mem_rsc::construct(1, i + first, move(*get_ptr_at(m_size - (i + 1))));
+            mem_rsc::construct(1, i + first, rsl::move(*get_ptr_at(m_size - (i + 1))));
         }
 
         m_size -= count;
@@ -1878,7 +1878,7 @@ namespace rsl
 
         if (pos != m_size) [[likely]]
         {
-            mem_rsc::construct(1, pos, move(*get_ptr_at(m_size)));
+            mem_rsc::construct(1, pos, rsl::move(*get_ptr_at(m_size)));
             mem_rsc::destroy(1, m_size);
         }
 
@@ -1943,7 +1943,7 @@ namespace rsl
     {
         for (auto to = mem_rsc::get_ptr() + offset; to != mem_rsc::get_ptr() + end; ++to, ++srcIter)
         {
-            *to = move(*srcIter);
+            *to = rsl::move(*srcIter);
         }
     }
 
@@ -1965,7 +1965,7 @@ namespace rsl
         {
             for (size_type i = offset; i != end; i++, ++srcIter)
             {
-                mem_rsc::construct(1, i, move(*srcIter));
+                mem_rsc::construct(1, i, rsl::move(*srcIter));
             }
         }
     }
@@ -2009,7 +2009,7 @@ namespace rsl
     {
         for (size_type i = offset; i != end; i++)
         {
-            mem_rsc::construct(1, static_cast<size_type>(i + shift), move(*get_ptr_at(i)));
+            mem_rsc::construct(1, static_cast<size_type>(i + shift), rsl::move(*get_ptr_at(i)));
         }
     }
 
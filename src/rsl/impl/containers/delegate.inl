@@ -55,7 +55,7 @@ namespace rsl
 	inline constexpr delegate<ReturnType(ParamTypes...), Alloc, Factory>
 	delegate<ReturnType(ParamTypes...), Alloc, Factory>::create(T& instance)
 	{
-		return delegate(base::template create_element<T, TMethod>(allocator_storage_type{}, instance));
+		return create<T, TMethod>(allocator_storage_type{}, instance);
 	}
 
 	template <typename ReturnType, typename... ParamTypes, allocator_type Alloc, untyped_factory_type Factory>
@@ -63,7 +63,7 @@ namespace rsl
 	inline constexpr delegate<ReturnType(ParamTypes...), Alloc, Factory>
 	delegate<ReturnType(ParamTypes...), Alloc, Factory>::create(const allocator_storage_type& alloc, T& instance)
 	{
-		return delegate(base::template create_element<T, TMethod>(alloc, instance));
+		return delegate(alloc, base::template create_element<T, TMethod>(alloc, instance));
 	}
 
 	template <typename ReturnType, typename... ParamTypes, allocator_type Alloc, untyped_factory_type Factory>
@@ -71,7 +71,7 @@ namespace rsl
 	inline constexpr delegate<ReturnType(ParamTypes...), Alloc, Factory>
 	delegate<ReturnType(ParamTypes...), Alloc, Factory>::create(const T& instance)
 	{
-		return delegate(base::template create_element<T, TMethod>(allocator_storage_type{}, instance));
+		return create<T, TMethod>(allocator_storage_type{}, instance);
 	}
 
 	template <typename ReturnType, typename... ParamTypes, allocator_type Alloc, untyped_factory_type Factory>
@@ -79,7 +79,7 @@ namespace rsl
 	inline constexpr delegate<ReturnType(ParamTypes...), Alloc, Factory>
 	delegate<ReturnType(ParamTypes...), Alloc, Factory>::create(const allocator_storage_type& alloc, const T& instance)
 	{
-		return delegate(base::template create_element<T, TMethod>(alloc, instance));
+		return delegate(alloc, base::template create_element<T, TMethod>(alloc, instance));
 	}
 
 	template <typename ReturnType, typename... ParamTypes, allocator_type Alloc, untyped_factory_type Factory>
@@ -87,7 +87,7 @@ namespace rsl
 	inline constexpr delegate<ReturnType(ParamTypes...), Alloc, Factory>
 	delegate<ReturnType(ParamTypes...), Alloc, Factory>::create()
 	{
-		return delegate(base::template create_element<TMethod>(allocator_storage_type{}));
+		return create<TMethod>(allocator_storage_type{});
 	}
 
 	template <typename ReturnType, typename... ParamTypes, allocator_type Alloc, untyped_factory_type Factory>
@@ -95,7 +95,7 @@ namespace rsl
 	inline constexpr delegate<ReturnType(ParamTypes...), Alloc, Factory>
 	delegate<ReturnType(ParamTypes...), Alloc, Factory>::create(const allocator_storage_type& alloc)
 	{
-		return delegate(base::template create_element<TMethod>(alloc));
+		return delegate(alloc, base::template create_element<TMethod>(alloc));
 	}
 
 	template <typename ReturnType, typename... ParamTypes, allocator_type Alloc, untyped_factory_type Factory>
@@ -104,7 +104,7 @@ namespace rsl
 	inline constexpr delegate<ReturnType(ParamTypes...), Alloc, Factory>
 	delegate<ReturnType(ParamTypes...), Alloc, Factory>::create(const Functor& instance)
 	{
-		return delegate(base::template create_element<Functor>(allocator_storage_type{}, instance));
+		return create<Functor>(allocator_storage_type{}, instance);
 	}
 
 	template <typename ReturnType, typename... ParamTypes, allocator_type Alloc, untyped_factory_type Factory>
@@ -115,7 +115,7 @@ namespace rsl
 		const allocator_storage_type& alloc, const Functor& instance
 	)
 	{
-		return delegate(base::template create_element<Functor>(alloc, instance));
+		return delegate(alloc, base::template create_element<Functor>(alloc, instance));
 	}
 
 	template <typename ReturnType, typename... ParamTypes, allocator_type Alloc, untyped_factory_type Factory>
@@ -0,0 +1,263 @@
+#pragma once
+#include "hashed_sparse_set.hpp"
+
+namespace rsl
+{
+	template <typename T, allocator_type Alloc, typename Hash, typename KeyEqual>
+	constexpr hashed_sparse_set<T, Alloc, Hash, KeyEqual>::hashed_sparse_set(const allocator_storage_type& allocStorage)
+		noexcept(nothrow_constructible_alloc)
+		: m_dense(allocStorage),
+		  m_sparse(allocStorage) {}
+
+	template <typename T, allocator_type Alloc, typename Hash, typename KeyEqual>
+	constexpr size_type hashed_sparse_set<T, Alloc, Hash, KeyEqual>::size() const noexcept
+	{
+		return m_dense.size();
+	}
+
+	template <typename T, allocator_type Alloc, typename Hash, typename KeyEqual>
+	constexpr bool hashed_sparse_set<T, Alloc, Hash, KeyEqual>::empty() const noexcept
+	{
+		return m_dense.empty();
+	}
+
+	template <typename T, allocator_type Alloc, typename Hash, typename KeyEqual>
+	constexpr size_type hashed_sparse_set<T, Alloc, Hash, KeyEqual>::capacity() const noexcept
+	{
+		return m_dense.capacity();
+	}
+
+	template <typename T, allocator_type Alloc, typename Hash, typename KeyEqual>
+	void hashed_sparse_set<T, Alloc, Hash, KeyEqual>::reserve(const size_type newCapacity)
+	{
+		m_dense.reserve(newCapacity);
+		m_sparse.reserve(newCapacity);
+	}
+
+	template <typename T, allocator_type Alloc, typename Hash, typename KeyEqual>
+	void hashed_sparse_set<T, Alloc, Hash, KeyEqual>::clear() noexcept
+	{
+		m_dense.clear();
+		m_sparse.clear();
+	}
+
+	template <typename T, allocator_type Alloc, typename Hash, typename KeyEqual>
+	size_type hashed_sparse_set<T, Alloc, Hash, KeyEqual>::count(const value_type& val) const noexcept
+	{
+		return contains(val) ? 1ull : 0ull;
+	}
+
+	template <typename T, allocator_type Alloc, typename Hash, typename KeyEqual>
+	bool hashed_sparse_set<T, Alloc, Hash, KeyEqual>::contains(const value_type& val) const noexcept
+	{
+		return m_sparse.contains(val);
+	}
+
+	template <typename T, allocator_type Alloc, typename Hash, typename KeyEqual>
+	bool hashed_sparse_set<T, Alloc, Hash, KeyEqual>::contains(const hashed_sparse_set& other) const noexcept
+	{
+		if (other.size() > size())
+		{
+			return false;
+		}
+
+		for (const value_type& val : other.m_dense)
+		{
+			if (!contains(val))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	template <typename T, allocator_type Alloc, typename Hash, typename KeyEqual>
+	size_type hashed_sparse_set<T, Alloc, Hash, KeyEqual>::index_of(const value_type& val) const noexcept
+	{
+		if (const size_type* index = m_sparse.find(val); index != nullptr)
+		{
+			return *index;
+		}
+
+		return npos;
+	}
+
+	template <typename T, allocator_type Alloc, typename Hash, typename KeyEqual>
+	bool hashed_sparse_set<T, Alloc, Hash, KeyEqual>::equals(const hashed_sparse_set& other) const noexcept
+	{
+		return size() == other.size() && contains(other);
+	}
+
+	template <typename T, allocator_type Alloc, typename Hash, typename KeyEqual>
+	typename hashed_sparse_set<T, Alloc, Hash, KeyEqual>::const_iterator_type
+	hashed_sparse_set<T, Alloc, Hash, KeyEqual>::find(const value_type& val) const noexcept
+	{
+		if (const size_type* index = m_sparse.find(val); index != nullptr)
+		{
+			return m_dense.iterator_at(*index);
+		}
+
+		return end();
+	}
+
+	template <typename T, allocator_type Alloc, typename Hash, typename KeyEqual>
+	pair<typename hashed_sparse_set<T, Alloc, Hash, KeyEqual>::const_iterator_type, bool>
+	hashed_sparse_set<T, Alloc, Hash, KeyEqual>::insert(const value_type& val)
+	{
+		auto [index, inserted] = m_sparse.try_emplace(val, m_dense.size());
+		if (inserted)
+		{
+			m_dense.push_back(val);
+		}
+
+		return {m_dense.iterator_at(index), inserted};
+	}
+
+	template <typename T, allocator_type Alloc, typename Hash, typename KeyEqual>
+	pair<typename hashed_sparse_set<T, Alloc, Hash, KeyEqual>::const_iterator_type, bool>
+	hashed_sparse_set<T, Alloc, Hash, KeyEqual>::insert(value_type&& val)
+	{
+		auto [index, inserted] = m_sparse.try_emplace(val, m_dense.size());
+		if (inserted)
+		{
+			m_dense.push_back(rsl::move(val));
+		}
+
+		return {m_dense.iterator_at(index), inserted};
+	}
+
+	template <typename T, allocator_type Alloc, typename Hash, typename KeyEqual>
+	template <typename... Args>
+	pair<typename hashed_sparse_set<T, Alloc, Hash, KeyEqual>::const_iterator_type, bool>
+	hashed_sparse_set<T, Alloc, Hash, KeyEqual>::emplace(Args&&... args)
+	{
+		return insert(value_type(forward<Args>(args)...));
+	}
+
+	template <typename T, allocator_type Alloc, typename Hash, typename KeyEqual>
+	size_type hashed_sparse_set<T, Alloc, Hash, KeyEqual>::erase(const value_type& val) noexcept
+	{
+		const size_type* indexPtr = m_sparse.find(val);
+		if (indexPtr == nullptr)
+		{
+			return 0ull;
+		}
+
+		const size_type index = *indexPtr;
+		m_sparse.erase(val);
+		m_dense.erase_swap(index);
+
+		if (index != m_dense.size())
+		{
+			*m_sparse.find(m_dense[index]) = index;
+		}
+
+		return 1ull;
+	}
+
+	template <typename T, allocator_type Alloc, typename Hash, typename KeyEqual>
+	constexpr const typename hashed_sparse_set<T, Alloc, Hash, KeyEqual>::value_type&
+	hashed_sparse_set<T, Alloc, Hash, KeyEqual>::at(const size_type i) const noexcept
+	{
+		return m_dense.at(i);
+	}
+
+	template <typename T, allocator_type Alloc, typename Hash, typename KeyEqual>
+	constexpr const typename hashed_sparse_set<T, Alloc, Hash, KeyEqual>::value_type&
+	hashed_sparse_set<T, Alloc, Hash, KeyEqual>::operator[](const size_type i) const noexcept
+	{
+		return m_dense.at(i);
+	}
+
+	template <typename T, allocator_type Alloc, typename Hash, typename KeyEqual>
+	constexpr const typename hashed_sparse_set<T, Alloc, Hash, KeyEqual>::value_type*
+	hashed_sparse_set<T, Alloc, Hash, KeyEqual>::data() const noexcept
+	{
+		return m_dense.data();
+	}
+
+	template <typename T, allocator_type Alloc, typename Hash, typename KeyEqual>
+	constexpr typename hashed_sparse_set<T, Alloc, Hash, KeyEqual>::const_view_type
+	hashed_sparse_set<T, Alloc, Hash, KeyEqual>::view() const noexcept
+	{
+		return m_dense.view();
+	}
+
+	template <typename T, allocator_type Alloc, typename Hash, typename KeyEqual>
+	constexpr const typename hashed_sparse_set<T, Alloc, Hash, KeyEqual>::dense_container&
+	hashed_sparse_set<T, Alloc, Hash, KeyEqual>::dense() const noexcept
+	{
+		return m_dense;
+	}
+
+	template <typename T, allocator_type Alloc, typename Hash, typename KeyEqual>
+	constexpr typename hashed_sparse_set<T, Alloc, Hash, KeyEqual>::allocator_t&
+	hashed_sparse_set<T, Alloc, Hash, KeyEqual>::get_allocator() noexcept
+	{
+		return m_dense.get_allocator();
+	}
+
+	template <typename T, allocator_type Alloc, typename Hash, typename KeyEqual>
+	constexpr const typename hashed_sparse_set<T, Alloc, Hash, KeyEqual>::allocator_t&
+	hashed_sparse_set<T, Alloc, Hash, KeyEqual>::get_allocator() const noexcept
+	{
+		return m_dense.get_allocator();
+	}
+
+	template <typename T, allocator_type Alloc, typename Hash, typename KeyEqual>
+	constexpr typename hashed_sparse_set<T, Alloc, Hash, KeyEqual>::const_iterator_type
+	hashed_sparse_set<T, Alloc, Hash, KeyEqual>::begin() const noexcept
+	{
+		return m_dense.begin();
+	}
+
+	template <typename T, allocator_type Alloc, typename Hash, typename KeyEqual>
+	constexpr typename hashed_sparse_set<T, Alloc, Hash, KeyEqual>::const_iterator_type
+	hashed_sparse_set<T, Alloc, Hash, KeyEqual>::cbegin() const noexcept
+	{
+		return m_dense.cbegin();
+	}
+
+	template <typename T, allocator_type Alloc, typename Hash, typename KeyEqual>
+	constexpr typename hashed_sparse_set<T, Alloc, Hash, KeyEqual>::const_iterator_type
+	hashed_sparse_set<T, Alloc, Hash, KeyEqual>::end() const noexcept
+	{
+		return m_dense.end();
+	}
+
+	template <typename T, allocator_type Alloc, typename Hash, typename KeyEqual>
+	constexpr typename hashed_sparse_set<T, Alloc, Hash, KeyEqual>::const_iterator_type
+	hashed_sparse_set<T, Alloc, Hash, KeyEqual>::cend() const noexcept
+	{
+		return m_dense.cend();
+	}
+
+	template <typename T, allocator_type Alloc, typename Hash, typename KeyEqual>
+	constexpr typename hashed_sparse_set<T, Alloc, Hash, KeyEqual>::const_reverse_iterator_type
+	hashed_sparse_set<T, Alloc, Hash, KeyEqual>::rbegin() const noexcept
+	{
+		return m_dense.rbegin();
+	}
+
+	template <typename T, allocator_type Alloc, typename Hash, typename KeyEqual>
+	constexpr typename hashed_sparse_set<T, Alloc, Hash, KeyEqual>::const_reverse_iterator_type
+	hashed_sparse_set<T, Alloc, Hash, KeyEqual>::crbegin() const noexcept
+	{
+		return m_dense.crbegin();
+	}
+
+	template <typename T, allocator_type Alloc, typename Hash, typename KeyEqual>
+	constexpr typename hashed_sparse_set<T, Alloc, Hash, KeyEqual>::const_reverse_iterator_type
+	hashed_sparse_set<T, Alloc, Hash, KeyEqual>::rend() const noexcept
+	{
+		return m_dense.rend();
+	}
+
+	template <typename T, allocator_type Alloc, typename Hash, typename KeyEqual>
+	constexpr typename hashed_sparse_set<T, Alloc, Hash, KeyEqual>::const_reverse_iterator_type
+	hashed_sparse_set<T, Alloc, Hash, KeyEqual>::crend() const noexcept
+	{
+		return m_dense.crend();
+	}
+} // namespace rsl
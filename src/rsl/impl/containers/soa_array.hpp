@@ -0,0 +1,338 @@
+#pragma once
+
+#include "../memory/typed_allocator.hpp"
+#include "../util/assert.hpp"
+#include "../util/primitives.hpp"
+#include "views.hpp"
+
+/**
+ * @file soa_array.hpp
+ */
+
+namespace rsl
+{
+	/**@class soa_row_reference
+	 * @brief Proxy to a single row of a soa_array, fields are accessed through get. Supports structured bindings.
+	 */
+	template <typename SoaArray, bool Const>
+	class soa_row_reference
+	{
+	public:
+		using container_type = conditional_t<Const, const SoaArray, SoaArray>;
+
+		template <size_type I>
+		using field_type = conditional_t<Const, const typename SoaArray::template field_at<I>, typename SoaArray::template field_at<I>>;
+
+		[[rythe_always_inline]] constexpr soa_row_reference(container_type* container, size_type index) noexcept
+			: m_container(container),
+			  m_index(index) {}
+
+		[[rythe_always_inline]] constexpr operator soa_row_reference<SoaArray, true>() const noexcept
+			requires(!Const)
+		{
+			return soa_row_reference<SoaArray, true>(m_container, m_index);
+		}
+
+		template <size_type I>
+		[[nodiscard]] [[rythe_always_inline]] constexpr field_type<I>& get() const noexcept
+		{
+			return m_container->template at<I>(m_index);
+		}
+
+		template <typename Field>
+		[[nodiscard]] [[rythe_always_inline]] constexpr field_type<SoaArray::template index_of_field<Field>>& get() const noexcept
+		{
+			return get<SoaArray::template index_of_field<Field>>();
+		}
+
+		[[nodiscard]] [[rythe_always_inline]] constexpr size_type index() const noexcept { return m_index; }
+
+	private:
+		container_type* m_container;
+		size_type m_index;
+	};
+
+	/**@class soa_row_iterator
+	 * @brief Zipped iterator over all columns of a soa_array, dereferences into a soa_row_reference.
+	 */
+	template <typename SoaArray, bool Const>
+	class soa_row_iterator
+	{
+	public:
+		using container_type = conditional_t<Const, const SoaArray, SoaArray>;
+		using value_type = soa_row_reference<SoaArray, Const>;
+		using reference = soa_row_reference<SoaArray, Const>;
+		using difference_type = diff_type;
+
+		[[rythe_always_inline]] constexpr soa_row_iterator() noexcept = default;
+		[[rythe_always_inline]] constexpr soa_row_iterator(container_type* container, size_type index) noexcept
+			: m_container(container),
+			  m_index(index) {}
+
+		[[rythe_always_inline]] constexpr operator soa_row_iterator<SoaArray, true>() const noexcept
+			requires(!Const)
+		{
+			return soa_row_iterator<SoaArray, true>(m_container, m_index);
+		}
+
+		[[nodiscard]] [[rythe_always_inline]] constexpr reference operator*() const noexcept
+		{
+			return reference(m_container, m_index);
+		}
+
+		[[nodiscard]] [[rythe_always_inline]] constexpr reference operator[](const difference_type offset) const noexcept
+		{
+			return reference(m_container, static_cast<size_type>(static_cast<difference_type>(m_index) + offset));
+		}
+
+		[[rythe_always_inline]] constexpr soa_row_iterator& operator++() noexcept
+		{
+			++m_index;
+			return *this;
+		}
+
+		[[rythe_always_inline]] constexpr soa_row_iterator operator++(int) noexcept
+		{
+			soa_row_iterator tmp = *this;
+			++m_index;
+			return tmp;
+		}
+
+		[[rythe_always_inline]] constexpr soa_row_iterator& operator--() noexcept
+		{
+			--m_index;
+			return *this;
+		}
+
+		[[rythe_always_inline]] constexpr soa_row_iterator operator--(int) noexcept
+		{
+			soa_row_iterator tmp = *this;
+			--m_index;
+			return tmp;
+		}
+
+		[[rythe_always_inline]] constexpr soa_row_iterator& operator+=(const difference_type offset) noexcept
+		{
+			m_index = static_cast<size_type>(static_cast<difference_type>(m_index) + offset);
+			return *this;
+		}
+
+		[[rythe_always_inline]] constexpr soa_row_iterator& operator-=(const difference_type offset) noexcept
+		{
+			return *this += -offset;
+		}
+
+		[[nodiscard]] [[rythe_always_inline]] constexpr soa_row_iterator operator+(const difference_type offset) const noexcept
+		{
+			soa_row_iterator tmp = *this;
+			return tmp += offset;
+		}
+
+		[[nodiscard]] [[rythe_always_inline]] constexpr soa_row_iterator operator-(const difference_type offset) const noexcept
+		{
+			soa_row_iterator tmp = *this;
+			return tmp -= offset;
+		}
+
+		[[nodiscard]] [[rythe_always_inline]] constexpr difference_type operator-(const soa_row_iterator& other) const noexcept
+		{
+			return static_cast<difference_type>(m_index) - static_cast<difference_type>(other.m_index);
+		}
+
+		[[nodiscard]] [[rythe_always_inline]] constexpr bool operator==(const soa_row_iterator& other) const noexcept
+		{
+			return m_index == other.m_index;
+		}
+
+		[[nodiscard]] [[rythe_always_inline]] constexpr auto operator<=>(const soa_row_iterator& other) const noexcept
+		{
+			return m_index <=> other.m_index;
+		}
+
+	private:
+		container_type* m_container = nullptr;
+		size_type m_index = 0ull;
+	};
+
+	/**@class basic_soa_array
+	 * @brief Structure of arrays container. Every field is stored in its own contiguous column, all columns share a
+	 * single size and capacity and live in one allocation. Each column starts on a column_alignment boundary so loops over
+	 * a single field can stream through memory using aligned vector loads.
+	 * @tparam Alloc Allocator used for the column storage.
+	 * @tparam Fields Types of the columns. Columns can be addressed by index, or by type if that type is unique.
+	 * @note Removing a row is done through erase_swap, which moves the last row into the removed slot in every column.
+	 */
+	template <allocator_type Alloc, typename... Fields>
+	class basic_soa_array
+	{
+		static_assert(sizeof...(Fields) != 0ull, "soa_array needs at least one field.");
+
+	public:
+		using allocator_storage_type = allocator_storage<Alloc>;
+		using allocator_t = Alloc;
+		using field_sequence = type_sequence<Fields...>;
+
+		template <size_type I>
+		using field_at = element_at_t<I, Fields...>;
+
+		template <typename Field>
+		constexpr static size_type index_of_field = index_of_element_v<Field, Fields...>;
+
+		template <size_type I>
+		using column_allocator = typed_allocator<field_at<I>, Alloc>;
+
+		template <size_type I>
+		using column_view = array_view<field_at<I>>;
+		template <size_type I>
+		using const_column_view = array_view<const field_at<I>>;
+
+		constexpr static size_type field_count = sizeof...(Fields);
+
+		/**@brief Alignment of the start of every column, wide enough for a full cache line and any vector register.
+		 */
+		constexpr static size_type column_alignment = 64ull;
+
+		using reference = soa_row_reference<basic_soa_array, false>;
+		using const_reference = soa_row_reference<basic_soa_array, true>;
+		using iterator_type = soa_row_iterator<basic_soa_array, false>;
+		using const_iterator_type = soa_row_iterator<basic_soa_array, true>;
+
+		[[rythe_always_inline]] constexpr basic_soa_array() = default;
+
+		[[rythe_always_inline]] explicit constexpr basic_soa_array(const allocator_storage_type& allocStorage)
+			noexcept(is_nothrow_copy_constructible_v<allocator_storage_type>);
+
+		basic_soa_array(const basic_soa_array& other);
+		basic_soa_array(basic_soa_array&& other) noexcept;
+		basic_soa_array& operator=(const basic_soa_array& other);
+		basic_soa_array& operator=(basic_soa_array&& other) noexcept;
+		~basic_soa_array();
+
+		/**@brief Returns the amount of rows.
+		 */
+		[[nodiscard]] [[rythe_always_inline]] constexpr size_type size() const noexcept;
+
+		/**@brief Returns whether there are no rows.
+		 */
+		[[nodiscard]] [[rythe_always_inline]] constexpr bool empty() const noexcept;
+
+		/**@brief Returns the amount of rows that can be stored without reallocating.
+		 */
+		[[nodiscard]] [[rythe_always_inline]] constexpr size_type capacity() const noexcept;
+
+		/**@brief Reserves space for at least newCapacity rows in every column.
+		 */
+		void reserve(size_type newCapacity);
+
+		/**@brief Resizes every column, new rows are default constructed.
+		 */
+		void resize(size_type newSize);
+
+		/**@brief Destroys all rows.
+		 * @note Will not release any memory.
+		 */
+		void clear() noexcept;
+
+		/**@brief Adds a row at the back, one value per field.
+		 */
+		void push_back(const Fields&... values);
+
+		/**@brief Constructs a row at the back, one argument per field. Each field is constructed from its own argument.
+		 */
+		template <typename... Args>
+			requires(sizeof...(Args) == sizeof...(Fields))
+		reference emplace_back(Args&&... args);
+
+		/**@brief Destroys the last row.
+		 */
+		void pop_back() noexcept;
+
+		/**@brief Removes a row by moving the last row into its slot in every column.
+		 */
+		void erase_swap(size_type pos) noexcept;
+
+		/**@brief Contiguous view over a single column.
+		 */
+		template <size_type I>
+		[[nodiscard]] [[rythe_always_inline]] constexpr column_view<I> view() noexcept;
+		template <size_type I>
+		[[nodiscard]] [[rythe_always_inline]] constexpr const_column_view<I> view() const noexcept;
+		template <typename Field>
+		[[nodiscard]] [[rythe_always_inline]] constexpr column_view<index_of_field<Field>> view() noexcept
+		{
+			return view<index_of_field<Field>>();
+		}
+
+		template <typename Field>
+		[[nodiscard]] [[rythe_always_inline]] constexpr const_column_view<index_of_field<Field>> view() const noexcept
+		{
+			return view<index_of_field<Field>>();
+		}
+
+		template <size_type I>
+		[[nodiscard]] [[rythe_always_inline]] constexpr field_at<I>* data() noexcept;
+		template <size_type I>
+		[[nodiscard]] [[rythe_always_inline]] constexpr const field_at<I>* data() const noexcept;
+
+		template <size_type I>
+		[[nodiscard]] [[rythe_always_inline]] constexpr field_at<I>& at(size_type i) noexcept;
+		template <size_type I>
+		[[nodiscard]] [[rythe_always_inline]] constexpr const field_at<I>& at(size_type i) const noexcept;
+		template <typename Field>
+		[[nodiscard]] [[rythe_always_inline]] constexpr field_at<index_of_field<Field>>& at(const size_type i) noexcept
+		{
+			return at<index_of_field<Field>>(i);
+		}
+
+		template <typename Field>
+		[[nodiscard]] [[rythe_always_inline]] constexpr const field_at<index_of_field<Field>>& at(const size_type i) const noexcept
+		{
+			return at<index_of_field<Field>>(i);
+		}
+
+		/**@brief Reference to all fields of a single row.
+		 */
+		[[nodiscard]] [[rythe_always_inline]] constexpr reference row(size_type i) noexcept;
+		[[nodiscard]] [[rythe_always_inline]] constexpr const_reference row(size_type i) const noexcept;
+		[[nodiscard]] [[rythe_always_inline]] constexpr reference operator[](size_type i) noexcept;
+		[[nodiscard]] [[rythe_always_inline]] constexpr const_reference operator[](size_type i) const noexcept;
+
+		[[nodiscard]] [[rythe_always_inline]] constexpr allocator_t& get_allocator() noexcept;
+		[[nodiscard]] [[rythe_always_inline]] constexpr const allocator_t& get_allocator() const noexcept;
+
+		[[nodiscard]] [[rythe_always_inline]] constexpr iterator_type begin() noexcept;
+		[[nodiscard]] [[rythe_always_inline]] constexpr const_iterator_type begin() const noexcept;
+		[[nodiscard]] [[rythe_always_inline]] constexpr const_iterator_type cbegin() const noexcept;
+
+		[[nodiscard]] [[rythe_always_inline]] constexpr iterator_type end() noexcept;
+		[[nodiscard]] [[rythe_always_inline]] constexpr const_iterator_type end() const noexcept;
+		[[nodiscard]] [[rythe_always_inline]] constexpr const_iterator_type cend() const noexcept;
+
+	private:
+		[[nodiscard]] [[rythe_always_inline]] constexpr static size_type column_bytes(size_type index, size_type capacity) noexcept;
+		[[nodiscard]] [[rythe_always_inline]] constexpr static size_type block_bytes(size_type capacity) noexcept;
+
+		template <typename Func>
+		[[rythe_always_inline]] constexpr static void for_each_column(Func&& func);
+
+		void reallocate(size_type newCapacity);
+		void grow_for(size_type requiredCapacity);
+		void destroy_rows(size_type offset, size_type count) noexcept;
+		void release() noexcept;
+		void copy_from(const basic_soa_array& other);
+		void steal_from(basic_soa_array& other) noexcept;
+
+		[[rythe_no_unique_address]] allocator_storage_type m_alloc;
+		void* m_columns[field_count] = {};
+		size_type m_size = 0ull;
+		size_type m_capacity = 0ull;
+	};
+
+	template <typename... Fields>
+	using soa_array = basic_soa_array<default_allocator, Fields...>;
+
+	template <typename... Fields>
+	using pmu_soa_array = basic_soa_array<polymorphic_allocator, Fields...>;
+} // namespace rsl
+
+#include "soa_array.inl"
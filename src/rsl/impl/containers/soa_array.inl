@@ -0,0 +1,473 @@
+#pragma once
+#include "soa_array.hpp"
+
+namespace rsl
+{
+	template <allocator_type Alloc, typename... Fields>
+	constexpr basic_soa_array<Alloc, Fields...>::basic_soa_array(const allocator_storage_type& allocStorage)
+		noexcept(is_nothrow_copy_constructible_v<allocator_storage_type>)
+		: m_alloc(allocStorage) {}
+
+	template <allocator_type Alloc, typename... Fields>
+	basic_soa_array<Alloc, Fields...>::basic_soa_array(const basic_soa_array& other)
+		: m_alloc(other.m_alloc)
+	{
+		copy_from(other);
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	basic_soa_array<Alloc, Fields...>::basic_soa_array(basic_soa_array&& other) noexcept
+		: m_alloc(other.m_alloc)
+	{
+		steal_from(other);
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	basic_soa_array<Alloc, Fields...>& basic_soa_array<Alloc, Fields...>::operator=(const basic_soa_array& other)
+	{
+		if (this == &other) [[unlikely]]
+		{
+			return *this;
+		}
+
+		release();
+		m_alloc = other.m_alloc;
+		copy_from(other);
+		return *this;
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	basic_soa_array<Alloc, Fields...>& basic_soa_array<Alloc, Fields...>::operator=(basic_soa_array&& other) noexcept
+	{
+		if (this == &other) [[unlikely]]
+		{
+			return *this;
+		}
+
+		release();
+		m_alloc = other.m_alloc;
+		steal_from(other);
+		return *this;
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	basic_soa_array<Alloc, Fields...>::~basic_soa_array()
+	{
+		release();
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	constexpr size_type basic_soa_array<Alloc, Fields...>::size() const noexcept
+	{
+		return m_size;
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	constexpr bool basic_soa_array<Alloc, Fields...>::empty() const noexcept
+	{
+		return m_size == 0ull;
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	constexpr size_type basic_soa_array<Alloc, Fields...>::capacity() const noexcept
+	{
+		return m_capacity;
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	void basic_soa_array<Alloc, Fields...>::reserve(const size_type newCapacity)
+	{
+		if (newCapacity > m_capacity)
+		{
+			reallocate(newCapacity);
+		}
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	void basic_soa_array<Alloc, Fields...>::resize(const size_type newSize)
+	{
+		if (newSize < m_size)
+		{
+			destroy_rows(newSize, m_size - newSize);
+		}
+		else if (newSize > m_size)
+		{
+			reserve(newSize);
+			for_each_column(
+				[&]<size_type I>(integral_constant<size_type, I>)
+				{
+					column_allocator<I>(m_alloc).construct(data<I>() + m_size, newSize - m_size);
+				}
+			);
+		}
+
+		m_size = newSize;
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	void basic_soa_array<Alloc, Fields...>::clear() noexcept
+	{
+		destroy_rows(0ull, m_size);
+		m_size = 0ull;
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	void basic_soa_array<Alloc, Fields...>::push_back(const Fields&... values)
+	{
+		emplace_back(values...);
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	template <typename... Args>
+		requires(sizeof...(Args) == sizeof...(Fields))
+	typename basic_soa_array<Alloc, Fields...>::reference basic_soa_array<Alloc, Fields...>::emplace_back(Args&&... args)
+	{
+		grow_for(m_size + 1ull);
+
+		[&]<size_type... Is>(index_sequence<Is...>)
+		{
+			(column_allocator<Is>(m_alloc).construct(data<Is>() + m_size, 1ull, forward<Args>(args)), ...);
+		}(index_sequence_for<Fields...>{});
+
+		return row(m_size++);
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	void basic_soa_array<Alloc, Fields...>::pop_back() noexcept
+	{
+		rsl_assert_out_of_range(m_size != 0ull);
+		--m_size;
+		destroy_rows(m_size, 1ull);
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	void basic_soa_array<Alloc, Fields...>::erase_swap(const size_type pos) noexcept
+	{
+		rsl_assert_out_of_range(pos < m_size);
+
+		const size_type last = m_size - 1ull;
+		if (pos != last)
+		{
+			for_each_column(
+				[&]<size_type I>(integral_constant<size_type, I>)
+				{
+					field_at<I>* column = data<I>();
+					column[pos] = rsl::move(column[last]);
+				}
+			);
+		}
+
+		pop_back();
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	template <size_type I>
+	constexpr typename basic_soa_array<Alloc, Fields...>::template column_view<I>
+	basic_soa_array<Alloc, Fields...>::view() noexcept
+	{
+		return column_view<I>::from_buffer(data<I>(), m_size);
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	template <size_type I>
+	constexpr typename basic_soa_array<Alloc, Fields...>::template const_column_view<I>
+	basic_soa_array<Alloc, Fields...>::view() const noexcept
+	{
+		return const_column_view<I>::from_buffer(data<I>(), m_size);
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	template <size_type I>
+	constexpr typename basic_soa_array<Alloc, Fields...>::template field_at<I>*
+	basic_soa_array<Alloc, Fields...>::data() noexcept
+	{
+		return static_cast<field_at<I>*>(m_columns[I]);
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	template <size_type I>
+	constexpr const typename basic_soa_array<Alloc, Fields...>::template field_at<I>*
+	basic_soa_array<Alloc, Fields...>::data() const noexcept
+	{
+		return static_cast<const field_at<I>*>(m_columns[I]);
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	template <size_type I>
+	constexpr typename basic_soa_array<Alloc, Fields...>::template field_at<I>&
+	basic_soa_array<Alloc, Fields...>::at(const size_type i) noexcept
+	{
+		rsl_assert_out_of_range(i < m_size);
+		return data<I>()[i];
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	template <size_type I>
+	constexpr const typename basic_soa_array<Alloc, Fields...>::template field_at<I>&
+	basic_soa_array<Alloc, Fields...>::at(const size_type i) const noexcept
+	{
+		rsl_assert_out_of_range(i < m_size);
+		return data<I>()[i];
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	constexpr typename basic_soa_array<Alloc, Fields...>::reference
+	basic_soa_array<Alloc, Fields...>::row(const size_type i) noexcept
+	{
+		rsl_assert_out_of_range(i < m_size);
+		return reference(this, i);
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	constexpr typename basic_soa_array<Alloc, Fields...>::const_reference
+	basic_soa_array<Alloc, Fields...>::row(const size_type i) const noexcept
+	{
+		rsl_assert_out_of_range(i < m_size);
+		return const_reference(this, i);
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	constexpr typename basic_soa_array<Alloc, Fields...>::reference
+	basic_soa_array<Alloc, Fields...>::operator[](const size_type i) noexcept
+	{
+		return row(i);
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	constexpr typename basic_soa_array<Alloc, Fields...>::const_reference
+	basic_soa_array<Alloc, Fields...>::operator[](const size_type i) const noexcept
+	{
+		return row(i);
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	constexpr typename basic_soa_array<Alloc, Fields...>::allocator_t& basic_soa_array<Alloc, Fields...>::get_allocator() noexcept
+	{
+		return *m_alloc;
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	constexpr const typename basic_soa_array<Alloc, Fields...>::allocator_t&
+	basic_soa_array<Alloc, Fields...>::get_allocator() const noexcept
+	{
+		return *m_alloc;
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	constexpr typename basic_soa_array<Alloc, Fields...>::iterator_type basic_soa_array<Alloc, Fields...>::begin() noexcept
+	{
+		return iterator_type(this, 0ull);
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	constexpr typename basic_soa_array<Alloc, Fields...>::const_iterator_type
+	basic_soa_array<Alloc, Fields...>::begin() const noexcept
+	{
+		return const_iterator_type(this, 0ull);
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	constexpr typename basic_soa_array<Alloc, Fields...>::const_iterator_type
+	basic_soa_array<Alloc, Fields...>::cbegin() const noexcept
+	{
+		return begin();
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	constexpr typename basic_soa_array<Alloc, Fields...>::iterator_type basic_soa_array<Alloc, Fields...>::end() noexcept
+	{
+		return iterator_type(this, m_size);
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	constexpr typename basic_soa_array<Alloc, Fields...>::const_iterator_type
+	basic_soa_array<Alloc, Fields...>::end() const noexcept
+	{
+		return const_iterator_type(this, m_size);
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	constexpr typename basic_soa_array<Alloc, Fields...>::const_iterator_type
+	basic_soa_array<Alloc, Fields...>::cend() const noexcept
+	{
+		return end();
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	constexpr size_type basic_soa_array<Alloc, Fields...>::column_bytes(const size_type index, const size_type capacity) noexcept
+	{
+		constexpr size_type fieldSizes[] = {sizeof(Fields)...};
+		const size_type bytes = fieldSizes[index] * capacity;
+		return (bytes + column_alignment - 1ull) & ~(column_alignment - 1ull);
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	constexpr size_type basic_soa_array<Alloc, Fields...>::block_bytes(const size_type capacity) noexcept
+	{
+		size_type bytes = 0ull;
+		for (size_type i = 0ull; i < field_count; i++)
+		{
+			bytes += column_bytes(i, capacity);
+		}
+
+		return bytes;
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	template <typename Func>
+	constexpr void basic_soa_array<Alloc, Fields...>::for_each_column(Func&& func)
+	{
+		[&]<size_type... Is>(index_sequence<Is...>)
+		{
+			(func(integral_constant<size_type, Is>{}), ...);
+		}(index_sequence_for<Fields...>{});
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	void basic_soa_array<Alloc, Fields...>::reallocate(const size_type newCapacity)
+	{
+		rsl_assert_invalid_parameters(newCapacity >= m_size);
+
+		void* newColumns[field_count] = {};
+		if (newCapacity != 0ull)
+		{
+			byte* block = static_cast<byte*>(m_alloc->allocate(block_bytes(newCapacity), column_alignment));
+			rsl_assert_invalid_object(block);
+
+			size_type offset = 0ull;
+			for (size_type i = 0ull; i < field_count; i++)
+			{
+				newColumns[i] = block + offset;
+				offset += column_bytes(i, newCapacity);
+			}
+
+			if (m_size != 0ull)
+			{
+				for_each_column(
+					[&]<size_type I>(integral_constant<size_type, I>)
+					{
+						column_allocator<I> columnAlloc(m_alloc);
+						columnAlloc.move(static_cast<field_at<I>*>(newColumns[I]), data<I>(), m_size);
+						columnAlloc.destroy(data<I>(), m_size);
+					}
+				);
+			}
+		}
+		else
+		{
+			destroy_rows(0ull, m_size);
+		}
+
+		if (m_columns[0] != nullptr)
+		{
+			m_alloc->deallocate(m_columns[0], block_bytes(m_capacity), column_alignment);
+		}
+
+		for (size_type i = 0ull; i < field_count; i++)
+		{
+			m_columns[i] = newColumns[i];
+		}
+
+		m_capacity = newCapacity;
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	void basic_soa_array<Alloc, Fields...>::grow_for(const size_type requiredCapacity)
+	{
+		if (requiredCapacity <= m_capacity) [[likely]]
+		{
+			return;
+		}
+
+		size_type newCapacity = m_capacity == 0ull ? 8ull : m_capacity * 2ull;
+		if (newCapacity < requiredCapacity)
+		{
+			newCapacity = requiredCapacity;
+		}
+
+		reallocate(newCapacity);
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	void basic_soa_array<Alloc, Fields...>::destroy_rows(const size_type offset, const size_type count) noexcept
+	{
+		if (count == 0ull)
+		{
+			return;
+		}
+
+		for_each_column(
+			[&]<size_type I>(integral_constant<size_type, I>)
+			{
+				column_allocator<I>(m_alloc).destroy(data<I>() + offset, count);
+			}
+		);
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	void basic_soa_array<Alloc, Fields...>::release() noexcept
+	{
+		destroy_rows(0ull, m_size);
+
+		if (m_columns[0] != nullptr)
+		{
+			m_alloc->deallocate(m_columns[0], block_bytes(m_capacity), column_alignment);
+		}
+
+		for (size_type i = 0ull; i < field_count; i++)
+		{
+			m_columns[i] = nullptr;
+		}
+
+		m_size = 0ull;
+		m_capacity = 0ull;
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	void basic_soa_array<Alloc, Fields...>::copy_from(const basic_soa_array& other)
+	{
+		if (other.m_size == 0ull)
+		{
+			return;
+		}
+
+		reallocate(other.m_size);
+		for_each_column(
+			[&]<size_type I>(integral_constant<size_type, I>)
+			{
+				column_allocator<I>(m_alloc).copy(data<I>(), other.template data<I>(), other.m_size);
+			}
+		);
+
+		m_size = other.m_size;
+	}
+
+	template <allocator_type Alloc, typename... Fields>
+	void basic_soa_array<Alloc, Fields...>::steal_from(basic_soa_array& other) noexcept
+	{
+		for (size_type i = 0ull; i < field_count; i++)
+		{
+			m_columns[i] = other.m_columns[i];
+			other.m_columns[i] = nullptr;
+		}
+
+		m_size = other.m_size;
+		m_capacity = other.m_capacity;
+		other.m_size = 0ull;
+		other.m_capacity = 0ull;
+	}
+} // namespace rsl
+
+namespace std
+{
+	template <typename SoaArray, bool Const>
+	struct tuple_size<rsl::soa_row_reference<SoaArray, Const>> : public std::integral_constant<std::size_t, SoaArray::field_count>
+	{
+	};
+
+	template <std::size_t I, typename SoaArray, bool Const>
+	struct tuple_element<I, rsl::soa_row_reference<SoaArray, Const>>
+	{
+		using type = typename rsl::soa_row_reference<SoaArray, Const>::template field_type<I>&;
+	};
+} // namespace std
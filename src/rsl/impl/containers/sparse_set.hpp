@@ -0,0 +1,155 @@
+#pragma once
+
+#include "../memory/typed_allocator.hpp"
+#include "../util/primitives.hpp"
+#include "array.hpp"
+#include "pair.hpp"
+
+/**
+ * @file sparse_set.hpp
+ */
+
+namespace rsl
+{
+	/**@class sparse_set
+	 * @brief Sparse set for dense integer ids, such as entity ids. Membership tests are O(1) without hashing and the
+	 * contained ids are stored contiguously for cache friendly iteration.
+	 * @tparam Index Unsigned integer type of the ids.
+	 * @tparam Alloc Allocator used for the dense storage and the sparse pages.
+	 * @tparam PageSize Amount of ids per sparse page, pages are only allocated once an id in their range is inserted.
+	 * @note The largest representable Index is reserved as tombstone and can't be inserted.
+	 * @note Removing an item will move the last item in the dense container into the removed slot.
+	 */
+	template <unsigned_type Index, allocator_type Alloc = default_allocator, size_type PageSize = 4096ull>
+	class sparse_set
+	{
+		static_assert(PageSize != 0ull && (PageSize & (PageSize - 1ull)) == 0ull, "PageSize needs to be a power of 2.");
+
+	public:
+		using value_type = Index;
+		using allocator_storage_type = allocator_storage<Alloc>;
+		using allocator_t = Alloc;
+
+		using dense_container = dynamic_array<value_type, allocator_t>;
+		using page_container = dynamic_array<value_type*, allocator_t>;
+		using page_allocator_type = typed_allocator<value_type, allocator_t>;
+
+		using iterator_type = typename dense_container::const_iterator_type;
+		using const_iterator_type = typename dense_container::const_iterator_type;
+		using reverse_iterator_type = typename dense_container::const_reverse_iterator_type;
+		using const_reverse_iterator_type = typename dense_container::const_reverse_iterator_type;
+		using view_type = typename dense_container::const_view_type;
+		using const_view_type = typename dense_container::const_view_type;
+
+		constexpr static size_type page_size = PageSize;
+		constexpr static value_type tombstone = static_cast<value_type>(-1);
+
+		[[rythe_always_inline]] constexpr sparse_set() = default;
+
+		[[rythe_always_inline]] explicit constexpr sparse_set(const allocator_storage_type& allocStorage);
+
+		sparse_set(const sparse_set& other);
+		sparse_set(sparse_set&& other) noexcept;
+		sparse_set& operator=(const sparse_set& other);
+		sparse_set& operator=(sparse_set&& other) noexcept;
+		~sparse_set();
+
+		/**@brief Returns the amount of ids in the set.
+		 */
+		[[nodiscard]] [[rythe_always_inline]] constexpr size_type size() const noexcept;
+
+		/**@brief Returns whether the set is empty.
+		 */
+		[[nodiscard]] [[rythe_always_inline]] constexpr bool empty() const noexcept;
+
+		/**@brief Returns the amount of ids the set can store without reallocating the dense container.
+		 */
+		[[nodiscard]] [[rythe_always_inline]] constexpr size_type capacity() const noexcept;
+
+		/**@brief Reserves space in the dense container.
+		 * @note Sparse pages are only allocated on insertion.
+		 */
+		void reserve(size_type newCapacity);
+
+		/**@brief Removes all ids from the set.
+		 * @note Will keep the allocated pages around, use reset to release them.
+		 */
+		void clear() noexcept;
+
+		/**@brief Removes all ids from the set and releases all sparse pages.
+		 */
+		void reset() noexcept;
+
+		/**@brief Checks whether a certain id is contained in the set.
+		 */
+		[[nodiscard]] [[rythe_always_inline]] constexpr bool contains(value_type id) const noexcept;
+
+		/**@brief Returns the amount of items of a certain id (either 0 or 1).
+		 * @note Function is only available for compatibility reasons, it is advised to use contains instead.
+		 */
+		[[nodiscard]] [[rythe_always_inline]] constexpr size_type count(value_type id) const noexcept;
+
+		/**@brief Returns the index of an id in the dense container, or npos if the id isn't contained.
+		 */
+		[[nodiscard]] [[rythe_always_inline]] constexpr size_type index_of(value_type id) const noexcept;
+
+		/**@brief Finds the iterator of an id.
+		 * @returns Iterator to the id if found, otherwise end.
+		 */
+		[[nodiscard]] [[rythe_always_inline]] constexpr const_iterator_type find(value_type id) const noexcept;
+
+		/**@brief Inserts new id into the set.
+		 * @returns Index of the id in the dense container and whether the id was newly inserted.
+		 */
+		pair<size_type, bool> insert(value_type id);
+
+		/**@brief Erases id from the set.
+		 * @returns Amount of ids erased (either 0 or 1).
+		 * @note The last id in the dense container will be moved into the erased slot.
+		 */
+		size_type erase(value_type id) noexcept;
+
+		[[nodiscard]] [[rythe_always_inline]] constexpr value_type at(size_type i) const noexcept;
+		[[nodiscard]] [[rythe_always_inline]] constexpr value_type operator[](size_type i) const noexcept;
+
+		[[nodiscard]] [[rythe_always_inline]] constexpr const value_type* data() const noexcept;
+		[[nodiscard]] [[rythe_always_inline]] constexpr const_view_type view() const noexcept;
+		[[nodiscard]] [[rythe_always_inline]] constexpr const dense_container& dense() const noexcept;
+
+		/**@brief Amount of sparse pages currently allocated.
+		 */
+		[[nodiscard]] [[rythe_always_inline]] constexpr size_type page_count() const noexcept;
+
+		[[nodiscard]] [[rythe_always_inline]] constexpr allocator_t& get_allocator() noexcept;
+		[[nodiscard]] [[rythe_always_inline]] constexpr const allocator_t& get_allocator() const noexcept;
+
+		[[nodiscard]] [[rythe_always_inline]] constexpr const_iterator_type begin() const noexcept;
+		[[nodiscard]] [[rythe_always_inline]] constexpr const_iterator_type cbegin() const noexcept;
+
+		[[nodiscard]] [[rythe_always_inline]] constexpr const_iterator_type end() const noexcept;
+		[[nodiscard]] [[rythe_always_inline]] constexpr const_iterator_type cend() const noexcept;
+
+		[[nodiscard]] [[rythe_always_inline]] constexpr const_reverse_iterator_type rbegin() const noexcept;
+		[[nodiscard]] [[rythe_always_inline]] constexpr const_reverse_iterator_type crbegin() const noexcept;
+
+		[[nodiscard]] [[rythe_always_inline]] constexpr const_reverse_iterator_type rend() const noexcept;
+		[[nodiscard]] [[rythe_always_inline]] constexpr const_reverse_iterator_type crend() const noexcept;
+
+	private:
+		[[nodiscard]] [[rythe_always_inline]] constexpr static size_type page_of(value_type id) noexcept;
+		[[nodiscard]] [[rythe_always_inline]] constexpr static size_type offset_of(value_type id) noexcept;
+
+		[[nodiscard]] [[rythe_always_inline]] constexpr const value_type* sparse_slot(value_type id) const noexcept;
+		[[nodiscard]] [[rythe_always_inline]] constexpr value_type* sparse_slot(value_type id) noexcept;
+		[[nodiscard]] value_type& assure_sparse_slot(value_type id);
+
+		void copy_pages_from(const sparse_set& other);
+		void release_pages() noexcept;
+
+		dense_container m_dense;
+		page_container m_pages;
+		page_allocator_type m_pageAllocator;
+	};
+} // namespace rsl
+
+#include "sparse_set.inl"
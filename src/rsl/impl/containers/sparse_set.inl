@@ -0,0 +1,391 @@
+#pragma once
+#include "sparse_set.hpp"
+
+namespace rsl
+{
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	constexpr sparse_set<Index, Alloc, PageSize>::sparse_set(const allocator_storage_type& allocStorage)
+		: m_dense(allocStorage),
+		  m_pages(allocStorage),
+		  m_pageAllocator(allocStorage) {}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	sparse_set<Index, Alloc, PageSize>::sparse_set(const sparse_set& other)
+		: m_dense(other.m_dense),
+		  m_pages(other.m_pages.get_allocator_storage()),
+		  m_pageAllocator(other.m_pageAllocator)
+	{
+		copy_pages_from(other);
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	sparse_set<Index, Alloc, PageSize>::sparse_set(sparse_set&& other) noexcept
+		: m_dense(rsl::move(other.m_dense)),
+		  m_pages(rsl::move(other.m_pages)),
+		  m_pageAllocator(other.m_pageAllocator)
+	{
+		other.m_pages.clear();
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	sparse_set<Index, Alloc, PageSize>& sparse_set<Index, Alloc, PageSize>::operator=(const sparse_set& other)
+	{
+		if (this == &other)
+		{
+			return *this;
+		}
+
+		release_pages();
+		m_dense = other.m_dense;
+		m_pageAllocator = other.m_pageAllocator;
+		copy_pages_from(other);
+		return *this;
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	sparse_set<Index, Alloc, PageSize>& sparse_set<Index, Alloc, PageSize>::operator=(sparse_set&& other) noexcept
+	{
+		if (this == &other)
+		{
+			return *this;
+		}
+
+		release_pages();
+		m_dense = rsl::move(other.m_dense);
+		m_pages = rsl::move(other.m_pages);
+		m_pageAllocator = other.m_pageAllocator;
+		other.m_pages.clear();
+		return *this;
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	sparse_set<Index, Alloc, PageSize>::~sparse_set()
+	{
+		release_pages();
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	constexpr size_type sparse_set<Index, Alloc, PageSize>::size() const noexcept
+	{
+		return m_dense.size();
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	constexpr bool sparse_set<Index, Alloc, PageSize>::empty() const noexcept
+	{
+		return m_dense.empty();
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	constexpr size_type sparse_set<Index, Alloc, PageSize>::capacity() const noexcept
+	{
+		return m_dense.capacity();
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	void sparse_set<Index, Alloc, PageSize>::reserve(const size_type newCapacity)
+	{
+		m_dense.reserve(newCapacity);
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	void sparse_set<Index, Alloc, PageSize>::clear() noexcept
+	{
+		// Only touch the slots that are actually in use instead of wiping every page.
+		for (const value_type id : m_dense)
+		{
+			*sparse_slot(id) = tombstone;
+		}
+
+		m_dense.clear();
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	void sparse_set<Index, Alloc, PageSize>::reset() noexcept
+	{
+		m_dense.clear();
+		release_pages();
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	constexpr bool sparse_set<Index, Alloc, PageSize>::contains(const value_type id) const noexcept
+	{
+		const value_type* slot = sparse_slot(id);
+		return slot != nullptr && *slot != tombstone;
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	constexpr size_type sparse_set<Index, Alloc, PageSize>::count(const value_type id) const noexcept
+	{
+		return contains(id) ? 1ull : 0ull;
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	constexpr size_type sparse_set<Index, Alloc, PageSize>::index_of(const value_type id) const noexcept
+	{
+		const value_type* slot = sparse_slot(id);
+		if (slot == nullptr || *slot == tombstone)
+		{
+			return npos;
+		}
+
+		return static_cast<size_type>(*slot);
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	constexpr typename sparse_set<Index, Alloc, PageSize>::const_iterator_type
+	sparse_set<Index, Alloc, PageSize>::find(const value_type id) const noexcept
+	{
+		const size_type index = index_of(id);
+		if (index == npos)
+		{
+			return end();
+		}
+
+		return m_dense.iterator_at(index);
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	pair<size_type, bool> sparse_set<Index, Alloc, PageSize>::insert(const value_type id)
+	{
+		rsl_assert_invalid_parameters(id != tombstone);
+
+		value_type& slot = assure_sparse_slot(id);
+		if (slot != tombstone)
+		{
+			return {static_cast<size_type>(slot), false};
+		}
+
+		const size_type index = m_dense.size();
+		m_dense.push_back(id);
+		slot = static_cast<value_type>(index);
+		return {index, true};
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	size_type sparse_set<Index, Alloc, PageSize>::erase(const value_type id) noexcept
+	{
+		value_type* slot = sparse_slot(id);
+		if (slot == nullptr || *slot == tombstone)
+		{
+			return 0ull;
+		}
+
+		const size_type index = static_cast<size_type>(*slot);
+		*slot = tombstone;
+		m_dense.erase_swap(index);
+
+		if (index != m_dense.size())
+		{
+			*sparse_slot(m_dense[index]) = static_cast<value_type>(index);
+		}
+
+		return 1ull;
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	constexpr typename sparse_set<Index, Alloc, PageSize>::value_type
+	sparse_set<Index, Alloc, PageSize>::at(const size_type i) const noexcept
+	{
+		return m_dense.at(i);
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	constexpr typename sparse_set<Index, Alloc, PageSize>::value_type
+	sparse_set<Index, Alloc, PageSize>::operator[](const size_type i) const noexcept
+	{
+		return m_dense.at(i);
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	constexpr const typename sparse_set<Index, Alloc, PageSize>::value_type*
+	sparse_set<Index, Alloc, PageSize>::data() const noexcept
+	{
+		return m_dense.data();
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	constexpr typename sparse_set<Index, Alloc, PageSize>::const_view_type
+	sparse_set<Index, Alloc, PageSize>::view() const noexcept
+	{
+		return m_dense.view();
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	constexpr const typename sparse_set<Index, Alloc, PageSize>::dense_container&
+	sparse_set<Index, Alloc, PageSize>::dense() const noexcept
+	{
+		return m_dense;
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	constexpr size_type sparse_set<Index, Alloc, PageSize>::page_count() const noexcept
+	{
+		size_type result = 0ull;
+		for (const value_type* page : m_pages)
+		{
+			if (page != nullptr)
+			{
+				++result;
+			}
+		}
+
+		return result;
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	constexpr typename sparse_set<Index, Alloc, PageSize>::allocator_t&
+	sparse_set<Index, Alloc, PageSize>::get_allocator() noexcept
+	{
+		return m_dense.get_allocator();
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	constexpr const typename sparse_set<Index, Alloc, PageSize>::allocator_t&
+	sparse_set<Index, Alloc, PageSize>::get_allocator() const noexcept
+	{
+		return m_dense.get_allocator();
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	constexpr typename sparse_set<Index, Alloc, PageSize>::const_iterator_type
+	sparse_set<Index, Alloc, PageSize>::begin() const noexcept
+	{
+		return m_dense.begin();
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	constexpr typename sparse_set<Index, Alloc, PageSize>::const_iterator_type
+	sparse_set<Index, Alloc, PageSize>::cbegin() const noexcept
+	{
+		return m_dense.cbegin();
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	constexpr typename sparse_set<Index, Alloc, PageSize>::const_iterator_type
+	sparse_set<Index, Alloc, PageSize>::end() const noexcept
+	{
+		return m_dense.end();
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	constexpr typename sparse_set<Index, Alloc, PageSize>::const_iterator_type
+	sparse_set<Index, Alloc, PageSize>::cend() const noexcept
+	{
+		return m_dense.cend();
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	constexpr typename sparse_set<Index, Alloc, PageSize>::const_reverse_iterator_type
+	sparse_set<Index, Alloc, PageSize>::rbegin() const noexcept
+	{
+		return m_dense.rbegin();
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	constexpr typename sparse_set<Index, Alloc, PageSize>::const_reverse_iterator_type
+	sparse_set<Index, Alloc, PageSize>::crbegin() const noexcept
+	{
+		return m_dense.crbegin();
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	constexpr typename sparse_set<Index, Alloc, PageSize>::const_reverse_iterator_type
+	sparse_set<Index, Alloc, PageSize>::rend() const noexcept
+	{
+		return m_dense.rend();
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	constexpr typename sparse_set<Index, Alloc, PageSize>::const_reverse_iterator_type
+	sparse_set<Index, Alloc, PageSize>::crend() const noexcept
+	{
+		return m_dense.crend();
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	constexpr size_type sparse_set<Index, Alloc, PageSize>::page_of(const value_type id) noexcept
+	{
+		return static_cast<size_type>(id) / page_size;
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	constexpr size_type sparse_set<Index, Alloc, PageSize>::offset_of(const value_type id) noexcept
+	{
+		return static_cast<size_type>(id) & (page_size - 1ull);
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	constexpr const typename sparse_set<Index, Alloc, PageSize>::value_type*
+	sparse_set<Index, Alloc, PageSize>::sparse_slot(const value_type id) const noexcept
+	{
+		const size_type page = page_of(id);
+		if (page >= m_pages.size())
+		{
+			return nullptr;
+		}
+
+		const value_type* pagePtr = m_pages[page];
+		if (pagePtr == nullptr)
+		{
+			return nullptr;
+		}
+
+		return pagePtr + offset_of(id);
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	constexpr typename sparse_set<Index, Alloc, PageSize>::value_type*
+	sparse_set<Index, Alloc, PageSize>::sparse_slot(const value_type id) noexcept
+	{
+		return const_cast<value_type*>(as_const(*this).sparse_slot(id));
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	typename sparse_set<Index, Alloc, PageSize>::value_type&
+	sparse_set<Index, Alloc, PageSize>::assure_sparse_slot(const value_type id)
+	{
+		const size_type page = page_of(id);
+		if (page >= m_pages.size())
+		{
+			m_pages.resize(page + 1ull, nullptr);
+		}
+
+		value_type*& pagePtr = m_pages[page];
+		if (pagePtr == nullptr) [[unlikely]]
+		{
+			pagePtr = m_pageAllocator.allocate(page_size);
+			constexpr_memset(pagePtr, 0xFF, page_size * sizeof(value_type));
+		}
+
+		return pagePtr[offset_of(id)];
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	void sparse_set<Index, Alloc, PageSize>::copy_pages_from(const sparse_set& other)
+	{
+		m_pages.resize(other.m_pages.size(), nullptr);
+		for (size_type i = 0; i < other.m_pages.size(); i++)
+		{
+			if (other.m_pages[i] != nullptr)
+			{
+				m_pages[i] = m_pageAllocator.allocate(page_size);
+				memcpy(m_pages[i], other.m_pages[i], page_size * sizeof(value_type));
+			}
+		}
+	}
+
+	template <unsigned_type Index, allocator_type Alloc, size_type PageSize>
+	void sparse_set<Index, Alloc, PageSize>::release_pages() noexcept
+	{
+		for (value_type* page : m_pages)
+		{
+			if (page != nullptr)
+			{
+				m_pageAllocator.deallocate(page, page_size);
+			}
+		}
+
+		m_pages.clear();
+	}
+} // namespace rsl
@@ -3,13 +3,23 @@
 #include "../memory/allocator.hpp"
 #include "../util/assert.hpp"
 #include "../util/common.hpp"
+#include "../util/type_index.hpp"
 #include "../util/type_traits.hpp"
-#include "map/dynamic_map.hpp"
+#include "array.hpp"
 
 namespace rsl
 {
+	/**@class basic_type_map
+	 * @brief Container holding at most one instance of each type. Entries are looked up by the type's type_index and
+	 * stored in a directly indexed array of slots, so a lookup is a bounds check and a load instead of a hash probe.
+	 * @tparam Alloc Allocator used for both the slots and the stored instances.
+	 * @tparam Factory Factory used to construct the stored instances.
+	 * @tparam StaticCapacity Amount of slots stored in place before the slots move to the heap.
+	 * @note Type indices are shared across all type maps, a map's slot array grows up to the largest index stored in it.
+	 */
 	template <
-		allocator_type Alloc = default_allocator, factory_type Factory = default_factory<void>>
+		allocator_type Alloc = default_allocator, factory_type Factory = default_factory<void>,
+		size_type StaticCapacity = 16ull>
 	class basic_type_map
 	{
 	private:
@@ -30,36 +40,35 @@ namespace rsl
 			: m_allocator(allocStorage),
 			  m_storage(allocStorage) {}
 
-		[[nodiscard]] [[rythe_always_inline]] constexpr size_type size() const noexcept { return m_storage.size(); }
-		[[nodiscard]] [[rythe_always_inline]] constexpr bool empty() const noexcept { return m_storage.empty(); }
+		[[nodiscard]] [[rythe_always_inline]] constexpr size_type size() const noexcept { return m_count; }
+		[[nodiscard]] [[rythe_always_inline]] constexpr bool empty() const noexcept { return m_count == 0ull; }
 
 		template <typename T>
-		[[nodiscard]] [[rythe_always_inline]] constexpr bool has() const noexcept
+		[[nodiscard]] [[rythe_always_inline]] bool has() const noexcept
 		{
-			constexpr id_type typeHash = type_id<T>();
-			return m_storage.contains(typeHash);
+			return try_get<T>() != nullptr;
 		}
 
 		template <typename T>
-		[[nodiscard]] [[rythe_always_inline]] constexpr const T* try_get() const noexcept
+		[[nodiscard]] [[rythe_always_inline]] const T* try_get() const noexcept
 		{
-			constexpr id_type typeHash = type_id<T>();
-			if (const entry_item* entry = m_storage.find(typeHash); entry != nullptr)
+			const size_type index = type_index<T>();
+			if (index >= m_storage.size())
 			{
-				return entry->template cast<const T>();
+				return nullptr;
 			}
 
-			return nullptr;
+			return m_storage[index].template cast<const T>();
 		}
 
 		template <typename T>
-		[[nodiscard]] [[rythe_always_inline]] constexpr T* try_get() noexcept
+		[[nodiscard]] [[rythe_always_inline]] T* try_get() noexcept
 		{
 			return const_cast<T*>(as_const(*this).template try_get<T>());
 		}
 
 		template <typename T>
-		[[nodiscard]] [[rythe_always_inline]] constexpr const T& get() const
+		[[nodiscard]] [[rythe_always_inline]] const T& get() const
 		{
 			auto* ptr = try_get<T>();
 			rsl_assert_invalid_object(ptr);
@@ -67,32 +76,39 @@ namespace rsl
 		}
 
 		template <typename T>
-		[[nodiscard]] [[rythe_always_inline]] constexpr T& get()
+		[[nodiscard]] [[rythe_always_inline]] T& get()
 		{
 			return const_cast<T&>(as_const(*this).template get<T>());
 		}
 
 		template <typename T, typename... Args>
-		[[rythe_always_inline]] constexpr std::pair<T&, bool> try_emplace(Args&&... args) noexcept
+		[[rythe_always_inline]] std::pair<T&, bool> try_emplace(Args&&... args) noexcept
 		{
-			constexpr id_type typeHash = type_id<T>();
-			auto result = m_storage.try_emplace(typeHash);
-			if (result.second)
+			const size_type index = type_index<T>();
+			if (index >= m_storage.size())
 			{
-				result.first.template construct<T>(this, forward<Args>(args)...);
+				m_storage.resize(index + 1ull);
 			}
 
-			return { ref(*(result.first.template cast<T>())), result.second };
+			entry_item& entry = m_storage[index];
+			const bool emplaced = entry.data == nullptr;
+			if (emplaced)
+			{
+				entry.template construct<T>(this, forward<Args>(args)...);
+				++m_count;
+			}
+
+			return { ref(*(entry.template cast<T>())), emplaced };
 		}
 
 		template <typename T, typename... Args>
-		[[rythe_always_inline]] constexpr T& emplace(Args&&... args)
+		[[rythe_always_inline]] T& emplace(Args&&... args)
 		{
 			return try_emplace<T>(forward<Args>(args)...).first;
 		}
 
 		template <typename T, typename... Args>
-		[[nodiscard]] [[rythe_always_inline]] constexpr T& get_or_emplace(Args&&... args) noexcept
+		[[nodiscard]] [[rythe_always_inline]] T& get_or_emplace(Args&&... args) noexcept
 		{
 			if (T* ptr = try_get<T>(); ptr != nullptr)
 			{
@@ -103,20 +119,35 @@ namespace rsl
 		}
 
 		template <typename T, typename... Args>
-		[[rythe_always_inline]] constexpr T& emplace_or_replace(Args&&... args) noexcept
+		[[rythe_always_inline]] T& emplace_or_replace(Args&&... args) noexcept
 		{
 			erase<T>();
 			return emplace<T>(forward<Args>(args)...);
 		}
 
 		template <typename T>
-		[[rythe_always_inline]] constexpr void erase() noexcept
+		[[rythe_always_inline]] void erase() noexcept
 		{
-			constexpr id_type typeHash = type_id<T>();
-			m_storage.erase(typeHash);
+			const size_type index = type_index<T>();
+			if (index < m_storage.size() && m_storage[index].data != nullptr)
+			{
+				m_storage[index].release();
+				--m_count;
+			}
 		}
 
-		[[rythe_always_inline]] constexpr void clear() noexcept { m_storage.clear(); }
+		/**@brief Destroys all stored instances.
+		 * @note Keeps the slot array around, so re-emplacing the same types won't reallocate.
+		 */
+		[[rythe_always_inline]] void clear() noexcept
+		{
+			for (entry_item& entry : m_storage)
+			{
+				entry.release();
+			}
+
+			m_count = 0ull;
+		}
 
 		[[rythe_always_inline]] constexpr allocator_t& get_allocator() noexcept { return m_allocator.get_allocator(); }
 
@@ -179,7 +210,7 @@ namespace rsl
 				return static_cast<T*>(data);
 			}
 
-			~entry_item()
+			void release()
 			{
 				if (data)
 				{
@@ -187,10 +218,13 @@ namespace rsl
 					(*deallocateEntry)(*map, *this);
 				}
 			}
+
+			~entry_item() { release(); }
 		};
 
-		alloc_type<pair<id_type, entry_item>> m_allocator;
-		dynamic_map<id_type, entry_item, hash_map_flags::defaultFlags, allocator_t> m_storage;
+		alloc_type<entry_item> m_allocator;
+		hybrid_array<entry_item, StaticCapacity, allocator_t> m_storage;
+		size_type m_count = 0ull;
 	};
 
 	using type_map = basic_type_map<>;
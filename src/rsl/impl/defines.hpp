@@ -248,6 +248,10 @@ namespace rsl
     #define RYTHE_FMA_ENABLED
 #endif
 
+#if defined(__AVX2__)
+    #define RYTHE_AVX2_ENABLED
+#endif
+
 #pragma endregion
 
 #pragma region ////////////////////////////////// Language convention ///////////////////////////////////
@@ -0,0 +1,284 @@
+#include "async_logger.hpp"
+
+#include <cstring>
+#include <mutex>
+
+#include "../platform/platform.hpp"
+#include "../threading/current_thread.hpp"
+
+#include "deferred_format.hpp"
+#include "message.hpp"
+#include "sink.hpp"
+
+namespace rsl::log
+{
+	namespace
+	{
+		thread_local fmt::memory_buffer encodedArgs;
+	} // namespace
+
+	async_logger::record::record(
+		const log::message& message, const string_view payload, char* spilled, const bool deferredFormat
+	) noexcept
+		: sourceLocation(message.sourceLocation),
+		  formatString(deferredFormat ? message.msg : string_view{}),
+		  spilledPayload(spilled),
+		  threadId(message.threadId),
+		  timestamp(message.timestamp),
+		  length(static_cast<uint32>(payload.size() + message.fields.size())),
+		  severity(message.severity),
+		  kind(
+			  deferredFormat       ? payload_kind::deferred
+			  : message.structured ? payload_kind::structured
+								   : payload_kind::formatted
+		  ),
+		  fieldsLength(static_cast<uint16>(message.fields.size()))
+	{
+		if (!spilledPayload)
+		{
+			std::memcpy(inlinePayload, payload.data(), payload.size());
+			std::memcpy(inlinePayload + payload.size(), message.fields.data(), message.fields.size());
+		}
+	}
+
+	async_logger::async_logger(
+		const string_view name, const overflow_policy policy, const size_type capacity, const log::severity severity,
+		const log::severity flushSeverity, pmu_allocator& allocator
+	)
+		: basic_logger(name, severity, flushSeverity),
+		  m_policy(policy),
+		  m_allocator(&allocator),
+		  m_records(capacity)
+	{
+		m_thread = platform::create_thread(&writer_main, this, "rsl async logger"_sv, allocator);
+	}
+
+	async_logger::~async_logger()
+	{
+		m_running.store(false, memory_order::release);
+		wake_writer();
+		m_thread.join();
+	}
+
+	void async_logger::flush()
+	{
+		// Reported from the calling thread, the summary lines go through the ring like any other message.
+		report_suppressed();
+
+		const uint32 ticket = m_flushRequested.fetch_add(1u, memory_order::acq_rel) + 1u;
+		wake_writer();
+
+		uint32 completed = m_flushCompleted.load(memory_order::acquire);
+		while (static_cast<int32>(ticket - completed) > 0)
+		{
+			m_flushCompleted.wait(completed, memory_order::acquire);
+			completed = m_flushCompleted.load(memory_order::acquire);
+		}
+	}
+
+	void async_logger::log(const log::message& message)
+	{
+		if (message.fields.size() > 0xFFFFull)
+		{
+			rsl_assert_msg_soft(false, "Fields of an async message can't take up more than 64KiB, they get dropped.");
+			log::message withoutFields = message;
+			withoutFields.fields = string_view{};
+			log(withoutFields);
+			return;
+		}
+
+		const bool deferred = m_deferFormatting && !message.structured;
+		string_view payload;
+		if (deferred)
+		{
+			encodedArgs.clear();
+			encode_format_args(message.formatArgs, encodedArgs);
+			payload = string_view::from_buffer(encodedArgs.data(), encodedArgs.size());
+		}
+		else
+		{
+			payload = format_text(message);
+		}
+
+		// Fields go right behind the payload.
+		char* spilledPayload = nullptr;
+		const size_type recordSize = payload.size() + message.fields.size();
+		if (recordSize > inline_payload_capacity)
+		{
+			spilledPayload = static_cast<char*>(m_allocator->allocate(recordSize));
+			rsl_assert_invalid_object(spilledPayload);
+			std::memcpy(spilledPayload, payload.data(), payload.size());
+			std::memcpy(spilledPayload + payload.size(), message.fields.data(), message.fields.size());
+		}
+
+		enqueue(message, payload, spilledPayload, deferred);
+
+		if (message.severity >= m_flushSeverity && m_writerSleeping.load(memory_order::relaxed))
+		{
+			wake_writer();
+		}
+	}
+
+	void async_logger::enqueue(
+		const log::message& message, const string_view payload, char* spilledPayload, const bool deferred
+	)
+	{
+		if (m_policy == overflow_policy::grow && m_overflowActive.load(memory_order::acquire))
+		{
+			push_overflow(message, payload, spilledPayload, deferred);
+			return;
+		}
+
+		while (!m_records.try_emplace(message, payload, spilledPayload, deferred))
+		{
+			switch (m_policy)
+			{
+				case overflow_policy::block:
+				{
+					wake_writer();
+					current_thread::yield();
+					break;
+				}
+				case overflow_policy::drop:
+				{
+					m_dropped.fetch_add(1ull, memory_order::relaxed);
+					if (spilledPayload)
+					{
+						m_allocator->deallocate(spilledPayload, payload.size() + message.fields.size());
+					}
+					return;
+				}
+				case overflow_policy::grow:
+				{
+					push_overflow(message, payload, spilledPayload, deferred);
+					wake_writer();
+					return;
+				}
+			}
+		}
+	}
+
+	void async_logger::push_overflow(
+		const log::message& message, const string_view payload, char* spilledPayload, const bool deferred
+	)
+	{
+		std::lock_guard guard(m_overflowLock);
+		m_overflow.emplace_back(message, payload, spilledPayload, deferred);
+		m_overflowActive.store(true, memory_order::release);
+	}
+
+	void async_logger::wake_writer() noexcept
+	{
+		m_wakeSignal.fetch_add(1u, std::memory_order_release);
+		platform::wake_one_on_address(m_wakeSignal);
+	}
+
+	uint32 async_logger::writer_main(void* userData)
+	{
+		static_cast<async_logger*>(userData)->run();
+		return 0u;
+	}
+
+	void async_logger::run()
+	{
+		while (true)
+		{
+			// Read before writing, so everything logged before a flush request or the destructor gets written first.
+			const uint32 wakeSignal = m_wakeSignal.load(std::memory_order_acquire);
+			const bool running = m_running.load(memory_order::acquire);
+			const uint32 flushRequested = m_flushRequested.load(memory_order::acquire);
+
+			const size_type written = write_pending();
+
+			if (!running || flushRequested != m_flushCompleted.load(memory_order::relaxed))
+			{
+				flush_sinks();
+				m_flushCompleted.store(flushRequested, memory_order::release);
+				m_flushCompleted.notify_all();
+			}
+
+			if (!running)
+			{
+				return;
+			}
+
+			if (written == 0ull)
+			{
+				m_writerSleeping.store(true, memory_order::relaxed);
+				platform::wait_on_address(m_wakeSignal, wakeSignal, poll_interval);
+				m_writerSleeping.store(false, memory_order::relaxed);
+			}
+		}
+	}
+
+	size_type async_logger::write_pending()
+	{
+		size_type written = 0ull;
+
+		record entry;
+		while (m_records.try_pop(entry))
+		{
+			write(entry);
+			written++;
+		}
+
+		if (m_policy == overflow_policy::grow && m_overflowActive.load(memory_order::acquire))
+		{
+			{
+				std::lock_guard guard(m_overflowLock);
+				rsl::swap(m_overflow, m_overflowWriting);
+				m_overflowActive.store(false, memory_order::release);
+			}
+
+			for (const record& overflowEntry : m_overflowWriting)
+			{
+				write(overflowEntry);
+				written++;
+			}
+			m_overflowWriting.clear();
+		}
+
+		return written;
+	}
+
+	void async_logger::write(const record& entry)
+	{
+		string_view formatted = entry.payload();
+		if (entry.kind == payload_kind::deferred)
+		{
+			m_deferredText.clear();
+			format_deferred(entry.formatString, entry.payload(), m_deferredText);
+			formatted = string_view::from_buffer(m_deferredText.data(), m_deferredText.size());
+		}
+
+		const log::message message{
+			.loggerName = m_name,
+			.threadId = entry.threadId,
+			.timestamp = entry.timestamp,
+			.sourceLocation = entry.sourceLocation,
+			.severity = entry.severity,
+			.msg = formatted,
+			.formatArgs = fmt::format_args{},
+			.fields = entry.fields(),
+			.structured = entry.kind == payload_kind::structured,
+			.formattedMsg = formatted,
+			.formatCache = &m_decoratedOutput,
+		};
+		m_decoratedOutput.reset();
+
+		for (sink* target : m_sinks)
+		{
+			target->log(message);
+		}
+
+		if (entry.severity >= m_flushSeverity)
+		{
+			flush_sinks();
+		}
+
+		if (entry.spilledPayload)
+		{
+			m_allocator->deallocate(entry.spilledPayload, entry.length);
+		}
+	}
+} // namespace rsl::log
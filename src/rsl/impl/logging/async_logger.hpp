@@ -0,0 +1,170 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+#include "../containers/string.hpp"
+#include "../memory/allocator_context.hpp"
+#include "../threading/mpmc_queue.hpp"
+#include "../threading/mutex.hpp"
+#include "../threading/thread.hpp"
+#include "../threading/thread_id.hpp"
+#include "../time/time_point.hpp"
+#include "../util/atomic.hpp"
+#include "../util/primitives.hpp"
+#include "../util/source_location.hpp"
+
+#include "formatter.hpp"
+#include "logger.hpp"
+
+/**
+ * @file async_logger.hpp
+ */
+
+namespace rsl::log
+{
+	/**@brief What an async_logger does with a message when its ring buffer is full.
+	 */
+	enum struct overflow_policy : uint8
+	{
+		block, // The caller yields until the writer thread made room.
+		drop,  // The message is thrown away and counted in dropped_count().
+		grow,  // The message goes into an unbounded queue behind a lock until the writer thread caught up.
+	};
+
+	/**@class async_logger
+	 * @brief Logger that keeps the sinks off the calling thread. Callers format into a thread local buffer and copy the
+	 * result into a preallocated ring of fixed size records, a dedicated writer thread runs the sinks and flushes them.
+	 * Messages too long for a record get copied into a separate allocation that the writer thread frees.
+	 * With deferred formatting callers only copy the binary encoded arguments and the writer thread formats them.
+	 * @note Sinks are only called from the writer thread, set them before logging from other threads. The format
+	 * arguments don't outlive the call, messages handed to the sinks have formatArgs empty. msg is the format string for
+	 * deferred messages and the formatted text otherwise.
+	 */
+	class async_logger final : public basic_logger
+	{
+	public:
+		constexpr static size_type default_capacity = 8192ull;
+
+		/**@brief Longest formatted message or encoded arguments, plus encoded fields, that fit in a record without a
+		 * separate allocation. Encoded fields can take up to 64KiB.
+		 */
+		constexpr static size_type inline_payload_capacity = 176ull;
+
+		/**@brief How long the writer thread sleeps once it runs out of work. Callers only wake it early for flushes,
+		 * messages at the flush severity and a full ring buffer, so regular messages never cost a syscall.
+		 */
+		constexpr static std::chrono::microseconds poll_interval = std::chrono::microseconds(1000);
+
+		/**@brief Starts the writer thread.
+		 * @param capacity Amount of records in the ring buffer, needs to be a power of 2.
+		 * @param allocator Allocator used for the writer thread and messages longer than inline_payload_capacity.
+		 */
+		explicit async_logger(
+			string_view name, overflow_policy policy = overflow_policy::block, size_type capacity = default_capacity,
+			log::severity severity = log::severity::default_severity,
+			log::severity flushSeverity = log::severity::default_flush_severity,
+			pmu_allocator& allocator = *allocator_context::globalAllocator
+		);
+
+		async_logger(const async_logger&) = delete;
+		async_logger(async_logger&&) = delete;
+		async_logger& operator=(const async_logger&) = delete;
+		async_logger& operator=(async_logger&&) = delete;
+
+		/**@brief Writes out everything that is still queued, flushes the sinks and stops the writer thread.
+		 */
+		~async_logger() override;
+
+		using basic_logger::log;
+
+		/**@brief Blocks until everything logged before the call went through the sinks and the sinks got flushed.
+		 */
+		void flush() override;
+
+		/**@brief Amount of messages thrown away by overflow_policy::drop.
+		 */
+		[[nodiscard]] [[rythe_always_inline]] uint64 dropped_count() const noexcept;
+		[[nodiscard]] [[rythe_always_inline]] overflow_policy policy() const noexcept { return m_policy; }
+		[[nodiscard]] [[rythe_always_inline]] size_type capacity() const noexcept { return m_records.capacity(); }
+
+		/**@brief Copies the arguments in binary form with encode_format_args and leaves formatting to the writer thread,
+		 * callers skip fmt entirely. Format strings need to outlive the logger, which string literals do.
+		 */
+		[[rythe_always_inline]] void defer_formatting(bool enabled) noexcept { m_deferFormatting = enabled; }
+		[[nodiscard]] [[rythe_always_inline]] bool formatting_deferred() const noexcept { return m_deferFormatting; }
+
+	protected:
+		void log(const log::message& message) override;
+
+	private:
+		enum struct payload_kind : uint8
+		{
+			formatted,  // The text with the format arguments applied.
+			deferred,   // The encoded format arguments, formatString is the text.
+			structured, // The text of a structured message as it was logged.
+		};
+
+		struct record
+		{
+			record() noexcept = default;
+			record(const log::message& message, string_view payload, char* spilled, bool deferredFormat) noexcept;
+
+			[[nodiscard]] [[rythe_always_inline]] string_view payload() const noexcept;
+			[[nodiscard]] [[rythe_always_inline]] string_view fields() const noexcept;
+
+			source_location sourceLocation;
+			// Only set for deferred records, the payload holds the encoded arguments.
+			string_view formatString;
+			char* spilledPayload = nullptr;
+			thread_id threadId{};
+			time::point32 timestamp;
+			// Payload and encoded fields together, the fields come last.
+			uint32 length = 0u;
+			log::severity severity = log::severity::off;
+			payload_kind kind = payload_kind::formatted;
+			uint16 fieldsLength = 0u;
+			char inlinePayload[inline_payload_capacity];
+		};
+
+		// A ring buffer cell is a record plus its sequence number, together they take up 4 cache lines.
+		static_assert(sizeof(record) + sizeof(size_type) <= 4ull * cache_line_size);
+
+		void enqueue(const log::message& message, string_view payload, char* spilledPayload, bool deferred);
+		void push_overflow(const log::message& message, string_view payload, char* spilledPayload, bool deferred);
+		void wake_writer() noexcept;
+
+		void run();
+		size_type write_pending();
+		void write(const record& entry);
+
+		static uint32 writer_main(void* userData);
+
+		overflow_policy m_policy;
+		pmu_allocator* m_allocator;
+		mpmc_queue<record> m_records;
+
+		// Only used by overflow_policy::grow, m_overflowActive sends callers past the ring buffer while the writer
+		// thread hasn't picked up the overflow yet so messages from the same thread stay in order.
+		mutex m_overflowLock;
+		dynamic_array<record> m_overflow;
+		dynamic_array<record> m_overflowWriting;
+		atomic<bool> m_overflowActive;
+
+		bool m_deferFormatting = false;
+
+		// Owned by the writer thread.
+		format_cache m_decoratedOutput;
+		fmt::memory_buffer m_deferredText;
+
+		atomic<uint64> m_dropped;
+		atomic<uint32> m_flushRequested;
+		atomic<uint32> m_flushCompleted;
+		atomic<bool> m_writerSleeping;
+		atomic<bool> m_running{true};
+		std::atomic<uint32> m_wakeSignal{0u};
+		thread m_thread;
+	};
+} // namespace rsl::log
+
+#include "async_logger.inl"
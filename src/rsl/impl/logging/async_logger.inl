@@ -0,0 +1,21 @@
+#pragma once
+#include "async_logger.hpp"
+
+namespace rsl::log
+{
+	inline uint64 async_logger::dropped_count() const noexcept
+	{
+		return m_dropped.load(memory_order::relaxed);
+	}
+
+	inline string_view async_logger::record::payload() const noexcept
+	{
+		return string_view::from_buffer(spilledPayload ? spilledPayload : inlinePayload, length - fieldsLength);
+	}
+
+	inline string_view async_logger::record::fields() const noexcept
+	{
+		const char* data = spilledPayload ? spilledPayload : inlinePayload;
+		return string_view::from_buffer(data + length - fieldsLength, fieldsLength);
+	}
+} // namespace rsl::log
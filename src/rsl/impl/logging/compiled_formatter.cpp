@@ -0,0 +1,354 @@
+#include "compiled_formatter.hpp"
+
+#include <chrono>
+#include <cstring>
+
+#include "../platform/platform.hpp"
+#include "../time/time_point.hpp"
+#include "../util/assert.hpp"
+#include "../util/hash.hpp"
+
+#include "message.hpp"
+
+namespace rsl::log
+{
+	namespace
+	{
+		using internal::append_text;
+		using internal::append_view;
+		using internal::extend;
+
+		struct field_name
+		{
+			string_view name;
+			pattern_field field;
+		};
+
+		constexpr field_name field_names[] = {
+			{"message"_sv, pattern_field::message},
+			{"logger"_sv, pattern_field::logger},
+			{"severity"_sv, pattern_field::severity},
+			{"thread"_sv, pattern_field::thread},
+			{"thread_id"_sv, pattern_field::thread_id},
+			{"time"_sv, pattern_field::date_time},
+			{"ms"_sv, pattern_field::milliseconds},
+			{"us"_sv, pattern_field::microseconds},
+			{"genesis"_sv, pattern_field::genesis},
+			{"file"_sv, pattern_field::source_file},
+			{"line"_sv, pattern_field::source_line},
+		};
+
+		constexpr size_type date_time_length = 19ull;
+		constexpr size_type max_cached_thread_name = 64ull;
+		constexpr size_type thread_name_cache_size = 16ull;
+
+		struct date_time_cache
+		{
+			int64 second = -1;
+			char text[date_time_length];
+		};
+
+		struct thread_name_entry
+		{
+			id_type threadId = 0ull;
+			int64 second = -1;
+			size_type length = 0ull;
+			char name[max_cached_thread_name];
+		};
+
+		// Owned by the thread that formats, which for an async_logger is its writer thread.
+		thread_local date_time_cache cachedDateTime;
+		thread_local thread_name_entry cachedThreadNames[thread_name_cache_size];
+
+		template <size_type Digits>
+		void append_digits(uint64 value, fmt::memory_buffer& dest)
+		{
+			char* digits = extend(dest, Digits);
+			for (size_type i = Digits; i > 0ull; i--)
+			{
+				digits[i - 1ull] = static_cast<char>('0' + value % 10ull);
+				value /= 10ull;
+			}
+		}
+
+		void put_digits(char* dest, int64 value, const size_type digits)
+		{
+			for (size_type i = digits; i > 0ull; i--)
+			{
+				dest[i - 1ull] = static_cast<char>('0' + value % 10);
+				value /= 10;
+			}
+		}
+
+		void render_date_time(const int64 second, char* dest)
+		{
+			namespace chrono = std::chrono;
+
+			const chrono::sys_seconds point{chrono::seconds(second)};
+			const chrono::sys_days day = chrono::floor<chrono::days>(point);
+			const chrono::year_month_day date{day};
+			const chrono::hh_mm_ss<chrono::seconds> timeOfDay{point - day};
+
+			put_digits(dest, static_cast<int>(date.year()), 4ull);
+			dest[4] = '-';
+			put_digits(dest + 5, static_cast<unsigned>(date.month()), 2ull);
+			dest[7] = '-';
+			put_digits(dest + 8, static_cast<unsigned>(date.day()), 2ull);
+			dest[10] = ' ';
+			put_digits(dest + 11, timeOfDay.hours().count(), 2ull);
+			dest[13] = ':';
+			put_digits(dest + 14, timeOfDay.minutes().count(), 2ull);
+			dest[16] = ':';
+			put_digits(dest + 17, timeOfDay.seconds().count(), 2ull);
+		}
+
+		void append_thread_name(const thread_id threadId, const int64 second, fmt::memory_buffer& dest)
+		{
+			thread_name_entry& entry = cachedThreadNames[threadId.nativeId % thread_name_cache_size];
+
+			// Refreshed once a second, so renamed threads show up under their new name soon enough.
+			if (entry.threadId != threadId.nativeId || entry.second != second)
+			{
+				const string_view name = platform::get_thread_name(threadId);
+				entry.threadId = threadId.nativeId;
+				entry.second = second;
+				entry.length = name.size() < max_cached_thread_name ? name.size() : max_cached_thread_name;
+				std::memcpy(entry.name, name.data(), entry.length);
+			}
+
+			append_text(entry.name, entry.length, dest);
+		}
+
+		void pad(
+			fmt::memory_buffer& dest, const size_type start, const size_type width, const pattern_alignment alignment
+		)
+		{
+			const size_type length = dest.size() - start;
+			if (length >= width)
+			{
+				return;
+			}
+
+			const size_type padding = width - length;
+			const size_type before = alignment == pattern_alignment::right    ? padding
+									 : alignment == pattern_alignment::center ? padding / 2ull
+																			  : 0ull;
+
+			dest.resize(start + width);
+			char* field = dest.data() + start;
+			if (before != 0ull)
+			{
+				std::memmove(field + before, field, length);
+				std::memset(field, ' ', before);
+			}
+			std::memset(field + before + length, ' ', padding - before);
+		}
+	} // namespace
+
+	compiled_pattern_formatter::compiled_pattern_formatter(const string_view pattern)
+	{
+		set_pattern(pattern);
+	}
+
+	void compiled_pattern_formatter::set_pattern(const string_view pattern)
+	{
+		m_pattern = dynamic_string::from_view(pattern);
+		m_cacheKey = combine_hash(type_id<compiled_pattern_formatter>(), hash_string(pattern));
+		m_instructions.clear();
+
+		const char* const begin = m_pattern.data();
+		const size_type size = m_pattern.size();
+
+		size_type literalStart = 0ull;
+		for (size_type i = 0ull; i < size; i++)
+		{
+			const char character = begin[i];
+			if (character != '{' && character != '}')
+			{
+				continue;
+			}
+
+			// {{ and }} keep one brace as part of the literal.
+			if (i + 1ull < size && begin[i + 1ull] == character)
+			{
+				add_literal(literalStart, i + 1ull - literalStart);
+				literalStart = i + 2ull;
+				i++;
+				continue;
+			}
+
+			if (character == '}')
+			{
+				rsl_assert_msg_soft(false, "Unmatched } in log pattern.");
+				continue;
+			}
+
+			size_type close = i + 1ull;
+			while (close < size && begin[close] != '}')
+			{
+				close++;
+			}
+
+			if (close == size)
+			{
+				rsl_assert_msg_soft(false, "Unterminated field in log pattern.");
+				break;
+			}
+
+			add_literal(literalStart, i - literalStart);
+
+			const string_view field = string_view::from_buffer(begin + i + 1ull, close - i - 1ull);
+			size_type separator = 0ull;
+			while (separator < field.size() && field[separator] != ':')
+			{
+				separator++;
+			}
+
+			const string_view spec = separator < field.size()
+										 ? string_view::from_buffer(field.data() + separator + 1ull, field.size() - separator - 1ull)
+										 : string_view{};
+			add_field(string_view::from_buffer(field.data(), separator), spec);
+
+			i = close;
+			literalStart = close + 1ull;
+		}
+
+		add_literal(literalStart, size - literalStart);
+	}
+
+	void compiled_pattern_formatter::add_literal(const size_type offset, const size_type size)
+	{
+		if (size == 0ull)
+		{
+			return;
+		}
+
+		m_instructions.emplace_back(instruction{
+			.field = pattern_field::literal,
+			.alignment = pattern_alignment::left,
+			.width = 0u,
+			.offset = static_cast<uint32>(offset),
+			.size = static_cast<uint32>(size),
+		});
+	}
+
+	void compiled_pattern_formatter::add_field(const string_view name, const string_view spec)
+	{
+		pattern_field field = pattern_field::literal;
+		for (const field_name& candidate : field_names)
+		{
+			if (candidate.name.size() == name.size() && std::memcmp(candidate.name.data(), name.data(), name.size()) == 0)
+			{
+				field = candidate.field;
+				break;
+			}
+		}
+
+		if (field == pattern_field::literal)
+		{
+			rsl_assert_msg_soft(false, "Unknown field in log pattern.");
+			return;
+		}
+
+		pattern_alignment alignment = pattern_alignment::left;
+		size_type cursor = 0ull;
+		if (!spec.empty())
+		{
+			switch (spec[0])
+			{
+				case '<': alignment = pattern_alignment::left; cursor++; break;
+				case '>': alignment = pattern_alignment::right; cursor++; break;
+				case '^': alignment = pattern_alignment::center; cursor++; break;
+				default: break;
+			}
+		}
+
+		uint16 width = 0u;
+		for (; cursor < spec.size() && spec[cursor] >= '0' && spec[cursor] <= '9'; cursor++)
+		{
+			width = static_cast<uint16>(width * 10u + static_cast<uint16>(spec[cursor] - '0'));
+		}
+
+		m_instructions.emplace_back(instruction{
+			.field = field,
+			.alignment = alignment,
+			.width = width,
+			.offset = 0u,
+			.size = 0u,
+		});
+	}
+
+	void compiled_pattern_formatter::format(const message& msg, fmt::memory_buffer& dest)
+	{
+		const int64 nanoseconds = wall_clock_nanoseconds(msg.timestamp);
+		const int64 second = nanoseconds >= 0 ? nanoseconds / 1000000000ll : (nanoseconds + 1ll) / 1000000000ll - 1ll;
+		const uint64 subsecond = static_cast<uint64>(nanoseconds - second * 1000000000ll);
+
+		for (const instruction& op : m_instructions)
+		{
+			const size_type start = dest.size();
+
+			switch (op.field)
+			{
+				case pattern_field::literal:
+				{
+					append_text(m_pattern.data() + op.offset, op.size, dest);
+					break;
+				}
+				case pattern_field::message: append_view(msg.formattedMsg, dest); break;
+				case pattern_field::logger: append_view(msg.loggerName, dest); break;
+				case pattern_field::severity: append_view(severity_name(msg.severity), dest); break;
+				case pattern_field::thread: append_thread_name(msg.threadId, second, dest); break;
+				case pattern_field::thread_id:
+				{
+					const fmt::format_int text(msg.threadId.nativeId);
+					append_text(text.data(), text.size(), dest);
+					break;
+				}
+				case pattern_field::date_time:
+				{
+					if (cachedDateTime.second != second)
+					{
+						render_date_time(second, cachedDateTime.text);
+						cachedDateTime.second = second;
+					}
+					append_text(cachedDateTime.text, date_time_length, dest);
+					break;
+				}
+				case pattern_field::milliseconds: append_digits<3ull>(subsecond / 1000000ull, dest); break;
+				case pattern_field::microseconds: append_digits<6ull>(subsecond / 1000ull, dest); break;
+				case pattern_field::genesis:
+				{
+					const int64 elapsed =
+						std::chrono::duration_cast<std::chrono::milliseconds>(msg.timestamp.duration - time::genesis.duration)
+							.count();
+					const uint64 milliseconds = elapsed > 0 ? static_cast<uint64>(elapsed) : 0ull;
+					const fmt::format_int seconds(milliseconds / 1000ull);
+					append_text(seconds.data(), seconds.size(), dest);
+					dest.push_back('.');
+					append_digits<3ull>(milliseconds % 1000ull, dest);
+					break;
+				}
+				case pattern_field::source_file:
+				{
+					if (const cstring file = msg.sourceLocation.file_name())
+					{
+						append_text(file, std::strlen(file), dest);
+					}
+					break;
+				}
+				case pattern_field::source_line:
+				{
+					const fmt::format_int text(msg.sourceLocation.line());
+					append_text(text.data(), text.size(), dest);
+					break;
+				}
+			}
+
+			if (op.width != 0u)
+			{
+				pad(dest, start, op.width, op.alignment);
+			}
+		}
+	}
+} // namespace rsl::log
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "../containers/string.hpp"
+#include "../util/primitives.hpp"
+
+#include "formatter.hpp"
+
+/**
+ * @file compiled_formatter.hpp
+ */
+
+namespace rsl::log
+{
+	/**@brief What a compiled_pattern_formatter renders for a piece of its pattern, with the name it has in patterns.
+	 */
+	enum struct pattern_field : uint8
+	{
+		literal,      // Text from the pattern itself.
+		message,      // {message} The message text with its format arguments applied.
+		logger,       // {logger}
+		severity,     // {severity} trace, debug, info, warn, error or fatal.
+		thread,       // {thread} Name of the thread that logged the message.
+		thread_id,    // {thread_id}
+		date_time,    // {time} UTC wall clock time as YYYY-MM-DD HH:MM:SS.
+		milliseconds, // {ms} Milliseconds into the second, 3 digits.
+		microseconds, // {us} Microseconds into the second, 6 digits.
+		genesis,      // {genesis} Seconds since time::genesis, with 3 decimals.
+		source_file,  // {file}
+		source_line,  // {line}
+	};
+
+	enum struct pattern_alignment : uint8
+	{
+		left,
+		right,
+		center,
+	};
+
+	/**@class compiled_pattern_formatter
+	 * @brief Formatter for patterns with named fields, like "{time}.{ms} [{severity:^7}] [{thread}] {message}". The
+	 * pattern gets compiled into a flat list of instructions that format runs through in a single switch, without any
+	 * virtual calls.
+	 * A field can be padded to a width, aligned left with <, right with > or centered with ^. {{ and }} are literal
+	 * braces.
+	 * The wall clock text is rendered once per second and thread names once per second per thread, both cached in the
+	 * thread that formats.
+	 */
+	class compiled_pattern_formatter final : public formatter
+	{
+	public:
+		explicit compiled_pattern_formatter(string_view pattern);
+
+		void format(const message& msg, fmt::memory_buffer& dest) override;
+
+		[[nodiscard]] id_type cache_key() const noexcept override { return m_cacheKey; }
+
+		void set_pattern(string_view pattern);
+		[[nodiscard]] [[rythe_always_inline]] string_view pattern() const noexcept { return m_pattern.view(); }
+
+	private:
+		struct instruction
+		{
+			pattern_field field;
+			pattern_alignment alignment;
+			uint16 width;
+			// Part of the pattern for literals.
+			uint32 offset;
+			uint32 size;
+		};
+
+		void add_literal(size_type offset, size_type size);
+		void add_field(string_view name, string_view spec);
+
+		dynamic_string m_pattern;
+		id_type m_cacheKey = invalid_id;
+		dynamic_array<instruction> m_instructions;
+	};
+} // namespace rsl::log
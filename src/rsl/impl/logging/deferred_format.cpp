@@ -0,0 +1,133 @@
+#include "deferred_format.hpp"
+
+#include <cstring>
+
+#include "../util/assert.hpp"
+
+#if defined(SPDLOG_FMT_EXTERNAL)
+#include <fmt/args.h>
+#else
+#include <spdlog/fmt/bundled/args.h>
+#endif
+
+namespace rsl::log
+{
+	namespace
+	{
+		using format_arg = fmt::basic_format_arg<fmt::format_context>;
+
+		template <typename T>
+		void put(fmt::memory_buffer& dest, const T& value)
+		{
+			const char* bytes = reinterpret_cast<const char*>(&value);
+			dest.append(bytes, bytes + sizeof(T));
+		}
+
+		void put_string(fmt::memory_buffer& dest, const char* data, const size_type size)
+		{
+			put(dest, encoded_arg::string);
+			put(dest, static_cast<uint32>(size));
+			dest.append(data, data + size);
+		}
+
+		template <typename T>
+		[[nodiscard]] T take(const char*& cursor)
+		{
+			T value;
+			std::memcpy(&value, cursor, sizeof(T));
+			cursor += sizeof(T);
+			return value;
+		}
+
+		struct arg_encoder
+		{
+			fmt::memory_buffer& dest;
+			const format_arg& arg;
+
+			template <typename T>
+			void put_value(const encoded_arg tag, const T value)
+			{
+				put(dest, tag);
+				put(dest, value);
+			}
+
+			void operator()(const int value) { put_value(encoded_arg::int32, static_cast<int32>(value)); }
+			void operator()(const unsigned value) { put_value(encoded_arg::uint32, static_cast<uint32>(value)); }
+			void operator()(const long long value) { put_value(encoded_arg::int64, static_cast<int64>(value)); }
+			void operator()(const unsigned long long value) { put_value(encoded_arg::uint64, static_cast<uint64>(value)); }
+			void operator()(const bool value) { put_value(encoded_arg::boolean, value); }
+			void operator()(const char value) { put_value(encoded_arg::character, value); }
+			void operator()(const float value) { put_value(encoded_arg::float32, value); }
+			void operator()(const double value) { put_value(encoded_arg::float64, value); }
+			void operator()(const long double value) { put_value(encoded_arg::extended_float, value); }
+			void operator()(const void* value) { put_value(encoded_arg::pointer, value); }
+
+			void operator()(const char* value) { put_string(dest, value, std::strlen(value)); }
+			void operator()(const fmt::string_view value) { put_string(dest, value.data(), value.size()); }
+
+			void operator()(fmt::monostate) {}
+
+			// Custom types and 128 bit integers don't have a binary form, they get formatted now.
+			template <typename T>
+			void operator()(const T&)
+			{
+				fmt::memory_buffer text;
+				fmt::vformat_to(fmt::appender(text), "{}", fmt::format_args(&arg, 1));
+				put_string(dest, text.data(), text.size());
+			}
+		};
+
+		// Only the thread that formats deferred messages touches these, they keep their storage between messages.
+		thread_local fmt::dynamic_format_arg_store<fmt::format_context> decodedArgs;
+	} // namespace
+
+	void encode_format_args(const fmt::format_args args, fmt::memory_buffer& dest)
+	{
+		for (int i = 0; i < args.max_size(); i++)
+		{
+			const format_arg arg = args.get(i);
+			if (!arg)
+			{
+				break;
+			}
+
+			fmt::visit_format_arg(arg_encoder{.dest = dest, .arg = arg}, arg);
+		}
+	}
+
+	void format_deferred(const string_view format, const string_view encodedArgs, fmt::memory_buffer& dest)
+	{
+		decodedArgs.clear();
+
+		const char* cursor = encodedArgs.data();
+		const char* const end = cursor + encodedArgs.size();
+		while (cursor < end)
+		{
+			switch (take<encoded_arg>(cursor))
+			{
+				case encoded_arg::int32: decodedArgs.push_back(take<int32>(cursor)); break;
+				case encoded_arg::uint32: decodedArgs.push_back(take<uint32>(cursor)); break;
+				case encoded_arg::int64: decodedArgs.push_back(static_cast<long long>(take<int64>(cursor))); break;
+				case encoded_arg::uint64:
+					decodedArgs.push_back(static_cast<unsigned long long>(take<uint64>(cursor)));
+					break;
+				case encoded_arg::boolean: decodedArgs.push_back(take<bool>(cursor)); break;
+				case encoded_arg::character: decodedArgs.push_back(take<char>(cursor)); break;
+				case encoded_arg::float32: decodedArgs.push_back(take<float32>(cursor)); break;
+				case encoded_arg::float64: decodedArgs.push_back(take<float64>(cursor)); break;
+				case encoded_arg::extended_float: decodedArgs.push_back(take<long double>(cursor)); break;
+				case encoded_arg::pointer: decodedArgs.push_back(take<const void*>(cursor)); break;
+				case encoded_arg::string:
+				{
+					const uint32 size = take<uint32>(cursor);
+					decodedArgs.push_back(fmt::string_view(cursor, size));
+					cursor += size;
+					break;
+				}
+				default: rsl_assert_invalid_parameters(false); return;
+			}
+		}
+
+		fmt::vformat_to(fmt::appender(dest), fmt::string_view(format.data(), format.size()), decodedArgs);
+	}
+} // namespace rsl::log
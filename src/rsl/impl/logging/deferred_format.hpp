@@ -0,0 +1,43 @@
+#pragma once
+
+#include "../containers/string.hpp"
+#include "../containers/views.hpp"
+#include "../util/primitives.hpp"
+
+#include "fmt_include.hpp"
+
+/**
+ * @file deferred_format.hpp
+ * @brief Binary encoding of format arguments, so log calls can copy their arguments and leave the formatting to
+ * whoever reads the message later.
+ */
+
+namespace rsl::log
+{
+	/**@brief Tag in front of every encoded argument.
+	 */
+	enum struct encoded_arg : uint8
+	{
+		int32,
+		uint32,
+		int64,
+		uint64,
+		boolean,
+		character,
+		float32,
+		float64,
+		extended_float,
+		string,  // uint32 length followed by the characters.
+		pointer, // Only the address, formatted the same way fmt formats pointers.
+	};
+
+	/**@brief Appends the arguments to dest in a compact binary form, format_deferred turns them into text later on.
+	 * Arithmetic values, pointers and strings are copied as they are. Anything else is formatted right away with its
+	 * default format and stored as a string, so format specs in the format string should only target built in types.
+	 */
+	void encode_format_args(fmt::format_args args, fmt::memory_buffer& dest);
+
+	/**@brief Appends the text fmt::vformat_to would have produced with the arguments encode_format_args encoded.
+	 */
+	void format_deferred(string_view format, string_view encodedArgs, fmt::memory_buffer& dest);
+} // namespace rsl::log
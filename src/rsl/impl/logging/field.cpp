@@ -0,0 +1,227 @@
+#include "field.hpp"
+
+#include <cmath>
+#include <cstring>
+
+namespace rsl::log
+{
+	namespace
+	{
+		using internal::append_text;
+		using internal::append_view;
+
+		constexpr size_type max_varint_size = 10ull;
+
+		void put_varint(fmt::memory_buffer& dest, uint64 value)
+		{
+			char bytes[max_varint_size];
+			size_type size = 0ull;
+			while (value >= 0x80ull)
+			{
+				bytes[size++] = static_cast<char>(static_cast<uint8>(value) | 0x80u);
+				value >>= 7u;
+			}
+			bytes[size++] = static_cast<char>(value);
+			append_text(bytes, size, dest);
+		}
+
+		void put_text(fmt::memory_buffer& dest, const string_view text)
+		{
+			put_varint(dest, text.size());
+			append_view(text, dest);
+		}
+
+		[[nodiscard]] bool take_varint(const char*& cursor, const char* const end, uint64& value) noexcept
+		{
+			value = 0ull;
+			for (uint32 shift = 0u; cursor != end && shift < 64u; shift += 7u)
+			{
+				const auto byte = static_cast<uint8>(*cursor++);
+				value |= static_cast<uint64>(byte & 0x7Fu) << shift;
+				if ((byte & 0x80u) == 0u)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		[[nodiscard]] bool take_text(const char*& cursor, const char* const end, string_view& text) noexcept
+		{
+			uint64 size = 0ull;
+			if (!take_varint(cursor, end, size) || size > static_cast<uint64>(end - cursor))
+			{
+				return false;
+			}
+
+			text = string_view::from_buffer(cursor, static_cast<size_type>(size));
+			cursor += size;
+			return true;
+		}
+
+		[[nodiscard]] constexpr uint64 zigzag_encode(const int64 value) noexcept
+		{
+			return (static_cast<uint64>(value) << 1u) ^ static_cast<uint64>(value >> 63);
+		}
+
+		[[nodiscard]] constexpr int64 zigzag_decode(const uint64 value) noexcept
+		{
+			return static_cast<int64>(value >> 1u) ^ -static_cast<int64>(value & 1ull);
+		}
+	} // namespace
+
+	void encode_fields(const array_view<const field> fields, fmt::memory_buffer& dest)
+	{
+		for (const field& entry : fields)
+		{
+			dest.push_back(static_cast<char>(entry.type));
+			put_text(dest, entry.key);
+
+			switch (entry.type)
+			{
+				case field_type::boolean: dest.push_back(entry.boolean ? '\1' : '\0'); break;
+				case field_type::signed_integer: put_varint(dest, zigzag_encode(entry.signedInteger)); break;
+				case field_type::unsigned_integer: put_varint(dest, entry.unsignedInteger); break;
+				case field_type::floating_point:
+				{
+					append_text(reinterpret_cast<const char*>(&entry.floatingPoint), sizeof(float64), dest);
+					break;
+				}
+				case field_type::string: put_text(dest, entry.text); break;
+			}
+		}
+	}
+
+	bool field_reader::next(field& result) noexcept
+	{
+		if (m_cursor == m_end)
+		{
+			return false;
+		}
+
+		const auto type = static_cast<field_type>(*m_cursor++);
+		if (!take_text(m_cursor, m_end, result.key))
+		{
+			m_cursor = m_end;
+			return false;
+		}
+
+		result.type = type;
+		bool valid = true;
+		switch (type)
+		{
+			case field_type::boolean:
+			{
+				valid = m_cursor != m_end;
+				if (valid)
+				{
+					result.boolean = *m_cursor++ != '\0';
+				}
+				break;
+			}
+			case field_type::signed_integer:
+			{
+				uint64 value = 0ull;
+				valid = take_varint(m_cursor, m_end, value);
+				result.signedInteger = zigzag_decode(value);
+				break;
+			}
+			case field_type::unsigned_integer: valid = take_varint(m_cursor, m_end, result.unsignedInteger); break;
+			case field_type::floating_point:
+			{
+				valid = static_cast<size_type>(m_end - m_cursor) >= sizeof(float64);
+				if (valid)
+				{
+					std::memcpy(&result.floatingPoint, m_cursor, sizeof(float64));
+					m_cursor += sizeof(float64);
+				}
+				break;
+			}
+			case field_type::string: valid = take_text(m_cursor, m_end, result.text); break;
+			default: valid = false; break;
+		}
+
+		if (!valid)
+		{
+			m_cursor = m_end;
+		}
+		return valid;
+	}
+
+	void append_json_string(const string_view text, fmt::memory_buffer& dest)
+	{
+		constexpr char hex_digits[] = "0123456789abcdef";
+
+		dest.push_back('"');
+
+		// Runs of characters that don't need escaping get appended in one go.
+		const char* runStart = text.data();
+		const char* const end = text.data() + text.size();
+		for (const char* cursor = runStart; cursor != end; ++cursor)
+		{
+			const auto character = static_cast<uint8>(*cursor);
+			if (character >= 0x20u && character != '"' && character != '\\')
+			{
+				continue;
+			}
+
+			append_text(runStart, static_cast<size_type>(cursor - runStart), dest);
+			runStart = cursor + 1;
+
+			switch (character)
+			{
+				case '"': append_view("\\\""_sv, dest); break;
+				case '\\': append_view("\\\\"_sv, dest); break;
+				case '\n': append_view("\\n"_sv, dest); break;
+				case '\r': append_view("\\r"_sv, dest); break;
+				case '\t': append_view("\\t"_sv, dest); break;
+				default:
+				{
+					const char escaped[] = {'\\', 'u', '0', '0', hex_digits[character >> 4u], hex_digits[character & 0xFu]};
+					append_text(escaped, sizeof(escaped), dest);
+					break;
+				}
+			}
+		}
+
+		append_text(runStart, static_cast<size_type>(end - runStart), dest);
+		dest.push_back('"');
+	}
+
+	void append_json_value(const field& value, fmt::memory_buffer& dest)
+	{
+		switch (value.type)
+		{
+			case field_type::boolean:
+			{
+				append_view(value.boolean ? "true"_sv : "false"_sv, dest);
+				break;
+			}
+			case field_type::signed_integer:
+			{
+				const fmt::format_int text(value.signedInteger);
+				append_text(text.data(), text.size(), dest);
+				break;
+			}
+			case field_type::unsigned_integer:
+			{
+				const fmt::format_int text(value.unsignedInteger);
+				append_text(text.data(), text.size(), dest);
+				break;
+			}
+			case field_type::floating_point:
+			{
+				if (std::isfinite(value.floatingPoint))
+				{
+					fmt::format_to(fmt::appender(dest), "{}", value.floatingPoint);
+				}
+				else
+				{
+					append_view("null"_sv, dest);
+				}
+				break;
+			}
+			case field_type::string: append_json_string(value.text, dest); break;
+		}
+	}
+} // namespace rsl::log
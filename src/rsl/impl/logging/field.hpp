@@ -0,0 +1,99 @@
+#pragma once
+
+#include "../containers/string.hpp"
+#include "../containers/views.hpp"
+#include "../util/concepts.hpp"
+#include "../util/primitives.hpp"
+
+#include "fmt_include.hpp"
+
+/**
+ * @file field.hpp
+ * @brief Typed key/value fields for structured log messages, and the compact binary form messages carry them in.
+ */
+
+namespace rsl::log
+{
+	enum struct field_type : uint8
+	{
+		boolean,
+		signed_integer,
+		unsigned_integer,
+		floating_point,
+		string,
+	};
+
+	/**@brief Key/value pair attached to a log message. Keys and strings are views, a field doesn't own anything.
+	 */
+	struct field
+	{
+		[[rythe_always_inline]] constexpr field(string_view fieldKey, bool fieldValue) noexcept;
+
+		template <integral_type T>
+			requires signed_type<T> && (!same_as<remove_cvr_t<T>, char>)
+		[[rythe_always_inline]] constexpr field(string_view fieldKey, T fieldValue) noexcept;
+
+		template <integral_type T>
+			requires unsigned_type<T> && (!same_as<remove_cvr_t<T>, char>) && (!same_as<remove_cvr_t<T>, bool>)
+		[[rythe_always_inline]] constexpr field(string_view fieldKey, T fieldValue) noexcept;
+
+		template <floating_point_type T>
+		[[rythe_always_inline]] constexpr field(string_view fieldKey, T fieldValue) noexcept;
+
+		[[rythe_always_inline]] constexpr field(string_view fieldKey, string_view fieldValue) noexcept;
+		[[rythe_always_inline]] field(string_view fieldKey, cstring fieldValue) noexcept;
+		[[rythe_always_inline]] field(string_view fieldKey, const dynamic_string& fieldValue) noexcept;
+
+		string_view key;
+		field_type type;
+
+		union
+		{
+			bool boolean;
+			int64 signedInteger;
+			uint64 unsignedInteger;
+			float64 floatingPoint;
+		};
+
+		// Only set for string fields.
+		string_view text;
+	};
+
+	/**@brief Appends the fields to dest in a compact binary form: per field a field_type byte, the key length as a
+	 * varint, the key, and then the value. Integers are varints, signed ones zigzag encoded, floating point values are
+	 * their 8 bytes as they are, strings are a varint length followed by the characters.
+	 */
+	void encode_fields(array_view<const field> fields, fmt::memory_buffer& dest);
+
+	/**@class field_reader
+	 * @brief Walks fields in the form encode_fields writes them, the views in the fields it reads point into the
+	 * encoded data.
+	 */
+	class field_reader
+	{
+	public:
+		constexpr field_reader() noexcept = default;
+		[[rythe_always_inline]] constexpr explicit field_reader(string_view encoded) noexcept;
+
+		/**@brief Reads the next field into result, returns false once there are no fields left or the data is
+		 * malformed.
+		 */
+		[[nodiscard]] bool next(field& result) noexcept;
+
+		[[nodiscard]] [[rythe_always_inline]] constexpr bool empty() const noexcept { return m_cursor == m_end; }
+
+	private:
+		const char* m_cursor = nullptr;
+		const char* m_end = nullptr;
+	};
+
+	/**@brief Appends text as a quoted JSON string.
+	 */
+	void append_json_string(string_view text, fmt::memory_buffer& dest);
+
+	/**@brief Appends the value of the field as JSON. Non finite floating point values become null.
+	 */
+	void append_json_value(const field& value, fmt::memory_buffer& dest);
+} // namespace rsl::log
+
+#include "field.inl"
@@ -0,0 +1,62 @@
+#pragma once
+#include "field.hpp"
+
+namespace rsl::log
+{
+	constexpr field::field(const string_view fieldKey, const bool fieldValue) noexcept
+		: key(fieldKey),
+		  type(field_type::boolean),
+		  boolean(fieldValue)
+	{
+	}
+
+	template <integral_type T>
+		requires signed_type<T> && (!same_as<remove_cvr_t<T>, char>)
+	constexpr field::field(const string_view fieldKey, const T fieldValue) noexcept
+		: key(fieldKey),
+		  type(field_type::signed_integer),
+		  signedInteger(static_cast<int64>(fieldValue))
+	{
+	}
+
+	template <integral_type T>
+		requires unsigned_type<T> && (!same_as<remove_cvr_t<T>, char>) && (!same_as<remove_cvr_t<T>, bool>)
+	constexpr field::field(const string_view fieldKey, const T fieldValue) noexcept
+		: key(fieldKey),
+		  type(field_type::unsigned_integer),
+		  unsignedInteger(static_cast<uint64>(fieldValue))
+	{
+	}
+
+	template <floating_point_type T>
+	constexpr field::field(const string_view fieldKey, const T fieldValue) noexcept
+		: key(fieldKey),
+		  type(field_type::floating_point),
+		  floatingPoint(static_cast<float64>(fieldValue))
+	{
+	}
+
+	constexpr field::field(const string_view fieldKey, const string_view fieldValue) noexcept
+		: key(fieldKey),
+		  type(field_type::string),
+		  unsignedInteger(0ull),
+		  text(fieldValue)
+	{
+	}
+
+	inline field::field(const string_view fieldKey, const cstring fieldValue) noexcept
+		: field(fieldKey, string_view::from_string_length(fieldValue))
+	{
+	}
+
+	inline field::field(const string_view fieldKey, const dynamic_string& fieldValue) noexcept
+		: field(fieldKey, fieldValue.view())
+	{
+	}
+
+	constexpr field_reader::field_reader(const string_view encoded) noexcept
+		: m_cursor(encoded.data()),
+		  m_end(encoded.data() + encoded.size())
+	{
+	}
+} // namespace rsl::log
@@ -0,0 +1,298 @@
+#include "file_sink.hpp"
+
+#include <cstring>
+#include <mutex>
+
+#include "../util/assert.hpp"
+
+#include "message.hpp"
+
+namespace rsl::log
+{
+	file_sink::file_sink(const string_view path, const file_sink_settings& settings, pmu_allocator& allocator)
+		: m_settings(settings),
+		  m_allocator(&allocator)
+	{
+		rsl_assert_invalid_parameters(!path.empty());
+		rsl_assert_invalid_parameters(settings.bufferSize != 0ull);
+
+		m_path.append(path.data(), path.data() + path.size());
+		m_buffer = static_cast<char*>(m_allocator->allocate(m_settings.bufferSize));
+		rsl_assert_invalid_object(m_buffer);
+
+		fmt::memory_buffer currentPath;
+		path_of(0ull, currentPath);
+		m_file = platform::open_file(currentPath.data());
+		rsl_assert_msg_soft(m_file, "Could not open log file.");
+
+		m_fileSize = m_file ? platform::get_file_size(m_file) : 0ull;
+		m_syncTarget = m_file;
+		m_openedAt = std::chrono::steady_clock::now();
+
+		m_thread = platform::create_thread(&rotation_main, this, "rsl file sink"_sv, allocator);
+	}
+
+	file_sink::~file_sink()
+	{
+		{
+			std::lock_guard guard(m_lock);
+			const string_view parts[] = {buffered()};
+			write_out(array_view<const string_view>::from_buffer(parts, 1ull));
+		}
+
+		m_running.store(false, memory_order::release);
+		wake_rotation_thread();
+		m_thread.join();
+
+		// A time based rotation can still have come in after the last write.
+		if (m_rotatedFile)
+		{
+			platform::close_file(m_rotatedFile);
+		}
+
+		if (m_file)
+		{
+			if (m_settings.syncPolicy != fsync_policy::never)
+			{
+				platform::sync_file(m_file);
+			}
+			platform::close_file(m_file);
+		}
+
+		m_allocator->deallocate(m_buffer, m_settings.bufferSize);
+	}
+
+	void file_sink::log(const message& msg)
+	{
+		const string_view text = format(msg);
+
+		std::lock_guard guard(m_lock);
+
+		const size_type size = text.size() + 1ull;
+		if (m_bufferUsed + size <= m_settings.bufferSize)
+		{
+			std::memcpy(m_buffer + m_bufferUsed, text.data(), text.size());
+			m_buffer[m_bufferUsed + text.size()] = '\n';
+			m_bufferUsed += size;
+			return;
+		}
+
+		// The buffered output and the message go out in one write, so the message doesn't need to be copied first.
+		const string_view parts[] = {buffered(), text, "\n"_sv};
+		write_out(array_view<const string_view>::from_buffer(parts, 3ull));
+	}
+
+	void file_sink::flush()
+	{
+		std::lock_guard guard(m_lock);
+
+		const string_view parts[] = {buffered()};
+		write_out(array_view<const string_view>::from_buffer(parts, 1ull));
+
+		if (m_settings.syncPolicy == fsync_policy::on_flush && m_file)
+		{
+			platform::sync_file(m_file);
+		}
+	}
+
+	void file_sink::write_out(const array_view<const string_view> parts)
+	{
+		adopt_rotated_file();
+
+		size_type size = 0ull;
+		for (const string_view part : parts)
+		{
+			size += part.size();
+		}
+
+		m_bufferUsed = 0ull;
+		if (size == 0ull || !m_file)
+		{
+			return;
+		}
+
+		// Only what reached the file counts towards its size, the rest of a failed write is dropped.
+		const size_type written = platform::write_file(m_file, parts);
+		m_fileSize += written;
+		if (written == size)
+		{
+			m_writes.fetch_add(1ull, memory_order::relaxed);
+		}
+		else
+		{
+			m_failedWrites.fetch_add(1ull, memory_order::relaxed);
+			rsl_assert_msg_soft(false, "Could not write to log file, the output that didn't fit got dropped.");
+		}
+
+		if (m_settings.maxFileSize != 0ull && m_fileSize >= m_settings.maxFileSize &&
+			!m_rotationRequested.load(memory_order::relaxed))
+		{
+			m_rotationRequested.store(true, memory_order::release);
+			wake_rotation_thread();
+		}
+	}
+
+	void file_sink::adopt_rotated_file()
+	{
+		if (!m_rotationReady.load(memory_order::acquire))
+		{
+			return;
+		}
+
+		{
+			std::lock_guard guard(m_handoffLock);
+
+			// The rotation thread closes the previous retired file before it rotates again.
+			rsl_assert_invalid_object(!m_retiredFile);
+			m_retiredFile = m_file;
+			m_file = m_rotatedFile;
+			m_fileSize = m_rotatedFileSize;
+			m_rotatedFile = file_handle{};
+			m_rotationReady.store(false, memory_order::relaxed);
+		}
+
+		m_rotationRequested.store(false, memory_order::relaxed);
+		m_rotations.fetch_add(1ull, memory_order::relaxed);
+		wake_rotation_thread();
+	}
+
+	void file_sink::wake_rotation_thread() noexcept
+	{
+		m_wakeSignal.fetch_add(1u, std::memory_order_release);
+		platform::wake_one_on_address(m_wakeSignal);
+	}
+
+	uint32 file_sink::rotation_main(void* userData)
+	{
+		static_cast<file_sink*>(userData)->run();
+		return 0u;
+	}
+
+	void file_sink::run()
+	{
+		using clock = std::chrono::steady_clock;
+
+		const bool rotatesOnTime = m_settings.rotationInterval > std::chrono::seconds::zero();
+		const bool syncsOnInterval = m_settings.syncPolicy == fsync_policy::interval;
+		clock::time_point nextSync = clock::now() + m_settings.syncInterval;
+
+		while (true)
+		{
+			const uint32 wakeSignal = m_wakeSignal.load(std::memory_order_acquire);
+			const bool running = m_running.load(memory_order::acquire);
+
+			file_handle retired;
+			{
+				std::lock_guard guard(m_handoffLock);
+				retired = m_retiredFile;
+				m_retiredFile = file_handle{};
+			}
+
+			if (retired)
+			{
+				if (m_settings.syncPolicy != fsync_policy::never)
+				{
+					platform::sync_file(retired);
+				}
+				platform::close_file(retired);
+			}
+
+			if (!running)
+			{
+				return;
+			}
+
+			const bool rotationPending = m_rotationReady.load(memory_order::acquire);
+			clock::time_point now = clock::now();
+			if (!rotationPending &&
+				(m_rotationRequested.load(memory_order::acquire) ||
+				 (rotatesOnTime && now - m_openedAt >= m_settings.rotationInterval)))
+			{
+				rotate();
+				now = clock::now();
+			}
+
+			if (syncsOnInterval && now >= nextSync)
+			{
+				if (m_syncTarget)
+				{
+					platform::sync_file(m_syncTarget);
+				}
+				nextSync = now + m_settings.syncInterval;
+			}
+
+			// Nothing to time while a rotated file waits to be picked up, picking it up wakes this thread again.
+			clock::time_point deadline = clock::time_point::max();
+			if (rotatesOnTime && !m_rotationReady.load(memory_order::acquire))
+			{
+				deadline = m_openedAt + m_settings.rotationInterval;
+			}
+			if (syncsOnInterval && nextSync < deadline)
+			{
+				deadline = nextSync;
+			}
+
+			if (deadline == clock::time_point::max())
+			{
+				platform::wait_on_address(m_wakeSignal, wakeSignal);
+			}
+			else
+			{
+				platform::wait_on_address(
+					m_wakeSignal, wakeSignal, std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - clock::now())
+				);
+			}
+		}
+	}
+
+	void file_sink::rotate()
+	{
+		fmt::memory_buffer from;
+		fmt::memory_buffer to;
+
+		if (m_settings.maxFiles != 0ull)
+		{
+			path_of(m_settings.maxFiles, from);
+			platform::remove_file(from.data());
+
+			for (size_type index = m_settings.maxFiles; index > 0ull; index--)
+			{
+				path_of(index - 1ull, from);
+				path_of(index, to);
+				platform::rename_file(from.data(), to.data());
+			}
+		}
+
+		// Without rotated files to keep the current file just starts over.
+		path_of(0ull, to);
+		const file_handle file = platform::open_file(to.data(), m_settings.maxFiles == 0ull);
+
+		m_openedAt = std::chrono::steady_clock::now();
+		if (!file)
+		{
+			// Keeps writing to the old file, a size based rotation gets requested again on the next write.
+			m_rotationRequested.store(false, memory_order::relaxed);
+			return;
+		}
+
+		{
+			std::lock_guard guard(m_handoffLock);
+			m_rotatedFile = file;
+			m_rotatedFileSize = platform::get_file_size(file);
+			m_rotationReady.store(true, memory_order::release);
+		}
+
+		m_syncTarget = file;
+	}
+
+	void file_sink::path_of(const size_type index, fmt::memory_buffer& dest) const
+	{
+		dest.clear();
+		dest.append(m_path.data(), m_path.data() + m_path.size());
+		if (index != 0ull)
+		{
+			fmt::format_to(fmt::appender(dest), ".{}", index);
+		}
+		dest.push_back('\0');
+	}
+} // namespace rsl::log
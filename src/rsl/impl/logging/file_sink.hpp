@@ -0,0 +1,137 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+#include "../containers/string.hpp"
+#include "../memory/allocator_context.hpp"
+#include "../platform/platform.hpp"
+#include "../threading/mutex.hpp"
+#include "../threading/thread.hpp"
+#include "../util/atomic.hpp"
+#include "../util/primitives.hpp"
+
+#include "fmt_include.hpp"
+#include "sink.hpp"
+
+/**
+ * @file file_sink.hpp
+ */
+
+namespace rsl::log
+{
+	/**@brief When a file_sink makes sure written data reached the storage device.
+	 */
+	enum struct fsync_policy : uint8
+	{
+		never,    // Left to the OS.
+		on_flush, // On every flush, which loggers do for messages at their flush severity.
+		interval, // The rotation thread syncs once every sync interval.
+	};
+
+	struct file_sink_settings
+	{
+		// Output collects in a buffer of this size and goes to the file in a single write once it's full or flushed.
+		size_type bufferSize = 1024ull * 1024ull;
+		// Rotates once the file grows past this size, 0 disables size based rotation.
+		uint64 maxFileSize = 0ull;
+		// Rotates once the file has been open this long, 0 disables time based rotation.
+		std::chrono::seconds rotationInterval = std::chrono::seconds::zero();
+		// Amount of rotated files kept around, path.1 is the most recent one.
+		size_type maxFiles = 5ull;
+		fsync_policy syncPolicy = fsync_policy::never;
+		std::chrono::milliseconds syncInterval = std::chrono::milliseconds(1000);
+	};
+
+	/**@class file_sink
+	 * @brief Sink that appends every message on its own line to a file. Output is buffered in userspace and written with
+	 * one gathered write per full buffer or flush, messages that don't fit in the buffer anymore go out in the same write
+	 * without being copied.
+	 * Rotating renames path to path.1, path.1 to path.2 and so on, then opens a new file at path. All of that, closing
+	 * the old file and interval syncs happen on a separate thread, the logging thread only swaps the handle.
+	 * @note Thread safe, the file can grow past maxFileSize by whatever gets written before the new file is ready.
+	 */
+	class file_sink final : public sink
+	{
+	public:
+		/**@brief Opens or creates the file at path and starts the rotation thread.
+		 * @param allocator Allocator used for the buffer and the rotation thread.
+		 */
+		explicit file_sink(
+			string_view path, const file_sink_settings& settings = {},
+			pmu_allocator& allocator = *allocator_context::globalAllocator
+		);
+
+		file_sink(const file_sink&) = delete;
+		file_sink(file_sink&&) = delete;
+		file_sink& operator=(const file_sink&) = delete;
+		file_sink& operator=(file_sink&&) = delete;
+
+		/**@brief Writes out the buffer, stops the rotation thread and closes the file.
+		 */
+		~file_sink() override;
+
+		void log(const message& msg) override;
+
+		/**@brief Writes out the buffer, and syncs the file with fsync_policy::on_flush.
+		 */
+		void flush() override;
+
+		[[nodiscard]] [[rythe_always_inline]] bool is_open() const noexcept { return m_file; }
+		[[nodiscard]] [[rythe_always_inline]] const file_sink_settings& settings() const noexcept { return m_settings; }
+
+		/**@brief Amount of write calls that got everything out so far, each one can cover many messages.
+		 */
+		[[nodiscard]] [[rythe_always_inline]] uint64 write_count() const noexcept;
+		/**@brief Amount of write calls that failed so far, like on a full disk. Whatever they didn't get out is lost.
+		 */
+		[[nodiscard]] [[rythe_always_inline]] uint64 failed_write_count() const noexcept;
+		/**@brief Amount of rotations the logging side picked up so far.
+		 */
+		[[nodiscard]] [[rythe_always_inline]] uint64 rotation_count() const noexcept;
+
+	private:
+		[[nodiscard]] [[rythe_always_inline]] string_view buffered() const noexcept;
+		void write_out(array_view<const string_view> parts);
+		void adopt_rotated_file();
+		void wake_rotation_thread() noexcept;
+
+		void run();
+		void rotate();
+		void path_of(size_type index, fmt::memory_buffer& dest) const;
+
+		static uint32 rotation_main(void* userData);
+
+		file_sink_settings m_settings;
+		pmu_allocator* m_allocator;
+		fmt::memory_buffer m_path;
+
+		// Logging side, guarded by m_lock.
+		mutex m_lock;
+		char* m_buffer = nullptr;
+		size_type m_bufferUsed = 0ull;
+		file_handle m_file;
+		uint64 m_fileSize = 0ull;
+
+		// Handed over by the rotation thread, m_rotationReady tells the logging side to pick it up.
+		mutex m_handoffLock;
+		file_handle m_rotatedFile;
+		uint64 m_rotatedFileSize = 0ull;
+		file_handle m_retiredFile;
+		atomic<bool> m_rotationReady;
+		atomic<bool> m_rotationRequested;
+
+		// Owned by the rotation thread, the newest file it opened.
+		file_handle m_syncTarget;
+		std::chrono::steady_clock::time_point m_openedAt;
+
+		atomic<uint64> m_writes;
+		atomic<uint64> m_failedWrites;
+		atomic<uint64> m_rotations;
+		atomic<bool> m_running{true};
+		std::atomic<uint32> m_wakeSignal{0u};
+		thread m_thread;
+	};
+} // namespace rsl::log
+
+#include "file_sink.inl"
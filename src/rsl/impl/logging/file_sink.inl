@@ -0,0 +1,25 @@
+#pragma once
+#include "file_sink.hpp"
+
+namespace rsl::log
+{
+	inline uint64 file_sink::write_count() const noexcept
+	{
+		return m_writes.load(memory_order::relaxed);
+	}
+
+	inline uint64 file_sink::failed_write_count() const noexcept
+	{
+		return m_failedWrites.load(memory_order::relaxed);
+	}
+
+	inline uint64 file_sink::rotation_count() const noexcept
+	{
+		return m_rotations.load(memory_order::relaxed);
+	}
+
+	inline string_view file_sink::buffered() const noexcept
+	{
+		return string_view::from_buffer(m_buffer, m_bufferUsed);
+	}
+} // namespace rsl::log
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstring>
+
 #define FMT_HEADER_ONLY
 #include <spdlog/fmt/fmt.h>
 
@@ -13,3 +15,26 @@ namespace rsl
 		return result;
 	}
 }
+
+namespace rsl::log::internal
+{
+	/**@brief Grows dest and returns where the new characters go, cheaper than fmt's append for the short pieces log
+	 * output is made of.
+	 */
+	[[nodiscard]] [[rythe_always_inline]] inline char* extend(fmt::memory_buffer& dest, const size_type size)
+	{
+		const size_type offset = dest.size();
+		dest.resize(offset + size);
+		return dest.data() + offset;
+	}
+
+	[[rythe_always_inline]] inline void append_text(const char* text, const size_type size, fmt::memory_buffer& dest)
+	{
+		std::memcpy(extend(dest, size), text, size);
+	}
+
+	[[rythe_always_inline]] inline void append_view(const string_view text, fmt::memory_buffer& dest)
+	{
+		append_text(text.data(), text.size(), dest);
+	}
+}
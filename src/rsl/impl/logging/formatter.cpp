@@ -1,5 +1,8 @@
 #include "formatter.hpp"
 
+#include <chrono>
+#include <type_traits>
+
 #include "../platform/platform.hpp"
 #include "../time/stopwatch.hpp"
 
@@ -27,13 +30,66 @@ namespace rsl::log
         };
     }
 
-    void pattern_formatter::format(const message& msg, fmt::memory_buffer& dest)
+    int64 wall_clock_nanoseconds(const time::point32 timestamp) noexcept
     {
-        const time::point32 time = time::main_clock.current_point();
+        using clock = time::point32::clock_type;
+        const std::chrono::nanoseconds sinceClockEpoch =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.duration);
+
+        if constexpr (std::is_same_v<clock, std::chrono::system_clock>)
+        {
+            return sinceClockEpoch.count();
+        }
+        else
+        {
+            // Measured once, so the wall clock of the messages doesn't jump around with adjustments of the system clock.
+            static const std::chrono::nanoseconds offset =
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::system_clock::now().time_since_epoch()
+                    ) -
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now().time_since_epoch());
+            return (sinceClockEpoch + offset).count();
+        }
+    }
+
+    void format_cache::reset() noexcept
+    {
+        m_buffer.clear();
+        m_entryCount = 0ull;
+    }
+
+    string_view format_cache::format(formatter& target, const message& msg)
+    {
+        const id_type key = target.cache_key();
+        if (key != invalid_id)
+        {
+            for (size_type i = 0ull; i < m_entryCount; i++)
+            {
+                if (m_entries[i].key == key)
+                {
+                    return string_view::from_buffer(m_buffer.data() + m_entries[i].offset, m_entries[i].size);
+                }
+            }
+        }
+
+        const size_type offset = m_buffer.size();
+        target.format(msg, m_buffer);
+        const size_type size = m_buffer.size() - offset;
 
+        if (key != invalid_id && m_entryCount < max_entries)
+        {
+            m_entries[m_entryCount++] = entry{.key = key, .offset = offset, .size = size};
+        }
+
+        return string_view::from_buffer(m_buffer.data() + offset, size);
+    }
+
+    void pattern_formatter::format(const message& msg, fmt::memory_buffer& dest)
+    {
+        // The time the message was logged rather than now, so every sink renders the same text.
         for (auto& formatter : m_formatters)
         {
-            formatter->format(msg, time, dest);
+            formatter->format(msg, msg.timestamp, dest);
         }
     }
 
@@ -116,6 +172,15 @@ namespace rsl::log
         dest.append(msg.loggerName.data(), msg.loggerName.data() + msg.loggerName.size());
     }
 
+    void message_text_formatter::format(
+            const message& msg,
+            [[maybe_unused]] const time::point32 time,
+            fmt::memory_buffer& dest
+            )
+    {
+        dest.append(msg.formattedMsg.data(), msg.formattedMsg.data() + msg.formattedMsg.size());
+    }
+
     void thread_name_formatter_flag::format(
             const message& msg,
             [[maybe_unused]] const time::point32 time,
@@ -3,6 +3,7 @@
 #include "../containers/views.hpp"
 #include "../memory/unique_object.hpp"
 #include "../time/time_point.hpp"
+#include "../util/type_traits.hpp"
 
 #include "fmt_include.hpp"
 
@@ -16,8 +17,48 @@ namespace rsl::log
 		NO_DTOR_RULE5_CONSTEXPR_NOEXCEPT(formatter)
 		virtual ~formatter() = default;
 		virtual void format(const message& msg, fmt::memory_buffer& dest) = 0;
+
+		/**@brief Formatters with the same key produce the same output for the same message, so a format_cache only
+		 * runs one of them. invalid_id opts out of caching.
+		 */
+		[[nodiscard]] virtual id_type cache_key() const noexcept { return invalid_id; }
 	};
 
+	/**@class format_cache
+	 * @brief Output of every distinct formatter for the message that is currently being logged. Sinks that share a
+	 * pattern get the output of the first one instead of formatting it again.
+	 */
+	class format_cache
+	{
+	public:
+		constexpr static size_type max_entries = 8ull;
+
+		/**@brief Forgets the output of the previous message, keeps the storage.
+		 */
+		void reset() noexcept;
+
+		/**@brief Output of the formatter for the message, formatted on the first request per cache key.
+		 * @note The view is only valid until the next call, formatting may grow the buffer.
+		 */
+		[[nodiscard]] string_view format(formatter& target, const message& msg);
+
+	private:
+		struct entry
+		{
+			id_type key;
+			size_type offset;
+			size_type size;
+		};
+
+		fmt::memory_buffer m_buffer;
+		entry m_entries[max_entries];
+		size_type m_entryCount = 0ull;
+	};
+
+	/**@brief Nanoseconds since the unix epoch at timestamp, for formatters that show the wall clock.
+	 */
+	[[nodiscard]] int64 wall_clock_nanoseconds(time::point32 timestamp) noexcept;
+
 	class flag_formatter
 	{
 	public:
@@ -35,6 +76,11 @@ namespace rsl::log
 
 		void format(const message& msg, fmt::memory_buffer& dest) override;
 
+		/**@brief Hash of the pattern and the flag formatter types, flag formatters are expected to only depend on their
+		 * options in the pattern.
+		 */
+		[[nodiscard]] id_type cache_key() const noexcept override { return m_cacheKey; }
+
 		template <derived_from<flag_formatter>... FlagFormatterTypes>
 		void set_pattern(string_view pattern, FlagFormatterTypes&&... flagFormatters);
 
@@ -42,6 +88,7 @@ namespace rsl::log
 		void compile_pattern(array_view<temporary_object<flag_formatter>> flagFormatters);
 
 		dynamic_string m_pattern;
+		id_type m_cacheKey = invalid_id;
 		using flag_formatter_ptr = unique_object<flag_formatter>;
 		dynamic_array<flag_formatter_ptr> m_formatters;
 	};
@@ -58,6 +105,14 @@ namespace rsl::log
 		void format(const message& msg, const time::point32 time, fmt::memory_buffer& dest) override;
 	};
 
+	/**@brief The message text with its format arguments applied.
+	 */
+	class message_text_formatter final : public flag_formatter
+	{
+	public:
+		void format(const message& msg, const time::point32 time, fmt::memory_buffer& dest) override;
+	};
+
 	class thread_name_formatter_flag final : public flag_formatter
 	{
 	public:
@@ -11,10 +11,19 @@ namespace rsl::log
     template <derived_from<flag_formatter>... FlagFormatterTypes>
     void pattern_formatter::set_pattern(const string_view pattern, FlagFormatterTypes&&... flagFormatters)
     {
-        using temporary_formatter_array = array<temporary_object<flag_formatter>, sizeof...(flagFormatters)>;
         m_pattern = dynamic_string::from_view(pattern);
-        temporary_formatter_array temporaryFlags = temporary_formatter_array::from_variadic_items(rsl::forward<FlagFormatterTypes>(flagFormatters)...);
+        m_cacheKey = combine_hash(
+                type_id<pattern_formatter>(), hash_string(pattern), type_id<remove_cvr_t<FlagFormatterTypes>>()...
+                );
 
-        compile_pattern(temporaryFlags);
+        dynamic_array<temporary_object<flag_formatter>> temporaryFlags;
+        temporaryFlags.reserve(sizeof...(FlagFormatterTypes));
+        (temporaryFlags.emplace_back(
+                 unique_object<remove_cvr_t<FlagFormatterTypes>>::create_in_place(rsl::forward<FlagFormatterTypes>(flagFormatters))
+                 ), ...);
+
+        compile_pattern(
+                array_view<temporary_object<flag_formatter>>::from_buffer(temporaryFlags.data(), temporaryFlags.size())
+                );
     }
 }
@@ -0,0 +1,66 @@
+#include "json_formatter.hpp"
+
+#include "../util/hash.hpp"
+
+#include "field.hpp"
+#include "message.hpp"
+
+namespace rsl::log
+{
+	namespace
+	{
+		using internal::append_text;
+		using internal::append_view;
+
+		template <typename T>
+		void append_integer(const T value, fmt::memory_buffer& dest)
+		{
+			const fmt::format_int text(value);
+			append_text(text.data(), text.size(), dest);
+		}
+	} // namespace
+
+	void json_formatter::format(const message& msg, fmt::memory_buffer& dest)
+	{
+		append_view(R"({"time":)"_sv, dest);
+		append_integer(wall_clock_nanoseconds(msg.timestamp), dest);
+		append_view(R"(,"severity":")"_sv, dest);
+		append_view(severity_name(msg.severity), dest);
+		append_view(R"(","logger":)"_sv, dest);
+		append_json_string(msg.loggerName, dest);
+		append_view(R"(,"thread":)"_sv, dest);
+		append_integer(msg.threadId.nativeId, dest);
+		append_view(R"(,"message":)"_sv, dest);
+		append_json_string(msg.formattedMsg, dest);
+
+		if (!msg.fields.empty())
+		{
+			append_view(R"(,"fields":{)"_sv, dest);
+
+			field_reader reader(msg.fields);
+			field entry(string_view{}, false);
+			bool first = true;
+			while (reader.next(entry))
+			{
+				if (!first)
+				{
+					dest.push_back(',');
+				}
+				first = false;
+
+				append_json_string(entry.key, dest);
+				dest.push_back(':');
+				append_json_value(entry, dest);
+			}
+
+			dest.push_back('}');
+		}
+
+		dest.push_back('}');
+	}
+
+	id_type json_formatter::cache_key() const noexcept
+	{
+		return type_id<json_formatter>();
+	}
+} // namespace rsl::log
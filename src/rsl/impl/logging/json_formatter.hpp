@@ -0,0 +1,28 @@
+#pragma once
+
+#include "../util/primitives.hpp"
+
+#include "formatter.hpp"
+
+/**
+ * @file json_formatter.hpp
+ */
+
+namespace rsl::log
+{
+	/**@class json_formatter
+	 * @brief Formats every message as a single line JSON object, with the fields of structured messages kept as typed
+	 * values instead of text:
+	 * {"time":1614834367089123000,"severity":"error","logger":"game","thread":4711,"message":"asset failed to load",
+	 * "fields":{"asset":"rock.png","attempt":3}}
+	 * time is in nanoseconds since the unix epoch, fields is left out for messages without any. Set it on a file_sink to
+	 * get JSON lines.
+	 */
+	class json_formatter final : public formatter
+	{
+	public:
+		void format(const message& msg, fmt::memory_buffer& dest) override;
+
+		[[nodiscard]] id_type cache_key() const noexcept override;
+	};
+} // namespace rsl::log
@@ -10,11 +10,24 @@
 #include "threading/current_thread.hpp"
 
 #include "message.hpp"
+#include "rate_limit.hpp"
 
 namespace rsl::log
 {
+	namespace
+	{
+		thread_local fmt::memory_buffer textBuffer;
+		thread_local fmt::memory_buffer encodedFields;
+		thread_local format_cache decoratedOutput;
+	} // namespace
+
 	void basic_logger::log(const log::severity s, const format_string format, const fmt::format_args args) noexcept
 	{
+		if (!should_log(s))
+		{
+			return;
+		}
+
 		const log::message logMessage
 		{
 			.loggerName = m_name,
@@ -29,7 +42,60 @@ namespace rsl::log
 		log(logMessage);
 	}
 
+	void basic_logger::log_fields(
+		const log::severity s, const format_string text, const array_view<const field> fields
+	) noexcept
+	{
+		if (!should_log(s))
+		{
+			return;
+		}
+
+		encodedFields.clear();
+		encode_fields(fields, encodedFields);
+
+		const log::message logMessage
+		{
+			.loggerName = m_name,
+			.threadId = current_thread::get_id(),
+			.timestamp = time::main_clock.current_point(),
+			.sourceLocation = text.srcLoc,
+			.severity = s,
+			.msg = text.str,
+			.formatArgs = fmt::format_args{},
+			.fields = string_view::from_buffer(encodedFields.data(), encodedFields.size()),
+			.structured = true,
+		};
+
+		log(logMessage);
+	}
+
+	basic_logger::~basic_logger()
+	{
+		// Callsites outlive the logger, they get tracked again by the next logger they suppress messages for.
+		std::lock_guard guard(m_callsiteLock);
+		for (internal::callsite_counter* callsite : m_callsites)
+		{
+			callsite->m_tracked.store(false, memory_order::relaxed);
+		}
+	}
+
 	void basic_logger::flush()
+	{
+		report_suppressed();
+		flush_sinks();
+	}
+
+	void basic_logger::report_suppressed()
+	{
+		std::lock_guard guard(m_callsiteLock);
+		for (internal::callsite_counter* callsite : m_callsites)
+		{
+			callsite->report_pending(*this);
+		}
+	}
+
+	void basic_logger::flush_sinks()
 	{
 		for (auto* sink : m_sinks)
 		{
@@ -37,26 +103,42 @@ namespace rsl::log
 		}
 	}
 
-	void synchronous_logger::log(const log::message& message)
+	void basic_logger::track_callsite(internal::callsite_counter& callsite)
+	{
+		std::lock_guard guard(m_callsiteLock);
+		m_callsites.push_back(&callsite);
+	}
+
+	string_view basic_logger::format_text(const log::message& message)
 	{
-		const bool logEnabled = message.severity >= m_severity && message.severity != log::severity::off;
-		if (!logEnabled)
+		// The text of structured messages is never a format string.
+		if (message.structured)
 		{
-			return;
+			return message.msg;
 		}
 
-		fmt::memory_buffer buf;
-		fmt::vformat_to(fmt::appender(buf), fmt::string_view(message.msg.data(), message.msg.size()),
+		textBuffer.clear();
+		fmt::vformat_to(fmt::appender(textBuffer), fmt::string_view(message.msg.data(), message.msg.size()),
 						message.formatArgs);
+		return string_view::from_buffer(textBuffer.data(), textBuffer.size());
+	}
+
+	void synchronous_logger::log(const log::message& message)
+	{
+		// Formatted once here, every sink shares the text and the decorated output of each distinct pattern.
+		log::message formatted = message;
+		formatted.formattedMsg = format_text(message);
+		decoratedOutput.reset();
+		formatted.formatCache = &decoratedOutput;
 
 		for (auto* sink : m_sinks)
 		{
-			sink->log(message);
+			sink->log(formatted);
 		}
 
 		if (message.severity >= m_flushSeverity)
 		{
-			flush();
+			flush_sinks();
 		}
 	}
 } // namespace rsl::log
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <initializer_list>
+
 #include "../util/source_location.hpp"
 #include "../containers/string.hpp"
+#include "../threading/mutex.hpp"
 
+#include "field.hpp"
 #include "severity.hpp"
 
 namespace rsl::log
@@ -10,6 +14,11 @@ namespace rsl::log
 	class sink;
 	struct message;
 
+	namespace internal
+	{
+		class callsite_counter;
+	}
+
 	struct format_string
 	{
 		[[rythe_always_inline]] constexpr format_string(
@@ -27,14 +36,26 @@ namespace rsl::log
 		explicit basic_logger(string_view name, log::severity severity = log::severity::default_severity,
 		                      log::severity flushSeverity = log::severity::default_flush_severity);
 
-		virtual ~basic_logger() = default;
+		virtual ~basic_logger();
 
 		template <typename... Args>
 		[[rythe_always_inline]] constexpr void log(log::severity s, format_string format, Args&&... args) noexcept;
 
 		void log(log::severity s, format_string format, fmt::format_args args) noexcept;
 
-		void flush();
+		/**@brief Logs text with typed key/value fields attached, like
+		 * log_fields(severity::error, "asset failed to load"_sv, {{"asset"_sv, path}, {"attempt"_sv, 3}}).
+		 * The fields get encoded into a buffer of the calling thread, nothing is formatted or allocated for them.
+		 * Formatters that don't know about fields only show the text, json_formatter writes everything.
+		 */
+		void log_fields(log::severity s, format_string text, array_view<const field> fields) noexcept;
+		[[rythe_always_inline]] void
+		log_fields(log::severity s, format_string text, std::initializer_list<field> fields) noexcept;
+
+		/**@brief Reports messages that rate limited callsites suppressed since their last report, then flushes every
+		 * sink. Loggers that hand messages to another thread first wait for it to catch up.
+		 */
+		virtual void flush();
 
 		[[rythe_always_inline]] void set_sinks(array_view<sink*> sinks);
 		[[nodiscard]] [[rythe_always_inline]] array_view<sink* const> view_sinks() const noexcept;
@@ -44,19 +65,48 @@ namespace rsl::log
 
 		[[rythe_always_inline]] void flush_at(severity s) noexcept;
 		[[nodiscard]] [[rythe_always_inline]] severity flush_severity() const noexcept;
+
+		/**@brief Whether a message of severity s passes the filter. log checks this before it builds a message, reads
+		 * the clock or touches any argument, so filtered calls only cost a compare.
+		 */
+		[[nodiscard]] [[rythe_always_inline]] bool should_log(severity s) const noexcept;
 	protected:
+		/**@brief Handles a message that passed should_log.
+		 */
 		virtual void log(const log::message& message) = 0;
 
+		/**@brief Applies the format arguments to the message text, into a buffer of the calling thread that gets reused
+		 * for every message. The text of structured messages is returned as it is.
+		 * @note The view is only valid until the thread formats its next message.
+		 */
+		[[nodiscard]] static string_view format_text(const log::message& message);
+
+		/**@brief Logs the summary lines of every tracked callsite with suppressed messages that aren't reported yet.
+		 */
+		void report_suppressed();
+
+		void flush_sinks();
+
 		dynamic_string m_name;
 		log::severity m_severity;
 		log::severity m_flushSeverity;
 		dynamic_array<sink*> m_sinks;
+
+	private:
+		friend class internal::callsite_counter;
+
+		void track_callsite(internal::callsite_counter& callsite);
+
+		// Rate limited callsites that suppressed messages for this logger.
+		mutex m_callsiteLock;
+		dynamic_array<internal::callsite_counter*> m_callsites;
 	};
 
 	class synchronous_logger final : public basic_logger
 	{
 	public:
 		using basic_logger::basic_logger;
+		using basic_logger::log;
 
 	protected:
 		void log(const log::message& message) override;
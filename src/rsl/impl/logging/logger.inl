@@ -16,7 +16,24 @@ namespace rsl::log
 	template <typename... Args>
 	constexpr void basic_logger::log(const log::severity s, const format_string format, Args&&... args) noexcept
 	{
-		log(s, format, fmt::make_format_args(rsl::forward<Args>(args)...));
+		if (!should_log(s))
+		{
+			return;
+		}
+
+		// Converted explicitly, a format_arg_store would pick this overload again instead of the format_args one.
+		log(s, format, fmt::format_args(fmt::make_format_args(args...)));
+	}
+
+	inline void
+	basic_logger::log_fields(const log::severity s, const format_string text, std::initializer_list<field> fields) noexcept
+	{
+		if (!should_log(s))
+		{
+			return;
+		}
+
+		log_fields(s, text, array_view<const field>::from_buffer(fields.begin(), fields.size()));
 	}
 
 	inline void basic_logger::filter(const severity s) noexcept
@@ -38,4 +55,9 @@ namespace rsl::log
 	{
 		return m_flushSeverity;
 	}
+
+	inline bool basic_logger::should_log(const severity s) const noexcept
+	{
+		return s >= m_severity && s != severity::off;
+	}
 } // namespace rsl::log
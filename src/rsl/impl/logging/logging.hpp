@@ -6,8 +6,17 @@
 #include "../util/primitives.hpp"
 #include "../containers/map/dynamic_map.hpp"
 
+#include "message.hpp"
 #include "sink.hpp"
 #include "logger.hpp"
+#include "async_logger.hpp"
+#include "deferred_format.hpp"
+#include "field.hpp"
+#include "compiled_formatter.hpp"
+#include "json_formatter.hpp"
+#include "file_sink.hpp"
+#include "mmap_ring_sink.hpp"
+#include "rate_limit.hpp"
 
 namespace rsl
 {
@@ -84,89 +93,125 @@ namespace rsl
 		template <class... Args, class FormatString>
 		[[rythe_always_inline]] void undecoratedTrace(const FormatString& format, Args&&... a)
 		{
-			undecoratedln(severity::trace, format, std::forward<Args>(a)...);
+			if constexpr (severity::trace >= compiled_severity)
+			{
+				undecoratedln(severity::trace, format, std::forward<Args>(a)...);
+			}
 		}
 
 		/** @brief same as println but with severity = debug */
 		template <class... Args, class FormatString>
 		[[rythe_always_inline]] void undecoratedDebug(const FormatString& format, Args&&... a)
 		{
-			undecoratedln(severity::debug, format, std::forward<Args>(a)...);
+			if constexpr (severity::debug >= compiled_severity)
+			{
+				undecoratedln(severity::debug, format, std::forward<Args>(a)...);
+			}
 		}
 
 		/** @brief same as undecoratedln but with severity = info */
 		template <class... Args, class FormatString>
 		[[rythe_always_inline]] void undecoratedInfo(const FormatString& format, Args&&... a)
 		{
-			undecoratedln(severity::info, format, std::forward<Args>(a)...);
+			if constexpr (severity::info >= compiled_severity)
+			{
+				undecoratedln(severity::info, format, std::forward<Args>(a)...);
+			}
 		}
 
 		/** @brief same as undecoratedln but with severity = warn */
 		template <class... Args, class FormatString>
 		[[rythe_always_inline]] void undecoratedWarn(const FormatString& format, Args&&... a)
 		{
-			undecoratedln(severity::warn, format, std::forward<Args>(a)...);
+			if constexpr (severity::warn >= compiled_severity)
+			{
+				undecoratedln(severity::warn, format, std::forward<Args>(a)...);
+			}
 		}
 
 		/** @brief same as undecoratedln but with severity = error */
 		template <class... Args, class FormatString>
 		[[rythe_always_inline]] void undecoratedError(const FormatString& format, Args&&... a)
 		{
-			undecoratedln(severity::error, format, std::forward<Args>(a)...);
+			if constexpr (severity::error >= compiled_severity)
+			{
+				undecoratedln(severity::error, format, std::forward<Args>(a)...);
+			}
 		}
 
 		/** @brief same as undecoratedln but with severity = fatal */
 		template <class... Args, class FormatString>
 		[[rythe_always_inline]] void undecoratedFatal(const FormatString& format, Args&&... a)
 		{
-			undecoratedln(severity::fatal, format, std::forward<Args>(a)...);
+			if constexpr (severity::fatal >= compiled_severity)
+			{
+				undecoratedln(severity::fatal, format, std::forward<Args>(a)...);
+			}
 		}
 
 		/** @brief same as println but with severity = trace */
 		template <class... Args, class FormatString>
 		[[rythe_always_inline]] void trace(const FormatString& format, Args&&... a)
 		{
-			println(severity::trace, format, std::forward<Args>(a)...);
+			if constexpr (severity::trace >= compiled_severity)
+			{
+				println(severity::trace, format, std::forward<Args>(a)...);
+			}
 		}
 
 		/** @brief same as println but with severity = debug */
 		template <class... Args, class FormatString>
 		[[rythe_always_inline]] void debug(const FormatString& format, Args&&... a)
 		{
-			println(severity::debug, format, std::forward<Args>(a)...);
+			if constexpr (severity::debug >= compiled_severity)
+			{
+				println(severity::debug, format, std::forward<Args>(a)...);
+			}
 		}
 
 		/** @brief same as println but with severity = info */
 		template <class... Args, class FormatString>
 		[[rythe_always_inline]] void info(const FormatString& format, Args&&... a)
 		{
-			println(severity::info, format, std::forward<Args>(a)...);
+			if constexpr (severity::info >= compiled_severity)
+			{
+				println(severity::info, format, std::forward<Args>(a)...);
+			}
 		}
 
 		/** @brief same as println but with severity = warn */
 		template <class... Args, class FormatString>
 		[[rythe_always_inline]] void warn(const FormatString& format, Args&&... a)
 		{
-			println(severity::warn, format, std::forward<Args>(a)...);
+			if constexpr (severity::warn >= compiled_severity)
+			{
+				println(severity::warn, format, std::forward<Args>(a)...);
+			}
 		}
 
 		/** @brief same as println but with severity = error */
 		template <class... Args, class FormatString>
 		[[rythe_always_inline]] void error(const FormatString& format, Args&&... a)
 		{
-			println(severity::error, format, std::forward<Args>(a)...);
+			if constexpr (severity::error >= compiled_severity)
+			{
+				println(severity::error, format, std::forward<Args>(a)...);
+			}
 		}
 
 		/** @brief same as println but with severity = fatal */
 		template <class... Args, class FormatString>
 		[[rythe_always_inline]] void fatal(const FormatString& format, Args&&... a)
 		{
-			println(severity::fatal, format, std::forward<Args>(a)...);
+			if constexpr (severity::fatal >= compiled_severity)
+			{
+				println(severity::fatal, format, std::forward<Args>(a)...);
+			}
 		}
 
 		namespace internal
 		{
-			void setup()
+			inline void setup()
 			{
 				auto& inst = logging_context::get();
 
@@ -184,22 +229,11 @@ namespace rsl
 				inst.logger = inst.fileLogger;
 				#endif
 
-				#if defined(RYTHE_LOG_TRACE)
-				filter(severity::trace);
-				#elif defined(RYTHE_LOG_DEBUG)
-				filter(severity::debug);
-				#elif defined(RYTHE_LOG_INFO)
-				filter(severity::info);
-				#elif defined(RYTHE_LOG_WARN)
-				filter(severity::warn);
-				#elif defined(RYTHE_LOG_ERROR)
-				filter(severity::error);
-				#elif defined(RYTHE_LOG_FATAL)
-				filter(severity::fatal);
-				#elif defined(RYTHE_DEBUG)
-				filter(severity::debug);
+				#if defined(RYTHE_LOG_TRACE) || defined(RYTHE_LOG_DEBUG) || defined(RYTHE_LOG_INFO) || defined(RYTHE_LOG_WARN) || \
+					defined(RYTHE_LOG_ERROR) || defined(RYTHE_LOG_FATAL)
+				filter(compiled_severity);
 				#else
-				filter(severity::info);
+				filter(severity::default_severity);
 				#endif
 
 				undecoratedInfo("== Initializing Logger");
@@ -207,4 +241,82 @@ namespace rsl
 		} // namespace internal
 	} // namespace log
 } // namespace rsl
+
+/**@def rsl_log_trace
+ * @brief Same as rsl::log::trace, but below rsl::log::compiled_severity the whole call compiles to nothing, including
+ * the evaluation of its arguments. The same goes for rsl_log_debug up to rsl_log_fatal.
+ */
+#define rsl_log_trace(...)                                                                                             \
+	if constexpr (::rsl::log::severity::trace >= ::rsl::log::compiled_severity)                                        \
+	{                                                                                                                  \
+		::rsl::log::trace(__VA_ARGS__);                                                                                \
+	}
+#define rsl_log_debug(...)                                                                                             \
+	if constexpr (::rsl::log::severity::debug >= ::rsl::log::compiled_severity)                                        \
+	{                                                                                                                  \
+		::rsl::log::debug(__VA_ARGS__);                                                                                \
+	}
+#define rsl_log_info(...)                                                                                              \
+	if constexpr (::rsl::log::severity::info >= ::rsl::log::compiled_severity)                                         \
+	{                                                                                                                  \
+		::rsl::log::info(__VA_ARGS__);                                                                                 \
+	}
+#define rsl_log_warn(...)                                                                                              \
+	if constexpr (::rsl::log::severity::warn >= ::rsl::log::compiled_severity)                                         \
+	{                                                                                                                  \
+		::rsl::log::warn(__VA_ARGS__);                                                                                 \
+	}
+#define rsl_log_error(...)                                                                                             \
+	if constexpr (::rsl::log::severity::error >= ::rsl::log::compiled_severity)                                        \
+	{                                                                                                                  \
+		::rsl::log::error(__VA_ARGS__);                                                                                \
+	}
+#define rsl_log_fatal(...)                                                                                             \
+	if constexpr (::rsl::log::severity::fatal >= ::rsl::log::compiled_severity)                                        \
+	{                                                                                                                  \
+		::rsl::log::fatal(__VA_ARGS__);                                                                                \
+	}
+
+/**@def rsl_log_to
+ * @brief Logs to a specific logger, severity needs to be a constant. Compiled out below rsl::log::compiled_severity,
+ * and the arguments are only evaluated once the logger's filter lets the message through.
+ */
+#define rsl_log_to(logger, severity, ...)                                                                              \
+	if constexpr ((severity) >= ::rsl::log::compiled_severity)                                                         \
+	{                                                                                                                  \
+		if ((logger).should_log(severity))                                                                             \
+		{                                                                                                              \
+			(logger).log(severity, __VA_ARGS__);                                                                       \
+		}                                                                                                              \
+	}
+
+/**@def rsl_log_limited
+ * @brief Same as rsl_log_to, but rate limited per statement. policy is a token_bucket, first_n_every_kth or sampled,
+ * wrapped in parentheses when it contains a comma. It goes into a callsite_limiter that's a static local of the
+ * statement, so it only gets read the first time. Once a message gets through after others got suppressed, a summary
+ * line with their count follows it. Suppressions that no later message reports get reported when the logger is flushed.
+ */
+#define rsl_log_limited(logger, severity, policy, ...)                                                                 \
+	if constexpr ((severity) >= ::rsl::log::compiled_severity)                                                         \
+	{                                                                                                                  \
+		if ((logger).should_log(severity))                                                                             \
+		{                                                                                                              \
+			static ::rsl::log::callsite_limiter<::std::remove_cvref_t<decltype(policy)>> rsl_callsite_limiter(         \
+				policy, ::rsl::source_location::current()                                                              \
+			);                                                                                                         \
+			if (::rsl::uint64 rsl_suppressed = 0ull; rsl_callsite_limiter.admit(rsl_suppressed))                       \
+			{                                                                                                          \
+				(logger).log(severity, __VA_ARGS__);                                                                   \
+				if (rsl_suppressed != 0ull)                                                                            \
+				{                                                                                                      \
+					rsl_callsite_limiter.report((logger), severity, rsl_suppressed);                                   \
+				}                                                                                                      \
+			}                                                                                                          \
+			else                                                                                                       \
+			{                                                                                                          \
+				rsl_callsite_limiter.track((logger), severity);                                                        \
+			}                                                                                                          \
+		}                                                                                                              \
+	}
+
 #undef logger
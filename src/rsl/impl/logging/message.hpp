@@ -8,6 +8,8 @@
 
 namespace rsl::log
 {
+	class format_cache;
+
 	struct message
 	{
 		string_view loggerName;
@@ -18,5 +20,15 @@ namespace rsl::log
 		log::severity severity;
 		string_view msg;
 		fmt::format_args formatArgs;
+		// Key/value fields in the form encode_fields writes them, read them with a field_reader. Empty for messages
+		// logged without fields.
+		string_view fields{};
+		// Set for messages logged through log_fields, even ones without any fields. Their text is never a format string.
+		bool structured = false;
+
+		// msg with formatArgs applied, loggers format it once before handing the message to their sinks.
+		string_view formattedMsg{};
+		// Decorated output shared by the sinks that get this message, see sink::format.
+		format_cache* formatCache = nullptr;
 	};
 }
@@ -0,0 +1,417 @@
+#include "mmap_ring_sink.hpp"
+
+#include <cstring>
+#include <mutex>
+
+#include "../util/assert.hpp"
+#include "../util/atomic.hpp"
+
+#include "deferred_format.hpp"
+#include "formatter.hpp"
+#include "message.hpp"
+
+namespace rsl::log
+{
+	namespace internal
+	{
+		// Start of the mapped file, the records follow right after it.
+		struct mmap_ring_header
+		{
+			uint64 magic;
+			uint32 version;
+			uint32 recordHeaderSize;
+			uint64 capacity;
+			// Logical positions, they only ever grow. The physical offset is the position modulo the capacity.
+			uint64 head;
+			uint64 tail;
+			uint64 nextSequence;
+			uint64 reserved[2];
+		};
+	} // namespace internal
+
+	namespace
+	{
+		using internal::mmap_ring_header;
+
+		static_assert(sizeof(mmap_ring_header) == 64ull);
+
+		constexpr uint64 ring_magic = 0x474E4952474F4C52ull; // "RLOGRING"
+		constexpr uint32 ring_version = 2u;
+
+		struct record_header
+		{
+			// Written last, 0 for records that were never completed.
+			uint64 sequence;
+			// Wall clock nanoseconds, so the records can be placed in time without a formatter writing it into the text.
+			int64 timestamp;
+			uint64 threadId;
+			uint32 length;
+			uint16 formatLength;
+			log::severity severity;
+			uint8 kind;
+		};
+
+		static_assert(sizeof(record_header) == 32ull);
+
+		// Fills the end of a lap that the next record didn't fit in. Gaps too small for a record header are skipped too.
+		constexpr uint8 wrap_marker = 0xFFu;
+		constexpr size_type record_alignment = 8ull;
+
+		[[nodiscard]] constexpr size_type record_size(const size_type length) noexcept
+		{
+			return (sizeof(record_header) + length + record_alignment - 1ull) & ~(record_alignment - 1ull);
+		}
+
+		[[nodiscard]] uint64 load_acquire(const uint64& value) noexcept
+		{
+			return atomic_ref<uint64>(const_cast<uint64&>(value)).load(memory_order::acquire);
+		}
+
+		void store_release(uint64& value, const uint64 newValue) noexcept
+		{
+			atomic_ref<uint64>(value).store(newValue, memory_order::release);
+		}
+
+		// Position past the record or lap end at position.
+		[[nodiscard]] uint64 skip_record(const byte* records, const size_type capacity, const uint64 position) noexcept
+		{
+			const size_type physical = position & (capacity - 1ull);
+			const size_type remaining = capacity - physical;
+			if (remaining < sizeof(record_header))
+			{
+				return position + remaining;
+			}
+
+			const auto* header = reinterpret_cast<const record_header*>(records + physical);
+			if (header->kind == wrap_marker)
+			{
+				return position + remaining;
+			}
+
+			return position + record_size(header->length);
+		}
+
+		// Reads the record at position if it's intact and has the expected sequence number, 0 accepts any sequence.
+		[[nodiscard]] bool read_record(
+			const byte* records, const size_type capacity, uint64 position, const uint64 expectedSequence,
+			mmap_ring_record& record, uint64& nextPosition
+		) noexcept
+		{
+			size_type physical = position & (capacity - 1ull);
+			size_type remaining = capacity - physical;
+			const auto* header = reinterpret_cast<const record_header*>(records + physical);
+
+			// Wrap markers are never at the start of a lap, so at most one jump is needed.
+			if (remaining < sizeof(record_header) || header->kind == wrap_marker)
+			{
+				position += remaining;
+				physical = 0ull;
+				remaining = capacity;
+				header = reinterpret_cast<const record_header*>(records);
+			}
+
+			const uint64 sequence = load_acquire(header->sequence);
+			if (sequence == 0ull || (expectedSequence != 0ull && sequence != expectedSequence))
+			{
+				return false;
+			}
+
+			const auto kind = static_cast<mmap_record_kind>(header->kind);
+			if (header->kind > static_cast<uint8>(mmap_record_kind::structured) ||
+				sizeof(record_header) + header->length > remaining || header->formatLength > header->length)
+			{
+				return false;
+			}
+
+			const char* body = reinterpret_cast<const char*>(header + 1);
+			record.sequence = sequence;
+			record.timestamp = header->timestamp;
+			record.threadId = thread_id{static_cast<id_type>(header->threadId)};
+			record.severity = header->severity;
+			record.kind = kind;
+			record.formatString = string_view::from_buffer(body, header->formatLength);
+			record.payload = string_view::from_buffer(body + header->formatLength, header->length - header->formatLength);
+
+			nextPosition = position + record_size(header->length);
+			return true;
+		}
+
+		[[nodiscard]] bool is_valid_ring(const file_mapping& mapping) noexcept
+		{
+			if (mapping.size() < sizeof(mmap_ring_header))
+			{
+				return false;
+			}
+
+			const auto* header = reinterpret_cast<const mmap_ring_header*>(mapping.data());
+			return header->magic == ring_magic && header->version == ring_version &&
+				   header->recordHeaderSize == sizeof(record_header) && header->capacity >= sizeof(record_header) &&
+				   (header->capacity & (header->capacity - 1ull)) == 0ull &&
+				   header->capacity <= mapping.size() - sizeof(mmap_ring_header);
+		}
+
+		void copy_path(const string_view path, fmt::memory_buffer& dest)
+		{
+			dest.append(path.data(), path.data() + path.size());
+			dest.push_back('\0');
+		}
+
+		thread_local fmt::memory_buffer encodedArgs;
+	} // namespace
+
+	void mmap_ring_record::format_to(fmt::memory_buffer& dest) const
+	{
+		if (kind == mmap_record_kind::binary)
+		{
+			format_deferred(formatString, payload, dest);
+		}
+		else if (kind == mmap_record_kind::structured)
+		{
+			dest.append(formatString.data(), formatString.data() + formatString.size());
+		}
+		else
+		{
+			dest.append(payload.data(), payload.data() + payload.size());
+		}
+	}
+
+	field_reader mmap_ring_record::fields() const noexcept
+	{
+		return kind == mmap_record_kind::structured ? field_reader(payload) : field_reader();
+	}
+
+	mmap_ring_sink::mmap_ring_sink(const string_view path, const size_type capacity)
+		: m_capacity(capacity)
+	{
+		rsl_assert_invalid_parameters(capacity >= 2ull * sizeof(record_header));
+		rsl_assert_invalid_parameters((capacity & (capacity - 1ull)) == 0ull);
+
+		fmt::memory_buffer nativePath;
+		copy_path(path, nativePath);
+		m_mapping = platform::map_file(nativePath.data(), sizeof(mmap_ring_header) + capacity, true);
+		rsl_assert_msg_soft(m_mapping, "Could not map log ring.");
+		if (!m_mapping)
+		{
+			return;
+		}
+
+		m_header = reinterpret_cast<mmap_ring_header*>(m_mapping.data());
+		m_records = m_mapping.data() + sizeof(mmap_ring_header);
+
+		if (is_valid_ring(m_mapping) && m_header->capacity == capacity)
+		{
+			// Picks up after the last intact record, the header's head can be one record behind after a crash.
+			m_tail = m_header->tail;
+			m_head = m_tail;
+			m_nextSequence = m_header->nextSequence != 0ull ? m_header->nextSequence : 1ull;
+
+			mmap_ring_record record;
+			uint64 next = 0ull;
+			uint64 expectedSequence = 0ull;
+			while (read_record(m_records, m_capacity, m_head, expectedSequence, record, next))
+			{
+				m_head = next;
+				expectedSequence = record.sequence + 1ull;
+			}
+
+			if (expectedSequence != 0ull)
+			{
+				m_nextSequence = expectedSequence;
+			}
+		}
+		else
+		{
+			// Leftovers could pass as records of the new ring, so everything starts out zeroed.
+			std::memset(m_mapping.data(), 0, m_mapping.size());
+			m_header->magic = ring_magic;
+			m_header->version = ring_version;
+			m_header->recordHeaderSize = sizeof(record_header);
+			m_header->capacity = capacity;
+		}
+
+		store_release(m_header->tail, m_tail);
+		store_release(m_header->head, m_head);
+		store_release(m_header->nextSequence, m_nextSequence);
+	}
+
+	mmap_ring_sink::~mmap_ring_sink()
+	{
+		if (m_mapping)
+		{
+			platform::unmap_file(m_mapping);
+		}
+	}
+
+	void mmap_ring_sink::log(const message& msg)
+	{
+		if (!m_mapping)
+		{
+			return;
+		}
+
+		if (m_storeBinary && !msg.structured && msg.formatArgs.get(0) && msg.msg.size() <= 0xFFFFull)
+		{
+			encodedArgs.clear();
+			encode_format_args(msg.formatArgs, encodedArgs);
+
+			const string_view encoded = string_view::from_buffer(encodedArgs.data(), encodedArgs.size());
+			if (record_size(msg.msg.size() + encoded.size()) <= m_capacity)
+			{
+				write(msg, mmap_record_kind::binary, msg.msg, encoded);
+				return;
+			}
+		}
+
+		if (msg.structured && msg.fields.size() < m_capacity - sizeof(record_header))
+		{
+			// Fields are never truncated, the text gives way instead.
+			string_view text = format(msg);
+			const size_type maxText = m_capacity - sizeof(record_header) - msg.fields.size();
+			const size_type textSize = text.size() < maxText ? text.size() : maxText;
+			text = string_view::from_buffer(text.data(), textSize < 0xFFFFull ? textSize : 0xFFFFull);
+
+			write(msg, mmap_record_kind::structured, text, msg.fields);
+			return;
+		}
+
+		write(msg, mmap_record_kind::text, string_view{}, format(msg));
+	}
+
+	void mmap_ring_sink::flush()
+	{
+		if (m_mapping)
+		{
+			platform::sync_mapping(m_mapping);
+		}
+	}
+
+	void mmap_ring_sink::write(
+		const message& msg, const mmap_record_kind kind, const string_view formatString, string_view payload
+	)
+	{
+		const size_type maxLength = m_capacity - sizeof(record_header);
+		if (formatString.size() + payload.size() > maxLength)
+		{
+			payload = string_view::from_buffer(payload.data(), maxLength - formatString.size());
+		}
+
+		const size_type length = formatString.size() + payload.size();
+		const size_type size = record_size(length);
+		const int64 timestamp = wall_clock_nanoseconds(msg.timestamp);
+
+		std::lock_guard guard(m_lock);
+
+		size_type physical = m_head & (m_capacity - 1ull);
+		const size_type remaining = m_capacity - physical;
+		if (remaining < size)
+		{
+			make_room(remaining);
+			if (remaining >= sizeof(record_header))
+			{
+				auto* marker = reinterpret_cast<record_header*>(m_records + physical);
+				marker->kind = wrap_marker;
+				store_release(marker->sequence, 0ull);
+			}
+			m_head += remaining;
+			physical = 0ull;
+		}
+
+		make_room(size);
+
+		// Whatever sequence number was left here is older than the new one, so readers can't mistake a torn record for
+		// an intact one until the sequence number goes in at the end.
+		auto* header = reinterpret_cast<record_header*>(m_records + physical);
+		char* body = reinterpret_cast<char*>(header + 1);
+		std::memcpy(body, formatString.data(), formatString.size());
+		std::memcpy(body + formatString.size(), payload.data(), payload.size());
+		header->timestamp = timestamp;
+		header->threadId = static_cast<uint64>(msg.threadId.nativeId);
+		header->length = static_cast<uint32>(length);
+		header->formatLength = static_cast<uint16>(formatString.size());
+		header->severity = msg.severity;
+		header->kind = static_cast<uint8>(kind);
+		store_release(header->sequence, m_nextSequence);
+
+		m_nextSequence++;
+		m_head += size;
+		store_release(m_header->head, m_head);
+		store_release(m_header->nextSequence, m_nextSequence);
+	}
+
+	void mmap_ring_sink::make_room(const size_type size)
+	{
+		const uint64 end = m_head + size;
+		if (end - m_tail <= m_capacity)
+		{
+			return;
+		}
+
+		while (end - m_tail > m_capacity)
+		{
+			m_tail = skip_record(m_records, m_capacity, m_tail);
+		}
+
+		// Published before anything gets overwritten, so the tail always points at an intact record.
+		store_release(m_header->tail, m_tail);
+	}
+
+	mmap_ring_reader::mmap_ring_reader(const string_view path)
+	{
+		fmt::memory_buffer nativePath;
+		copy_path(path, nativePath);
+		m_mapping = platform::map_file(nativePath.data(), 0ull, false);
+		if (!m_mapping)
+		{
+			return;
+		}
+
+		if (!is_valid_ring(m_mapping))
+		{
+			platform::unmap_file(m_mapping);
+			m_mapping = file_mapping{};
+			return;
+		}
+
+		m_header = reinterpret_cast<const mmap_ring_header*>(m_mapping.data());
+		m_records = m_mapping.data() + sizeof(mmap_ring_header);
+		m_capacity = m_header->capacity;
+		rewind();
+	}
+
+	mmap_ring_reader::~mmap_ring_reader()
+	{
+		if (m_mapping)
+		{
+			platform::unmap_file(m_mapping);
+		}
+	}
+
+	bool mmap_ring_reader::next(mmap_ring_record& record)
+	{
+		if (!m_mapping)
+		{
+			return false;
+		}
+
+		uint64 nextPosition = 0ull;
+		if (!read_record(m_records, m_capacity, m_position, m_expectedSequence, record, nextPosition))
+		{
+			return false;
+		}
+
+		m_position = nextPosition;
+		m_expectedSequence = record.sequence + 1ull;
+		return true;
+	}
+
+	void mmap_ring_reader::rewind()
+	{
+		if (!m_mapping)
+		{
+			return;
+		}
+
+		m_position = load_acquire(m_header->tail);
+		m_expectedSequence = 0ull;
+	}
+} // namespace rsl::log
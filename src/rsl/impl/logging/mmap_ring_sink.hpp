@@ -0,0 +1,153 @@
+#pragma once
+
+#include "../containers/string.hpp"
+#include "../platform/platform.hpp"
+#include "../threading/mutex.hpp"
+#include "../threading/thread_id.hpp"
+#include "../util/primitives.hpp"
+
+#include "field.hpp"
+#include "fmt_include.hpp"
+#include "severity.hpp"
+#include "sink.hpp"
+
+/**
+ * @file mmap_ring_sink.hpp
+ */
+
+namespace rsl::log
+{
+	namespace internal
+	{
+		struct mmap_ring_header;
+	}
+
+	/**@brief How a record in an mmap ring stores its message.
+	 */
+	enum struct mmap_record_kind : uint8
+	{
+		text,       // The output of the sink's formatter.
+		binary,     // The format string followed by the arguments in the form encode_format_args writes them.
+		structured, // The output of the sink's formatter followed by the fields in the form encode_fields writes them.
+	};
+
+	/**@brief Record read back from an mmap ring, the views point into the mapped file.
+	 */
+	struct mmap_ring_record
+	{
+		uint64 sequence = 0ull;
+		// Wall clock time of the message in nanoseconds since the Unix epoch, see wall_clock_nanoseconds.
+		int64 timestamp = 0ll;
+		thread_id threadId{};
+		log::severity severity = log::severity::off;
+		mmap_record_kind kind = mmap_record_kind::text;
+		// The format string of binary records and the text of structured records.
+		string_view formatString;
+		// The text, the encoded arguments of binary records or the encoded fields of structured records.
+		string_view payload;
+
+		/**@brief Appends the message text, binary records get formatted with format_deferred.
+		 */
+		void format_to(fmt::memory_buffer& dest) const;
+
+		/**@brief The fields of structured records, other records don't have any.
+		 */
+		[[nodiscard]] field_reader fields() const noexcept;
+	};
+
+	/**@class mmap_ring_sink
+	 * @brief Sink that copies every message into a fixed size ring of records in a file mapped with MAP_SHARED. Logging
+	 * is a memcpy without any system call, and since the memory belongs to the file the records survive the process
+	 * crashing. Once the ring is full the oldest records get overwritten.
+	 * Every record starts with a sequence number that gets written last, so mmap_ring_reader can tell intact records
+	 * from torn ones and stale ones from an earlier lap. Every record also keeps the time and thread of its message, binary
+ * and structured records included. Messages with fields keep them in their binary encoding.
+	 * @note Thread safe. Messages longer than the ring get truncated.
+	 */
+	class mmap_ring_sink final : public sink
+	{
+	public:
+		constexpr static size_type default_capacity = 4ull * 1024ull * 1024ull;
+
+		/**@brief Maps the ring at path and creates it when needed. A ring an earlier process left behind with the same
+		 * capacity gets continued after its last intact record, anything else gets reset.
+		 * @param capacity Size of the record area in bytes, needs to be a power of 2.
+		 */
+		explicit mmap_ring_sink(string_view path, size_type capacity = default_capacity);
+
+		mmap_ring_sink(const mmap_ring_sink&) = delete;
+		mmap_ring_sink(mmap_ring_sink&&) = delete;
+		mmap_ring_sink& operator=(const mmap_ring_sink&) = delete;
+		mmap_ring_sink& operator=(mmap_ring_sink&&) = delete;
+
+		~mmap_ring_sink() override;
+
+		void log(const message& msg) override;
+
+		/**@brief Blocks until the ring reached the storage device. Surviving a process crash doesn't need this, only OS
+		 * crashes and power loss do.
+		 */
+		void flush() override;
+
+		/**@brief Stores messages with format arguments as binary records, which skips both fmt and the formatter.
+		 * mmap_ring_record::format_to formats them when they get read back.
+		 */
+		[[rythe_always_inline]] void store_binary(bool enabled) noexcept { m_storeBinary = enabled; }
+		[[nodiscard]] [[rythe_always_inline]] bool stores_binary() const noexcept { return m_storeBinary; }
+
+		[[nodiscard]] [[rythe_always_inline]] bool is_open() const noexcept { return m_mapping; }
+		[[nodiscard]] [[rythe_always_inline]] size_type capacity() const noexcept { return m_capacity; }
+
+	private:
+		void write(const message& msg, mmap_record_kind kind, string_view formatString, string_view payload);
+		void make_room(size_type size);
+
+		file_mapping m_mapping;
+		internal::mmap_ring_header* m_header = nullptr;
+		byte* m_records = nullptr;
+		size_type m_capacity;
+		bool m_storeBinary = false;
+
+		// Copies of the positions in the header, which only get written to.
+		mutex m_lock;
+		uint64 m_head = 0ull;
+		uint64 m_tail = 0ull;
+		uint64 m_nextSequence = 1ull;
+	};
+
+	/**@class mmap_ring_reader
+	 * @brief Walks the intact records of a ring written by mmap_ring_sink, oldest first.
+	 * @note Meant for rings nothing writes to anymore, like the one left behind by a crashed process.
+	 */
+	class mmap_ring_reader
+	{
+	public:
+		explicit mmap_ring_reader(string_view path);
+
+		mmap_ring_reader(const mmap_ring_reader&) = delete;
+		mmap_ring_reader& operator=(const mmap_ring_reader&) = delete;
+
+		~mmap_ring_reader();
+
+		/**@brief Whether path held a ring written by mmap_ring_sink.
+		 */
+		[[nodiscard]] [[rythe_always_inline]] bool is_open() const noexcept { return m_mapping; }
+
+		/**@brief Moves on to the next record, returns false once there are no intact records left.
+		 * @note record stays valid as long as the reader.
+		 */
+		[[nodiscard]] bool next(mmap_ring_record& record);
+
+		/**@brief Starts over at the oldest record.
+		 */
+		void rewind();
+
+	private:
+		file_mapping m_mapping;
+		const internal::mmap_ring_header* m_header = nullptr;
+		const byte* m_records = nullptr;
+		size_type m_capacity = 0ull;
+		uint64 m_position = 0ull;
+		uint64 m_expectedSequence = 0ull;
+	};
+} // namespace rsl::log
@@ -0,0 +1,89 @@
+#include "rate_limit.hpp"
+
+#include <chrono>
+
+#include "../util/assert.hpp"
+
+#include "logger.hpp"
+
+namespace rsl::log
+{
+	namespace
+	{
+		[[nodiscard]] uint64 initial_sample_state() noexcept;
+
+		// Seeded with the clock and the address of the thread's own state, so threads don't share a sequence.
+		thread_local uint64 sampleState = initial_sample_state();
+
+		uint64 initial_sample_state() noexcept
+		{
+			const uint64 seed = static_cast<uint64>(std::chrono::high_resolution_clock::now().time_since_epoch().count()) ^
+								reinterpret_cast<uint64>(&sampleState);
+			return seed != 0ull ? seed : 0x9E3779B97F4A7C15ull;
+		}
+	} // namespace
+
+	namespace internal
+	{
+		void callsite_counter::report(basic_logger& logger, const log::severity severity, const uint64 suppressed) const
+		{
+			logger.log(
+				severity, format_string("{} similar messages suppressed at {}:{}"_sv, m_location), suppressed,
+				m_location.file_name(), m_location.line()
+			);
+		}
+
+		void callsite_counter::report_pending(basic_logger& logger)
+		{
+			if (const uint64 suppressed = take_pending(); suppressed != 0ull)
+			{
+				report(logger, m_severity, suppressed);
+			}
+		}
+
+		void callsite_counter::start_tracking(basic_logger& logger, const log::severity severity)
+		{
+			if (!m_tracked.exchange(true, memory_order::relaxed))
+			{
+				m_severity = severity;
+				logger.track_callsite(*this);
+			}
+		}
+
+		uint32 sample_random() noexcept
+		{
+			uint64 state = sampleState;
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			sampleState = state;
+			return static_cast<uint32>(state >> 32);
+		}
+	} // namespace internal
+
+	callsite_limiter<token_bucket>::callsite_limiter(const token_bucket& policy, const source_location& location) noexcept
+		: callsite_counter(location)
+	{
+		rsl_assert_invalid_parameters(policy.messagesPerSecond > 0.0);
+		rsl_assert_invalid_parameters(policy.burst != 0u);
+
+		m_interval = static_cast<int64>(1000000000.0 / policy.messagesPerSecond);
+		m_tolerance = m_interval * static_cast<int64>(policy.burst - 1u);
+	}
+
+	callsite_limiter<first_n_every_kth>::callsite_limiter(
+		const first_n_every_kth& policy, const source_location& location
+	) noexcept
+		: callsite_counter(location),
+		  m_policy(policy)
+	{
+	}
+
+	callsite_limiter<sampled>::callsite_limiter(const sampled& policy, const source_location& location) noexcept
+		: callsite_counter(location)
+	{
+		rsl_assert_invalid_parameters(policy.probability >= 0.0 && policy.probability <= 1.0);
+
+		m_threshold = static_cast<uint64>(policy.probability * 4294967296.0);
+	}
+} // namespace rsl::log
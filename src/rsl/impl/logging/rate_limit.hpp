@@ -0,0 +1,154 @@
+#pragma once
+
+#include "../util/atomic.hpp"
+#include "../util/primitives.hpp"
+#include "../util/source_location.hpp"
+
+#include "severity.hpp"
+
+/**
+ * @file rate_limit.hpp
+ */
+
+namespace rsl::log
+{
+	class basic_logger;
+
+	/**@brief Lets through a steady rate of messages with bursts of up to burst messages, anything over that gets
+	 * suppressed.
+	 */
+	struct token_bucket
+	{
+		float64 messagesPerSecond;
+		uint32 burst = 1u;
+	};
+
+	/**@brief Lets through the first messages and after those only every Kth one.
+	 */
+	struct first_n_every_kth
+	{
+		uint64 first;
+		// 0 suppresses everything after the first messages.
+		uint64 every;
+	};
+
+	/**@brief Lets each message through with the given probability.
+	 */
+	struct sampled
+	{
+		float64 probability;
+	};
+
+	namespace internal
+	{
+		/**@class callsite_counter
+		 * @brief Where a callsite_limiter sits and how many of its messages it suppressed.
+		 */
+		class callsite_counter
+		{
+		public:
+			constexpr explicit callsite_counter(const source_location& location) noexcept
+				: m_location(location)
+			{
+			}
+
+			[[nodiscard]] [[rythe_always_inline]] const source_location& location() const noexcept { return m_location; }
+
+			/**@brief Every message suppressed so far, including the ones already reported.
+			 */
+			[[nodiscard]] [[rythe_always_inline]] uint64 suppressed_count() const noexcept;
+
+			/**@brief Logs the summary line for the messages suppressed before the one that just got through, at the same
+			 * severity and with the location of the callsite.
+			 */
+			void report(basic_logger& logger, log::severity severity, uint64 suppressed) const;
+
+			/**@brief Hands the callsite to the logger after a suppression, so flushing the logger reports suppressions
+			 * that no later message got through to report. Only the first logger a callsite suppresses messages for
+			 * keeps track of it, until that logger is destroyed.
+			 */
+			[[rythe_always_inline]] void track(basic_logger& logger, log::severity severity);
+
+			/**@brief Reports the messages suppressed since the last report, if there are any.
+			 */
+			void report_pending(basic_logger& logger);
+
+		protected:
+			[[rythe_always_inline]] bool pass(uint64& suppressed) noexcept;
+			[[rythe_always_inline]] bool suppress() noexcept;
+
+		private:
+			friend class log::basic_logger;
+
+			[[rythe_always_inline]] uint64 take_pending() noexcept;
+			void start_tracking(basic_logger& logger, log::severity severity);
+
+			source_location m_location;
+			// Suppressed since the last message that got through.
+			atomic<uint64> m_pending{0ull};
+			atomic<uint64> m_reported{0ull};
+			// Set while a logger keeps track of the callsite, m_severity is what its summaries get logged at.
+			atomic<bool> m_tracked{false};
+			log::severity m_severity = log::severity::off;
+		};
+
+		/**@brief Random number from a generator of the calling thread, for sampled limiters.
+		 */
+		[[nodiscard]] uint32 sample_random() noexcept;
+	} // namespace internal
+
+	/**@class callsite_limiter
+	 * @brief State of one rate limited log statement, meant to be a static local of the callsite so there is nothing to
+	 * look up. rsl_log_limited declares one for every statement.
+	 * Specialized for token_bucket, first_n_every_kth and sampled. All of them are thread safe and lock free.
+	 */
+	template <typename Policy>
+	class callsite_limiter;
+
+	template <>
+	class callsite_limiter<token_bucket> final : public internal::callsite_counter
+	{
+	public:
+		callsite_limiter(const token_bucket& policy, const source_location& location) noexcept;
+
+		/**@brief Whether the message gets logged, suppressed is set to the messages suppressed since the last one that
+		 * got through.
+		 */
+		[[nodiscard]] [[rythe_always_inline]] bool admit(uint64& suppressed) noexcept;
+		[[nodiscard]] [[rythe_always_inline]] bool admit(int64 nanoseconds, uint64& suppressed) noexcept;
+
+	private:
+		int64 m_interval;
+		int64 m_tolerance;
+		// When the bucket is full again, in nanoseconds of a steady clock.
+		atomic<int64> m_fullAt{0ll};
+	};
+
+	template <>
+	class callsite_limiter<first_n_every_kth> final : public internal::callsite_counter
+	{
+	public:
+		callsite_limiter(const first_n_every_kth& policy, const source_location& location) noexcept;
+
+		[[nodiscard]] [[rythe_always_inline]] bool admit(uint64& suppressed) noexcept;
+
+	private:
+		first_n_every_kth m_policy;
+		atomic<uint64> m_count{0ull};
+	};
+
+	template <>
+	class callsite_limiter<sampled> final : public internal::callsite_counter
+	{
+	public:
+		callsite_limiter(const sampled& policy, const source_location& location) noexcept;
+
+		[[nodiscard]] [[rythe_always_inline]] bool admit(uint64& suppressed) noexcept;
+
+	private:
+		// Probability scaled to 2^32, which lets 1 through everything.
+		uint64 m_threshold;
+	};
+} // namespace rsl::log
+
+#include "rate_limit.inl"
@@ -0,0 +1,93 @@
+#pragma once
+#include "rate_limit.hpp"
+
+#include <chrono>
+
+namespace rsl::log
+{
+	namespace internal
+	{
+		inline uint64 callsite_counter::suppressed_count() const noexcept
+		{
+			return m_reported.load(memory_order::relaxed) + m_pending.load(memory_order::relaxed);
+		}
+
+		inline void callsite_counter::track(basic_logger& logger, const log::severity severity)
+		{
+			if (!m_tracked.load(memory_order::relaxed))
+			{
+				start_tracking(logger, severity);
+			}
+		}
+
+		inline uint64 callsite_counter::take_pending() noexcept
+		{
+			// Only pays for the exchange after a suppression.
+			uint64 pending = m_pending.load(memory_order::relaxed);
+			if (pending != 0ull)
+			{
+				pending = m_pending.exchange(0ull, memory_order::relaxed);
+				m_reported.fetch_add(pending, memory_order::relaxed);
+			}
+			return pending;
+		}
+
+		inline bool callsite_counter::pass(uint64& suppressed) noexcept
+		{
+			suppressed = take_pending();
+			return true;
+		}
+
+		inline bool callsite_counter::suppress() noexcept
+		{
+			m_pending.fetch_add(1ull, memory_order::relaxed);
+			return false;
+		}
+	} // namespace internal
+
+	inline bool callsite_limiter<token_bucket>::admit(uint64& suppressed) noexcept
+	{
+		const int64 nanoseconds =
+			std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+				.count();
+		return admit(nanoseconds, suppressed);
+	}
+
+	inline bool callsite_limiter<token_bucket>::admit(const int64 nanoseconds, uint64& suppressed) noexcept
+	{
+		// Generic cell rate algorithm, the whole bucket is a single timestamp that every message pushes forward by one
+		// interval.
+		int64 fullAt = m_fullAt.load(memory_order::relaxed);
+		do
+		{
+			if (nanoseconds < fullAt - m_tolerance)
+			{
+				return suppress();
+			}
+		}
+		while (!m_fullAt.compare_exchange_weak(
+			fullAt, (fullAt > nanoseconds ? fullAt : nanoseconds) + m_interval, memory_order::relaxed
+		));
+
+		return pass(suppressed);
+	}
+
+	inline bool callsite_limiter<first_n_every_kth>::admit(uint64& suppressed) noexcept
+	{
+		const uint64 index = m_count.fetch_add(1ull, memory_order::relaxed);
+		if (index < m_policy.first || (m_policy.every != 0ull && (index - m_policy.first + 1ull) % m_policy.every == 0ull))
+		{
+			return pass(suppressed);
+		}
+		return suppress();
+	}
+
+	inline bool callsite_limiter<sampled>::admit(uint64& suppressed) noexcept
+	{
+		if (internal::sample_random() < m_threshold)
+		{
+			return pass(suppressed);
+		}
+		return suppress();
+	}
+} // namespace rsl::log
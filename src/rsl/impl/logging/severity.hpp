@@ -22,6 +22,45 @@ namespace rsl::log
 		#endif
 	};
 
+	/**@brief Lowest severity that gets compiled in. Calls through the rsl_log_* macros below it compile to nothing and
+	 * don't evaluate their arguments, the log::trace ... log::fatal helpers drop their body. Only raised by the same
+	 * RYTHE_LOG_* defines that pick the filter of the default logger, without one nothing gets stripped and log::filter
+	 * can still enable every severity at runtime.
+	 */
+	constexpr severity compiled_severity =
+	#if defined(RYTHE_LOG_TRACE)
+		severity::trace;
+	#elif defined(RYTHE_LOG_DEBUG)
+		severity::debug;
+	#elif defined(RYTHE_LOG_INFO)
+		severity::info;
+	#elif defined(RYTHE_LOG_WARN)
+		severity::warn;
+	#elif defined(RYTHE_LOG_ERROR)
+		severity::error;
+	#elif defined(RYTHE_LOG_FATAL)
+		severity::fatal;
+	#else
+		severity::trace;
+	#endif
+
+	/**@brief Lower case name of the severity, like "warn".
+	 */
+	[[nodiscard]] [[rythe_always_inline]] constexpr string_view severity_name(const severity s) noexcept
+	{
+		switch (s)
+		{
+			case severity::trace: return "trace"_sv;
+			case severity::debug: return "debug"_sv;
+			case severity::info: return "info"_sv;
+			case severity::warn: return "warn"_sv;
+			case severity::error: return "error"_sv;
+			case severity::fatal: return "fatal"_sv;
+			case severity::off: return "off"_sv;
+		}
+		return string_view{};
+	}
+
 	namespace internal
 	{
 		[[nodiscard]] [[rythe_always_inline]] constexpr static spdlog::level::level_enum rythe_to_spdlog(const severity s)
@@ -0,0 +1,24 @@
+#include "sink.hpp"
+
+#include "message.hpp"
+
+namespace rsl::log
+{
+	string_view sink::format(const message& msg)
+	{
+		if (!m_formatter.is_armed())
+		{
+			return msg.formattedMsg;
+		}
+
+		if (msg.formatCache)
+		{
+			return msg.formatCache->format(*m_formatter, msg);
+		}
+
+		// Messages that didn't come from a logger have nothing to share with.
+		thread_local format_cache scratch;
+		scratch.reset();
+		return scratch.format(*m_formatter, msg);
+	}
+} // namespace rsl::log
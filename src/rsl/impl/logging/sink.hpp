@@ -25,6 +25,14 @@ namespace rsl::log
 
         [[rythe_always_inline]] void filter(severity s) noexcept;
 		[[nodiscard]] [[rythe_always_inline]] severity filter_severity() const noexcept;
+
+	protected:
+		/**@brief The message decorated by this sink's formatter, or just its text if there is no formatter. Sinks with
+		 * the same pattern share the output through the message's format_cache.
+		 * @note The view is only valid until the next call.
+		 */
+		[[nodiscard]] string_view format(const message& msg);
+
 	private:
 		severity m_severity = severity::default_severity;
 		unique_object<formatter> m_formatter;
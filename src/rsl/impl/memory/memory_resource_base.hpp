@@ -548,7 +548,11 @@ namespace rsl
             noexcept(factory_traits<Factory>::noexcept_moveable);
         [[rythe_always_inline]] constexpr void set_ptr_to_static_memory() noexcept;
 
-        static_capacity_storage<conditional_t<Untyped, void, UtilType>, BufferSize> m_buffer{};
+        // Raw bytes instead of UtilType[] so the in-place elements are only constructed when the container does so.
+        using static_storage = static_capacity_storage<void, BufferSize>;
+        constexpr static size_type static_alignment = alignof(conditional_t<is_void_v<UtilType>, std::max_align_t, UtilType>);
+
+        alignas(static_alignment) static_storage m_buffer{};
         typed_alloc_type m_alloc;
         void* m_ptr = m_buffer.data;
     };
@@ -558,7 +562,7 @@ namespace rsl
         allocator_type Alloc = default_allocator,
         untyped_factory_type Factory = type_erased_factory,
         typename UtilType = void>
-    class untyped_hybrid_memory_resource : hybrid_memory_resource_base<BufferSize, Alloc, Factory, UtilType, true>
+    class untyped_hybrid_memory_resource : public hybrid_memory_resource_base<BufferSize, Alloc, Factory, UtilType, true>
     {
         using base_type = hybrid_memory_resource_base<BufferSize, Alloc, Factory, UtilType, true>;
 
@@ -573,7 +577,7 @@ namespace rsl
     };
 
     template <typename T, size_type BufferCount, allocator_type Alloc = default_allocator, factory_type Factory = default_factory<T>>
-    class typed_hybrid_memory_resource : hybrid_memory_resource_base<BufferCount * sizeof(T), Alloc, Factory, T, false>
+    class typed_hybrid_memory_resource : public hybrid_memory_resource_base<BufferCount * sizeof(T), Alloc, Factory, T, false>
     {
         using base_type = hybrid_memory_resource_base<BufferCount * sizeof(T), Alloc, Factory, T, false>;
 
@@ -651,7 +651,7 @@ namespace rsl
                 m_ptr = m_alloc.allocate(newCount);
                 if (m_ptr) [[likely]]
                 {
-                    m_alloc.move(m_ptr, m_buffer.data, oldCount);
+                    m_alloc.move(get_ptr(), get_static_ptr(), oldCount);
                 }
             }
         }
@@ -675,7 +675,7 @@ namespace rsl
                 m_ptr = m_alloc.allocate(newCount, alignment);
                 if (m_ptr) [[likely]]
                 {
-                    m_alloc.move(m_ptr, m_buffer.data, oldCount);
+                    m_alloc.move(get_ptr(), get_static_ptr(), oldCount);
                 }
             }
         }
@@ -872,14 +872,14 @@ namespace rsl
     template <size_type BufferSize, allocator_type Alloc, factory_type Factory, typename UtilType, bool Untyped>
     constexpr UtilType* hybrid_memory_resource_base<BufferSize, Alloc, Factory, UtilType, Untyped>::get_static_ptr() noexcept
     {
-        return bit_cast<UtilType*>(m_buffer.data);
+        return bit_cast<UtilType*>(static_cast<static_storage::value_type*>(m_buffer.data));
     }
 
     template <size_type BufferSize, allocator_type Alloc, factory_type Factory, typename UtilType, bool Untyped>
     constexpr const UtilType* hybrid_memory_resource_base<BufferSize, Alloc, Factory, UtilType, Untyped>::
     get_static_ptr() const noexcept
     {
-        return bit_cast<const UtilType*>(m_buffer.data);
+        return bit_cast<const UtilType*>(static_cast<const static_storage::value_type*>(m_buffer.data));
     }
 
     template <size_type BufferSize, allocator_type Alloc, factory_type Factory, typename UtilType, bool Untyped>
@@ -918,7 +918,7 @@ namespace rsl
     template <size_type BufferSize, allocator_type Alloc, factory_type Factory, typename UtilType, bool Untyped>
     constexpr void hybrid_memory_resource_base<BufferSize, Alloc, Factory, UtilType, Untyped>::set_ptr_to_static_memory() noexcept
     {
-        set_ptr(m_buffer.data);
+        m_ptr = m_buffer.data;
     }
 
     template <typename T, size_type BufferCount, allocator_type Alloc, factory_type Factory>
@@ -114,18 +114,10 @@ namespace rsl
             unique_object<OtherType, Alloc, OtherFactory>&& other
             ) noexcept
     {
-        unique_rsc::disarm();
-
-        mem_rsc::set_allocator(other.mem_rsc::get_allocator_storage());
-        mem_rsc::set_factory(other.mem_rsc::get_factory_storage());
-        unique_rsc::m_value.emplace(rsl::move(other.unique_rsc::m_value.value()));
-
-        m_factory = rsl::move(other.get_factory_storage());
-
-        mem_rsc::set_ptr(other.mem_rsc::get_ptr());
-        other.mem_rsc::set_ptr(nullptr);
-
-        return *this;
+        // The bases of other are a different unique_resource, the converting constructor already knows how to take
+        // them apart.
+        unique_object converted(rsl::move(other));
+        return *this = rsl::move(converted);
     }
 
     template <typename T, allocator_type Alloc, statically_optional_typed_factory_type Factory>
@@ -0,0 +1,33 @@
+#include "cpu_topology.hpp"
+
+namespace rsl
+{
+	cpu_mask cpu_topology::one_cpu_per_core() const noexcept
+	{
+		cpu_mask result;
+		for (const cpu_core_info& core : cores)
+		{
+			const size_type first = core.logicalCpus.find_first_set();
+			if (first != npos)
+			{
+				result.set(first);
+			}
+		}
+
+		return result;
+	}
+
+	const cpu_cache_info*
+	cpu_topology::find_cache(const uint32 level, const cpu_cache_type type, const size_type cpu) const noexcept
+	{
+		for (const cpu_cache_info& cache : caches)
+		{
+			if (cache.level == level && cache.type == type && cache.sharedCpus.test(cpu))
+			{
+				return &cache;
+			}
+		}
+
+		return nullptr;
+	}
+} // namespace rsl
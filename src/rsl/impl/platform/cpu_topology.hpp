@@ -0,0 +1,88 @@
+#pragma once
+
+#include "../containers/array.hpp"
+#include "../containers/bitset.hpp"
+#include "../util/primitives.hpp"
+
+/**
+ * @file cpu_topology.hpp
+ */
+
+namespace rsl
+{
+	constexpr size_type max_cpu_count = 1024ull;
+
+	/**@brief Set of logical cpus, bit i stands for the logical cpu with index i.
+	 */
+	using cpu_mask = static_bitset<max_cpu_count>;
+
+	enum struct thread_priority : uint8
+	{
+		lowest,
+		below_normal,
+		normal,
+		above_normal,
+		highest,
+		// Real-time scheduling, usually needs elevated privileges.
+		time_critical,
+	};
+
+	enum struct cpu_cache_type : uint8
+	{
+		data,
+		instruction,
+		unified,
+	};
+
+	struct cpu_cache_info
+	{
+		uint32 level = 0u;
+		cpu_cache_type type = cpu_cache_type::unified;
+		size_type size = 0ull;
+		size_type lineSize = 0ull;
+		uint32 associativity = 0u;
+		// Logical cpus that share this cache.
+		cpu_mask sharedCpus;
+	};
+
+	struct cpu_core_info
+	{
+		uint32 package = 0u;
+		uint32 coreId = 0u;
+		// SMT siblings, the logical cpus that run on this physical core.
+		cpu_mask logicalCpus;
+	};
+
+	/**@struct cpu_topology
+	 * @brief Layout of the machine, physical cores with their SMT siblings and the cache hierarchy.
+	 */
+	struct cpu_topology
+	{
+		uint32 logicalCpuCount = 0u;
+		uint32 packageCount = 0u;
+		size_type cacheLineSize = cache_line_size;
+		dynamic_array<cpu_core_info> cores;
+		// Every distinct cache once, ordered by level.
+		dynamic_array<cpu_cache_info> caches;
+
+		[[nodiscard]] [[rythe_always_inline]] size_type physical_core_count() const noexcept { return cores.size(); }
+
+		/**@brief Whether cache_line_size covers the lines of this machine, padding based on a smaller constant doesn't
+		 * prevent false sharing.
+		 */
+		[[nodiscard]] [[rythe_always_inline]] bool cache_line_size_sufficient() const noexcept
+		{
+			return cacheLineSize <= cache_line_size;
+		}
+
+		/**@brief First logical cpu of every physical core, pinning one thread to each keeps them off each other's SMT
+		 * siblings.
+		 */
+		[[nodiscard]] cpu_mask one_cpu_per_core() const noexcept;
+
+		/**@brief Cache of the given level and type that the logical cpu uses, nullptr if there is none.
+		 */
+		[[nodiscard]] const cpu_cache_info*
+		find_cache(uint32 level, cpu_cache_type type, size_type cpu = 0ull) const noexcept;
+	};
+} // namespace rsl
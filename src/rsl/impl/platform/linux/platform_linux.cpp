@@ -2,16 +2,516 @@
 
 #if RYTHE_PLATFORM_LINUX
 
+#include <atomic>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <new>
+
 #include <dlfcn.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <sched.h>
+#include <time.h>
 #include <pthread.h>
+#include <unistd.h>
 #include <utmpx.h>
+#include <linux/futex.h>
 #include <sys/syscall.h>
 #include <sys/prctl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+
+#include "../../threading/current_thread.hpp"
+#include "../../threading/thread.hpp"
 
 namespace rsl
 {
+	namespace
+	{
+		// Linux limits native thread names to 15 characters, the cache keeps longer names intact.
+		constexpr size_type native_thread_name_length = 16ull;
+		constexpr size_type max_thread_name_length = 64ull;
+		constexpr size_type thread_name_slot_count = 1024ull;
+
+		// Open addressing table keyed by the kernel thread id. Claiming and releasing slots is rare and happens under
+		// thread_name_lock, lookups don't take the lock. A released slot becomes a tombstone so the probe sequences
+		// running through it stay intact, and gets reused by the next claim.
+		constexpr id_type empty_thread_name_slot = 0ull;
+		constexpr id_type released_thread_name_slot = ~0ull;
+		constexpr size_type thread_name_word_count = max_thread_name_length / sizeof(uint64);
+
+		// Every field is written under a seqlock, readers copy the name out and retry if the sequence moved, so they
+		// never see a torn name or a name that belongs to the next thread to claim the slot.
+		struct thread_name_slot
+		{
+			std::atomic<uint32> sequence{0u};
+			std::atomic<id_type> threadId{empty_thread_name_slot};
+			std::atomic<size_type> length{0ull};
+			std::atomic<uint64> name[thread_name_word_count];
+		};
+
+		thread_name_slot thread_names[thread_name_slot_count];
+		pthread_mutex_t thread_name_lock = PTHREAD_MUTEX_INITIALIZER;
+
+		// Names handed out by get_thread_name, valid until the calling thread asks for the next one.
+		thread_local char thread_name_buffer[max_thread_name_length];
+
+		[[nodiscard]] size_type thread_name_slot_index(const id_type key) noexcept
+		{
+			return static_cast<size_type>((key * 0x9E3779B97F4A7C15ull) >> 54ull);
+		}
+
+		[[nodiscard]] thread_name_slot& thread_name_probe(const id_type key, const size_type probe) noexcept
+		{
+			return thread_names[(thread_name_slot_index(key) + probe) & (thread_name_slot_count - 1ull)];
+		}
+
+		// Only called with thread_name_lock held, so there is never more than one writer per slot.
+		template <typename Func>
+		void write_thread_name_slot(thread_name_slot& slot, Func&& write)
+		{
+			const uint32 sequence = slot.sequence.load(std::memory_order_relaxed);
+			slot.sequence.store(sequence + 1u, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			write();
+			slot.sequence.store(sequence + 2u, std::memory_order_release);
+		}
+
+		// Copies the name out of the slot, returns false if the slot doesn't belong to key (anymore).
+		[[nodiscard]] bool read_thread_name_slot(const thread_name_slot& slot, const id_type key, char* name, size_type& length)
+		{
+			uint64 words[thread_name_word_count];
+			while (true)
+			{
+				const uint32 sequence = slot.sequence.load(std::memory_order_acquire);
+				if (sequence & 1u)
+				{
+					sched_yield();
+					continue;
+				}
+
+				const id_type threadId = slot.threadId.load(std::memory_order_relaxed);
+				length = slot.length.load(std::memory_order_relaxed);
+				for (size_type i = 0ull; i < thread_name_word_count; i++)
+				{
+					words[i] = slot.name[i].load(std::memory_order_relaxed);
+				}
+
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+				{
+					continue;
+				}
+
+				if (threadId != key)
+				{
+					return false;
+				}
+
+				std::memcpy(name, words, length);
+				return true;
+			}
+		}
+
+		// Doesn't claim anything, looking up a name shouldn't use up a slot.
+		[[nodiscard]] bool find_thread_name(const thread_id threadId, char* name, size_type& length)
+		{
+			const id_type key = threadId.nativeId;
+			for (size_type probe = 0ull; probe < thread_name_slot_count; probe++)
+			{
+				const thread_name_slot& slot = thread_name_probe(key, probe);
+				const id_type current = slot.threadId.load(std::memory_order_acquire);
+
+				if (current == key)
+				{
+					return read_thread_name_slot(slot, key, name, length);
+				}
+
+				if (current == empty_thread_name_slot)
+				{
+					return false;
+				}
+			}
+
+			return false;
+		}
+
+		// Only called with thread_name_lock held.
+		thread_name_slot* claim_thread_name_slot(const id_type key)
+		{
+			thread_name_slot* reusable = nullptr;
+			for (size_type probe = 0ull; probe < thread_name_slot_count; probe++)
+			{
+				thread_name_slot& slot = thread_name_probe(key, probe);
+				const id_type current = slot.threadId.load(std::memory_order_relaxed);
+
+				if (current == key)
+				{
+					return &slot;
+				}
+
+				if (current == released_thread_name_slot && !reusable)
+				{
+					reusable = &slot;
+				}
+				else if (current == empty_thread_name_slot)
+				{
+					if (!reusable)
+					{
+						reusable = &slot;
+					}
+					break;
+				}
+			}
+
+			if (reusable)
+			{
+				write_thread_name_slot(
+					*reusable,
+					[&]
+					{
+						reusable->threadId.store(key, std::memory_order_relaxed);
+						reusable->length.store(0ull, std::memory_order_relaxed);
+					}
+				);
+			}
+
+			return reusable;
+		}
+
+		[[nodiscard]] bool store_thread_name(const thread_id threadId, const string_view name)
+		{
+			const size_type length = name.size() < max_thread_name_length ? name.size() : max_thread_name_length;
+			uint64 words[thread_name_word_count] = {};
+			std::memcpy(words, name.data(), length);
+
+			pthread_mutex_lock(&thread_name_lock);
+			thread_name_slot* slot = claim_thread_name_slot(threadId.nativeId);
+			if (slot)
+			{
+				write_thread_name_slot(
+					*slot,
+					[&]
+					{
+						for (size_type i = 0ull; i < thread_name_word_count; i++)
+						{
+							slot->name[i].store(words[i], std::memory_order_relaxed);
+						}
+						slot->length.store(length, std::memory_order_relaxed);
+					}
+				);
+			}
+			pthread_mutex_unlock(&thread_name_lock);
+
+			return slot != nullptr;
+		}
+
+		void release_thread_name(const thread_id threadId)
+		{
+			const id_type key = threadId.nativeId;
+
+			pthread_mutex_lock(&thread_name_lock);
+			for (size_type probe = 0ull; probe < thread_name_slot_count; probe++)
+			{
+				thread_name_slot& slot = thread_name_probe(key, probe);
+				const id_type current = slot.threadId.load(std::memory_order_relaxed);
+
+				if (current == key)
+				{
+					write_thread_name_slot(
+						slot,
+						[&]
+						{
+							slot.threadId.store(released_thread_name_slot, std::memory_order_relaxed);
+							slot.length.store(0ull, std::memory_order_relaxed);
+						}
+					);
+					break;
+				}
+
+				if (current == empty_thread_name_slot)
+				{
+					break;
+				}
+			}
+			pthread_mutex_unlock(&thread_name_lock);
+		}
+
+		// Gives the slot back once a thread that named itself exits, kernel thread ids get recycled and the table is
+		// only so large. Threads that only ever got named by others keep their slot, those are expected to be rare.
+		struct thread_name_release
+		{
+			thread_id threadId{};
+			bool named = false;
+
+			~thread_name_release()
+			{
+				if (named)
+				{
+					release_thread_name(threadId);
+				}
+			}
+		};
+
+		thread_local thread_name_release current_thread_name_release;
+
+		struct native_thread_context
+		{
+			pmu_allocator* allocator;
+			platform::native_thread_start function;
+			void* userData;
+			pthread_t handle;
+			std::atomic<id_type> nativeId{0ull};
+			std::atomic<bool> finished{false};
+			uint32 result = 0u;
+			size_type nameLength = 0ull;
+			char name[max_thread_name_length];
+		};
+
+		void* internal_native_thread_start(void* args)
+		{
+			native_thread_context& context = *static_cast<native_thread_context*>(args);
+
+			// Name the thread before publishing its id, so a name set through the thread handle isn't overwritten.
+			current_thread::set_name(string_view::from_buffer(context.name, context.nameLength));
+
+			const thread_id threadId = platform::get_current_thread_id();
+			context.nativeId.store(threadId.nativeId, std::memory_order_release);
+
+			context.result = context.function(context.userData);
+
+			context.finished.store(true, std::memory_order_release);
+			return nullptr;
+		}
+
+		static_assert(sizeof(std::atomic<uint32>) == sizeof(uint32), "Futexes operate on plain 32 bit words.");
+
+		uint32* futex_address(const std::atomic<uint32>& address)
+		{
+			return const_cast<uint32*>(reinterpret_cast<const uint32*>(&address));
+		}
+
+		// Reads a small sysfs file, the contents are cut off at the buffer size.
+		string_view read_sys_file(const cstring path, char* buffer, const size_type bufferSize)
+		{
+			const int file = open(path, O_RDONLY);
+			if (file == -1)
+			{
+				return string_view{};
+			}
+
+			const ssize_t length = read(file, buffer, bufferSize);
+			close(file);
+
+			return length > 0 ? string_view::from_buffer(buffer, static_cast<size_type>(length)) : string_view{};
+		}
+
+		size_type parse_uint(const string_view text, size_type& position)
+		{
+			size_type value = 0ull;
+			while (position < text.size() && text[position] >= '0' && text[position] <= '9')
+			{
+				value = value * 10ull + static_cast<size_type>(text[position] - '0');
+				position++;
+			}
+
+			return value;
+		}
+
+		size_type read_sys_uint(const cstring path, const size_type fallback)
+		{
+			char buffer[32];
+			const string_view text = read_sys_file(path, buffer, sizeof(buffer));
+			if (text.empty())
+			{
+				return fallback;
+			}
+
+			size_type position = 0ull;
+			const size_type value = parse_uint(text, position);
+
+			// Cache sizes are reported as "32K".
+			if (position < text.size())
+			{
+				switch (text[position])
+				{
+					case 'K': return value * 1024ull;
+					case 'M': return value * 1024ull * 1024ull;
+					case 'G': return value * 1024ull * 1024ull * 1024ull;
+					default: break;
+				}
+			}
+
+			return value;
+		}
+
+		// Parses cpu lists like "0-3,8,10-11".
+		cpu_mask read_sys_cpu_list(const cstring path)
+		{
+			cpu_mask result;
+
+			char buffer[4096];
+			const string_view text = read_sys_file(path, buffer, sizeof(buffer));
+
+			size_type position = 0ull;
+			while (position < text.size() && text[position] >= '0' && text[position] <= '9')
+			{
+				const size_type first = parse_uint(text, position);
+				size_type last = first;
+				if (position < text.size() && text[position] == '-')
+				{
+					position++;
+					last = parse_uint(text, position);
+				}
+
+				for (size_type cpu = first; cpu <= last && cpu < max_cpu_count; cpu++)
+				{
+					result.set(cpu);
+				}
+
+				if (position < text.size() && text[position] == ',')
+				{
+					position++;
+				}
+			}
+
+			return result;
+		}
+
+		void query_cpu_caches(cpu_topology& topology, const size_type cpu)
+		{
+			char path[128];
+			for (size_type index = 0ull;; index++)
+			{
+				std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%zu/cache/index%zu/shared_cpu_list", cpu, index);
+				const cpu_mask sharedCpus = read_sys_cpu_list(path);
+				if (sharedCpus.none())
+				{
+					return;
+				}
+
+				// Every cache is listed under each cpu that shares it, only its first cpu reports it.
+				if (sharedCpus.find_first_set() != cpu)
+				{
+					continue;
+				}
+
+				cpu_cache_info& cache = topology.caches.emplace_back();
+				cache.sharedCpus = sharedCpus;
+
+				std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%zu/cache/index%zu/level", cpu, index);
+				cache.level = static_cast<uint32>(read_sys_uint(path, 0ull));
+				std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%zu/cache/index%zu/size", cpu, index);
+				cache.size = read_sys_uint(path, 0ull);
+				std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%zu/cache/index%zu/coherency_line_size", cpu, index);
+				cache.lineSize = read_sys_uint(path, cache_line_size);
+				std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%zu/cache/index%zu/ways_of_associativity", cpu, index);
+				cache.associativity = static_cast<uint32>(read_sys_uint(path, 0ull));
+
+				char typeBuffer[32];
+				std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%zu/cache/index%zu/type", cpu, index);
+				const string_view type = read_sys_file(path, typeBuffer, sizeof(typeBuffer));
+				if (!type.empty() && type[0] == 'D')
+				{
+					cache.type = cpu_cache_type::data;
+				}
+				else if (!type.empty() && type[0] == 'I')
+				{
+					cache.type = cpu_cache_type::instruction;
+				}
+				else
+				{
+					cache.type = cpu_cache_type::unified;
+				}
+			}
+		}
+
+		void query_cpu_topology(cpu_topology& topology)
+		{
+			cpu_mask onlineCpus = read_sys_cpu_list("/sys/devices/system/cpu/online");
+			if (onlineCpus.none())
+			{
+				// No sysfs, assume every cpu is a core of its own.
+				for (size_type cpu = 0ull; cpu < platform::hardware_concurrency() && cpu < max_cpu_count; cpu++)
+				{
+					onlineCpus.set(cpu);
+				}
+			}
+
+			cpu_mask packages;
+			char path[128];
+			onlineCpus.for_each_set(
+				[&](const size_type cpu)
+				{
+					topology.logicalCpuCount++;
+
+					std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%zu/topology/thread_siblings_list", cpu);
+					cpu_mask siblings = read_sys_cpu_list(path);
+					if (siblings.none())
+					{
+						siblings.set(cpu);
+					}
+
+					// A physical core gets reported by its first SMT sibling.
+					if (siblings.find_first_set() == cpu)
+					{
+						cpu_core_info& core = topology.cores.emplace_back();
+						core.logicalCpus = siblings & onlineCpus;
+
+						std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%zu/topology/physical_package_id", cpu);
+						core.package = static_cast<uint32>(read_sys_uint(path, 0ull));
+						std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%zu/topology/core_id", cpu);
+						core.coreId = static_cast<uint32>(read_sys_uint(path, cpu));
+
+						if (core.package < max_cpu_count)
+						{
+							packages.set(core.package);
+						}
+					}
+
+					query_cpu_caches(topology, cpu);
+				}
+			);
+
+			topology.packageCount = static_cast<uint32>(packages.count() > 0ull ? packages.count() : 1ull);
+
+			// Insertion sort, there are only a handful of caches.
+			for (size_type i = 1ull; i < topology.caches.size(); i++)
+			{
+				for (size_type j = i; j > 0ull && topology.caches[j - 1ull].level > topology.caches[j].level; j--)
+				{
+					const cpu_cache_info temp = topology.caches[j];
+					topology.caches[j] = topology.caches[j - 1ull];
+					topology.caches[j - 1ull] = temp;
+				}
+			}
+
+			if (const cpu_cache_info* l1 = topology.find_cache(1u, cpu_cache_type::data, onlineCpus.find_first_set());
+				l1 && l1->lineSize != 0ull)
+			{
+				topology.cacheLineSize = l1->lineSize;
+			}
+		}
+
+		int native_nice_value(const thread_priority priority)
+		{
+			switch (priority)
+			{
+				case thread_priority::lowest: return 19;
+				case thread_priority::below_normal: return 10;
+				case thread_priority::normal: return 0;
+				case thread_priority::above_normal: return -5;
+				case thread_priority::highest: return -10;
+				case thread_priority::time_critical: return -20;
+			}
+
+			return 0;
+		}
+	} // namespace
+
 	dynamic_library platform::load_library(cstring path)
 	{
 		dynamic_library result;
@@ -29,12 +529,224 @@ namespace rsl
 		return dlsym(library.m_handle, symbolName);
 	}
 
+	file_handle platform::open_file(const cstring path, const bool truncate)
+	{
+		file_handle result;
+		result.m_handle = open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC | (truncate ? O_TRUNC : 0), 0644);
+		return result;
+	}
+
+	void platform::close_file(const file_handle file)
+	{
+		close(static_cast<int>(file.m_handle));
+	}
+
+	size_type platform::write_file(const file_handle file, const array_view<const string_view> buffers)
+	{
+		constexpr size_type maxBatch = 64ull;
+		iovec batch[maxBatch];
+
+		size_type total = 0ull;
+		size_type next = 0ull;
+		size_type offset = 0ull; // Bytes of buffers[next] that a previous partial write already got out.
+		while (next < buffers.size())
+		{
+			size_type count = 0ull;
+			for (size_type i = next; i < buffers.size() && count < maxBatch; i++)
+			{
+				const size_type skip = i == next ? offset : 0ull;
+				batch[count].iov_base = const_cast<char*>(buffers[i].data() + skip);
+				batch[count].iov_len = buffers[i].size() - skip;
+				count++;
+			}
+
+			const ssize_t written = writev(static_cast<int>(file.m_handle), batch, static_cast<int>(count));
+			if (written < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+				return total;
+			}
+
+			total += static_cast<size_type>(written);
+
+			// Skip past everything that made it out, a short write continues halfway through a buffer.
+			size_type remaining = static_cast<size_type>(written) + offset;
+			while (next < buffers.size() && remaining >= buffers[next].size())
+			{
+				remaining -= buffers[next].size();
+				next++;
+			}
+			offset = remaining;
+		}
+
+		return total;
+	}
+
+	bool platform::sync_file(const file_handle file)
+	{
+		return fdatasync(static_cast<int>(file.m_handle)) == 0;
+	}
+
+	uint64 platform::get_file_size(const file_handle file)
+	{
+		struct stat status;
+		if (fstat(static_cast<int>(file.m_handle), &status) != 0)
+		{
+			return 0ull;
+		}
+		return static_cast<uint64>(status.st_size);
+	}
+
+	bool platform::rename_file(const cstring oldPath, const cstring newPath)
+	{
+		return rename(oldPath, newPath) == 0;
+	}
+
+	bool platform::remove_file(const cstring path)
+	{
+		return unlink(path) == 0;
+	}
+
+	file_mapping platform::map_file(const cstring path, size_type size, const bool writable)
+	{
+		file_mapping result;
+
+		const int file = open(path, writable ? O_RDWR | O_CREAT | O_CLOEXEC : O_RDONLY | O_CLOEXEC, 0644);
+		if (file < 0)
+		{
+			return result;
+		}
+
+		struct stat status;
+		if (fstat(file, &status) != 0)
+		{
+			close(file);
+			return result;
+		}
+
+		if (size == 0ull)
+		{
+			size = static_cast<size_type>(status.st_size);
+		}
+
+		const bool tooSmall = static_cast<size_type>(status.st_size) < size;
+		if (size == 0ull || (tooSmall && (!writable || ftruncate(file, static_cast<off_t>(size)) != 0)))
+		{
+			close(file);
+			return result;
+		}
+
+		void* data = mmap(nullptr, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, file, 0);
+		// The mapping keeps the file alive on its own.
+		close(file);
+
+		if (data != MAP_FAILED)
+		{
+			result.m_data = static_cast<byte*>(data);
+			result.m_size = size;
+		}
+		return result;
+	}
+
+	void platform::unmap_file(const file_mapping mapping)
+	{
+		munmap(mapping.m_data, mapping.m_size);
+	}
+
+	bool platform::sync_mapping(const file_mapping& mapping)
+	{
+		return msync(mapping.m_data, mapping.m_size, MS_SYNC) == 0;
+	}
+
+	thread platform::create_thread(
+		const native_thread_start startFunction, void* userData, const string_view name, pmu_allocator& allocator
+	)
+	{
+		rsl_assert_always(startFunction);
+
+		thread result;
+
+		native_thread_context* threadContext = allocator.allocate<native_thread_context>();
+		if (!threadContext)
+		{
+			return result;
+		}
+
+		new (threadContext) native_thread_context();
+
+		threadContext->allocator = &allocator;
+		threadContext->function = startFunction;
+		threadContext->userData = userData;
+		threadContext->nameLength = name.size() < max_thread_name_length ? name.size() : max_thread_name_length;
+		for (size_type i = 0ull; i < threadContext->nameLength; i++)
+		{
+			threadContext->name[i] = name[i];
+		}
+
+		if (pthread_create(&threadContext->handle, nullptr, &internal_native_thread_start, threadContext) != 0)
+		{
+			threadContext->~native_thread_context();
+			allocator.deallocate(threadContext);
+			return result;
+		}
+
+		result.m_handle = threadContext;
+		return result;
+	}
+
+	uint32 platform::destroy_thread(const thread thread)
+	{
+		native_thread_context* context = static_cast<native_thread_context*>(thread.m_handle);
+		if (!context)
+		{
+			return 0u;
+		}
+
+		pthread_join(context->handle, nullptr);
+
+		const uint32 result = context->result;
+		pmu_allocator* allocator = context->allocator;
+
+		context->~native_thread_context();
+		allocator->deallocate(context);
+
+		return result;
+	}
+
+	bool platform::is_thread_active(const thread thread)
+	{
+		const native_thread_context* context = static_cast<native_thread_context*>(thread.m_handle);
+		return context && !context->finished.load(std::memory_order_acquire);
+	}
+
 	thread_id platform::get_current_thread_id()
 	{
         // return thread_id{ .nativeId = static_cast<id_type>(syscall( SYS_gettid ) );
 		return thread_id{ .nativeId = static_cast<id_type>(gettid()) };
 	}
 
+	thread_id platform::get_thread_id(const thread thread)
+	{
+		const native_thread_context* context = static_cast<native_thread_context*>(thread.m_handle);
+		if (!context)
+		{
+			return thread_id{.nativeId = 0ull};
+		}
+
+		// The kernel id is only known once the thread has started running.
+		id_type nativeId = context->nativeId.load(std::memory_order_acquire);
+		while (nativeId == 0ull)
+		{
+			sched_yield();
+			nativeId = context->nativeId.load(std::memory_order_acquire);
+		}
+
+		return thread_id{.nativeId = nativeId};
+	}
+
 	void platform::yield_current_thread()
 	{
 		sched_yield();
@@ -65,6 +777,207 @@ namespace rsl
 			sleepTime = remainingTime;
 		}
 	}
+
+	void platform::sleep_current_thread_until(const std::chrono::steady_clock::time_point deadline)
+	{
+		// steady_clock is CLOCK_MONOTONIC, an absolute deadline doesn't drift when the sleep gets interrupted.
+		const int64 nanoseconds =
+			std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+		if (nanoseconds <= 0)
+		{
+			return;
+		}
+
+		timespec deadlineTime;
+		deadlineTime.tv_sec = static_cast<time_t>(nanoseconds / 1000000000ll);
+		deadlineTime.tv_nsec = static_cast<long>(nanoseconds % 1000000000ll);
+
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadlineTime, nullptr) == EINTR)
+		{
+		}
+	}
+
+	void platform::wait_on_address(const std::atomic<uint32>& address, const uint32 expected)
+	{
+		// EAGAIN when the value already changed and EINTR on signals both just mean the caller re-checks.
+		syscall(SYS_futex, futex_address(address), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+	}
+
+	void platform::wait_on_address(
+		const std::atomic<uint32>& address, const uint32 expected, const std::chrono::nanoseconds timeout
+	)
+	{
+		if (timeout <= std::chrono::nanoseconds::zero())
+		{
+			return;
+		}
+
+		// FUTEX_WAIT takes a relative timeout, ETIMEDOUT is just another reason for the caller to re-check.
+		timespec relativeTimeout;
+		relativeTimeout.tv_sec = static_cast<time_t>(timeout.count() / 1000000000ll);
+		relativeTimeout.tv_nsec = static_cast<long>(timeout.count() % 1000000000ll);
+		syscall(SYS_futex, futex_address(address), FUTEX_WAIT_PRIVATE, expected, &relativeTimeout, nullptr, 0);
+	}
+
+	void platform::wake_one_on_address(std::atomic<uint32>& address)
+	{
+		syscall(SYS_futex, futex_address(address), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+	}
+
+	void platform::wake_all_on_address(std::atomic<uint32>& address)
+	{
+		syscall(SYS_futex, futex_address(address), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+	}
+
+	void platform::set_thread_name(const thread thread, const string_view name)
+	{
+		native_thread_context* context = static_cast<native_thread_context*>(thread.m_handle);
+		if (!context)
+		{
+			return;
+		}
+
+		char nativeName[native_thread_name_length];
+		const size_type nativeLength = name.size() < native_thread_name_length ? name.size() : native_thread_name_length - 1ull;
+		for (size_type i = 0ull; i < nativeLength; i++)
+		{
+			nativeName[i] = name[i];
+		}
+		nativeName[nativeLength] = '\0';
+
+		pthread_setname_np(context->handle, nativeName);
+
+		[[maybe_unused]] const bool stored = store_thread_name(get_thread_id(thread), name);
+		rsl_assert_rarely(stored);
+	}
+
+	void platform::set_thread_name(const thread_id threadId, const string_view name)
+	{
+		char nativeName[native_thread_name_length];
+		const size_type nativeLength = name.size() < native_thread_name_length ? name.size() : native_thread_name_length - 1ull;
+		for (size_type i = 0ull; i < nativeLength; i++)
+		{
+			nativeName[i] = name[i];
+		}
+		nativeName[nativeLength] = '\0';
+
+		if (threadId == get_current_thread_id())
+		{
+			pthread_setname_np(pthread_self(), nativeName);
+			current_thread_name_release.threadId = threadId;
+			current_thread_name_release.named = true;
+		}
+		else
+		{
+			// Threads that weren't created through rsl don't have a pthread handle we know of.
+			char path[64];
+			std::snprintf(path, sizeof(path), "/proc/self/task/%llu/comm", static_cast<unsigned long long>(threadId.nativeId));
+			if (const int file = open(path, O_WRONLY); file != -1)
+			{
+				[[maybe_unused]] const ssize_t written = write(file, nativeName, nativeLength);
+				close(file);
+			}
+		}
+
+		[[maybe_unused]] const bool stored = store_thread_name(threadId, name);
+		rsl_assert_rarely(stored);
+	}
+
+	string_view platform::get_thread_name(const thread thread)
+	{
+		return get_thread_name(get_thread_id(thread));
+	}
+
+	string_view platform::get_thread_name(const thread_id threadId)
+	{
+		size_type length = 0ull;
+		if (find_thread_name(threadId, thread_name_buffer, length) && length != 0ull)
+		{
+			return string_view::from_buffer(thread_name_buffer, length);
+		}
+
+		// Unnamed threads are named after their id, same as on Windows.
+		const int idLength = std::snprintf(
+			thread_name_buffer, sizeof(thread_name_buffer), "%llu", static_cast<unsigned long long>(threadId.nativeId)
+		);
+		return string_view::from_buffer(thread_name_buffer, static_cast<size_type>(idLength));
+	}
+
+	bool platform::set_thread_affinity(const thread thread, const cpu_mask& mask)
+	{
+		return set_thread_affinity(get_thread_id(thread), mask);
+	}
+
+	bool platform::set_thread_affinity(const thread_id threadId, const cpu_mask& mask)
+	{
+		cpu_set_t nativeMask;
+		CPU_ZERO(&nativeMask);
+		mask.for_each_set(
+			[&](const size_type cpu)
+			{
+				if (cpu < CPU_SETSIZE)
+				{
+					CPU_SET(cpu, &nativeMask);
+				}
+			}
+		);
+
+		return sched_setaffinity(static_cast<pid_t>(threadId.nativeId), sizeof(nativeMask), &nativeMask) == 0;
+	}
+
+	bool platform::set_thread_priority(const thread thread, const thread_priority priority)
+	{
+		return set_thread_priority(get_thread_id(thread), priority);
+	}
+
+	bool platform::set_thread_priority(const thread_id threadId, const thread_priority priority)
+	{
+		const pid_t nativeId = static_cast<pid_t>(threadId.nativeId);
+
+		if (priority == thread_priority::time_critical)
+		{
+			sched_param parameters{};
+			parameters.sched_priority = sched_get_priority_min(SCHED_FIFO);
+			return sched_setscheduler(nativeId, SCHED_FIFO, &parameters) == 0;
+		}
+
+		// Drop out of real-time scheduling in case the thread was time critical before.
+		if (sched_getscheduler(nativeId) != SCHED_OTHER)
+		{
+			sched_param parameters{};
+			if (sched_setscheduler(nativeId, SCHED_OTHER, &parameters) != 0)
+			{
+				return false;
+			}
+		}
+
+		// On Linux nice values are per thread when given a thread id.
+		return setpriority(PRIO_PROCESS, static_cast<id_t>(nativeId), native_nice_value(priority)) == 0;
+	}
+
+	uint32 platform::hardware_concurrency()
+	{
+		cpu_set_t allowedCpus;
+		if (sched_getaffinity(0, sizeof(allowedCpus), &allowedCpus) == 0)
+		{
+			return static_cast<uint32>(CPU_COUNT(&allowedCpus));
+		}
+
+		const long onlineCpus = sysconf(_SC_NPROCESSORS_ONLN);
+		return onlineCpus > 0 ? static_cast<uint32>(onlineCpus) : 1u;
+	}
+
+	const cpu_topology& platform::get_cpu_topology()
+	{
+		static const cpu_topology topology = []()
+		{
+			cpu_topology result;
+			query_cpu_topology(result);
+			return result;
+		}();
+
+		return topology;
+	}
 } // namespace rsl
 
 #endif
@@ -1,13 +1,21 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+
+#include "../containers/views.hpp"
+#include "../memory/allocator_context.hpp"
 #include "../util/common.hpp"
 #include "../util/primitives.hpp"
 
 #include "../threading/thread_id.hpp"
+#include "cpu_topology.hpp"
 
 namespace rsl
 {
 	class dynamic_library;
+	class file_handle;
+	class file_mapping;
 	class thread;
 
 	class platform
@@ -20,6 +28,27 @@ namespace rsl
 
 		static void* get_symbol(dynamic_library library, cstring symbolName);
 
+		// Opens path for appending and creates it when missing, truncate empties an existing file. Open files can still
+		// be renamed or removed.
+		static file_handle open_file(cstring path, bool truncate = false);
+		static void close_file(file_handle file);
+		// Writes all buffers in order, with a single system call where the platform supports gathered writes. Returns
+		// the amount of bytes written, which is less than the size of all buffers together if a write failed.
+		static size_type write_file(file_handle file, array_view<const string_view> buffers);
+		// Blocks until the written data reached the storage device.
+		static bool sync_file(file_handle file);
+		static uint64 get_file_size(file_handle file);
+		// Replaces an existing file at newPath.
+		static bool rename_file(cstring oldPath, cstring newPath);
+		static bool remove_file(cstring path);
+
+		// Maps the file at path into memory, shared with the file so writes end up in it even if the process dies.
+		// Writable mappings create the file and grow it to size, read only mappings with size 0 cover the whole file.
+		static file_mapping map_file(cstring path, size_type size, bool writable);
+		static void unmap_file(file_mapping mapping);
+		// Blocks until changes made through the mapping reached the storage device.
+		static bool sync_mapping(const file_mapping& mapping);
+
 		static thread create_thread(native_thread_start startFunction, void* userData = nullptr, string_view name = "unknown thread"_sv, pmu_allocator& allocator = *allocator_context::globalAllocator);
 		static uint32 destroy_thread(thread thread);
 
@@ -29,11 +58,35 @@ namespace rsl
 		static thread_id get_thread_id(thread thread);
 		static void yield_current_thread();
 		static void sleep_current_thread(uint32 milliseconds);
+		// Sleeps until std::chrono::steady_clock reaches deadline, with the resolution of the OS timers instead of whole
+		// milliseconds. Still wakes up late by however long the scheduler takes to get back to the thread.
+		static void sleep_current_thread_until(std::chrono::steady_clock::time_point deadline);
+
+		// Puts the calling thread to sleep as long as address still holds expected, may return spuriously.
+		static void wait_on_address(const std::atomic<uint32>& address, uint32 expected);
+		// Same as above but gives up after timeout.
+		static void wait_on_address(const std::atomic<uint32>& address, uint32 expected, std::chrono::nanoseconds timeout);
+		static void wake_one_on_address(std::atomic<uint32>& address);
+		static void wake_all_on_address(std::atomic<uint32>& address);
 
 		static void set_thread_name(thread thread, string_view name);
 		static void set_thread_name(thread_id threadId, string_view name);
+		// The name is copied out for the calling thread and stays valid until it asks for the next thread name.
 		static string_view get_thread_name(thread thread);
 		static string_view get_thread_name(thread_id threadId);
+
+		// Restricts the thread to the logical cpus in mask, returns false if the OS refused.
+		static bool set_thread_affinity(thread thread, const cpu_mask& mask);
+		static bool set_thread_affinity(thread_id threadId, const cpu_mask& mask);
+		// Raising priority above normal usually needs elevated privileges, returns false if the OS refused.
+		static bool set_thread_priority(thread thread, thread_priority priority);
+		static bool set_thread_priority(thread_id threadId, thread_priority priority);
+
+		// Amount of logical cpus this process is allowed to run on. Queried on every call, so changes to the affinity of
+		// the process show up, but it's a system call.
+		static uint32 hardware_concurrency();
+		// Queried once on first use.
+		static const cpu_topology& get_cpu_topology();
 	};
 
 #if !defined(RYTHE_DYNAMIC_LIBRARY_HANDLE_IMPL)
@@ -68,4 +121,36 @@ namespace rsl
 
 		friend class platform;
 	};
+
+	class file_handle
+	{
+	public:
+		operator bool() const { return m_handle != invalid_handle; }
+
+	private:
+		// Holds the file descriptor or the HANDLE, both platforms use -1 for invalid handles.
+		constexpr static diff_type invalid_handle = -1;
+
+		diff_type m_handle = invalid_handle;
+
+		friend class platform;
+	};
+
+	class file_mapping
+	{
+	public:
+		operator bool() const { return m_data; }
+
+		[[nodiscard]] byte* data() const noexcept { return m_data; }
+		[[nodiscard]] size_type size() const noexcept { return m_size; }
+
+	private:
+		byte* m_data = nullptr;
+		size_type m_size = 0ull;
+		// Only used on Windows, which needs the file and the mapping object to stay open for flushes and unmapping.
+		diff_type m_fileHandle = -1;
+		diff_type m_mappingHandle = -1;
+
+		friend class platform;
+	};
 } // namespace rsl
@@ -13,8 +13,14 @@
 #include <libloaderapi.h>
 #include <windef.h>
 #include <winbase.h>
+#include <fileapi.h>
+#include <memoryapi.h>
 #include <processthreadsapi.h>
+#include <sysinfoapi.h>
 #include <process.h>
+#include <synchapi.h>
+
+#pragma comment(lib, "Synchronization.lib")
 
 #define RYTHE_DYNAMIC_LIBRARY_HANDLE_IMPL HMODULE
 #include "../platform.hpp"
@@ -45,6 +51,117 @@ namespace rsl
 			void* userData;
 		};
 
+		int native_thread_priority(const thread_priority priority)
+		{
+			switch (priority)
+			{
+				case thread_priority::lowest: return THREAD_PRIORITY_LOWEST;
+				case thread_priority::below_normal: return THREAD_PRIORITY_BELOW_NORMAL;
+				case thread_priority::normal: return THREAD_PRIORITY_NORMAL;
+				case thread_priority::above_normal: return THREAD_PRIORITY_ABOVE_NORMAL;
+				case thread_priority::highest: return THREAD_PRIORITY_HIGHEST;
+				case thread_priority::time_critical: return THREAD_PRIORITY_TIME_CRITICAL;
+			}
+
+			return THREAD_PRIORITY_NORMAL;
+		}
+
+		cpu_mask to_cpu_mask(const KAFFINITY affinity)
+		{
+			cpu_mask result;
+			for (size_type cpu = 0ull; cpu < sizeof(KAFFINITY) * 8ull; cpu++)
+			{
+				if (affinity & (static_cast<KAFFINITY>(1) << cpu))
+				{
+					result.set(cpu);
+				}
+			}
+
+			return result;
+		}
+
+		// Only covers the first processor group, same as the affinity functions.
+		void query_cpu_topology(cpu_topology& topology)
+		{
+			DWORD bufferSize = 0u;
+			::GetLogicalProcessorInformation(nullptr, &bufferSize);
+
+			dynamic_array<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> entries;
+			entries.resize(bufferSize / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+			if (entries.empty() || !::GetLogicalProcessorInformation(entries.data(), &bufferSize))
+			{
+				cpu_core_info& core = topology.cores.emplace_back();
+				core.logicalCpus.set(0ull);
+				topology.logicalCpuCount = 1u;
+				topology.packageCount = 1u;
+				return;
+			}
+
+			cpu_mask logicalCpus;
+			for (const SYSTEM_LOGICAL_PROCESSOR_INFORMATION& entry : entries)
+			{
+				switch (entry.Relationship)
+				{
+					case RelationProcessorCore:
+					{
+						cpu_core_info& core = topology.cores.emplace_back();
+						core.coreId = static_cast<uint32>(topology.cores.size() - 1ull);
+						core.logicalCpus = to_cpu_mask(entry.ProcessorMask);
+						logicalCpus |= core.logicalCpus;
+						break;
+					}
+					case RelationProcessorPackage:
+					{
+						const cpu_mask packageCpus = to_cpu_mask(entry.ProcessorMask);
+						for (cpu_core_info& core : topology.cores)
+						{
+							if (core.logicalCpus.intersects(packageCpus))
+							{
+								core.package = topology.packageCount;
+							}
+						}
+						topology.packageCount++;
+						break;
+					}
+					case RelationCache:
+					{
+						cpu_cache_info& cache = topology.caches.emplace_back();
+						cache.level = entry.Cache.Level;
+						cache.size = entry.Cache.Size;
+						cache.lineSize = entry.Cache.LineSize;
+						cache.associativity = entry.Cache.Associativity;
+						cache.sharedCpus = to_cpu_mask(entry.ProcessorMask);
+						switch (entry.Cache.Type)
+						{
+							case CacheData: cache.type = cpu_cache_type::data; break;
+							case CacheInstruction: cache.type = cpu_cache_type::instruction; break;
+							default: cache.type = cpu_cache_type::unified; break;
+						}
+						break;
+					}
+					default: break;
+				}
+			}
+
+			topology.logicalCpuCount = static_cast<uint32>(logicalCpus.count());
+			topology.packageCount = topology.packageCount > 0u ? topology.packageCount : 1u;
+
+			for (size_type i = 1ull; i < topology.caches.size(); i++)
+			{
+				for (size_type j = i; j > 0ull && topology.caches[j - 1ull].level > topology.caches[j].level; j--)
+				{
+					const cpu_cache_info temp = topology.caches[j];
+					topology.caches[j] = topology.caches[j - 1ull];
+					topology.caches[j - 1ull] = temp;
+				}
+			}
+
+			if (const cpu_cache_info* l1 = topology.find_cache(1u, cpu_cache_type::data); l1 && l1->lineSize != 0ull)
+			{
+				topology.cacheLineSize = l1->lineSize;
+			}
+		}
+
 		DWORD internal_native_thread_start(void* args)
 		{
 			native_thread_context& context = *static_cast<native_thread_context*>(args);
@@ -78,6 +195,142 @@ namespace rsl
 		return bit_cast<void*>(::GetProcAddress(library.m_handle, symbolName));
 	}
 
+	file_handle platform::open_file(const cstring path, const bool truncate)
+	{
+		// FILE_SHARE_DELETE keeps the file renameable while it's open, the same as on posix.
+		const HANDLE handle = ::CreateFileA(
+			path, FILE_APPEND_DATA, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+			truncate ? CREATE_ALWAYS : OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr
+		);
+
+		file_handle result;
+		result.m_handle = reinterpret_cast<diff_type>(handle);
+		return result;
+	}
+
+	void platform::close_file(const file_handle file)
+	{
+		::CloseHandle(reinterpret_cast<HANDLE>(file.m_handle));
+	}
+
+	size_type platform::write_file(const file_handle file, const array_view<const string_view> buffers)
+	{
+		// WriteFileGather only works on unbuffered files with page aligned buffers, so each buffer is its own call.
+		size_type total = 0ull;
+		for (const string_view buffer : buffers)
+		{
+			size_type offset = 0ull;
+			while (offset < buffer.size())
+			{
+				DWORD written = 0;
+				constexpr size_type maxChunk = 0x40000000ull;
+				const size_type remaining = buffer.size() - offset;
+				const DWORD toWrite = static_cast<DWORD>(remaining < maxChunk ? remaining : maxChunk);
+				if (!::WriteFile(reinterpret_cast<HANDLE>(file.m_handle), buffer.data() + offset, toWrite, &written, nullptr))
+				{
+					return total + offset;
+				}
+				offset += written;
+			}
+			total += offset;
+		}
+
+		return total;
+	}
+
+	bool platform::sync_file(const file_handle file)
+	{
+		return ::FlushFileBuffers(reinterpret_cast<HANDLE>(file.m_handle));
+	}
+
+	uint64 platform::get_file_size(const file_handle file)
+	{
+		LARGE_INTEGER size;
+		if (!::GetFileSizeEx(reinterpret_cast<HANDLE>(file.m_handle), &size))
+		{
+			return 0ull;
+		}
+		return static_cast<uint64>(size.QuadPart);
+	}
+
+	bool platform::rename_file(const cstring oldPath, const cstring newPath)
+	{
+		return ::MoveFileExA(oldPath, newPath, MOVEFILE_REPLACE_EXISTING);
+	}
+
+	bool platform::remove_file(const cstring path)
+	{
+		return ::DeleteFileA(path);
+	}
+
+	file_mapping platform::map_file(const cstring path, size_type size, const bool writable)
+	{
+		file_mapping result;
+
+		const HANDLE file = ::CreateFileA(
+			path, writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+			FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, writable ? OPEN_ALWAYS : OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL, nullptr
+		);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			return result;
+		}
+
+		LARGE_INTEGER fileSize;
+		if (!::GetFileSizeEx(file, &fileSize))
+		{
+			::CloseHandle(file);
+			return result;
+		}
+
+		if (size == 0ull)
+		{
+			size = static_cast<size_type>(fileSize.QuadPart);
+		}
+
+		// Creating a writable mapping larger than the file grows the file.
+		const bool tooSmall = static_cast<size_type>(fileSize.QuadPart) < size;
+		const HANDLE mapping = size == 0ull || (tooSmall && !writable)
+								   ? nullptr
+								   : ::CreateFileMappingA(
+										 file, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY,
+										 static_cast<DWORD>(size >> 32ull), static_cast<DWORD>(size & 0xFFFFFFFFull), nullptr
+									 );
+		if (!mapping)
+		{
+			::CloseHandle(file);
+			return result;
+		}
+
+		void* data = ::MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size);
+		if (!data)
+		{
+			::CloseHandle(mapping);
+			::CloseHandle(file);
+			return result;
+		}
+
+		result.m_data = static_cast<byte*>(data);
+		result.m_size = size;
+		result.m_fileHandle = reinterpret_cast<diff_type>(file);
+		result.m_mappingHandle = reinterpret_cast<diff_type>(mapping);
+		return result;
+	}
+
+	void platform::unmap_file(const file_mapping mapping)
+	{
+		::UnmapViewOfFile(mapping.m_data);
+		::CloseHandle(reinterpret_cast<HANDLE>(mapping.m_mappingHandle));
+		::CloseHandle(reinterpret_cast<HANDLE>(mapping.m_fileHandle));
+	}
+
+	bool platform::sync_mapping(const file_mapping& mapping)
+	{
+		return ::FlushViewOfFile(mapping.m_data, mapping.m_size) &&
+			   ::FlushFileBuffers(reinterpret_cast<HANDLE>(mapping.m_fileHandle));
+	}
+
 	thread platform::create_thread(const native_thread_start startFunction, void* userData, string_view name,
 	                               pmu_allocator& allocator)
 	{
@@ -163,6 +416,65 @@ namespace rsl
 		::Sleep(milliseconds);
 	}
 
+	void platform::sleep_current_thread_until(const std::chrono::steady_clock::time_point deadline)
+	{
+		// High resolution waitable timers wake up with sub-millisecond precision, Sleep rounds to the system tick.
+		thread_local HANDLE timer = ::CreateWaitableTimerExW(
+			nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_MODIFY_STATE | SYNCHRONIZE
+		);
+
+		const auto remaining = deadline - std::chrono::steady_clock::now();
+		if (remaining <= std::chrono::steady_clock::duration::zero())
+		{
+			return;
+		}
+
+		// Negative due times are relative, in 100 nanosecond units.
+		const int64 ticks = std::chrono::duration_cast<std::chrono::duration<int64, std::ratio<1, 10000000>>>(remaining).count();
+		LARGE_INTEGER dueTime;
+		dueTime.QuadPart = -(ticks > 0 ? ticks : 1);
+
+		if (timer && ::SetWaitableTimer(timer, &dueTime, 0, nullptr, nullptr, FALSE))
+		{
+			::WaitForSingleObject(timer, INFINITE);
+		}
+		else
+		{
+			::Sleep(static_cast<DWORD>(std::chrono::ceil<std::chrono::milliseconds>(remaining).count()));
+		}
+	}
+
+	void platform::wait_on_address(const std::atomic<uint32>& address, uint32 expected)
+	{
+		::WaitOnAddress(const_cast<std::atomic<uint32>*>(&address), &expected, sizeof(uint32), INFINITE);
+	}
+
+	void platform::wait_on_address(
+		const std::atomic<uint32>& address, uint32 expected, const std::chrono::nanoseconds timeout
+	)
+	{
+		if (timeout <= std::chrono::nanoseconds::zero())
+		{
+			return;
+		}
+
+		// WaitOnAddress only takes whole milliseconds, round up so short timeouts still wait.
+		const auto milliseconds = std::chrono::ceil<std::chrono::milliseconds>(timeout).count();
+		::WaitOnAddress(
+			const_cast<std::atomic<uint32>*>(&address), &expected, sizeof(uint32), static_cast<DWORD>(milliseconds)
+		);
+	}
+
+	void platform::wake_one_on_address(std::atomic<uint32>& address)
+	{
+		::WakeByAddressSingle(&address);
+	}
+
+	void platform::wake_all_on_address(std::atomic<uint32>& address)
+	{
+		::WakeByAddressAll(&address);
+	}
+
 	void platform::set_thread_name(const thread thread, const string_view name)
 	{
 		set_thread_name(thread.get_id(), name);
@@ -192,6 +504,59 @@ namespace rsl
 
 		return thread_names.emplace(threadId, rsl::move(nativeThreadName) ).name;
 	}
+
+	bool platform::set_thread_affinity(const thread thread, const cpu_mask& mask)
+	{
+		return ::SetThreadAffinityMask(thread.m_handle, static_cast<DWORD_PTR>(mask.data()[0])) != 0;
+	}
+
+	bool platform::set_thread_affinity(const thread_id threadId, const cpu_mask& mask)
+	{
+		const HANDLE handle = ::OpenThread(THREAD_SET_INFORMATION | THREAD_QUERY_INFORMATION, FALSE, static_cast<DWORD>(threadId.nativeId));
+		if (!handle)
+		{
+			return false;
+		}
+
+		const bool result = ::SetThreadAffinityMask(handle, static_cast<DWORD_PTR>(mask.data()[0])) != 0;
+		::CloseHandle(handle);
+		return result;
+	}
+
+	bool platform::set_thread_priority(const thread thread, const thread_priority priority)
+	{
+		return ::SetThreadPriority(thread.m_handle, native_thread_priority(priority)) != 0;
+	}
+
+	bool platform::set_thread_priority(const thread_id threadId, const thread_priority priority)
+	{
+		const HANDLE handle = ::OpenThread(THREAD_SET_INFORMATION, FALSE, static_cast<DWORD>(threadId.nativeId));
+		if (!handle)
+		{
+			return false;
+		}
+
+		const bool result = ::SetThreadPriority(handle, native_thread_priority(priority)) != 0;
+		::CloseHandle(handle);
+		return result;
+	}
+
+	uint32 platform::hardware_concurrency()
+	{
+		return static_cast<uint32>(::GetActiveProcessorCount(ALL_PROCESSOR_GROUPS));
+	}
+
+	const cpu_topology& platform::get_cpu_topology()
+	{
+		static const cpu_topology topology = []()
+		{
+			cpu_topology result;
+			query_cpu_topology(result);
+			return result;
+		}();
+
+		return topology;
+	}
 } // namespace rsl
 
 #endif
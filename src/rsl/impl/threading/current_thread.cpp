@@ -1,17 +1,76 @@
 ﻿#include "current_thread.hpp"
 
+#include <mutex>
+
+#include "../containers/array.hpp"
 #include "../platform/platform.hpp"
+#include "../util/atomic.hpp"
+#include "mutex.hpp"
 
 namespace rsl::current_thread
 {
-	void yield()
+	namespace
 	{
-		platform::yield_current_thread();
-	}
+		struct thread_index_registry
+		{
+			mutex lock;
+			size_type nextIndex = 0ull;
+			dynamic_array<size_type> freeIndices;
+
+			[[nodiscard]] static thread_index_registry& get()
+			{
+				// Leaked on purpose, threads that exit during static destruction still hand their index back.
+				static thread_index_registry* registry = new thread_index_registry();
+				return *registry;
+			}
+		};
+
+		struct thread_index_holder
+		{
+			~thread_index_holder()
+			{
+				if (internal::threadIndex != npos)
+				{
+					thread_index_registry& registry = thread_index_registry::get();
+					std::lock_guard guard(registry.lock);
+					registry.freeIndices.push_back(internal::threadIndex);
+					internal::threadIndex = npos;
+				}
+			}
+		};
+
+		// Only exists to hand the index back when the thread exits.
+		thread_local thread_index_holder threadIndexHolder;
+
+		using steady_clock = std::chrono::steady_clock;
 
-	thread_id get_id()
+		// Bounds of the precise sleep margin, it starts out around the default timer slack plus wake-up latency of Linux.
+		constexpr int64 min_sleep_margin = 20000;
+		constexpr int64 max_sleep_margin = 20000000;
+		constexpr int64 initial_sleep_margin = 200000;
+
+		// Closer to the deadline than this spinning uses pause instructions instead of yielding the core.
+		constexpr auto pause_spin_window = std::chrono::microseconds(20);
+		constexpr uint32 pause_spin_count = 16u;
+
+		// In nanoseconds, shared by all threads since they all wake up through the same scheduler.
+		atomic<int64> sleepMargin(initial_sleep_margin);
+
+		void update_sleep_margin(const int64 margin, const int64 late) noexcept
+		{
+			// Jumps up as soon as a sleep woke up later than the margin allowed for and creeps back down slowly, so an
+			// occasional slow wake-up doesn't keep the margin high.
+			const int64 observed = late + late / 4;
+			int64 next = observed > margin ? observed : margin - (margin - observed) / 16;
+			next = next < min_sleep_margin ? min_sleep_margin : next;
+			next = next > max_sleep_margin ? max_sleep_margin : next;
+			sleepMargin.store(next, memory_order::relaxed);
+		}
+	} // namespace
+
+	void yield()
 	{
-		return platform::get_current_thread_id();
+		platform::yield_current_thread();
 	}
 
 	string_view get_name()
@@ -23,4 +82,92 @@ namespace rsl::current_thread
 	{
 		platform::set_thread_name(get_id(), name);
 	}
+
+	namespace internal
+	{
+		constinit thread_local size_type threadIndex = npos;
+		// No OS hands out 0 as a thread id.
+		constinit thread_local thread_id cachedThreadId{};
+
+		thread_id cache_thread_id()
+		{
+			cachedThreadId = platform::get_current_thread_id();
+			return cachedThreadId;
+		}
+
+		size_type acquire_thread_index()
+		{
+			// Touching the holder registers its destructor for this thread.
+			[[maybe_unused]] thread_index_holder& holder = threadIndexHolder;
+
+			thread_index_registry& registry = thread_index_registry::get();
+			std::lock_guard guard(registry.lock);
+
+			size_type index;
+			if (registry.freeIndices.empty())
+			{
+				index = registry.nextIndex++;
+			}
+			else
+			{
+				// Lowest free index first keeps the indices in use packed.
+				size_type* lowest = registry.freeIndices.data();
+				for (size_type& candidate : registry.freeIndices)
+				{
+					if (candidate < *lowest)
+					{
+						lowest = &candidate;
+					}
+				}
+
+				index = *lowest;
+				*lowest = registry.freeIndices.back();
+				registry.freeIndices.pop_back();
+			}
+
+			threadIndex = index;
+			return index;
+		}
+
+		void sleep_until(const steady_clock::time_point deadline)
+		{
+			platform::sleep_current_thread_until(deadline);
+		}
+
+		void precise_sleep_until(const steady_clock::time_point deadline)
+		{
+			const int64 margin = sleepMargin.load(memory_order::relaxed);
+			const steady_clock::time_point wakeTarget = deadline - std::chrono::nanoseconds(margin);
+
+			if (steady_clock::now() < wakeTarget)
+			{
+				platform::sleep_current_thread_until(wakeTarget);
+				const auto late = steady_clock::now() - wakeTarget;
+				update_sleep_margin(margin, std::chrono::duration_cast<std::chrono::nanoseconds>(late).count());
+			}
+
+			// With a single cpu spinning would keep whatever else has to run off the core.
+			static const bool canPause = platform::hardware_concurrency() > 1u;
+
+			for (steady_clock::time_point now = steady_clock::now(); now < deadline; now = steady_clock::now())
+			{
+				if (!canPause || deadline - now > pause_spin_window)
+				{
+					platform::yield_current_thread();
+					continue;
+				}
+
+				for (uint32 i = 0u; i < pause_spin_count; i++)
+				{
+					rythe_pause_instruction();
+				}
+			}
+		}
+	} // namespace internal
+
+	time::span<time64> precise_sleep_margin()
+	{
+		return time::span<time64>(std::chrono::nanoseconds(sleepMargin.load(memory_order::relaxed)));
+	}
 }
+
@@ -8,16 +8,49 @@
 namespace rsl::current_thread
 {
     void yield();
-    thread_id get_id();
+    // Cached per thread, only the first call asks the OS.
+    [[rythe_always_inline]] thread_id get_id();
 
+	// Sleeps through the OS with nanosecond resolution, wakes up late by the scheduler latency.
 	template <time::duration_rep Precision = time32>
 	void sleep_for(time::span<Precision> duration);
 
 	template <time::duration_rep Precision = time32, time::clock_type ClockType = time::timer32::clock_type>
 	void sleep_until(time::point<Precision, ClockType> timepoint);
 
+	// Sleeps through the OS until the calibrated wake-up margin before the deadline and spins for the rest, wakes up
+	// within microseconds of it. Keeps the core busy for the last stretch, meant for fixed rate loops.
+	template <time::duration_rep Precision = time32>
+	void precise_sleep_for(time::span<Precision> duration);
+
+	template <time::duration_rep Precision = time32, time::clock_type ClockType = time::timer32::clock_type>
+	void precise_sleep_until(time::point<Precision, ClockType> timepoint);
+
+	// How long before a deadline precise sleeps stop sleeping and start spinning. Follows how late OS sleeps wake up.
+	time::span<time64> precise_sleep_margin();
+
 	string_view get_name();
 	void set_name(string_view name);
+
+	// Small index that is unique among the threads alive right now. Handed out on first use and reused once the
+	// thread exits, so indices stay below the highest amount of threads that used them at the same time.
+	[[rythe_always_inline]] size_type get_index();
+
+	namespace internal
+	{
+		// Constant initialized so reading it compiles to a plain thread local load.
+		extern constinit thread_local size_type threadIndex;
+		size_type acquire_thread_index();
+
+		extern constinit thread_local thread_id cachedThreadId;
+		thread_id cache_thread_id();
+
+		void sleep_until(std::chrono::steady_clock::time_point deadline);
+		void precise_sleep_until(std::chrono::steady_clock::time_point deadline);
+
+		template <time::clock_type ClockType>
+		[[nodiscard]] std::chrono::steady_clock::time_point to_steady_deadline(typename ClockType::duration sinceEpoch);
+	}
 }
 
 #include "current_thread.inl"
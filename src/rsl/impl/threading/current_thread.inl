@@ -4,15 +4,64 @@
 
 namespace rsl::current_thread
 {
+	inline thread_id get_id()
+	{
+		const thread_id cached = internal::cachedThreadId;
+		return cached.nativeId != 0ull ? cached : internal::cache_thread_id();
+	}
+
+	inline size_type get_index()
+	{
+		const size_type index = internal::threadIndex;
+		return index != npos ? index : internal::acquire_thread_index();
+	}
+
+	namespace internal
+	{
+		template <time::clock_type ClockType>
+		std::chrono::steady_clock::time_point to_steady_deadline(const typename ClockType::duration sinceEpoch)
+		{
+			using steady_clock = std::chrono::steady_clock;
+			if constexpr (is_same_v<ClockType, steady_clock>)
+			{
+				return steady_clock::time_point{sinceEpoch};
+			}
+			else
+			{
+				// Other clocks can't be slept on directly, convert to the time left instead.
+				const auto remaining = sinceEpoch - ClockType::now().time_since_epoch();
+				return steady_clock::now() + std::chrono::duration_cast<steady_clock::duration>(remaining);
+			}
+		}
+	}
+
 	template <time::duration_rep Precision>
 	void sleep_for(time::span<Precision> duration)
 	{
-		platform::sleep_current_thread(duration.template milliseconds<uint64>());
+		internal::sleep_until(
+			std::chrono::steady_clock::now() +
+			std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration.duration)
+		);
 	}
 
 	template <time::duration_rep Precision, time::clock_type ClockType>
 	void sleep_until(time::point<Precision, ClockType> timepoint)
 	{
-		sleep_for(timepoint - time::stopwatch<Precision, ClockType>::current_point());
+		internal::sleep_until(internal::to_steady_deadline<ClockType>(timepoint.duration));
+	}
+
+	template <time::duration_rep Precision>
+	void precise_sleep_for(time::span<Precision> duration)
+	{
+		internal::precise_sleep_until(
+			std::chrono::steady_clock::now() +
+			std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration.duration)
+		);
+	}
+
+	template <time::duration_rep Precision, time::clock_type ClockType>
+	void precise_sleep_until(time::point<Precision, ClockType> timepoint)
+	{
+		internal::precise_sleep_until(internal::to_steady_deadline<ClockType>(timepoint.duration));
 	}
 }
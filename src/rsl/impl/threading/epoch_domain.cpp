@@ -0,0 +1,328 @@
+#include "epoch_domain.hpp"
+
+#include <mutex>
+
+#include "mutex.hpp"
+
+namespace rsl
+{
+	namespace internal
+	{
+		struct epoch_retired
+		{
+			void* ptr;
+			epoch_domain::deleter_func deleter;
+			void* context;
+		};
+
+		struct epoch_batch
+		{
+			epoch_batch* next = nullptr;
+			// Epoch when the batch was sealed, it's safe to free two epochs later.
+			uint64 epoch = 0ull;
+			size_type count = 0ull;
+			epoch_retired entries[epoch_domain::batch_capacity];
+		};
+
+		struct epoch_thread_cache
+		{
+			constexpr static size_type max_domains = 8ull;
+
+			struct entry
+			{
+				const epoch_domain* domain = nullptr;
+				uint64 serial = 0ull;
+				epoch_record* record = nullptr;
+			};
+
+			entry entries[max_domains];
+			size_type count = 0ull;
+
+			~epoch_thread_cache()
+			{
+				for (size_type i = 0ull; i < count; i++)
+				{
+					[[maybe_unused]] const bool released =
+						epoch_domain::release_record(entries[i].domain, entries[i].serial, entries[i].record);
+					rsl_assert_rarely(released);
+				}
+			}
+		};
+	} // namespace internal
+
+	namespace
+	{
+		thread_local internal::epoch_thread_cache threadRecords;
+
+		mutex liveDomainsLock;
+		epoch_domain* liveDomains = nullptr;
+		std::atomic<uint64> nextDomainSerial{1ull};
+	} // namespace
+
+	epoch_domain::epoch_domain(pmu_allocator& allocator)
+		: m_allocator(&allocator),
+		  m_serial(nextDomainSerial.fetch_add(1ull, std::memory_order_relaxed))
+	{
+		std::lock_guard guard(liveDomainsLock);
+		m_nextLive = liveDomains;
+		liveDomains = this;
+	}
+
+	epoch_domain::~epoch_domain()
+	{
+		{
+			std::lock_guard guard(liveDomainsLock);
+			for (epoch_domain** link = &liveDomains; *link; link = &(*link)->m_nextLive)
+			{
+				if (*link == this)
+				{
+					*link = m_nextLive;
+					break;
+				}
+			}
+		}
+
+		internal::epoch_record* record = m_records.load(std::memory_order_acquire);
+		while (record)
+		{
+			rsl_assert_invalid_operation(
+				(record->state.load(std::memory_order_acquire) & internal::epoch_record::pinned_bit) == 0ull
+			);
+
+			internal::epoch_batch* batch = record->pendingHead;
+			while (batch)
+			{
+				internal::epoch_batch* next = batch->next;
+				free_batch(batch);
+				batch = next;
+			}
+
+			if (record->current)
+			{
+				free_batch(record->current);
+			}
+
+			internal::epoch_record* next = record->next;
+			record->~epoch_record();
+			m_allocator->deallocate(record, sizeof(internal::epoch_record), alignof(internal::epoch_record));
+			record = next;
+		}
+	}
+
+	void epoch_domain::retire(void* ptr, const deleter_func deleter, void* context)
+	{
+		rsl_assert_invalid_parameters(deleter);
+		if (!ptr)
+		{
+			return;
+		}
+
+		internal::epoch_record& record = *local_record();
+		if (!record.current)
+		{
+			record.current = m_allocator->allocate<internal::epoch_batch>(alignof(internal::epoch_batch));
+			rsl_assert_invalid_object(record.current);
+			new (record.current) internal::epoch_batch();
+		}
+
+		internal::epoch_batch& batch = *record.current;
+		batch.entries[batch.count++] = internal::epoch_retired{.ptr = ptr, .deleter = deleter, .context = context};
+
+		if (batch.count == batch_capacity)
+		{
+			seal_batch(record);
+			try_advance();
+			free_ready_batches(record);
+		}
+	}
+
+	size_type epoch_domain::collect()
+	{
+		internal::epoch_record& record = *local_record();
+		if (record.current)
+		{
+			seal_batch(record);
+		}
+
+		try_advance();
+		return free_ready_batches(record);
+	}
+
+	bool epoch_domain::try_advance() noexcept
+	{
+		const uint64 epoch = m_epoch.load(std::memory_order_relaxed);
+		// Pairs with the fence in pin, any thread that pinned before this point is seen as pinned below.
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		for (internal::epoch_record* record = m_records.load(std::memory_order_acquire); record; record = record->next)
+		{
+			const uint64 state = record->state.load(std::memory_order_relaxed);
+			if ((state & internal::epoch_record::pinned_bit) && (state >> 1ull) != epoch)
+			{
+				return false;
+			}
+		}
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		uint64 expected = epoch;
+		// Another thread advancing it at the same time is just as good.
+		m_epoch.compare_exchange_strong(expected, epoch + 1ull, std::memory_order_release, std::memory_order_relaxed);
+		return true;
+	}
+
+	epoch_domain& epoch_domain::shared()
+	{
+		static epoch_domain domain;
+		return domain;
+	}
+
+	internal::epoch_record* epoch_domain::acquire_record()
+	{
+		for (internal::epoch_record* record = m_records.load(std::memory_order_acquire); record; record = record->next)
+		{
+			bool expected = false;
+			if (!record->claimed.load(std::memory_order_relaxed) &&
+				record->claimed.compare_exchange_strong(expected, true, std::memory_order_acquire))
+			{
+				return record;
+			}
+		}
+
+		internal::epoch_record* record =
+			m_allocator->allocate<internal::epoch_record>(alignof(internal::epoch_record));
+		rsl_assert_invalid_object(record);
+		new (record) internal::epoch_record();
+
+		internal::epoch_record* head = m_records.load(std::memory_order_relaxed);
+		do
+		{
+			record->next = head;
+		}
+		while (!m_records.compare_exchange_weak(head, record, std::memory_order_release, std::memory_order_relaxed));
+
+		return record;
+	}
+
+	internal::epoch_record* epoch_domain::local_record()
+	{
+		internal::epoch_thread_cache& cache = threadRecords;
+		for (size_type i = 0ull; i < cache.count; i++)
+		{
+			if (cache.entries[i].domain == this && cache.entries[i].serial == m_serial)
+			{
+				return cache.entries[i].record;
+			}
+		}
+
+		size_type slot = cache.count;
+		if (slot == internal::epoch_thread_cache::max_domains)
+		{
+			// Make room by handing back a record that isn't pinned, or dropping one of a domain that no longer exists.
+			for (slot = 0ull; slot < cache.count; slot++)
+			{
+				const internal::epoch_thread_cache::entry& entry = cache.entries[slot];
+				if (release_record(entry.domain, entry.serial, entry.record))
+				{
+					break;
+				}
+			}
+
+			rsl_assert_invalid_operation(slot < cache.count);
+		}
+		else
+		{
+			cache.count++;
+		}
+
+		internal::epoch_record* record = acquire_record();
+		cache.entries[slot] = internal::epoch_thread_cache::entry{.domain = this, .serial = m_serial, .record = record};
+		return record;
+	}
+
+	void epoch_domain::seal_batch(internal::epoch_record& record) noexcept
+	{
+		internal::epoch_batch* batch = record.current;
+		record.current = nullptr;
+
+		// Everything in the batch was unlinked before this point, readers that could still see it are pinned to
+		// this epoch or an earlier one.
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		batch->epoch = m_epoch.load(std::memory_order_relaxed);
+
+		if (record.pendingTail)
+		{
+			record.pendingTail->next = batch;
+		}
+		else
+		{
+			record.pendingHead = batch;
+		}
+		record.pendingTail = batch;
+	}
+
+	size_type epoch_domain::free_ready_batches(internal::epoch_record& record) noexcept
+	{
+		const uint64 epoch = m_epoch.load(std::memory_order_acquire);
+
+		size_type freed = 0ull;
+		while (record.pendingHead && record.pendingHead->epoch + 2ull <= epoch)
+		{
+			internal::epoch_batch* batch = record.pendingHead;
+			record.pendingHead = batch->next;
+			freed += free_batch(batch);
+		}
+
+		if (!record.pendingHead)
+		{
+			record.pendingTail = nullptr;
+		}
+
+		return freed;
+	}
+
+	size_type epoch_domain::free_batch(internal::epoch_batch* batch) noexcept
+	{
+		const size_type count = batch->count;
+		for (size_type i = 0ull; i < count; i++)
+		{
+			const internal::epoch_retired& retired = batch->entries[i];
+			retired.deleter(retired.ptr, retired.context);
+		}
+
+		batch->~epoch_batch();
+		m_allocator->deallocate(batch, sizeof(internal::epoch_batch), alignof(internal::epoch_batch));
+		return count;
+	}
+
+	bool epoch_domain::release_record(
+		const epoch_domain* domain, const uint64 serial, internal::epoch_record* record
+	) noexcept
+	{
+		std::lock_guard guard(liveDomainsLock);
+
+		bool live = false;
+		for (const epoch_domain* candidate = liveDomains; candidate; candidate = candidate->m_nextLive)
+		{
+			if (candidate == domain && candidate->m_serial == serial)
+			{
+				live = true;
+				break;
+			}
+		}
+
+		if (!live)
+		{
+			return true;
+		}
+
+		if (record->nesting > 0u)
+		{
+			return false;
+		}
+
+		// The record keeps its retired batches, whoever claims it next frees them.
+		record->claimed.store(false, std::memory_order_release);
+		return true;
+	}
+} // namespace rsl
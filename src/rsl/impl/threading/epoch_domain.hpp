@@ -0,0 +1,165 @@
+#pragma once
+
+#include <atomic>
+
+#include "../memory/allocator_context.hpp"
+#include "../util/assert.hpp"
+#include "../util/primitives.hpp"
+
+/**
+ * @file epoch_domain.hpp
+ */
+
+namespace rsl
+{
+	class epoch_domain;
+
+	namespace internal
+	{
+		struct epoch_batch;
+		struct epoch_thread_cache;
+
+		struct alignas(cache_line_size) epoch_record
+		{
+			constexpr static uint64 pinned_bit = 1ull;
+
+			// Epoch the owner pinned shifted up by one, with pinned_bit set while pinned. Read by threads advancing
+			// the epoch.
+			std::atomic<uint64> state{0ull};
+			std::atomic<bool> claimed{true};
+			epoch_record* next = nullptr;
+
+			// Only touched by the owning thread.
+			uint32 nesting = 0u;
+			epoch_batch* current = nullptr;
+			epoch_batch* pendingHead = nullptr;
+			epoch_batch* pendingTail = nullptr;
+		};
+	} // namespace internal
+
+	/**@class epoch_guard
+	 * @brief Keeps the calling thread pinned to the current epoch of a domain, nothing retired while the guard lives
+	 * gets freed. Guards nest, only the outermost one pins and unpins.
+	 * @note Guards belong to the thread that created them and can't be handed to other threads.
+	 */
+	class epoch_guard
+	{
+	public:
+		epoch_guard() noexcept = default;
+		epoch_guard(epoch_guard&& other) noexcept;
+		epoch_guard& operator=(epoch_guard&& other) noexcept;
+
+		epoch_guard(const epoch_guard&) = delete;
+		epoch_guard& operator=(const epoch_guard&) = delete;
+
+		[[rythe_always_inline]] ~epoch_guard() { release(); }
+
+		/**@brief Unpins early.
+		 */
+		void release() noexcept;
+
+		[[nodiscard]] [[rythe_always_inline]] bool is_pinned() const noexcept { return m_record != nullptr; }
+
+	private:
+		friend class epoch_domain;
+
+		explicit epoch_guard(internal::epoch_record* record) noexcept
+			: m_record(record) {}
+
+		internal::epoch_record* m_record = nullptr;
+	};
+
+	/**@class epoch_domain
+	 * @brief Epoch based reclamation for lock-free structures. Readers pin the domain while they hold pointers into a
+	 * structure, writers retire memory they unlinked instead of freeing it right away. Retired memory is freed once
+	 * the global epoch moved on twice, at which point no pinned thread can still see it.
+	 * Every thread gets its own record in the domain on first use, so pinning only touches memory of the calling
+	 * thread. Retired pointers are collected in per-thread batches that are allocated from, and whose contents are
+	 * usually freed through, rsl allocators, a whole batch gets freed at once.
+	 * @note Threads hand their record back when they exit, retired memory that wasn't freed yet goes to the next thread
+	 * that picks up the record or gets freed when the domain is destroyed.
+	 */
+	class epoch_domain
+	{
+	public:
+		using deleter_func = void (*)(void* ptr, void* context);
+
+		/**@brief Amount of retired pointers collected before the batch is handed off to be freed.
+		 */
+		constexpr static size_type batch_capacity = 64ull;
+
+		/**@param allocator Allocator used for the thread records and retire batches.
+		 */
+		explicit epoch_domain(pmu_allocator& allocator = *allocator_context::globalAllocator);
+
+		epoch_domain(const epoch_domain&) = delete;
+		epoch_domain(epoch_domain&&) = delete;
+		epoch_domain& operator=(const epoch_domain&) = delete;
+		epoch_domain& operator=(epoch_domain&&) = delete;
+
+		/**@brief Frees everything that was retired, no thread may be pinned anymore.
+		 */
+		~epoch_domain();
+
+		/**@brief Pins the calling thread until the guard is destroyed.
+		 */
+		[[nodiscard]] [[rythe_always_inline]] epoch_guard pin();
+
+		/**@brief Frees ptr with deleter once no thread can still be reading it. Call after ptr was unlinked from the
+		 * structure, pinned or not.
+		 * @param context Passed to deleter along with ptr.
+		 */
+		void retire(void* ptr, deleter_func deleter, void* context = nullptr);
+
+		/**@brief Destroys and deallocates an object that was allocated from allocator once no thread can still be
+		 * reading it.
+		 */
+		template <typename T>
+		void retire(T* ptr, pmu_allocator& allocator);
+
+		/**@brief Tries to advance the epoch and frees the retired batches of the calling thread that became safe.
+		 * Happens automatically every time a batch fills up, call it when retiring stops for a while.
+		 * @returns Amount of retired pointers that got freed.
+		 */
+		size_type collect();
+
+		/**@brief Advances the epoch if every pinned thread observed the current one.
+		 */
+		bool try_advance() noexcept;
+
+		[[nodiscard]] [[rythe_always_inline]] uint64 current_epoch() const noexcept
+		{
+			return m_epoch.load(std::memory_order_acquire);
+		}
+
+		/**@brief Process wide domain, for structures that don't need a domain of their own.
+		 */
+		[[nodiscard]] static epoch_domain& shared();
+
+	private:
+		friend class epoch_guard;
+		friend struct internal::epoch_thread_cache;
+
+		[[nodiscard]] internal::epoch_record* acquire_record();
+		[[nodiscard]] internal::epoch_record* local_record();
+		void seal_batch(internal::epoch_record& record) noexcept;
+		size_type free_ready_batches(internal::epoch_record& record) noexcept;
+		size_type free_batch(internal::epoch_batch* batch) noexcept;
+
+		[[rythe_always_inline]] static void unpin(internal::epoch_record& record) noexcept;
+		// Hands a record back to its domain if the domain still exists, returns false if the record is still pinned.
+		static bool release_record(const epoch_domain* domain, uint64 serial, internal::epoch_record* record) noexcept;
+
+		pmu_allocator* m_allocator;
+		// Distinguishes this domain from earlier domains at the same address in thread caches.
+		uint64 m_serial;
+		alignas(cache_line_size) std::atomic<uint64> m_epoch{0ull};
+		// Records are only ever added, released records get reused by other threads.
+		alignas(cache_line_size) std::atomic<internal::epoch_record*> m_records{nullptr};
+
+		// Registry of live domains, exiting threads check it before handing their record back.
+		epoch_domain* m_nextLive = nullptr;
+	};
+} // namespace rsl
+
+#include "epoch_domain.inl"
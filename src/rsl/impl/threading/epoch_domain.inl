@@ -0,0 +1,70 @@
+#pragma once
+#include "epoch_domain.hpp"
+
+namespace rsl
+{
+	inline epoch_guard epoch_domain::pin()
+	{
+		internal::epoch_record* record = local_record();
+		if (record->nesting++ == 0u)
+		{
+			const uint64 epoch = m_epoch.load(std::memory_order_relaxed);
+			record->state.store((epoch << 1ull) | internal::epoch_record::pinned_bit, std::memory_order_relaxed);
+			// Pairs with the fence in try_advance, the pin has to be visible before this thread reads any pointers.
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+		}
+
+		return epoch_guard(record);
+	}
+
+	inline void epoch_domain::unpin(internal::epoch_record& record) noexcept
+	{
+		rsl_assert_invalid_operation(record.nesting > 0u);
+		if (--record.nesting == 0u)
+		{
+			record.state.store(0ull, std::memory_order_release);
+		}
+	}
+
+	inline epoch_guard::epoch_guard(epoch_guard&& other) noexcept
+		: m_record(other.m_record)
+	{
+		other.m_record = nullptr;
+	}
+
+	inline epoch_guard& epoch_guard::operator=(epoch_guard&& other) noexcept
+	{
+		if (this != &other)
+		{
+			release();
+			m_record = other.m_record;
+			other.m_record = nullptr;
+		}
+
+		return *this;
+	}
+
+	inline void epoch_guard::release() noexcept
+	{
+		if (m_record)
+		{
+			epoch_domain::unpin(*m_record);
+			m_record = nullptr;
+		}
+	}
+
+	template <typename T>
+	void epoch_domain::retire(T* ptr, pmu_allocator& allocator)
+	{
+		retire(
+			static_cast<void*>(ptr),
+			[](void* object, void* context)
+			{
+				T* typed = static_cast<T*>(object);
+				typed->~T();
+				static_cast<pmu_allocator*>(context)->deallocate(typed, sizeof(T), alignof(T));
+			},
+			&allocator
+		);
+	}
+} // namespace rsl
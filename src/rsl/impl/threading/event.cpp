@@ -0,0 +1,40 @@
+#include "event.hpp"
+
+#include "../platform/platform.hpp"
+#include "spin_wait.hpp"
+
+namespace rsl
+{
+	namespace
+	{
+		internal::spin_budget eventSpins;
+	} // namespace
+
+	void event::wait() const noexcept
+	{
+		if (internal::spin_until(eventSpins, [this]() { return is_set(); }))
+		{
+			return;
+		}
+
+		uint32 state = m_state.load(std::memory_order_acquire);
+		while (state != set_state)
+		{
+			if (state == unset_state &&
+				!m_state.compare_exchange_weak(
+					state, waiting_state, std::memory_order_acquire, std::memory_order_acquire
+				))
+			{
+				continue;
+			}
+
+			platform::wait_on_address(m_state, waiting_state);
+			state = m_state.load(std::memory_order_acquire);
+		}
+	}
+
+	void event::wake_waiters() noexcept
+	{
+		platform::wake_all_on_address(m_state);
+	}
+} // namespace rsl
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+
+#include "../util/primitives.hpp"
+
+/**
+ * @file event.hpp
+ */
+
+namespace rsl
+{
+	/**@class event
+	 * @brief Single word manual-reset event. Once set every waiting thread continues until the event gets reset.
+	 */
+	class event
+	{
+	public:
+		constexpr event() noexcept = default;
+		constexpr explicit event(const bool initiallySet) noexcept
+			: m_state(initiallySet ? set_state : unset_state) {}
+
+		event(const event&) = delete;
+		event& operator=(const event&) = delete;
+
+		/**@brief Sets the event and wakes up all waiting threads.
+		 */
+		[[rythe_always_inline]] void set() noexcept;
+		[[rythe_always_inline]] void reset() noexcept;
+
+		[[nodiscard]] [[rythe_always_inline]] bool is_set() const noexcept;
+
+		/**@brief Waits until the event is set.
+		 */
+		void wait() const noexcept;
+
+	private:
+		constexpr static uint32 unset_state = 0u;
+		constexpr static uint32 set_state = 1u;
+		constexpr static uint32 waiting_state = 2u;
+
+		void wake_waiters() noexcept;
+
+		mutable std::atomic<uint32> m_state{unset_state};
+	};
+
+	static_assert(sizeof(event) == sizeof(uint32));
+} // namespace rsl
+
+#include "event.inl"
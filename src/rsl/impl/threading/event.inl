@@ -0,0 +1,24 @@
+#pragma once
+#include "event.hpp"
+
+namespace rsl
+{
+	inline void event::set() noexcept
+	{
+		if (m_state.exchange(set_state, std::memory_order_release) == waiting_state)
+		{
+			wake_waiters();
+		}
+	}
+
+	inline void event::reset() noexcept
+	{
+		uint32 expected = set_state;
+		m_state.compare_exchange_strong(expected, unset_state, std::memory_order_relaxed, std::memory_order_relaxed);
+	}
+
+	inline bool event::is_set() const noexcept
+	{
+		return m_state.load(std::memory_order_acquire) == set_state;
+	}
+} // namespace rsl
@@ -0,0 +1,376 @@
+#include "job_system.hpp"
+
+#include <cstdio>
+
+#include "../platform/platform.hpp"
+#include "current_thread.hpp"
+
+namespace rsl
+{
+	namespace
+	{
+		thread_local job_system* currentSystem = nullptr;
+		thread_local size_type currentWorkerIndex = npos;
+		thread_local internal::job* currentJob = nullptr;
+
+		// Idle workers yield this many times before they park.
+		constexpr size_type idle_yield_count = 64ull;
+	} // namespace
+
+	struct job_system::worker
+	{
+		work_stealing_deque<internal::job*> deque;
+		job_system* system;
+		size_type index;
+		thread handle;
+
+		worker(job_system* owner, const size_type workerIndex, const size_type capacity)
+			: deque(capacity),
+			  system(owner),
+			  index(workerIndex) {}
+	};
+
+	job_system::job_system(const size_type workerThreadCount, const size_type maxJobs, pmu_allocator& allocator)
+		: m_allocator(&allocator),
+		  m_maxJobs(maxJobs),
+		  m_freeJobs(maxJobs),
+		  m_injectedJobs(maxJobs)
+	{
+		rsl_assert_invalid_parameters(maxJobs >= 2ull && (maxJobs & (maxJobs - 1ull)) == 0ull);
+		rsl_assert_msg_soft_rarely(
+			platform::get_cpu_topology().cache_line_size_sufficient(), "cache_line_size is smaller than the cache lines"
+		);
+
+		m_jobs = static_cast<internal::job*>(m_allocator->allocate(sizeof(internal::job) * maxJobs, alignof(internal::job)));
+		rsl_assert_invalid_object(m_jobs);
+
+		for (size_type i = 0ull; i < maxJobs; i++)
+		{
+			new (&m_jobs[i]) internal::job();
+			[[maybe_unused]] const bool pushed = m_freeJobs.try_push(&m_jobs[i]);
+		}
+
+		size_type threadCount = workerThreadCount;
+		if (threadCount == npos)
+		{
+			// SMT siblings share execution units, a second worker on the same core mostly adds contention.
+			const size_type physicalCores = platform::get_cpu_topology().physical_core_count();
+			const size_type allowedCpus = static_cast<size_type>(platform::hardware_concurrency());
+			const size_type cores = physicalCores < allowedCpus ? physicalCores : allowedCpus;
+			threadCount = cores > 1ull ? cores - 1ull : 0ull;
+		}
+
+		m_workerCount = threadCount + 1ull;
+		m_workers = static_cast<worker*>(m_allocator->allocate(sizeof(worker) * m_workerCount, alignof(worker)));
+		rsl_assert_invalid_object(m_workers);
+
+		for (size_type i = 0ull; i < m_workerCount; i++)
+		{
+			new (&m_workers[i]) worker(this, i, maxJobs);
+		}
+
+		// Taking over the identity of a worker of another job_system would cut it off from its own deque, that happens
+		// when a job lazily creates shared() for example.
+		if (!currentSystem)
+		{
+			currentSystem = this;
+			currentWorkerIndex = 0ull;
+		}
+
+		for (size_type i = 1ull; i < m_workerCount; i++)
+		{
+			m_workers[i].handle = platform::create_thread(&worker_main, &m_workers[i], "rsl job worker"_sv, *m_allocator);
+		}
+	}
+
+	job_system::~job_system()
+	{
+		m_running.store(false, std::memory_order_release);
+		m_wake->signal.fetch_add(1u, std::memory_order_release);
+		platform::wake_all_on_address(m_wake->signal);
+
+		for (size_type i = 1ull; i < m_workerCount; i++)
+		{
+			m_workers[i].handle.join();
+		}
+
+		for (size_type i = 0ull; i < m_workerCount; i++)
+		{
+			m_workers[i].~worker();
+		}
+		m_allocator->deallocate(m_workers, sizeof(worker) * m_workerCount, alignof(worker));
+
+		for (size_type i = 0ull; i < m_maxJobs; i++)
+		{
+			m_jobs[i].~job();
+		}
+		m_allocator->deallocate(m_jobs, sizeof(internal::job) * m_maxJobs, alignof(internal::job));
+
+		if (currentSystem == this)
+		{
+			currentSystem = nullptr;
+			currentWorkerIndex = npos;
+		}
+	}
+
+	void job_system::run(const job_handle handle)
+	{
+		rsl_assert_invalid_parameters(handle.valid());
+		internal::job* job = handle.job;
+
+		if (currentSystem == this)
+		{
+			if (m_workers[currentWorkerIndex].deque.push(job))
+			{
+				wake_worker();
+				return;
+			}
+		}
+		else if (m_injectedJobs.try_push(job))
+		{
+			wake_worker();
+			return;
+		}
+
+		// Out of queue space, running the job right away still makes progress.
+		execute(job);
+	}
+
+	void job_system::wait(const job_handle handle)
+	{
+		while (!is_completed(handle))
+		{
+			if (!try_execute_one())
+			{
+				platform::yield_current_thread();
+			}
+		}
+	}
+
+	bool job_system::is_completed(const job_handle handle) const noexcept
+	{
+		if (!handle.valid())
+		{
+			return true;
+		}
+
+		return handle.job->generation.load(std::memory_order_acquire) != handle.generation ||
+			   handle.job->unfinished.load(std::memory_order_acquire) == 0u;
+	}
+
+	job_handle job_system::current_job() noexcept
+	{
+		if (!currentJob)
+		{
+			return job_handle{};
+		}
+
+		return job_handle{.job = currentJob, .generation = currentJob->generation.load(std::memory_order_relaxed)};
+	}
+
+	size_type job_system::current_worker_index() const noexcept
+	{
+		return currentSystem == this ? currentWorkerIndex : npos;
+	}
+
+	job_system& job_system::shared()
+	{
+		static job_system system;
+		return system;
+	}
+
+	internal::job* job_system::allocate_job(const job_handle parent)
+	{
+		internal::job* job = try_allocate_job(parent);
+		while (!job)
+		{
+			// Pool exhausted, finish some work to free up slots.
+			if (!try_execute_one())
+			{
+				platform::yield_current_thread();
+			}
+			job = try_allocate_job(parent);
+		}
+
+		return job;
+	}
+
+	internal::job* job_system::try_allocate_job(const job_handle parent) noexcept
+	{
+		internal::job* job = nullptr;
+		if (!m_freeJobs.try_pop(job))
+		{
+			return nullptr;
+		}
+
+		job->parent = parent.job;
+		job->unfinished.store(1u, std::memory_order_relaxed);
+
+		if (parent.valid())
+		{
+			rsl_assert_invalid_parameters(!is_completed(parent));
+			parent.job->unfinished.fetch_add(1u, std::memory_order_relaxed);
+		}
+
+		return job;
+	}
+
+	void job_system::release_job(internal::job* job) noexcept
+	{
+		job->generation.fetch_add(1u, std::memory_order_release);
+
+		// The queue fits every job, it only looks full while a pop that claimed the slot we need hasn't finished.
+		// Dropping the job instead would shrink the pool for good, until nothing can be allocated anymore.
+		while (!m_freeJobs.try_push(job))
+		{
+			platform::yield_current_thread();
+		}
+	}
+
+	void job_system::complete_job(internal::job* job) noexcept
+	{
+		while (job)
+		{
+			if (job->unfinished.fetch_sub(1u, std::memory_order_acq_rel) != 1u)
+			{
+				return;
+			}
+
+			internal::job* parent = job->parent;
+			release_job(job);
+			job = parent;
+		}
+	}
+
+	void job_system::execute(internal::job* job)
+	{
+		internal::job* previousJob = currentJob;
+		currentJob = job;
+
+		job->invoke(*this, job->storage);
+
+		currentJob = previousJob;
+		complete_job(job);
+	}
+
+	internal::job* job_system::find_job() noexcept
+	{
+		internal::job* job = nullptr;
+		size_type firstVictim = 0ull;
+
+		if (currentSystem == this)
+		{
+			if (m_workers[currentWorkerIndex].deque.pop(job))
+			{
+				return job;
+			}
+
+			firstVictim = currentWorkerIndex + 1ull;
+		}
+
+		if (m_injectedJobs.try_pop(job))
+		{
+			return job;
+		}
+
+		for (size_type i = 0ull; i < m_workerCount; i++)
+		{
+			const size_type victim = (firstVictim + i) % m_workerCount;
+			if (currentSystem == this && victim == currentWorkerIndex)
+			{
+				continue;
+			}
+
+			if (m_workers[victim].deque.steal(job))
+			{
+				return job;
+			}
+		}
+
+		return nullptr;
+	}
+
+	void job_system::wake_worker() noexcept
+	{
+		if (m_workerCount == 1ull)
+		{
+			return;
+		}
+
+		// Pairs with the fence in park_worker, either this sees the parked worker or the worker sees the new job.
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (m_wake->parkedWorkers.load(std::memory_order_relaxed) != 0u)
+		{
+			m_wake->signal.fetch_add(1u, std::memory_order_release);
+			platform::wake_one_on_address(m_wake->signal);
+		}
+	}
+
+	void job_system::park_worker()
+	{
+		m_wake->parkedWorkers.fetch_add(1u, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const uint32 signal = m_wake->signal.load(std::memory_order_acquire);
+
+		// Jobs scheduled before the worker announced itself don't wake it, so it looks one last time.
+		internal::job* job = m_running.load(std::memory_order_acquire) ? find_job() : nullptr;
+		if (!job && m_running.load(std::memory_order_acquire))
+		{
+			platform::wait_on_address(m_wake->signal, signal);
+		}
+
+		m_wake->parkedWorkers.fetch_sub(1u, std::memory_order_relaxed);
+
+		if (job)
+		{
+			execute(job);
+		}
+	}
+
+	bool job_system::try_execute_one()
+	{
+		internal::job* job = find_job();
+		if (!job)
+		{
+			return false;
+		}
+
+		execute(job);
+		return true;
+	}
+
+	uint32 job_system::worker_main(void* userData)
+	{
+		worker& self = *static_cast<worker*>(userData);
+		job_system& system = *self.system;
+
+		currentSystem = &system;
+		currentWorkerIndex = self.index;
+
+		char name[32];
+		const int nameLength = std::snprintf(name, sizeof(name), "rsl job worker %zu", self.index);
+		current_thread::set_name(string_view::from_buffer(name, static_cast<size_type>(nameLength)));
+
+		size_type idleCount = 0ull;
+		while (system.m_running.load(std::memory_order_acquire))
+		{
+			if (system.try_execute_one())
+			{
+				idleCount = 0ull;
+			}
+			else if (++idleCount < idle_yield_count)
+			{
+				current_thread::yield();
+			}
+			else
+			{
+				system.park_worker();
+				idleCount = 0ull;
+			}
+		}
+
+		currentSystem = nullptr;
+		currentWorkerIndex = npos;
+		return 0u;
+	}
+} // namespace rsl
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <atomic>
+
+#include "../memory/allocator_context.hpp"
+#include "../util/cache_aligned.hpp"
+#include "../util/concepts.hpp"
+#include "../util/primitives.hpp"
+#include "mpmc_queue.hpp"
+#include "thread.hpp"
+#include "work_stealing_deque.hpp"
+
+/**
+ * @file job_system.hpp
+ */
+
+namespace rsl
+{
+	class job_system;
+
+	namespace internal
+	{
+		struct alignas(cache_line_size) job
+		{
+			// Fills the job up to two cache lines.
+			constexpr static size_type inline_storage_size = 96ull;
+			constexpr static size_type inline_storage_alignment = 16ull;
+
+			using invoke_func = void (*)(job_system& system, void* storage);
+
+			invoke_func invoke = nullptr;
+			job* parent = nullptr;
+			// Own invocation plus unfinished children, the job completes when this reaches 0.
+			std::atomic<uint32> unfinished{0u};
+			// Incremented every time the job slot is released, invalidates outstanding handles.
+			std::atomic<uint32> generation{0u};
+			alignas(inline_storage_alignment) byte storage[inline_storage_size];
+		};
+
+		static_assert(sizeof(job) == cache_line_size * 2ull);
+	} // namespace internal
+
+	/**@struct job_handle
+	 * @brief Reference to a job in a job_system. Handles stay safe to query after the job completed and its slot got reused.
+	 */
+	struct job_handle
+	{
+		internal::job* job = nullptr;
+		uint32 generation = 0u;
+
+		[[nodiscard]] [[rythe_always_inline]] bool valid() const noexcept { return job != nullptr; }
+	};
+
+	/**@class job_system
+	 * @brief Work-stealing scheduler with one worker per physical core. Every worker owns a work_stealing_deque, new jobs
+	 * are pushed to the deque of the thread that runs them and idle workers steal from the others. Jobs are allocated
+	 * from a fixed pool, callables are stored inline in the job when they fit, delegates included.
+	 * Jobs can be created as children of another job, a parent only completes once all of its children completed, which
+	 * allows fork-join by waiting on the parent. Waiting runs other jobs instead of blocking. Workers that run out of
+	 * work park until a job gets scheduled.
+	 * @note The thread that creates the job_system becomes worker 0 and only runs jobs while it waits, unless it already
+	 * is a worker of another job_system. It then stays one and schedules on the new job_system like any other thread.
+	 */
+	class job_system
+	{
+	public:
+		constexpr static size_type default_max_jobs = 4096ull;
+
+		/**@brief Starts the worker threads.
+		 * @param workerThreadCount Amount of worker threads to start, npos for one per physical core minus the calling
+		 * thread.
+		 * @param maxJobs Maximum amount of jobs that can be alive at the same time, needs to be a power of 2.
+		 * @param allocator Allocator used for the job pool, workers and callables that don't fit inline.
+		 */
+		explicit job_system(
+			size_type workerThreadCount = npos, size_type maxJobs = default_max_jobs,
+			pmu_allocator& allocator = *allocator_context::globalAllocator
+		);
+
+		job_system(const job_system&) = delete;
+		job_system(job_system&&) = delete;
+		job_system& operator=(const job_system&) = delete;
+		job_system& operator=(job_system&&) = delete;
+
+		/**@brief Stops and joins all worker threads. Jobs that haven't run yet are dropped, wait on them first.
+		 */
+		~job_system();
+
+		/**@brief Creates a job without running it yet, so children can be attached before it gets scheduled.
+		 */
+		template <invocable<void()> Func>
+		[[nodiscard]] job_handle create(Func&& func);
+
+		/**@brief Creates a job that parent waits on, parent may not have completed yet.
+		 */
+		template <invocable<void()> Func>
+		[[nodiscard]] job_handle create_child(job_handle parent, Func&& func);
+
+		/**@brief Schedules a created job.
+		 */
+		void run(job_handle handle);
+
+		/**@brief Creates and schedules a job.
+		 */
+		template <invocable<void()> Func>
+		job_handle schedule(Func&& func);
+
+		/**@brief Creates and schedules a job that parent waits on.
+		 */
+		template <invocable<void()> Func>
+		job_handle schedule_child(job_handle parent, Func&& func);
+
+		/**@brief Like schedule_child, but gives up instead of waiting for a free slot when all jobs are in use.
+		 * Recursive splitters use it to run the work themselves rather than piling up more jobs.
+		 * @returns An invalid handle if no job could be created, func won't have been moved from in that case.
+		 */
+		template <invocable<void()> Func>
+		job_handle try_schedule_child(job_handle parent, Func&& func);
+
+		/**@brief Runs other jobs until the job and all of its children completed.
+		 */
+		void wait(job_handle handle);
+
+		[[nodiscard]] bool is_completed(job_handle handle) const noexcept;
+
+		/**@brief Runs a single pending job on the calling thread, lets threads that wait on something else help out.
+		 * @returns False if there was no job to run.
+		 */
+		bool try_execute_one();
+
+		/**@brief Job currently running on the calling thread, invalid outside of jobs.
+		 */
+		[[nodiscard]] static job_handle current_job() noexcept;
+
+		/**@brief Index of the calling thread among the workers of this job_system, npos for threads that aren't one of
+		 * its workers. Stays the same for the lifetime of the thread, so it can be used to index per-worker state.
+		 */
+		[[nodiscard]] size_type current_worker_index() const noexcept;
+
+		/**@brief Amount of threads that run jobs, including the thread that created the job_system.
+		 */
+		[[nodiscard]] [[rythe_always_inline]] size_type worker_count() const noexcept { return m_workerCount; }
+
+		/**@brief Process wide job_system with default settings, created on first use by the calling thread which becomes
+		 * its worker 0. Used by the parallel algorithms when no job_system is given.
+		 */
+		[[nodiscard]] static job_system& shared();
+
+	private:
+		struct worker;
+
+		template <typename Func>
+		[[nodiscard]] job_handle init_job(internal::job* job, Func&& func);
+
+		[[nodiscard]] internal::job* allocate_job(job_handle parent);
+		[[nodiscard]] internal::job* try_allocate_job(job_handle parent) noexcept;
+		void release_job(internal::job* job) noexcept;
+		void complete_job(internal::job* job) noexcept;
+		void execute(internal::job* job);
+		[[nodiscard]] internal::job* find_job() noexcept;
+		void wake_worker() noexcept;
+		void park_worker();
+
+		static uint32 worker_main(void* userData);
+
+		pmu_allocator* m_allocator;
+		internal::job* m_jobs = nullptr;
+		size_type m_maxJobs;
+		mpmc_queue<internal::job*> m_freeJobs;
+		// Jobs scheduled by threads that aren't workers of this job_system.
+		mpmc_queue<internal::job*> m_injectedJobs;
+
+		worker* m_workers = nullptr;
+		size_type m_workerCount = 0ull;
+		std::atomic<bool> m_running{true};
+		// Parked workers wait for signal to change, scheduling only bumps it while any of them are parked. Workers write
+		// it whenever they park, so it gets a line of its own away from the members every run reads.
+		struct wake_state
+		{
+			std::atomic<uint32> signal{0u};
+			std::atomic<uint32> parkedWorkers{0u};
+		};
+
+		cache_aligned<wake_state> m_wake;
+	};
+} // namespace rsl
+
+#include "job_system.inl"
@@ -0,0 +1,82 @@
+#pragma once
+#include "job_system.hpp"
+
+namespace rsl
+{
+	template <invocable<void()> Func>
+	job_handle job_system::create(Func&& func)
+	{
+		return create_child(job_handle{}, forward<Func>(func));
+	}
+
+	template <invocable<void()> Func>
+	job_handle job_system::create_child(const job_handle parent, Func&& func)
+	{
+		return init_job(allocate_job(parent), forward<Func>(func));
+	}
+
+	template <typename Func>
+	job_handle job_system::init_job(internal::job* job, Func&& func)
+	{
+		using functor_type = decay_t<Func>;
+
+		if constexpr (sizeof(functor_type) <= internal::job::inline_storage_size &&
+					  alignof(functor_type) <= internal::job::inline_storage_alignment)
+		{
+			new (job->storage) functor_type(forward<Func>(func));
+			job->invoke = [](job_system&, void* storage)
+			{
+				functor_type& functor = *static_cast<functor_type*>(storage);
+				functor();
+				functor.~functor_type();
+			};
+		}
+		else
+		{
+			functor_type* functor = m_allocator->allocate<functor_type>(alignof(functor_type));
+			rsl_assert_invalid_object(functor);
+			new (functor) functor_type(forward<Func>(func));
+			new (job->storage) functor_type*(functor);
+
+			job->invoke = [](job_system& system, void* storage)
+			{
+				functor_type* functor = *static_cast<functor_type**>(storage);
+				(*functor)();
+				functor->~functor_type();
+				system.m_allocator->deallocate(functor, alignof(functor_type));
+			};
+		}
+
+		return job_handle{.job = job, .generation = job->generation.load(std::memory_order_relaxed)};
+	}
+
+	template <invocable<void()> Func>
+	job_handle job_system::schedule(Func&& func)
+	{
+		const job_handle handle = create_child(job_handle{}, forward<Func>(func));
+		run(handle);
+		return handle;
+	}
+
+	template <invocable<void()> Func>
+	job_handle job_system::schedule_child(const job_handle parent, Func&& func)
+	{
+		const job_handle handle = create_child(parent, forward<Func>(func));
+		run(handle);
+		return handle;
+	}
+
+	template <invocable<void()> Func>
+	job_handle job_system::try_schedule_child(const job_handle parent, Func&& func)
+	{
+		internal::job* job = try_allocate_job(parent);
+		if (!job)
+		{
+			return job_handle{};
+		}
+
+		const job_handle handle = init_job(job, forward<Func>(func));
+		run(handle);
+		return handle;
+	}
+} // namespace rsl
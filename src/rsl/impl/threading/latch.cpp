@@ -0,0 +1,67 @@
+#include "latch.hpp"
+
+#include "../platform/platform.hpp"
+#include "spin_wait.hpp"
+
+namespace rsl
+{
+	namespace
+	{
+		internal::spin_budget latchSpins;
+		internal::spin_budget barrierSpins;
+	} // namespace
+
+	void latch::wait() const noexcept
+	{
+		if (internal::spin_until(latchSpins, [this]() { return try_wait(); }))
+		{
+			return;
+		}
+
+		uint32 state = m_state.load(std::memory_order_acquire);
+		while ((state & count_mask) != 0u)
+		{
+			const uint32 waiting = state | waiters_flag;
+			if (state != waiting &&
+				!m_state.compare_exchange_weak(state, waiting, std::memory_order_acquire, std::memory_order_acquire))
+			{
+				continue;
+			}
+
+			platform::wait_on_address(m_state, waiting);
+			state = m_state.load(std::memory_order_acquire);
+		}
+	}
+
+	void latch::wake_waiters() noexcept
+	{
+		platform::wake_all_on_address(m_state);
+	}
+
+	void barrier::arrive_and_wait() noexcept
+	{
+		const uint32 previous = m_state.fetch_add(1u, std::memory_order_acq_rel);
+		const uint32 phase = previous >> phase_shift;
+
+		if ((previous & arrived_mask) + 1u == m_expected)
+		{
+			// Last to arrive, reset the arrival count and move on to the next phase in one go.
+			m_state.fetch_add((1u << phase_shift) - m_expected, std::memory_order_acq_rel);
+			platform::wake_all_on_address(m_state);
+			return;
+		}
+
+		const auto phaseChanged = [this, phase]() { return (m_state.load(std::memory_order_acquire) >> phase_shift) != phase; };
+		if (internal::spin_until(barrierSpins, phaseChanged))
+		{
+			return;
+		}
+
+		uint32 state = m_state.load(std::memory_order_acquire);
+		while ((state >> phase_shift) == phase)
+		{
+			platform::wait_on_address(m_state, state);
+			state = m_state.load(std::memory_order_acquire);
+		}
+	}
+} // namespace rsl
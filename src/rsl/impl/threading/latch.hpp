@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+
+#include "../util/assert.hpp"
+#include "../util/primitives.hpp"
+
+/**
+ * @file latch.hpp
+ */
+
+namespace rsl
+{
+	/**@class latch
+	 * @brief Single use, single word countdown. Threads wait until the count reached zero.
+	 */
+	class latch
+	{
+	public:
+		constexpr static uint32 max_count = (1u << 31u) - 1u;
+
+		constexpr explicit latch(const uint32 expected) noexcept
+			: m_state(expected) {}
+
+		latch(const latch&) = delete;
+		latch& operator=(const latch&) = delete;
+
+		[[rythe_always_inline]] void count_down(uint32 count = 1u) noexcept;
+		[[nodiscard]] [[rythe_always_inline]] bool try_wait() const noexcept;
+		void wait() const noexcept;
+
+		[[rythe_always_inline]] void arrive_and_wait(const uint32 count = 1u) noexcept
+		{
+			count_down(count);
+			wait();
+		}
+
+	private:
+		constexpr static uint32 waiters_flag = 1u << 31u;
+		constexpr static uint32 count_mask = waiters_flag - 1u;
+
+		void wake_waiters() noexcept;
+
+		mutable std::atomic<uint32> m_state;
+	};
+
+	/**@class barrier
+	 * @brief Reusable single word rendezvous point for a fixed amount of threads. The word holds the phase in the upper
+	 * and the arrival count in the lower 16 bits, so up to 65535 threads can take part.
+	 */
+	class barrier
+	{
+	public:
+		constexpr static uint32 max_expected = (1u << 16u) - 1u;
+
+		explicit barrier(const uint32 expected) noexcept
+			: m_expected(expected)
+		{
+			rsl_assert_invalid_parameters(expected > 0u && expected <= max_expected);
+		}
+
+		barrier(const barrier&) = delete;
+		barrier& operator=(const barrier&) = delete;
+
+		/**@brief Arrives at the barrier and waits until all expected threads arrived in this phase.
+		 */
+		void arrive_and_wait() noexcept;
+
+	private:
+		constexpr static uint32 phase_shift = 16u;
+		constexpr static uint32 arrived_mask = (1u << phase_shift) - 1u;
+
+		std::atomic<uint32> m_state{0u};
+		uint32 m_expected;
+	};
+} // namespace rsl
+
+#include "latch.inl"
@@ -0,0 +1,21 @@
+#pragma once
+#include "latch.hpp"
+
+namespace rsl
+{
+	inline void latch::count_down(const uint32 count) noexcept
+	{
+		const uint32 previous = m_state.fetch_sub(count, std::memory_order_acq_rel);
+		rsl_assert_invalid_operation((previous & count_mask) >= count);
+
+		if ((previous & count_mask) == count && (previous & waiters_flag))
+		{
+			wake_waiters();
+		}
+	}
+
+	inline bool latch::try_wait() const noexcept
+	{
+		return (m_state.load(std::memory_order_acquire) & count_mask) == 0u;
+	}
+} // namespace rsl
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+
+#include "../memory/typed_allocator.hpp"
+#include "../util/assert.hpp"
+#include "../util/cache_aligned.hpp"
+#include "../util/primitives.hpp"
+
+/**
+ * @file mpmc_queue.hpp
+ */
+
+namespace rsl
+{
+	/**@class mpmc_queue
+	 * @brief Bounded lock-free queue for any amount of producer and consumer threads, based on Dmitry Vyukov's bounded
+	 * MPMC queue. Every slot carries a sequence number that tells producers and consumers whether the slot is ready for
+	 * them, so both sides only contend on a single compare-exchange of their own position.
+	 * @tparam T Item type, only needs to be move constructible and move assignable.
+	 * @tparam Alloc Allocator used for the slots.
+	 * @tparam Factory Factory used to construct and destroy items in the slots.
+	 */
+	template <typename T, allocator_type Alloc = default_allocator, typed_factory_type Factory = default_factory<T>>
+	class mpmc_queue
+	{
+	public:
+		using value_type = T;
+		using allocator_storage_type = allocator_storage<Alloc>;
+		using allocator_t = Alloc;
+		using factory_storage_type = factory_storage<Factory>;
+		using factory_t = Factory;
+		using typed_alloc_type = typed_allocator<value_type, Alloc, Factory>;
+
+		/**@brief Creates a queue that can hold capacity items.
+		 * @param capacity Maximum amount of items in the queue, needs to be a power of 2 and at least 2.
+		 */
+		explicit mpmc_queue(size_type capacity);
+		mpmc_queue(size_type capacity, const allocator_storage_type& allocStorage);
+
+		mpmc_queue(const mpmc_queue&) = delete;
+		mpmc_queue(mpmc_queue&&) = delete;
+		mpmc_queue& operator=(const mpmc_queue&) = delete;
+		mpmc_queue& operator=(mpmc_queue&&) = delete;
+
+		~mpmc_queue();
+
+		/**@brief Pushes a copy of the item.
+		 * @returns False if the queue was full.
+		 */
+		[[nodiscard]] bool try_push(const value_type& value);
+
+		/**@brief Moves the item into the queue.
+		 * @returns False if the queue was full, in which case value is left untouched.
+		 */
+		[[nodiscard]] bool try_push(value_type&& value);
+
+		/**@brief Constructs an item in place.
+		 * @returns False if the queue was full.
+		 */
+		template <typename... Args>
+		[[nodiscard]] bool try_emplace(Args&&... args);
+
+		/**@brief Moves the oldest available item into out.
+		 * @returns False if the queue was empty.
+		 */
+		[[nodiscard]] bool try_pop(value_type& out);
+
+		/**@brief Approximate amount of items in the queue.
+		 */
+		[[nodiscard]] size_type size_approx() const noexcept;
+
+		[[nodiscard]] [[rythe_always_inline]] size_type capacity() const noexcept { return m_mask + 1ull; }
+
+		[[nodiscard]] [[rythe_always_inline]] constexpr allocator_t& get_allocator() noexcept { return m_alloc.get_allocator(); }
+		[[nodiscard]] [[rythe_always_inline]] constexpr const allocator_t& get_allocator() const noexcept
+		{
+			return m_alloc.get_allocator();
+		}
+
+	private:
+		struct cell
+		{
+			std::atomic<size_type> sequence;
+			alignas(value_type) byte storage[sizeof(value_type)];
+
+			[[nodiscard]] [[rythe_always_inline]] value_type* get() noexcept { return reinterpret_cast<value_type*>(storage); }
+		};
+
+		template <typename... Args>
+		[[nodiscard]] bool push_impl(Args&&... args);
+
+		// Read only after construction.
+		typed_alloc_type m_alloc;
+		cell* m_cells = nullptr;
+		size_type m_mask = 0ull;
+
+		cache_aligned<std::atomic<size_type>> m_enqueuePos{0ull};
+		cache_aligned<std::atomic<size_type>> m_dequeuePos{0ull};
+	};
+} // namespace rsl
+
+#include "mpmc_queue.inl"
@@ -0,0 +1,133 @@
+#pragma once
+#include "mpmc_queue.hpp"
+
+namespace rsl
+{
+	template <typename T, allocator_type Alloc, typed_factory_type Factory>
+	mpmc_queue<T, Alloc, Factory>::mpmc_queue(const size_type capacity)
+		: mpmc_queue(capacity, allocator_storage_type{}) {}
+
+	template <typename T, allocator_type Alloc, typed_factory_type Factory>
+	mpmc_queue<T, Alloc, Factory>::mpmc_queue(const size_type capacity, const allocator_storage_type& allocStorage)
+		: m_alloc(allocStorage),
+		  m_mask(capacity - 1ull)
+	{
+		rsl_assert_invalid_parameters(capacity >= 2ull && (capacity & (capacity - 1ull)) == 0ull);
+
+		m_cells = static_cast<cell*>(m_alloc.get_allocator().allocate(capacity * sizeof(cell), cache_line_size));
+		rsl_assert_invalid_object(m_cells);
+
+		for (size_type i = 0ull; i < capacity; i++)
+		{
+			new (&m_cells[i].sequence) std::atomic<size_type>(i);
+		}
+	}
+
+	template <typename T, allocator_type Alloc, typed_factory_type Factory>
+	mpmc_queue<T, Alloc, Factory>::~mpmc_queue()
+	{
+		const size_type enqueuePos = m_enqueuePos->load(std::memory_order_relaxed);
+		for (size_type pos = m_dequeuePos->load(std::memory_order_relaxed); pos != enqueuePos; ++pos)
+		{
+			m_alloc.destroy(m_cells[pos & m_mask].get(), 1ull);
+		}
+
+		m_alloc.get_allocator().deallocate(m_cells, capacity() * sizeof(cell), cache_line_size);
+	}
+
+	template <typename T, allocator_type Alloc, typed_factory_type Factory>
+	bool mpmc_queue<T, Alloc, Factory>::try_push(const value_type& value)
+	{
+		return push_impl(value);
+	}
+
+	template <typename T, allocator_type Alloc, typed_factory_type Factory>
+	bool mpmc_queue<T, Alloc, Factory>::try_push(value_type&& value)
+	{
+		return push_impl(rsl::move(value));
+	}
+
+	template <typename T, allocator_type Alloc, typed_factory_type Factory>
+	template <typename... Args>
+	bool mpmc_queue<T, Alloc, Factory>::try_emplace(Args&&... args)
+	{
+		return push_impl(forward<Args>(args)...);
+	}
+
+	template <typename T, allocator_type Alloc, typed_factory_type Factory>
+	template <typename... Args>
+	bool mpmc_queue<T, Alloc, Factory>::push_impl(Args&&... args)
+	{
+		cell* target;
+		size_type pos = m_enqueuePos->load(std::memory_order_relaxed);
+		while (true)
+		{
+			target = &m_cells[pos & m_mask];
+			const size_type sequence = target->sequence.load(std::memory_order_acquire);
+			const diff_type diff = static_cast<diff_type>(sequence) - static_cast<diff_type>(pos);
+
+			if (diff == 0)
+			{
+				if (m_enqueuePos->compare_exchange_weak(pos, pos + 1ull, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (diff < 0)
+			{
+				return false;
+			}
+			else
+			{
+				pos = m_enqueuePos->load(std::memory_order_relaxed);
+			}
+		}
+
+		m_alloc.construct(target->get(), 1ull, forward<Args>(args)...);
+		target->sequence.store(pos + 1ull, std::memory_order_release);
+		return true;
+	}
+
+	template <typename T, allocator_type Alloc, typed_factory_type Factory>
+	bool mpmc_queue<T, Alloc, Factory>::try_pop(value_type& out)
+	{
+		cell* target;
+		size_type pos = m_dequeuePos->load(std::memory_order_relaxed);
+		while (true)
+		{
+			target = &m_cells[pos & m_mask];
+			const size_type sequence = target->sequence.load(std::memory_order_acquire);
+			const diff_type diff = static_cast<diff_type>(sequence) - static_cast<diff_type>(pos + 1ull);
+
+			if (diff == 0)
+			{
+				if (m_dequeuePos->compare_exchange_weak(pos, pos + 1ull, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (diff < 0)
+			{
+				return false;
+			}
+			else
+			{
+				pos = m_dequeuePos->load(std::memory_order_relaxed);
+			}
+		}
+
+		value_type* item = target->get();
+		out = rsl::move(*item);
+		m_alloc.destroy(item, 1ull);
+		target->sequence.store(pos + m_mask + 1ull, std::memory_order_release);
+		return true;
+	}
+
+	template <typename T, allocator_type Alloc, typed_factory_type Factory>
+	size_type mpmc_queue<T, Alloc, Factory>::size_approx() const noexcept
+	{
+		const size_type dequeuePos = m_dequeuePos->load(std::memory_order_relaxed);
+		const size_type enqueuePos = m_enqueuePos->load(std::memory_order_relaxed);
+		return enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0ull;
+	}
+} // namespace rsl
@@ -0,0 +1,118 @@
+#include "mutex.hpp"
+
+#include "../platform/platform.hpp"
+#include "spin_wait.hpp"
+
+namespace rsl
+{
+	namespace
+	{
+		internal::spin_budget mutexSpins;
+		internal::spin_budget sharedMutexSpins;
+	} // namespace
+
+	void mutex::lock_slow() noexcept
+	{
+		const bool acquired = internal::spin_until(
+			mutexSpins,
+			[this]()
+			{
+				uint32 expected = unlocked;
+				return m_state.load(std::memory_order_relaxed) == unlocked &&
+					   m_state.compare_exchange_weak(
+						   expected, locked, std::memory_order_acquire, std::memory_order_relaxed
+					   );
+			}
+		);
+
+		if (acquired)
+		{
+			return;
+		}
+
+		// Once parked we can't know whether other threads are still waiting, so we take the lock as contended.
+		while (m_state.exchange(contended, std::memory_order_acquire) != unlocked)
+		{
+			platform::wait_on_address(m_state, contended);
+		}
+	}
+
+	void mutex::unlock_slow() noexcept
+	{
+		platform::wake_one_on_address(m_state);
+	}
+
+	void shared_mutex::lock_slow() noexcept
+	{
+		if (internal::spin_until(sharedMutexSpins, [this]() { return try_lock(); }))
+		{
+			return;
+		}
+
+		uint32 state = m_state.load(std::memory_order_relaxed);
+		while (true)
+		{
+			if ((state & (writer_flag | reader_mask)) == 0u)
+			{
+				if (m_state.compare_exchange_weak(
+						state, (state | writer_flag) & ~writer_pending_flag, std::memory_order_acquire,
+						std::memory_order_relaxed
+					))
+				{
+					return;
+				}
+				continue;
+			}
+
+			// Announcing the pending writer stops new readers from coming in.
+			const uint32 waiting = state | waiters_flag | writer_pending_flag;
+			if (state != waiting &&
+				!m_state.compare_exchange_weak(state, waiting, std::memory_order_relaxed, std::memory_order_relaxed))
+			{
+				continue;
+			}
+
+			platform::wait_on_address(m_state, waiting);
+			state = m_state.load(std::memory_order_relaxed);
+		}
+	}
+
+	void shared_mutex::lock_shared_slow() noexcept
+	{
+		if (internal::spin_until(sharedMutexSpins, [this]() { return try_lock_shared(); }))
+		{
+			return;
+		}
+
+		uint32 state = m_state.load(std::memory_order_relaxed);
+		while (true)
+		{
+			if ((state & (writer_flag | writer_pending_flag)) == 0u)
+			{
+				if (m_state.compare_exchange_weak(
+						state, state + 1u, std::memory_order_acquire, std::memory_order_relaxed
+					))
+				{
+					return;
+				}
+				continue;
+			}
+
+			const uint32 waiting = state | waiters_flag;
+			if (state != waiting &&
+				!m_state.compare_exchange_weak(state, waiting, std::memory_order_relaxed, std::memory_order_relaxed))
+			{
+				continue;
+			}
+
+			platform::wait_on_address(m_state, waiting);
+			state = m_state.load(std::memory_order_relaxed);
+		}
+	}
+
+	void shared_mutex::wake_waiters() noexcept
+	{
+		// Readers and writers wait on the same word, wake all of them and let them race for it.
+		platform::wake_all_on_address(m_state);
+	}
+} // namespace rsl
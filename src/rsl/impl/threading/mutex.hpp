@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+
+#include "../util/assert.hpp"
+#include "../util/primitives.hpp"
+
+/**
+ * @file mutex.hpp
+ */
+
+namespace rsl
+{
+	/**@class mutex
+	 * @brief Single word lock that spins for a short while before parking the thread on the lock word, so it's cheap
+	 * to embed in large amounts of objects. Satisfies Lockable, std::lock_guard and std::unique_lock work with it.
+	 * @note Not recursive.
+	 */
+	class mutex
+	{
+	public:
+		constexpr mutex() noexcept = default;
+
+		mutex(const mutex&) = delete;
+		mutex& operator=(const mutex&) = delete;
+
+		[[rythe_always_inline]] void lock() noexcept;
+		[[nodiscard]] [[rythe_always_inline]] bool try_lock() noexcept;
+		[[rythe_always_inline]] void unlock() noexcept;
+
+	private:
+		constexpr static uint32 unlocked = 0u;
+		constexpr static uint32 locked = 1u;
+		constexpr static uint32 contended = 2u;
+
+		void lock_slow() noexcept;
+		void unlock_slow() noexcept;
+
+		std::atomic<uint32> m_state{unlocked};
+	};
+
+	/**@class shared_mutex
+	 * @brief Single word reader-writer lock. Waiting writers block new readers so writers don't starve.
+	 * Satisfies SharedLockable, std::shared_lock works with it.
+	 */
+	class shared_mutex
+	{
+	public:
+		constexpr shared_mutex() noexcept = default;
+
+		shared_mutex(const shared_mutex&) = delete;
+		shared_mutex& operator=(const shared_mutex&) = delete;
+
+		[[rythe_always_inline]] void lock() noexcept;
+		[[nodiscard]] [[rythe_always_inline]] bool try_lock() noexcept;
+		[[rythe_always_inline]] void unlock() noexcept;
+
+		[[rythe_always_inline]] void lock_shared() noexcept;
+		[[nodiscard]] [[rythe_always_inline]] bool try_lock_shared() noexcept;
+		[[rythe_always_inline]] void unlock_shared() noexcept;
+
+	private:
+		constexpr static uint32 writer_flag = 1u << 31u;
+		constexpr static uint32 waiters_flag = 1u << 30u;
+		constexpr static uint32 writer_pending_flag = 1u << 29u;
+		constexpr static uint32 reader_mask = writer_pending_flag - 1u;
+
+		void lock_slow() noexcept;
+		void lock_shared_slow() noexcept;
+		void wake_waiters() noexcept;
+
+		std::atomic<uint32> m_state{0u};
+	};
+
+	static_assert(sizeof(mutex) == sizeof(uint32));
+	static_assert(sizeof(shared_mutex) == sizeof(uint32));
+} // namespace rsl
+
+#include "mutex.inl"
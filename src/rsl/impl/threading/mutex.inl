@@ -0,0 +1,98 @@
+#pragma once
+#include "mutex.hpp"
+
+namespace rsl
+{
+	inline void mutex::lock() noexcept
+	{
+		uint32 expected = unlocked;
+		if (!m_state.compare_exchange_strong(expected, locked, std::memory_order_acquire, std::memory_order_relaxed))
+		{
+			lock_slow();
+		}
+	}
+
+	inline bool mutex::try_lock() noexcept
+	{
+		uint32 expected = unlocked;
+		return m_state.compare_exchange_strong(expected, locked, std::memory_order_acquire, std::memory_order_relaxed);
+	}
+
+	inline void mutex::unlock() noexcept
+	{
+		if (m_state.exchange(unlocked, std::memory_order_release) == contended)
+		{
+			unlock_slow();
+		}
+	}
+
+	inline void shared_mutex::lock() noexcept
+	{
+		if (!try_lock())
+		{
+			lock_slow();
+		}
+	}
+
+	inline bool shared_mutex::try_lock() noexcept
+	{
+		uint32 state = m_state.load(std::memory_order_relaxed);
+		while ((state & (writer_flag | reader_mask)) == 0u)
+		{
+			if (m_state.compare_exchange_weak(
+					state, (state | writer_flag) & ~writer_pending_flag, std::memory_order_acquire,
+					std::memory_order_relaxed
+				))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	inline void shared_mutex::unlock() noexcept
+	{
+		const uint32 previous = m_state.fetch_and(~(writer_flag | waiters_flag), std::memory_order_release);
+		if (previous & waiters_flag)
+		{
+			wake_waiters();
+		}
+	}
+
+	inline void shared_mutex::lock_shared() noexcept
+	{
+		if (!try_lock_shared())
+		{
+			lock_shared_slow();
+		}
+	}
+
+	inline bool shared_mutex::try_lock_shared() noexcept
+	{
+		uint32 state = m_state.load(std::memory_order_relaxed);
+		while ((state & (writer_flag | writer_pending_flag)) == 0u)
+		{
+			rsl_assert_rarely((state & reader_mask) != reader_mask);
+			if (m_state.compare_exchange_weak(state, state + 1u, std::memory_order_acquire, std::memory_order_relaxed))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	inline void shared_mutex::unlock_shared() noexcept
+	{
+		const uint32 previous = m_state.fetch_sub(1u, std::memory_order_release);
+		rsl_assert_invalid_operation((previous & reader_mask) != 0u);
+
+		// The last reader out lets waiting writers in.
+		if ((previous & reader_mask) == 1u && (previous & waiters_flag))
+		{
+			m_state.fetch_and(~waiters_flag, std::memory_order_relaxed);
+			wake_waiters();
+		}
+	}
+} // namespace rsl
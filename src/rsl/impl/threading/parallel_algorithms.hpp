@@ -0,0 +1,99 @@
+#pragma once
+
+#include <functional>
+
+#include "../containers/views.hpp"
+#include "../memory/allocator_context.hpp"
+#include "../util/cache_aligned.hpp"
+#include "../util/primitives.hpp"
+#include "job_system.hpp"
+#include "mutex.hpp"
+
+/**
+ * @file parallel_algorithms.hpp
+ */
+
+namespace rsl
+{
+	/**@brief Grain size that lets the algorithm split the range into a few chunks per worker.
+	 */
+	constexpr size_type auto_grain_size = 0ull;
+
+	namespace internal
+	{
+		// Chunks handed out per worker when the grain size is picked automatically, a few more than one so idle
+		// workers have something left to steal when the work isn't evenly spread.
+		constexpr size_type parallel_chunks_per_worker = 8ull;
+		// Sorting and merging less than this isn't worth the job overhead.
+		constexpr size_type parallel_sort_min_grain = 2048ull;
+
+		template <typename T, contiguous_iterator Iter, contiguous_iterator ConstIter>
+		[[nodiscard]] [[rythe_always_inline]] constexpr array_view<T> to_parallel_range(array_view<T, Iter, ConstIter> range
+		) noexcept;
+
+		template <typename T, input_or_output_iterator<T> Iter, input_or_output_iterator<T> ConstIter>
+			requires contiguous_iterator<Iter>
+		[[nodiscard]] [[rythe_always_inline]] constexpr array_view<T>
+		to_parallel_range(iterator_view<T, Iter, ConstIter> range) noexcept;
+
+		template <typename View>
+		using parallel_range_t = decltype(to_parallel_range(declval<remove_cvr_t<View>>()));
+
+		template <typename View>
+		using parallel_value_t = typename parallel_range_t<View>::value_type;
+	} // namespace internal
+
+	/**@brief Views over contiguous memory, array_view and iterator_view with contiguous iterators.
+	 */
+	template <typename View>
+	concept parallel_range = requires(remove_cvr_t<View> view) { internal::to_parallel_range(view); };
+
+	/**@brief Calls func on every element of the range, spread over the workers of the job_system. The range is split
+	 * in half recursively until the parts are no larger than the grain size, so idle workers steal large parts first.
+	 * @param grainSize Amount of elements a single job handles at most, auto_grain_size splits into a few chunks per
+	 * worker. Raise it when func is cheap, lower it when func is expensive or uneven.
+	 * @note Blocks until all elements were visited, the calling thread runs jobs while it waits.
+	 */
+	template <parallel_range View, typename Func>
+	void parallel_for(job_system& jobs, View&& range, Func&& func, size_type grainSize = auto_grain_size);
+
+	/**@brief parallel_for on job_system::shared().
+	 */
+	template <parallel_range View, typename Func>
+	void parallel_for(View&& range, Func&& func, size_type grainSize = auto_grain_size);
+
+	/**@brief Folds the range into a single value with op, `op(op(identity, a), b)`. Every worker folds the chunks it
+	 * runs into its own partial, the partials are combined with op once all chunks are done.
+	 * @param identity Value that op leaves the other operand unchanged for, it starts every partial.
+	 * @param op Associative and commutative operation, called both with (T, element) and with (T, T).
+	 * @note The order in which elements get combined differs between runs, floating point results can vary slightly.
+	 */
+	template <parallel_range View, typename T, typename Op>
+	[[nodiscard]] T
+	parallel_reduce(job_system& jobs, View&& range, T identity, Op&& op, size_type grainSize = auto_grain_size);
+
+	/**@brief parallel_reduce on job_system::shared().
+	 */
+	template <parallel_range View, typename T, typename Op>
+	[[nodiscard]] T parallel_reduce(View&& range, T identity, Op&& op, size_type grainSize = auto_grain_size);
+
+	/**@brief Sorts the range with a parallel merge sort. Chunks of the range are sorted by separate jobs, after which
+	 * sorted runs get merged pairwise until one run is left. Every merge is itself split into independent parts by
+	 * binary searching the split point of the other run, so the last rounds still use all workers.
+	 * @param grainSize Amount of elements sorted or merged by a single job at most.
+	 * @param allocator Allocator for the scratch buffer the runs are merged into, as large as the range.
+	 * @note Not stable.
+	 */
+	template <parallel_range View, typename Compare = std::less<>>
+	void parallel_sort(
+		job_system& jobs, View&& range, Compare&& comp = Compare{}, size_type grainSize = auto_grain_size,
+		pmu_allocator& allocator = *allocator_context::threadSpecificAllocator
+	);
+
+	/**@brief parallel_sort on job_system::shared().
+	 */
+	template <parallel_range View, typename Compare = std::less<>>
+	void parallel_sort(View&& range, Compare&& comp = Compare{}, size_type grainSize = auto_grain_size);
+} // namespace rsl
+
+#include "parallel_algorithms.inl"
@@ -0,0 +1,331 @@
+#pragma once
+#include "parallel_algorithms.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <mutex>
+
+namespace rsl
+{
+	namespace internal
+	{
+		template <typename T, contiguous_iterator Iter, contiguous_iterator ConstIter>
+		constexpr array_view<T> to_parallel_range(array_view<T, Iter, ConstIter> range) noexcept
+		{
+			return array_view<T>::from_buffer(range.data(), range.size());
+		}
+
+		template <typename T, input_or_output_iterator<T> Iter, input_or_output_iterator<T> ConstIter>
+			requires contiguous_iterator<Iter>
+		constexpr array_view<T> to_parallel_range(iterator_view<T, Iter, ConstIter> range) noexcept
+		{
+			T* first = rsl::to_address(range.begin());
+			return array_view<T>::from_buffer(first, static_cast<size_type>(rsl::to_address(range.end()) - first));
+		}
+
+		[[nodiscard]] [[rythe_always_inline]] inline size_type
+		resolve_grain_size(const job_system& jobs, const size_type count, const size_type grainSize) noexcept
+		{
+			if (grainSize != auto_grain_size)
+			{
+				return grainSize;
+			}
+
+			const size_type chunkCount = jobs.worker_count() * parallel_chunks_per_worker;
+			const size_type grain = (count + chunkCount - 1ull) / chunkCount;
+			return grain > 0ull ? grain : 1ull;
+		}
+
+		// Splits [first, last) in half until the part is small enough for leaf, every upper half becomes a child job
+		// of the job that is currently running. Once the job pool runs dry the rest of the range runs right here,
+		// waiting for a slot could deadlock with other splitters that wait for one too.
+		template <typename Leaf>
+		void split_range(job_system& jobs, const size_type first, size_type last, const size_type grain, const Leaf& leaf)
+		{
+			while (last - first > grain)
+			{
+				const size_type middle = first + (last - first) / 2ull;
+				const Leaf* leafPtr = &leaf;
+				const job_handle child = jobs.try_schedule_child(
+					job_system::current_job(),
+					[&jobs, middle, last, grain, leafPtr]() { split_range(jobs, middle, last, grain, *leafPtr); }
+				);
+
+				if (!child.valid())
+				{
+					break;
+				}
+
+				last = middle;
+			}
+
+			leaf(first, last);
+		}
+
+		// Runs leaf over all of [0, count) and returns once every part completed. Leaf always runs inside a job, so it
+		// can attach children of its own to job_system::current_job().
+		template <typename Leaf>
+		void run_split(job_system& jobs, const size_type count, const size_type grain, const Leaf& leaf)
+		{
+			const job_handle root =
+				jobs.schedule([&jobs, count, grain, &leaf]() { split_range(jobs, 0ull, count, grain, leaf); });
+			jobs.wait(root);
+		}
+
+		// Merges the sorted runs [a, aEnd) and [b, bEnd) into out. Large merges are cut in two at the middle of the
+		// longer run and the matching position in the other run, the upper part becomes a child job.
+		template <typename T, typename Compare>
+		void parallel_merge(
+			job_system& jobs, T* a, T* aEnd, T* b, T* bEnd, T* out, const size_type grain, const Compare& comp
+		)
+		{
+			// A grain of at least 2 guarantees that both halves shrink.
+			while (static_cast<size_type>((aEnd - a) + (bEnd - b)) > grain)
+			{
+				const size_type aCount = static_cast<size_type>(aEnd - a);
+				const size_type bCount = static_cast<size_type>(bEnd - b);
+
+				T* aMiddle;
+				T* bMiddle;
+				if (aCount >= bCount)
+				{
+					aMiddle = a + aCount / 2ull;
+					bMiddle = std::lower_bound(b, bEnd, *aMiddle, comp);
+				}
+				else
+				{
+					bMiddle = b + bCount / 2ull;
+					aMiddle = std::upper_bound(a, aEnd, *bMiddle, comp);
+				}
+
+				T* outMiddle = out + (aMiddle - a) + (bMiddle - b);
+				const Compare* compPtr = &comp;
+				const job_handle child = jobs.try_schedule_child(
+					job_system::current_job(),
+					[&jobs, aMiddle, aEnd, bMiddle, bEnd, outMiddle, grain, compPtr]()
+					{ parallel_merge(jobs, aMiddle, aEnd, bMiddle, bEnd, outMiddle, grain, *compPtr); }
+				);
+
+				if (!child.valid())
+				{
+					break;
+				}
+
+				aEnd = aMiddle;
+				bEnd = bMiddle;
+			}
+
+			std::merge(
+				std::make_move_iterator(a), std::make_move_iterator(aEnd), std::make_move_iterator(b),
+				std::make_move_iterator(bEnd), out, comp
+			);
+		}
+	} // namespace internal
+
+	template <parallel_range View, typename Func>
+	void parallel_for(job_system& jobs, View&& range, Func&& func, const size_type grainSize)
+	{
+		const auto elements = internal::to_parallel_range(range);
+		const size_type grain = internal::resolve_grain_size(jobs, elements.size(), grainSize);
+		if (elements.size() <= grain)
+		{
+			for (size_type i = 0ull; i < elements.size(); i++)
+			{
+				func(elements.data()[i]);
+			}
+			return;
+		}
+
+		internal::run_split(
+			jobs, elements.size(), grain,
+			[data = elements.data(), &func](const size_type first, const size_type last)
+			{
+				for (size_type i = first; i < last; i++)
+				{
+					func(data[i]);
+				}
+			}
+		);
+	}
+
+	template <parallel_range View, typename Func>
+	void parallel_for(View&& range, Func&& func, const size_type grainSize)
+	{
+		parallel_for(job_system::shared(), rsl::forward<View>(range), rsl::forward<Func>(func), grainSize);
+	}
+
+	template <parallel_range View, typename T, typename Op>
+	T parallel_reduce(job_system& jobs, View&& range, T identity, Op&& op, const size_type grainSize)
+	{
+		using partial_type = cache_aligned<T>;
+
+		const auto elements = internal::to_parallel_range(range);
+		if (elements.empty())
+		{
+			return identity;
+		}
+
+		const size_type grain = internal::resolve_grain_size(jobs, elements.size(), grainSize);
+		if (elements.size() <= grain)
+		{
+			for (size_type i = 0ull; i < elements.size(); i++)
+			{
+				identity = op(rsl::move(identity), elements.data()[i]);
+			}
+			return identity;
+		}
+
+		// One partial per worker, threads that aren't workers share a last partial behind a lock.
+		const size_type partialCount = jobs.worker_count() + 1ull;
+		pmu_allocator& allocator = *allocator_context::threadSpecificAllocator;
+		partial_type* partials =
+			static_cast<partial_type*>(allocator.allocate(sizeof(partial_type) * partialCount, alignof(partial_type)));
+		rsl_assert_invalid_object(partials);
+
+		for (size_type i = 0ull; i < partialCount; i++)
+		{
+			new (&partials[i]) partial_type(identity);
+		}
+
+		mutex foreignLock;
+
+		internal::run_split(
+			jobs, elements.size(), grain,
+			[data = elements.data(), &jobs, &identity, &op, partials, partialCount,
+			 &foreignLock](const size_type first, const size_type last)
+			{
+				T local = identity;
+				for (size_type i = first; i < last; i++)
+				{
+					local = op(rsl::move(local), data[i]);
+				}
+
+				const size_type worker = jobs.current_worker_index();
+				if (worker != npos)
+				{
+					T& partial = partials[worker].value;
+					partial = op(rsl::move(partial), rsl::move(local));
+				}
+				else
+				{
+					std::lock_guard<mutex> guard(foreignLock);
+					T& partial = partials[partialCount - 1ull].value;
+					partial = op(rsl::move(partial), rsl::move(local));
+				}
+			}
+		);
+
+		for (size_type i = 0ull; i < partialCount; i++)
+		{
+			identity = op(rsl::move(identity), rsl::move(partials[i].value));
+			partials[i].~partial_type();
+		}
+
+		allocator.deallocate(partials, sizeof(partial_type) * partialCount, alignof(partial_type));
+		return identity;
+	}
+
+	template <parallel_range View, typename T, typename Op>
+	T parallel_reduce(View&& range, T identity, Op&& op, const size_type grainSize)
+	{
+		return parallel_reduce(
+			job_system::shared(), rsl::forward<View>(range), rsl::move(identity), rsl::forward<Op>(op), grainSize
+		);
+	}
+
+	template <parallel_range View, typename Compare>
+	void parallel_sort(
+		job_system& jobs, View&& range, Compare&& comp, const size_type grainSize, pmu_allocator& allocator
+	)
+	{
+		using value_type = internal::parallel_value_t<View>;
+
+		const auto elements = internal::to_parallel_range(range);
+		const size_type count = elements.size();
+		value_type* data = elements.data();
+
+		size_type grain = grainSize;
+		if (grain == auto_grain_size)
+		{
+			grain = count / (jobs.worker_count() * internal::parallel_chunks_per_worker);
+			grain = grain > internal::parallel_sort_min_grain ? grain : internal::parallel_sort_min_grain;
+		}
+		grain = grain > 2ull ? grain : 2ull;
+
+		if (count <= grain)
+		{
+			std::sort(data, data + count, comp);
+			return;
+		}
+
+		value_type* scratch =
+			static_cast<value_type*>(allocator.allocate(sizeof(value_type) * count, alignof(value_type)));
+		rsl_assert_invalid_object(scratch);
+
+		// Move the initial runs into the scratch buffer and sort them there.
+		const size_type runCount = (count + grain - 1ull) / grain;
+		internal::run_split(
+			jobs, runCount, 1ull,
+			[data, scratch, count, grain, &comp](const size_type first, const size_type last)
+			{
+				for (size_type run = first; run < last; run++)
+				{
+					const size_type runStart = run * grain;
+					const size_type runEnd = runStart + grain < count ? runStart + grain : count;
+					std::uninitialized_move(data + runStart, data + runEnd, scratch + runStart);
+					std::sort(scratch + runStart, scratch + runEnd, comp);
+				}
+			}
+		);
+
+		// Merge runs pairwise, ping-ponging between the scratch buffer and the range.
+		value_type* source = scratch;
+		value_type* destination = data;
+		for (size_type width = grain; width < count; width *= 2ull)
+		{
+			const size_type pairCount = (count + width * 2ull - 1ull) / (width * 2ull);
+			internal::run_split(
+				jobs, pairCount, 1ull,
+				[&jobs, source, destination, count, width, grain, &comp](const size_type first, const size_type last)
+				{
+					for (size_type pair = first; pair < last; pair++)
+					{
+						const size_type start = pair * width * 2ull;
+						const size_type middle = start + width < count ? start + width : count;
+						const size_type end = middle + width < count ? middle + width : count;
+
+						internal::parallel_merge(
+							jobs, source + start, source + middle, source + middle, source + end, destination + start,
+							grain, comp
+						);
+					}
+				}
+			);
+
+			value_type* previousSource = source;
+			source = destination;
+			destination = previousSource;
+		}
+
+		internal::run_split(
+			jobs, count, grain,
+			[data, scratch, source](const size_type first, const size_type last)
+			{
+				if (source != data)
+				{
+					std::move(scratch + first, scratch + last, data + first);
+				}
+				std::destroy(scratch + first, scratch + last);
+			}
+		);
+
+		allocator.deallocate(scratch, sizeof(value_type) * count, alignof(value_type));
+	}
+
+	template <parallel_range View, typename Compare>
+	void parallel_sort(View&& range, Compare&& comp, const size_type grainSize)
+	{
+		parallel_sort(job_system::shared(), rsl::forward<View>(range), rsl::forward<Compare>(comp), grainSize);
+	}
+} // namespace rsl
@@ -0,0 +1,53 @@
+#include "semaphore.hpp"
+
+#include "../platform/platform.hpp"
+#include "spin_wait.hpp"
+
+namespace rsl
+{
+	namespace
+	{
+		internal::spin_budget semaphoreSpins;
+	} // namespace
+
+	void semaphore::acquire_slow() noexcept
+	{
+		if (internal::spin_until(semaphoreSpins, [this]() { return try_acquire(); }))
+		{
+			return;
+		}
+
+		uint32 state = m_state.load(std::memory_order_relaxed);
+		while (true)
+		{
+			if ((state & count_mask) != 0u)
+			{
+				if (m_state.compare_exchange_weak(
+						state, state - 1u, std::memory_order_acquire, std::memory_order_relaxed
+					))
+				{
+					return;
+				}
+				continue;
+			}
+
+			const uint32 waiting = state | waiters_flag;
+			if (state != waiting &&
+				!m_state.compare_exchange_weak(state, waiting, std::memory_order_relaxed, std::memory_order_relaxed))
+			{
+				continue;
+			}
+
+			platform::wait_on_address(m_state, waiting);
+			state = m_state.load(std::memory_order_relaxed);
+		}
+	}
+
+	void semaphore::wake_waiters() noexcept
+	{
+		// There's no room in the word to count waiters, so every waiter gets woken and the ones that lose the race for
+		// the count flag themselves again.
+		m_state.fetch_and(~waiters_flag, std::memory_order_relaxed);
+		platform::wake_all_on_address(m_state);
+	}
+} // namespace rsl
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+
+#include "../util/assert.hpp"
+#include "../util/primitives.hpp"
+
+/**
+ * @file semaphore.hpp
+ */
+
+namespace rsl
+{
+	/**@class semaphore
+	 * @brief Single word counting semaphore, threads that find no count left park on the counter.
+	 */
+	class semaphore
+	{
+	public:
+		constexpr static uint32 max_count = (1u << 31u) - 1u;
+
+		constexpr explicit semaphore(uint32 initialCount = 0u) noexcept
+			: m_state(initialCount) {}
+
+		semaphore(const semaphore&) = delete;
+		semaphore& operator=(const semaphore&) = delete;
+
+		/**@brief Takes one from the count, waits until there is one to take.
+		 */
+		[[rythe_always_inline]] void acquire() noexcept;
+		[[nodiscard]] [[rythe_always_inline]] bool try_acquire() noexcept;
+
+		/**@brief Adds to the count and wakes up waiting threads.
+		 */
+		[[rythe_always_inline]] void release(uint32 count = 1u) noexcept;
+
+		[[nodiscard]] [[rythe_always_inline]] uint32 count_approx() const noexcept
+		{
+			return m_state.load(std::memory_order_relaxed) & count_mask;
+		}
+
+	private:
+		constexpr static uint32 waiters_flag = 1u << 31u;
+		constexpr static uint32 count_mask = waiters_flag - 1u;
+
+		void acquire_slow() noexcept;
+		void wake_waiters() noexcept;
+
+		std::atomic<uint32> m_state;
+	};
+
+	static_assert(sizeof(semaphore) == sizeof(uint32));
+} // namespace rsl
+
+#include "semaphore.inl"
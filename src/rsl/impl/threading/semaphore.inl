@@ -0,0 +1,38 @@
+#pragma once
+#include "semaphore.hpp"
+
+namespace rsl
+{
+	inline void semaphore::acquire() noexcept
+	{
+		if (!try_acquire())
+		{
+			acquire_slow();
+		}
+	}
+
+	inline bool semaphore::try_acquire() noexcept
+	{
+		uint32 state = m_state.load(std::memory_order_relaxed);
+		while ((state & count_mask) != 0u)
+		{
+			if (m_state.compare_exchange_weak(state, state - 1u, std::memory_order_acquire, std::memory_order_relaxed))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	inline void semaphore::release(const uint32 count) noexcept
+	{
+		const uint32 previous = m_state.fetch_add(count, std::memory_order_release);
+		rsl_assert_out_of_range((previous & count_mask) + count <= max_count);
+
+		if (previous & waiters_flag)
+		{
+			wake_waiters();
+		}
+	}
+} // namespace rsl
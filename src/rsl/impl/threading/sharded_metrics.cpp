@@ -0,0 +1,243 @@
+#include "sharded_metrics.hpp"
+
+#include <bit>
+#include <mutex>
+
+#include "../platform/platform.hpp"
+#include "mutex.hpp"
+
+namespace rsl
+{
+	namespace
+	{
+		mutex registryLock;
+		sharded_counter* registeredCounters = nullptr;
+		sharded_histogram* registeredHistograms = nullptr;
+
+		[[nodiscard]] size_type resolve_shard_count(const size_type shardCount)
+		{
+			if (shardCount != auto_shard_count)
+			{
+				rsl_assert_invalid_parameters(std::has_single_bit(shardCount));
+				return shardCount;
+			}
+
+			return std::bit_ceil(static_cast<size_type>(platform::hardware_concurrency()));
+		}
+
+		template <typename Shard>
+		[[nodiscard]] Shard* allocate_shards(pmu_allocator& allocator, const size_type shardCount)
+		{
+			Shard* shards = static_cast<Shard*>(allocator.allocate(sizeof(Shard) * shardCount, alignof(Shard)));
+			rsl_assert_invalid_object(shards);
+
+			for (size_type i = 0ull; i < shardCount; i++)
+			{
+				new (&shards[i]) Shard();
+			}
+
+			return shards;
+		}
+
+		template <typename Shard>
+		void deallocate_shards(pmu_allocator& allocator, Shard* shards, const size_type shardCount) noexcept
+		{
+			for (size_type i = 0ull; i < shardCount; i++)
+			{
+				shards[i].~Shard();
+			}
+
+			allocator.deallocate(shards, sizeof(Shard) * shardCount, alignof(Shard));
+		}
+	} // namespace
+
+	sharded_counter::sharded_counter(const string_view name, const size_type shardCount, pmu_allocator& allocator)
+		: m_name(name),
+		  m_allocator(&allocator),
+		  m_shardCount(resolve_shard_count(shardCount))
+	{
+		m_shards = allocate_shards<shard>(*m_allocator, m_shardCount);
+		if (!m_name.empty())
+		{
+			metrics_registry::add(*this);
+		}
+	}
+
+	sharded_counter::~sharded_counter()
+	{
+		if (!m_name.empty())
+		{
+			metrics_registry::remove(*this);
+		}
+
+		deallocate_shards(*m_allocator, m_shards, m_shardCount);
+	}
+
+	int64 sharded_counter::value() const noexcept
+	{
+		int64 result = 0;
+		for (size_type i = 0ull; i < m_shardCount; i++)
+		{
+			result += m_shards[i].value.load(memory_order::relaxed);
+		}
+
+		return result;
+	}
+
+	float64 histogram_snapshot::mean() const noexcept
+	{
+		return count == 0ull ? 0.0 : static_cast<float64>(sum) / static_cast<float64>(count);
+	}
+
+	uint64 histogram_snapshot::percentile(const float64 fraction) const noexcept
+	{
+		rsl_assert_invalid_parameters(fraction >= 0.0 && fraction <= 1.0);
+		if (count == 0ull)
+		{
+			return 0ull;
+		}
+
+		// Rank of the value we're looking for, at least the first value.
+		uint64 rank = static_cast<uint64>(fraction * static_cast<float64>(count) + 0.5);
+		rank = rank == 0ull ? 1ull : rank;
+
+		uint64 seen = 0ull;
+		for (size_type bucket = 0ull; bucket < bucket_count; bucket++)
+		{
+			seen += buckets[bucket];
+			if (seen >= rank)
+			{
+				const uint64 bound = bucket_upper_bound(bucket);
+				return bound < max ? bound : max;
+			}
+		}
+
+		return max;
+	}
+
+	sharded_histogram::sharded_histogram(const string_view name, const size_type shardCount, pmu_allocator& allocator)
+		: m_name(name),
+		  m_allocator(&allocator),
+		  m_shardCount(resolve_shard_count(shardCount))
+	{
+		m_shards = allocate_shards<shard>(*m_allocator, m_shardCount);
+		if (!m_name.empty())
+		{
+			metrics_registry::add(*this);
+		}
+	}
+
+	sharded_histogram::~sharded_histogram()
+	{
+		if (!m_name.empty())
+		{
+			metrics_registry::remove(*this);
+		}
+
+		deallocate_shards(*m_allocator, m_shards, m_shardCount);
+	}
+
+	histogram_snapshot sharded_histogram::snapshot() const noexcept
+	{
+		histogram_snapshot result;
+		for (size_type i = 0ull; i < m_shardCount; i++)
+		{
+			const shard& source = m_shards[i];
+			for (size_type bucket = 0ull; bucket < histogram_snapshot::bucket_count; bucket++)
+			{
+				const uint64 amount = source.buckets[bucket].load(memory_order::relaxed);
+				result.buckets[bucket] += amount;
+				result.count += amount;
+			}
+
+			result.sum += source.sum.load(memory_order::relaxed);
+
+			const uint64 max = source.max.load(memory_order::relaxed);
+			result.max = max > result.max ? max : result.max;
+		}
+
+		return result;
+	}
+
+	void metrics_registry::snapshot(metrics_snapshot& output)
+	{
+		output.counters.clear();
+		output.histograms.clear();
+
+		std::lock_guard guard(registryLock);
+		for (const sharded_counter* counter = registeredCounters; counter; counter = counter->m_nextRegistered)
+		{
+			output.counters.push_back(counter_sample{.name = counter->m_name, .value = counter->value()});
+		}
+
+		for (const sharded_histogram* histogram = registeredHistograms; histogram;
+			 histogram = histogram->m_nextRegistered)
+		{
+			output.histograms.push_back(histogram_sample{.name = histogram->m_name, .snapshot = histogram->snapshot()});
+		}
+	}
+
+	metrics_snapshot metrics_registry::snapshot()
+	{
+		metrics_snapshot result;
+		snapshot(result);
+		return result;
+	}
+
+	template <typename T>
+	void metrics_registry::link(T*& head, T& item) noexcept
+	{
+		item.m_prevRegistered = nullptr;
+		item.m_nextRegistered = head;
+		if (head)
+		{
+			head->m_prevRegistered = &item;
+		}
+		head = &item;
+	}
+
+	template <typename T>
+	void metrics_registry::unlink(T*& head, T& item) noexcept
+	{
+		if (item.m_prevRegistered)
+		{
+			item.m_prevRegistered->m_nextRegistered = item.m_nextRegistered;
+		}
+		else
+		{
+			head = item.m_nextRegistered;
+		}
+
+		if (item.m_nextRegistered)
+		{
+			item.m_nextRegistered->m_prevRegistered = item.m_prevRegistered;
+		}
+
+		item.m_prevRegistered = nullptr;
+		item.m_nextRegistered = nullptr;
+	}
+
+	void metrics_registry::add(sharded_counter& counter)
+	{
+		std::lock_guard guard(registryLock);
+		link(registeredCounters, counter);
+	}
+
+	void metrics_registry::remove(sharded_counter& counter)
+	{
+		std::lock_guard guard(registryLock);
+		unlink(registeredCounters, counter);
+	}
+
+	void metrics_registry::add(sharded_histogram& histogram)
+	{
+		std::lock_guard guard(registryLock);
+		link(registeredHistograms, histogram);
+	}
+
+	void metrics_registry::remove(sharded_histogram& histogram)
+	{
+		std::lock_guard guard(registryLock);
+		unlink(registeredHistograms, histogram);
+	}
+} // namespace rsl
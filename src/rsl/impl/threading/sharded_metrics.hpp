@@ -0,0 +1,189 @@
+#pragma once
+
+#include "../containers/array.hpp"
+#include "../containers/views.hpp"
+#include "../memory/allocator_context.hpp"
+#include "../util/atomic.hpp"
+#include "../util/cache_aligned.hpp"
+#include "../util/primitives.hpp"
+#include "current_thread.hpp"
+
+/**
+ * @file sharded_metrics.hpp
+ */
+
+namespace rsl
+{
+	/**@brief Picks one shard per logical cpu, rounded up to a power of two.
+	 */
+	constexpr size_type auto_shard_count = 0ull;
+
+	/**@class sharded_counter
+	 * @brief Counter for hot paths. Every thread adds to its own cache line and reads sum all of them, so adding costs
+	 * the same no matter how many threads do it at once. Thread indices map onto shards modulo the shard count, threads
+	 * beyond the shard count share a shard with a lower index.
+	 * @note Named counters show up in metrics_registry snapshots, the name needs to outlive the counter.
+	 */
+	class sharded_counter
+	{
+	public:
+		/**@param shardCount Power of two, or auto_shard_count.
+		 */
+		explicit sharded_counter(
+			string_view name = string_view{}, size_type shardCount = auto_shard_count,
+			pmu_allocator& allocator = *allocator_context::globalAllocator
+		);
+
+		sharded_counter(const sharded_counter&) = delete;
+		sharded_counter(sharded_counter&&) = delete;
+		sharded_counter& operator=(const sharded_counter&) = delete;
+		sharded_counter& operator=(sharded_counter&&) = delete;
+
+		~sharded_counter();
+
+		[[rythe_always_inline]] void add(int64 amount) noexcept;
+		[[rythe_always_inline]] void increment() noexcept { add(1); }
+
+		/**@brief Sum of all shards. Adds that happen at the same time may or may not be included.
+		 */
+		[[nodiscard]] int64 value() const noexcept;
+
+		[[nodiscard]] [[rythe_always_inline]] string_view name() const noexcept { return m_name; }
+		[[nodiscard]] [[rythe_always_inline]] size_type shard_count() const noexcept { return m_shardCount; }
+
+	private:
+		friend class metrics_registry;
+
+		using shard = cache_aligned<atomic<int64>>;
+
+		string_view m_name;
+		pmu_allocator* m_allocator;
+		shard* m_shards;
+		size_type m_shardCount;
+
+		sharded_counter* m_prevRegistered = nullptr;
+		sharded_counter* m_nextRegistered = nullptr;
+	};
+
+	/**@struct histogram_snapshot
+	 * @brief Summed contents of a sharded_histogram. Bucket 0 counts zeroes, bucket n counts values in
+	 * [2^(n-1), 2^n).
+	 */
+	struct histogram_snapshot
+	{
+		constexpr static size_type bucket_count = 65ull;
+
+		uint64 buckets[bucket_count] = {};
+		uint64 count = 0ull;
+		uint64 sum = 0ull;
+		uint64 max = 0ull;
+
+		[[nodiscard]] [[rythe_always_inline]] constexpr static size_type bucket_of(uint64 value) noexcept;
+		[[nodiscard]] [[rythe_always_inline]] constexpr static uint64 bucket_upper_bound(size_type bucket) noexcept;
+
+		[[nodiscard]] float64 mean() const noexcept;
+
+		/**@brief Upper bound of the bucket that contains the given fraction of the values, never more than max.
+		 * @param fraction In [0, 1], 0.99 gives the 99th percentile.
+		 */
+		[[nodiscard]] uint64 percentile(float64 fraction) const noexcept;
+	};
+
+	/**@class sharded_histogram
+	 * @brief Distribution of values in power of two buckets, for latencies and sizes on hot paths. Shards the same way
+	 * sharded_counter does, a shard is the buckets plus the sum and max of one thread.
+	 * @note Named histograms show up in metrics_registry snapshots, the name needs to outlive the histogram.
+	 */
+	class sharded_histogram
+	{
+	public:
+		/**@param shardCount Power of two, or auto_shard_count.
+		 */
+		explicit sharded_histogram(
+			string_view name = string_view{}, size_type shardCount = auto_shard_count,
+			pmu_allocator& allocator = *allocator_context::globalAllocator
+		);
+
+		sharded_histogram(const sharded_histogram&) = delete;
+		sharded_histogram(sharded_histogram&&) = delete;
+		sharded_histogram& operator=(const sharded_histogram&) = delete;
+		sharded_histogram& operator=(sharded_histogram&&) = delete;
+
+		~sharded_histogram();
+
+		[[rythe_always_inline]] void record(uint64 value) noexcept;
+
+		/**@brief Sums all shards. Records that happen at the same time may or may not be included.
+		 */
+		[[nodiscard]] histogram_snapshot snapshot() const noexcept;
+
+		[[nodiscard]] [[rythe_always_inline]] string_view name() const noexcept { return m_name; }
+		[[nodiscard]] [[rythe_always_inline]] size_type shard_count() const noexcept { return m_shardCount; }
+
+	private:
+		friend class metrics_registry;
+
+		struct alignas(cache_line_size) shard
+		{
+			atomic<uint64> buckets[histogram_snapshot::bucket_count];
+			atomic<uint64> sum;
+			atomic<uint64> max;
+		};
+
+		string_view m_name;
+		pmu_allocator* m_allocator;
+		shard* m_shards;
+		size_type m_shardCount;
+
+		sharded_histogram* m_prevRegistered = nullptr;
+		sharded_histogram* m_nextRegistered = nullptr;
+	};
+
+	struct counter_sample
+	{
+		string_view name;
+		int64 value;
+	};
+
+	struct histogram_sample
+	{
+		string_view name;
+		histogram_snapshot snapshot;
+	};
+
+	struct metrics_snapshot
+	{
+		dynamic_array<counter_sample> counters;
+		dynamic_array<histogram_sample> histograms;
+	};
+
+	/**@class metrics_registry
+	 * @brief Every named sharded_counter and sharded_histogram that currently exists, for always-on metrics that get
+	 * read out from a single place.
+	 */
+	class metrics_registry
+	{
+	public:
+		/**@brief Reads every registered counter and histogram. Clears output first, reusing it keeps its storage.
+		 */
+		static void snapshot(metrics_snapshot& output);
+		[[nodiscard]] static metrics_snapshot snapshot();
+
+	private:
+		friend class sharded_counter;
+		friend class sharded_histogram;
+
+		static void add(sharded_counter& counter);
+		static void remove(sharded_counter& counter);
+		static void add(sharded_histogram& histogram);
+		static void remove(sharded_histogram& histogram);
+
+		// Intrusive list threaded through m_prevRegistered and m_nextRegistered, new items go in front.
+		template <typename T>
+		static void link(T*& head, T& item) noexcept;
+		template <typename T>
+		static void unlink(T*& head, T& item) noexcept;
+	};
+} // namespace rsl
+
+#include "sharded_metrics.inl"
@@ -0,0 +1,43 @@
+#pragma once
+#include "sharded_metrics.hpp"
+
+#include <bit>
+
+namespace rsl
+{
+	inline void sharded_counter::add(const int64 amount) noexcept
+	{
+		// Threads beyond the shard count share shards with the ones below it, so even the first thread of a shard needs
+		// the add to be atomic. Without other threads on the line it's an uncontended locked add.
+		m_shards[current_thread::get_index() & (m_shardCount - 1ull)].value.fetch_add(amount, memory_order::relaxed);
+	}
+
+	constexpr size_type histogram_snapshot::bucket_of(const uint64 value) noexcept
+	{
+		return static_cast<size_type>(std::bit_width(value));
+	}
+
+	constexpr uint64 histogram_snapshot::bucket_upper_bound(const size_type bucket) noexcept
+	{
+		if (bucket == 0ull)
+		{
+			return 0ull;
+		}
+
+		return bucket >= 64ull ? ~0ull : (1ull << bucket) - 1ull;
+	}
+
+	inline void sharded_histogram::record(const uint64 value) noexcept
+	{
+		shard& target = m_shards[current_thread::get_index() & (m_shardCount - 1ull)];
+
+		target.buckets[histogram_snapshot::bucket_of(value)].fetch_add(1ull, memory_order::relaxed);
+		target.sum.fetch_add(value, memory_order::relaxed);
+
+		// Only values above the current max need the compare-exchange, which stops being the case soon enough.
+		uint64 max = target.max.load(memory_order::relaxed);
+		while (value > max && !target.max.compare_exchange_weak(max, value, memory_order::relaxed))
+		{
+		}
+	}
+} // namespace rsl
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+
+#include "../defines.hpp"
+#include "../platform/platform.hpp"
+#include "../util/primitives.hpp"
+
+/**
+ * @file spin_wait.hpp
+ */
+
+namespace rsl::internal
+{
+	/**@class spin_budget
+	 * @brief Rounds of exponential backoff a waiting thread spins before it parks, adapted to how spinning went before.
+	 * Every spin that ends with the wait being over allows one more round next time, every spin that ends in parking one
+	 * less. Locks that are held briefly drift towards the maximum, long held or oversubscribed ones towards the minimum.
+	 * The primitives are a single word, so they can't keep a budget per object. Each kind of primitive shares one.
+	 */
+	class spin_budget
+	{
+	public:
+		// Round n pauses 2^n times, the minimum keeps probing whether spinning started paying off again, the maximum is
+		// around 30 microseconds.
+		constexpr static uint32 min_rounds = 2u;
+		constexpr static uint32 max_rounds = 10u;
+		constexpr static uint32 initial_rounds = 5u;
+
+		constexpr spin_budget() noexcept = default;
+
+		[[nodiscard]] [[rythe_always_inline]] uint32 rounds() const noexcept
+		{
+			return m_rounds.load(std::memory_order_relaxed);
+		}
+
+		[[rythe_always_inline]] void update(const uint32 rounds, const bool succeeded) noexcept
+		{
+			// Only written when the budget changes, so settled budgets don't bounce between cores.
+			if (succeeded && rounds < max_rounds)
+			{
+				m_rounds.store(rounds + 1u, std::memory_order_relaxed);
+			}
+			else if (!succeeded && rounds > min_rounds)
+			{
+				m_rounds.store(rounds - 1u, std::memory_order_relaxed);
+			}
+		}
+
+	private:
+		std::atomic<uint32> m_rounds{initial_rounds};
+	};
+
+	/**@brief With a single cpu the thread we're waiting on can't make progress while we spin. Checked once, querying
+	 * the cpus on every wait would cost more than the spinning saves.
+	 */
+	[[nodiscard]] inline bool can_spin() noexcept
+	{
+		static const bool multipleCpus = platform::hardware_concurrency() > 1u;
+		return multipleCpus;
+	}
+
+	/**@brief Spins with exponential backoff until pred returns true or the spin budget ran out. Spinning avoids the
+	 * cost of parking for locks that are only held briefly, the backoff keeps the spinning threads off the cache line.
+	 * @returns Whether pred returned true.
+	 */
+	template <typename Pred>
+	[[nodiscard]] bool spin_until(spin_budget& budget, Pred&& pred) noexcept
+	{
+		if (!can_spin())
+		{
+			return pred();
+		}
+
+		const uint32 rounds = budget.rounds();
+		for (uint32 round = 0u; round < rounds; round++)
+		{
+			if (pred())
+			{
+				budget.update(rounds, true);
+				return true;
+			}
+
+			for (uint32 i = 0u; i < (1u << round); i++)
+			{
+				rythe_pause_instruction();
+			}
+		}
+
+		const bool succeeded = pred();
+		budget.update(rounds, succeeded);
+		return succeeded;
+	}
+} // namespace rsl::internal
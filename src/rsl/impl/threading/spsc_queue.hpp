@@ -0,0 +1,128 @@
+#pragma once
+
+#include <atomic>
+
+#include "../containers/views.hpp"
+#include "../memory/typed_allocator.hpp"
+#include "../util/assert.hpp"
+#include "../util/cache_aligned.hpp"
+#include "../util/primitives.hpp"
+
+/**
+ * @file spsc_queue.hpp
+ */
+
+namespace rsl
+{
+	/**@class spsc_queue
+	 * @brief Bounded lock-free ring buffer for exactly one producer thread and one consumer thread.
+	 * The head and tail indices live on separate cache lines, and each side keeps a cached copy of the other side's index
+	 * so the shared index is only re-read when the queue appears full or empty.
+	 * @tparam T Item type, only needs to be move constructible and move assignable.
+	 * @tparam Capacity Maximum amount of items in the queue, needs to be a power of 2.
+	 * @tparam Alloc Allocator used for the ring buffer.
+	 * @tparam Factory Factory used to construct and destroy items in the ring buffer.
+	 * @note Pushing functions may only be called from the producer thread, popping functions only from the consumer thread.
+	 */
+	template <typename T, size_type Capacity, allocator_type Alloc = default_allocator, typed_factory_type Factory = default_factory<T>>
+	class spsc_queue
+	{
+		static_assert(Capacity >= 2ull && (Capacity & (Capacity - 1ull)) == 0ull, "Capacity needs to be a power of 2.");
+
+	public:
+		using value_type = T;
+		using allocator_storage_type = allocator_storage<Alloc>;
+		using allocator_t = Alloc;
+		using factory_storage_type = factory_storage<Factory>;
+		using factory_t = Factory;
+		using typed_alloc_type = typed_allocator<value_type, Alloc, Factory>;
+
+		constexpr static size_type static_capacity = Capacity;
+
+		spsc_queue();
+		explicit spsc_queue(const allocator_storage_type& allocStorage);
+
+		spsc_queue(const spsc_queue&) = delete;
+		spsc_queue(spsc_queue&&) = delete;
+		spsc_queue& operator=(const spsc_queue&) = delete;
+		spsc_queue& operator=(spsc_queue&&) = delete;
+
+		~spsc_queue();
+
+		/**@brief Pushes a copy of the item. Producer only.
+		 * @returns False if the queue was full.
+		 */
+		[[nodiscard]] bool try_push(const value_type& value);
+
+		/**@brief Moves the item into the queue. Producer only.
+		 * @returns False if the queue was full, in which case value is left untouched.
+		 */
+		[[nodiscard]] bool try_push(value_type&& value);
+
+		/**@brief Constructs an item in place. Producer only.
+		 * @returns False if the queue was full.
+		 */
+		template <typename... Args>
+		[[nodiscard]] bool try_emplace(Args&&... args);
+
+		/**@brief Moves as many items as fit into the queue, publishing them all at once. Producer only.
+		 * @returns Amount of items moved from the front of values.
+		 */
+		size_type try_push_bulk(array_view<value_type> values);
+
+		/**@brief Moves the oldest item into out. Consumer only.
+		 * @returns False if the queue was empty.
+		 */
+		[[nodiscard]] bool try_pop(value_type& out);
+
+		/**@brief Moves up to out.size() items into out, releasing their slots all at once. Consumer only.
+		 * @returns Amount of items written to the front of out.
+		 */
+		size_type try_pop_bulk(array_view<value_type> out);
+
+		/**@brief Amount of items in the queue.
+		 * @note Only a snapshot when called while the other side is active.
+		 */
+		[[nodiscard]] size_type size() const noexcept;
+
+		/**@brief Whether the queue is empty.
+		 * @note Only a snapshot when called while the other side is active.
+		 */
+		[[nodiscard]] bool empty() const noexcept;
+
+		[[nodiscard]] [[rythe_always_inline]] constexpr static size_type capacity() noexcept { return Capacity; }
+
+		[[nodiscard]] [[rythe_always_inline]] constexpr allocator_t& get_allocator() noexcept { return m_alloc.get_allocator(); }
+		[[nodiscard]] [[rythe_always_inline]] constexpr const allocator_t& get_allocator() const noexcept
+		{
+			return m_alloc.get_allocator();
+		}
+
+	private:
+		constexpr static size_type index_mask = Capacity - 1ull;
+
+		template <typename... Args>
+		[[nodiscard]] bool push_impl(Args&&... args);
+
+		struct consumer_state
+		{
+			std::atomic<size_type> head{0ull};
+			size_type cachedTail = 0ull;
+		};
+
+		struct producer_state
+		{
+			std::atomic<size_type> tail{0ull};
+			size_type cachedHead = 0ull;
+		};
+
+		cache_aligned<consumer_state> m_consumer;
+		cache_aligned<producer_state> m_producer;
+
+		// Shared and read only after construction, starts on the line after the producer's.
+		typed_alloc_type m_alloc;
+		value_type* m_buffer = nullptr;
+	};
+} // namespace rsl
+
+#include "spsc_queue.inl"
@@ -0,0 +1,157 @@
+#pragma once
+#include "spsc_queue.hpp"
+
+namespace rsl
+{
+	template <typename T, size_type Capacity, allocator_type Alloc, typed_factory_type Factory>
+	spsc_queue<T, Capacity, Alloc, Factory>::spsc_queue()
+		: m_alloc(),
+		  m_buffer(m_alloc.allocate(Capacity, cache_line_size))
+	{
+		rsl_assert_invalid_object(m_buffer);
+	}
+
+	template <typename T, size_type Capacity, allocator_type Alloc, typed_factory_type Factory>
+	spsc_queue<T, Capacity, Alloc, Factory>::spsc_queue(const allocator_storage_type& allocStorage)
+		: m_alloc(allocStorage),
+		  m_buffer(m_alloc.allocate(Capacity, cache_line_size))
+	{
+		rsl_assert_invalid_object(m_buffer);
+	}
+
+	template <typename T, size_type Capacity, allocator_type Alloc, typed_factory_type Factory>
+	spsc_queue<T, Capacity, Alloc, Factory>::~spsc_queue()
+	{
+		const size_type tail = m_producer->tail.load(std::memory_order_relaxed);
+		for (size_type head = m_consumer->head.load(std::memory_order_relaxed); head != tail; ++head)
+		{
+			m_alloc.destroy(m_buffer + (head & index_mask), 1ull);
+		}
+
+		m_alloc.deallocate(m_buffer, Capacity, cache_line_size);
+	}
+
+	template <typename T, size_type Capacity, allocator_type Alloc, typed_factory_type Factory>
+	bool spsc_queue<T, Capacity, Alloc, Factory>::try_push(const value_type& value)
+	{
+		return push_impl(value);
+	}
+
+	template <typename T, size_type Capacity, allocator_type Alloc, typed_factory_type Factory>
+	bool spsc_queue<T, Capacity, Alloc, Factory>::try_push(value_type&& value)
+	{
+		return push_impl(rsl::move(value));
+	}
+
+	template <typename T, size_type Capacity, allocator_type Alloc, typed_factory_type Factory>
+	template <typename... Args>
+	bool spsc_queue<T, Capacity, Alloc, Factory>::try_emplace(Args&&... args)
+	{
+		return push_impl(forward<Args>(args)...);
+	}
+
+	template <typename T, size_type Capacity, allocator_type Alloc, typed_factory_type Factory>
+	template <typename... Args>
+	bool spsc_queue<T, Capacity, Alloc, Factory>::push_impl(Args&&... args)
+	{
+		const size_type tail = m_producer->tail.load(std::memory_order_relaxed);
+		if (tail - m_producer->cachedHead == Capacity)
+		{
+			m_producer->cachedHead = m_consumer->head.load(std::memory_order_acquire);
+			if (tail - m_producer->cachedHead == Capacity)
+			{
+				return false;
+			}
+		}
+
+		m_alloc.construct(m_buffer + (tail & index_mask), 1ull, forward<Args>(args)...);
+		m_producer->tail.store(tail + 1ull, std::memory_order_release);
+		return true;
+	}
+
+	template <typename T, size_type Capacity, allocator_type Alloc, typed_factory_type Factory>
+	size_type spsc_queue<T, Capacity, Alloc, Factory>::try_push_bulk(array_view<value_type> values)
+	{
+		const size_type tail = m_producer->tail.load(std::memory_order_relaxed);
+		size_type freeSlots = Capacity - (tail - m_producer->cachedHead);
+		if (freeSlots < values.size())
+		{
+			m_producer->cachedHead = m_consumer->head.load(std::memory_order_acquire);
+			freeSlots = Capacity - (tail - m_producer->cachedHead);
+		}
+
+		const size_type count = values.size() < freeSlots ? values.size() : freeSlots;
+		for (size_type i = 0ull; i < count; i++)
+		{
+			m_alloc.construct(m_buffer + ((tail + i) & index_mask), 1ull, rsl::move(values[i]));
+		}
+
+		if (count != 0ull)
+		{
+			m_producer->tail.store(tail + count, std::memory_order_release);
+		}
+
+		return count;
+	}
+
+	template <typename T, size_type Capacity, allocator_type Alloc, typed_factory_type Factory>
+	bool spsc_queue<T, Capacity, Alloc, Factory>::try_pop(value_type& out)
+	{
+		const size_type head = m_consumer->head.load(std::memory_order_relaxed);
+		if (head == m_consumer->cachedTail)
+		{
+			m_consumer->cachedTail = m_producer->tail.load(std::memory_order_acquire);
+			if (head == m_consumer->cachedTail)
+			{
+				return false;
+			}
+		}
+
+		value_type* slot = m_buffer + (head & index_mask);
+		out = rsl::move(*slot);
+		m_alloc.destroy(slot, 1ull);
+		m_consumer->head.store(head + 1ull, std::memory_order_release);
+		return true;
+	}
+
+	template <typename T, size_type Capacity, allocator_type Alloc, typed_factory_type Factory>
+	size_type spsc_queue<T, Capacity, Alloc, Factory>::try_pop_bulk(array_view<value_type> out)
+	{
+		const size_type head = m_consumer->head.load(std::memory_order_relaxed);
+		size_type available = m_consumer->cachedTail - head;
+		if (available < out.size())
+		{
+			m_consumer->cachedTail = m_producer->tail.load(std::memory_order_acquire);
+			available = m_consumer->cachedTail - head;
+		}
+
+		const size_type count = out.size() < available ? out.size() : available;
+		for (size_type i = 0ull; i < count; i++)
+		{
+			value_type* slot = m_buffer + ((head + i) & index_mask);
+			out[i] = rsl::move(*slot);
+			m_alloc.destroy(slot, 1ull);
+		}
+
+		if (count != 0ull)
+		{
+			m_consumer->head.store(head + count, std::memory_order_release);
+		}
+
+		return count;
+	}
+
+	template <typename T, size_type Capacity, allocator_type Alloc, typed_factory_type Factory>
+	size_type spsc_queue<T, Capacity, Alloc, Factory>::size() const noexcept
+	{
+		const size_type head = m_consumer->head.load(std::memory_order_acquire);
+		const size_type tail = m_producer->tail.load(std::memory_order_acquire);
+		return tail - head;
+	}
+
+	template <typename T, size_type Capacity, allocator_type Alloc, typed_factory_type Factory>
+	bool spsc_queue<T, Capacity, Alloc, Factory>::empty() const noexcept
+	{
+		return size() == 0ull;
+	}
+} // namespace rsl
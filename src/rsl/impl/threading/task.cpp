@@ -0,0 +1,96 @@
+#include "task.hpp"
+
+#include <exception>
+
+namespace rsl
+{
+	namespace internal
+	{
+		namespace
+		{
+			// Keeps the frame itself aligned to what operator new would have given it.
+			constexpr size_type frame_header_size = alignof(std::max_align_t);
+			static_assert(frame_header_size >= sizeof(pmu_allocator*));
+		} // namespace
+
+		void* allocate_coroutine_frame(pmu_allocator& allocator, const size_type size)
+		{
+			byte* memory = static_cast<byte*>(allocator.allocate(size + frame_header_size, frame_header_size));
+			rsl_assert_invalid_object(memory);
+
+			new (memory) pmu_allocator*(&allocator);
+			return memory + frame_header_size;
+		}
+
+		void deallocate_coroutine_frame(void* ptr, const size_type size) noexcept
+		{
+			byte* memory = static_cast<byte*>(ptr) - frame_header_size;
+			pmu_allocator* allocator = *std::launder(reinterpret_cast<pmu_allocator**>(memory));
+			allocator->deallocate(memory, size + frame_header_size, frame_header_size);
+		}
+
+		void* coroutine_frame_allocation::operator new(const size_type size)
+		{
+			return allocate_coroutine_frame(*allocator_context::threadSpecificAllocator, size);
+		}
+
+		void coroutine_frame_allocation::operator delete(void* ptr, const size_type size) noexcept
+		{
+			deallocate_coroutine_frame(ptr, size);
+		}
+
+		void task_promise_base::unhandled_exception() const noexcept
+		{
+			std::terminate();
+		}
+
+		std::coroutine_handle<> when_all_state::arrive(size_type) noexcept
+		{
+			if (remaining.fetch_sub(1ull, std::memory_order_acq_rel) == 1ull)
+			{
+				return continuation;
+			}
+
+			return std::noop_coroutine();
+		}
+
+		std::coroutine_handle<> when_any_state::arrive(const size_type index) noexcept
+		{
+			std::coroutine_handle<> next = std::noop_coroutine();
+
+			size_type expected = npos;
+			if (winner.compare_exchange_strong(expected, index, std::memory_order_acq_rel, std::memory_order_relaxed))
+			{
+				// Only resume the awaiting coroutine if it already finished starting all the tasks.
+				if (flags.fetch_or(won_flag, std::memory_order_acq_rel) & armed_flag)
+				{
+					next = continuation;
+				}
+			}
+
+			release();
+			return next;
+		}
+
+		void when_any_state::release() noexcept
+		{
+			if (references.fetch_sub(1ull, std::memory_order_acq_rel) == 1ull)
+			{
+				pmu_allocator* owner = allocator;
+				this->~when_any_state();
+				owner->deallocate(this, sizeof(when_any_state), alignof(when_any_state));
+			}
+		}
+
+		std::coroutine_handle<> sync_wait_state::arrive(size_type) noexcept
+		{
+			done.store(true, std::memory_order_release);
+			return std::noop_coroutine();
+		}
+	} // namespace internal
+
+	void resume_on_awaitable::await_suspend(const std::coroutine_handle<> handle) const
+	{
+		m_jobs->schedule([handle]() { handle.resume(); });
+	}
+} // namespace rsl
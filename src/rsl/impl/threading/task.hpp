@@ -0,0 +1,346 @@
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <memory>
+#include <tuple>
+
+#include "../memory/allocator_context.hpp"
+#include "../util/assert.hpp"
+#include "../util/primitives.hpp"
+#include "current_thread.hpp"
+#include "job_system.hpp"
+
+/**
+ * @file task.hpp
+ */
+
+namespace rsl
+{
+	template <typename T = void>
+	class task;
+
+	namespace internal
+	{
+		[[nodiscard]] [[rythe_allocating]] void* allocate_coroutine_frame(pmu_allocator& allocator, size_type size);
+		void deallocate_coroutine_frame(void* ptr, size_type size) noexcept;
+
+		/**@class coroutine_frame_allocation
+		 * @brief Allocates coroutine frames from the thread specific allocator, or from the allocator passed after a
+		 * leading std::allocator_arg. The allocator gets stored in front of the frame so the frame can be destroyed from
+		 * any thread.
+		 */
+		class coroutine_frame_allocation
+		{
+		public:
+			[[nodiscard]] static void* operator new(size_type size);
+
+			template <typename... Args>
+			[[nodiscard]] static void* operator new(
+				size_type size, std::allocator_arg_t, pmu_allocator& allocator, Args&&...
+			);
+
+			// Member function coroutines receive the object as first argument.
+			template <typename Class, typename... Args>
+			[[nodiscard]] static void* operator new(
+				size_type size, Class&, std::allocator_arg_t, pmu_allocator& allocator, Args&&...
+			);
+
+			static void operator delete(void* ptr, size_type size) noexcept;
+		};
+
+		template <typename T>
+		class task_promise;
+
+		class task_promise_base : public coroutine_frame_allocation
+		{
+		public:
+			struct final_awaiter
+			{
+				[[nodiscard]] [[rythe_always_inline]] bool await_ready() const noexcept { return false; }
+
+				template <typename Promise>
+				[[nodiscard]] std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept;
+
+				[[rythe_always_inline]] void await_resume() const noexcept {}
+			};
+
+			[[nodiscard]] [[rythe_always_inline]] std::suspend_always initial_suspend() const noexcept { return {}; }
+			[[nodiscard]] [[rythe_always_inline]] final_awaiter final_suspend() const noexcept { return {}; }
+			[[noreturn]] void unhandled_exception() const noexcept;
+
+			void set_continuation(std::coroutine_handle<> continuation) noexcept { m_continuation = continuation; }
+
+		private:
+			std::coroutine_handle<> m_continuation;
+		};
+
+		template <typename T>
+		class task_promise final : public task_promise_base
+		{
+		public:
+			task_promise() noexcept = default;
+			~task_promise();
+
+			task_promise(const task_promise&) = delete;
+			task_promise& operator=(const task_promise&) = delete;
+
+			[[nodiscard]] task<T> get_return_object() noexcept;
+
+			template <typename U>
+			void return_value(U&& value) noexcept(is_nothrow_constructible_v<T, U&&>);
+
+			[[nodiscard]] T& result() & noexcept;
+			[[nodiscard]] T&& result() && noexcept;
+
+		private:
+			alignas(T) byte m_storage[sizeof(T)];
+			bool m_hasValue = false;
+		};
+
+		template <>
+		class task_promise<void> final : public task_promise_base
+		{
+		public:
+			[[nodiscard]] task<void> get_return_object() noexcept;
+
+			[[rythe_always_inline]] void return_void() const noexcept {}
+			[[rythe_always_inline]] void result() const noexcept {}
+		};
+	} // namespace internal
+
+	/**@class task
+	 * @brief Lazily started coroutine. The task starts running when it gets awaited and resumes the awaiting coroutine
+	 * through symmetric transfer when it finishes, so chains of tasks don't grow the stack.
+	 * Frames are allocated from the thread specific allocator, coroutines that take std::allocator_arg followed by a
+	 * pmu_allocator& as their first parameters allocate their frame from that allocator instead, an arena for example.
+	 * @tparam T Type of the value the coroutine co_returns.
+	 * @note Exceptions are not supported, an exception escaping the coroutine terminates.
+	 */
+	template <typename T>
+	class [[nodiscard]] task
+	{
+	public:
+		using value_type = T;
+		using promise_type = internal::task_promise<T>;
+		using handle_type = std::coroutine_handle<promise_type>;
+
+		task() noexcept = default;
+		explicit task(handle_type handle) noexcept
+			: m_handle(handle) {}
+
+		task(task&& other) noexcept;
+		task& operator=(task&& other) noexcept;
+
+		task(const task&) = delete;
+		task& operator=(const task&) = delete;
+
+		~task();
+
+		/**@brief Starts the task and suspends the awaiting coroutine until it finished.
+		 * @returns Reference to the result for lvalue tasks, rvalue reference for rvalue tasks.
+		 */
+		[[nodiscard]] auto operator co_await() & noexcept;
+		[[nodiscard]] auto operator co_await() && noexcept;
+
+		[[nodiscard]] [[rythe_always_inline]] bool valid() const noexcept { return static_cast<bool>(m_handle); }
+
+		/**@brief Whether the coroutine ran to completion. Invalid tasks count as done.
+		 */
+		[[nodiscard]] [[rythe_always_inline]] bool is_done() const noexcept { return !m_handle || m_handle.done(); }
+
+		/**@brief Result of a finished task.
+		 */
+		[[nodiscard]] decltype(auto) result() &;
+		[[nodiscard]] decltype(auto) result() &&;
+
+		[[nodiscard]] [[rythe_always_inline]] handle_type get_handle() const noexcept { return m_handle; }
+
+	private:
+		template <bool Move>
+		struct awaiter;
+
+		handle_type m_handle;
+	};
+
+	/**@class resume_on_awaitable
+	 * @brief Suspends the awaiting coroutine and continues it as a job on the job_system.
+	 */
+	class resume_on_awaitable
+	{
+	public:
+		explicit resume_on_awaitable(job_system& jobs) noexcept
+			: m_jobs(&jobs) {}
+
+		[[nodiscard]] [[rythe_always_inline]] bool await_ready() const noexcept { return false; }
+		void await_suspend(std::coroutine_handle<> handle) const;
+		[[rythe_always_inline]] void await_resume() const noexcept {}
+
+	private:
+		job_system* m_jobs;
+	};
+
+	/**@brief Continues the coroutine on a worker of jobs, `co_await resume_on(jobs);`.
+	 */
+	[[nodiscard]] [[rythe_always_inline]] inline resume_on_awaitable resume_on(job_system& jobs) noexcept
+	{
+		return resume_on_awaitable{jobs};
+	}
+
+	namespace internal
+	{
+		// The last party to arrive resumes the continuation, the awaiting coroutine itself counts as one party.
+		struct when_all_state
+		{
+			std::atomic<size_type> remaining{0ull};
+			std::coroutine_handle<> continuation;
+
+			[[nodiscard]] std::coroutine_handle<> arrive(size_type index) noexcept;
+		};
+
+		// Refcounted since the losing tasks can finish after the awaiting coroutine already moved on.
+		struct when_any_state
+		{
+			constexpr static uint32 armed_flag = 1u;
+			constexpr static uint32 won_flag = 2u;
+
+			std::atomic<size_type> references{0ull};
+			std::atomic<size_type> winner{npos};
+			std::atomic<uint32> flags{0u};
+			std::coroutine_handle<> continuation;
+			pmu_allocator* allocator = nullptr;
+
+			[[nodiscard]] std::coroutine_handle<> arrive(size_type index) noexcept;
+			void release() noexcept;
+		};
+
+		struct sync_wait_state
+		{
+			std::atomic<bool> done{false};
+
+			[[nodiscard]] std::coroutine_handle<> arrive(size_type index) noexcept;
+		};
+
+		/**@class task_runner
+		 * @brief Eagerly destroyed coroutine that awaits a task and reports to State when it finished.
+		 */
+		template <typename State>
+		class task_runner
+		{
+		public:
+			class promise_type : public coroutine_frame_allocation
+			{
+			public:
+				template <typename Task>
+				promise_type(State* state, size_type index, Task&) noexcept
+					: m_state(state),
+					  m_index(index) {}
+
+				struct final_awaiter
+				{
+					[[nodiscard]] [[rythe_always_inline]] bool await_ready() const noexcept { return false; }
+					[[nodiscard]] std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle
+					) noexcept;
+					[[rythe_always_inline]] void await_resume() const noexcept {}
+				};
+
+				[[nodiscard]] task_runner get_return_object() noexcept;
+				[[nodiscard]] [[rythe_always_inline]] std::suspend_always initial_suspend() const noexcept { return {}; }
+				[[nodiscard]] [[rythe_always_inline]] final_awaiter final_suspend() const noexcept { return {}; }
+				[[rythe_always_inline]] void return_void() const noexcept {}
+				[[noreturn]] void unhandled_exception() const noexcept;
+
+			private:
+				State* m_state;
+				size_type m_index;
+			};
+
+			explicit task_runner(std::coroutine_handle<promise_type> handle) noexcept
+				: m_handle(handle) {}
+
+			[[rythe_always_inline]] void start() const { m_handle.resume(); }
+
+		private:
+			std::coroutine_handle<promise_type> m_handle;
+		};
+
+		template <typename State, typename Task>
+		task_runner<State> run_task(State* state, size_type index, Task& task);
+	} // namespace internal
+
+	/**@class when_all_awaitable
+	 * @brief Starts all tasks and resumes the awaiting coroutine once every one of them finished, on the thread that
+	 * finished last. The results stay in the tasks.
+	 */
+	template <typename... Tasks>
+	class when_all_awaitable
+	{
+	public:
+		explicit when_all_awaitable(Tasks&... tasks) noexcept
+			: m_tasks(tasks...) {}
+
+		[[nodiscard]] bool await_ready() const noexcept;
+		[[nodiscard]] bool await_suspend(std::coroutine_handle<> handle);
+		[[rythe_always_inline]] void await_resume() const noexcept {}
+
+	private:
+		std::tuple<Tasks&...> m_tasks;
+		internal::when_all_state m_state;
+	};
+
+	/**@class when_any_awaitable
+	 * @brief Starts all tasks and resumes the awaiting coroutine as soon as the first one finished.
+	 * @returns Index of the task that finished first.
+	 * @note The other tasks keep running, the tasks need to outlive their completion.
+	 */
+	template <typename... Tasks>
+	class when_any_awaitable
+	{
+		static_assert(sizeof...(Tasks) > 0ull, "when_any needs at least one task.");
+
+	public:
+		explicit when_any_awaitable(Tasks&... tasks) noexcept
+			: m_tasks(tasks...) {}
+
+		[[nodiscard]] bool await_ready() noexcept;
+		[[nodiscard]] bool await_suspend(std::coroutine_handle<> handle);
+		[[nodiscard]] size_type await_resume() noexcept;
+
+	private:
+		std::tuple<Tasks&...> m_tasks;
+		internal::when_any_state* m_state = nullptr;
+		size_type m_readyIndex = npos;
+	};
+
+	/**@brief Awaits all tasks, `co_await when_all(a, b, c);`.
+	 */
+	template <typename... Tasks>
+	[[nodiscard]] when_all_awaitable<Tasks...> when_all(Tasks&... tasks) noexcept
+	{
+		return when_all_awaitable<Tasks...>{tasks...};
+	}
+
+	/**@brief Awaits the first task to finish, `size_type first = co_await when_any(a, b);`.
+	 */
+	template <typename... Tasks>
+	[[nodiscard]] when_any_awaitable<Tasks...> when_any(Tasks&... tasks) noexcept
+	{
+		return when_any_awaitable<Tasks...>{tasks...};
+	}
+
+	/**@brief Runs the task from non coroutine code and blocks the calling thread until it finished.
+	 */
+	template <typename T>
+	decltype(auto) sync_wait(task<T>& task);
+	template <typename T>
+	T sync_wait(task<T>&& task);
+
+	/**@brief Runs the task from non coroutine code and runs jobs of the job_system while waiting.
+	 */
+	template <typename T>
+	decltype(auto) sync_wait(job_system& jobs, task<T>& task);
+	template <typename T>
+	T sync_wait(job_system& jobs, task<T>&& task);
+} // namespace rsl
+
+#include "task.inl"
@@ -0,0 +1,346 @@
+#pragma once
+#include "task.hpp"
+
+namespace rsl
+{
+	namespace internal
+	{
+		template <typename... Args>
+		void* coroutine_frame_allocation::operator new(
+			const size_type size, std::allocator_arg_t, pmu_allocator& allocator, Args&&...
+		)
+		{
+			return allocate_coroutine_frame(allocator, size);
+		}
+
+		template <typename Class, typename... Args>
+		void* coroutine_frame_allocation::operator new(
+			const size_type size, Class&, std::allocator_arg_t, pmu_allocator& allocator, Args&&...
+		)
+		{
+			return allocate_coroutine_frame(allocator, size);
+		}
+
+		template <typename Promise>
+		std::coroutine_handle<> task_promise_base::final_awaiter::await_suspend(std::coroutine_handle<Promise> handle
+		) noexcept
+		{
+			const std::coroutine_handle<> continuation = handle.promise().m_continuation;
+			return continuation ? continuation : std::noop_coroutine();
+		}
+
+		template <typename T>
+		task_promise<T>::~task_promise()
+		{
+			if (m_hasValue)
+			{
+				reinterpret_cast<T*>(m_storage)->~T();
+			}
+		}
+
+		template <typename T>
+		task<T> task_promise<T>::get_return_object() noexcept
+		{
+			return task<T>{std::coroutine_handle<task_promise>::from_promise(*this)};
+		}
+
+		template <typename T>
+		template <typename U>
+		void task_promise<T>::return_value(U&& value) noexcept(is_nothrow_constructible_v<T, U&&>)
+		{
+			new (m_storage) T(forward<U>(value));
+			m_hasValue = true;
+		}
+
+		template <typename T>
+		T& task_promise<T>::result() & noexcept
+		{
+			rsl_assert_invalid_operation(m_hasValue);
+			return *std::launder(reinterpret_cast<T*>(m_storage));
+		}
+
+		template <typename T>
+		T&& task_promise<T>::result() && noexcept
+		{
+			rsl_assert_invalid_operation(m_hasValue);
+			return move(*std::launder(reinterpret_cast<T*>(m_storage)));
+		}
+
+		inline task<void> task_promise<void>::get_return_object() noexcept
+		{
+			return task<void>{std::coroutine_handle<task_promise>::from_promise(*this)};
+		}
+	} // namespace internal
+
+	template <typename T>
+	template <bool Move>
+	struct task<T>::awaiter
+	{
+		handle_type handle;
+
+		[[nodiscard]] [[rythe_always_inline]] bool await_ready() const noexcept { return !handle || handle.done(); }
+
+		[[nodiscard]] std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+		{
+			handle.promise().set_continuation(awaiting);
+			return handle;
+		}
+
+		decltype(auto) await_resume()
+		{
+			rsl_assert_invalid_object(handle);
+			if constexpr (Move)
+			{
+				return move(handle.promise()).result();
+			}
+			else
+			{
+				return handle.promise().result();
+			}
+		}
+	};
+
+	template <typename T>
+	task<T>::task(task&& other) noexcept
+		: m_handle(other.m_handle)
+	{
+		other.m_handle = nullptr;
+	}
+
+	template <typename T>
+	task<T>& task<T>::operator=(task&& other) noexcept
+	{
+		if (this != &other)
+		{
+			if (m_handle)
+			{
+				m_handle.destroy();
+			}
+
+			m_handle = other.m_handle;
+			other.m_handle = nullptr;
+		}
+
+		return *this;
+	}
+
+	template <typename T>
+	task<T>::~task()
+	{
+		if (m_handle)
+		{
+			m_handle.destroy();
+		}
+	}
+
+	template <typename T>
+	auto task<T>::operator co_await() & noexcept
+	{
+		return awaiter<false>{m_handle};
+	}
+
+	template <typename T>
+	auto task<T>::operator co_await() && noexcept
+	{
+		return awaiter<true>{m_handle};
+	}
+
+	template <typename T>
+	decltype(auto) task<T>::result() &
+	{
+		rsl_assert_invalid_operation(valid() && is_done());
+		return m_handle.promise().result();
+	}
+
+	template <typename T>
+	decltype(auto) task<T>::result() &&
+	{
+		rsl_assert_invalid_operation(valid() && is_done());
+		return move(m_handle.promise()).result();
+	}
+
+	namespace internal
+	{
+		template <typename State>
+		std::coroutine_handle<> task_runner<State>::promise_type::final_awaiter::await_suspend(
+			std::coroutine_handle<promise_type> handle
+		) noexcept
+		{
+			promise_type& promise = handle.promise();
+			const std::coroutine_handle<> next = promise.m_state->arrive(promise.m_index);
+			handle.destroy();
+			return next;
+		}
+
+		template <typename State>
+		task_runner<State> task_runner<State>::promise_type::get_return_object() noexcept
+		{
+			return task_runner{std::coroutine_handle<promise_type>::from_promise(*this)};
+		}
+
+		template <typename State>
+		void task_runner<State>::promise_type::unhandled_exception() const noexcept
+		{
+			std::terminate();
+		}
+
+		template <typename State, typename Task>
+		task_runner<State> run_task(State*, size_type, Task& task)
+		{
+			co_await task;
+		}
+
+		template <typename... Tasks, typename State>
+		void start_task_runners(std::tuple<Tasks&...>& tasks, State* state)
+		{
+			std::apply(
+				[state](Tasks&... ts)
+				{
+					size_type index = 0ull;
+					(run_task(state, index++, ts).start(), ...);
+				},
+				tasks
+			);
+		}
+	} // namespace internal
+
+	template <typename... Tasks>
+	bool when_all_awaitable<Tasks...>::await_ready() const noexcept
+	{
+		return std::apply([](const Tasks&... ts) { return (ts.is_done() && ...); }, m_tasks);
+	}
+
+	template <typename... Tasks>
+	bool when_all_awaitable<Tasks...>::await_suspend(const std::coroutine_handle<> handle)
+	{
+		m_state.continuation = handle;
+		// One extra count so none of the tasks resumes us before all of them got started.
+		m_state.remaining.store(sizeof...(Tasks) + 1ull, std::memory_order_relaxed);
+
+		internal::start_task_runners(m_tasks, &m_state);
+
+		return m_state.remaining.fetch_sub(1ull, std::memory_order_acq_rel) != 1ull;
+	}
+
+	template <typename... Tasks>
+	bool when_any_awaitable<Tasks...>::await_ready() noexcept
+	{
+		std::apply(
+			[this](const Tasks&... ts)
+			{
+				size_type index = 0ull;
+				const auto check = [this, &index](const auto& t)
+				{
+					if (m_readyIndex == npos && t.is_done())
+					{
+						m_readyIndex = index;
+					}
+					index++;
+				};
+				(check(ts), ...);
+			},
+			m_tasks
+		);
+
+		return m_readyIndex != npos;
+	}
+
+	template <typename... Tasks>
+	bool when_any_awaitable<Tasks...>::await_suspend(const std::coroutine_handle<> handle)
+	{
+		pmu_allocator& allocator = *allocator_context::threadSpecificAllocator;
+		m_state = allocator.allocate<internal::when_any_state>(alignof(internal::when_any_state));
+		rsl_assert_invalid_object(m_state);
+		new (m_state) internal::when_any_state();
+
+		m_state->allocator = &allocator;
+		m_state->continuation = handle;
+		m_state->references.store(sizeof...(Tasks) + 1ull, std::memory_order_relaxed);
+
+		internal::start_task_runners(m_tasks, m_state);
+
+		// If a task already won we continue right away, otherwise the winner resumes us.
+		const uint32 flags = m_state->flags.fetch_or(internal::when_any_state::armed_flag, std::memory_order_acq_rel);
+		return (flags & internal::when_any_state::won_flag) == 0u;
+	}
+
+	template <typename... Tasks>
+	size_type when_any_awaitable<Tasks...>::await_resume() noexcept
+	{
+		if (!m_state)
+		{
+			return m_readyIndex;
+		}
+
+		const size_type winner = m_state->winner.load(std::memory_order_acquire);
+		m_state->release();
+		m_state = nullptr;
+		return winner;
+	}
+
+	namespace internal
+	{
+		template <typename T>
+		void start_sync_wait(sync_wait_state& state, task<T>& task)
+		{
+			run_task(&state, 0ull, task).start();
+		}
+	} // namespace internal
+
+	template <typename T>
+	decltype(auto) sync_wait(task<T>& task)
+	{
+		internal::sync_wait_state state;
+		internal::start_sync_wait(state, task);
+
+		while (!state.done.load(std::memory_order_acquire))
+		{
+			current_thread::yield();
+		}
+
+		return task.result();
+	}
+
+	template <typename T>
+	T sync_wait(task<T>&& task)
+	{
+		if constexpr (is_void_v<T>)
+		{
+			sync_wait(task);
+		}
+		else
+		{
+			return move(sync_wait(task));
+		}
+	}
+
+	template <typename T>
+	decltype(auto) sync_wait(job_system& jobs, task<T>& task)
+	{
+		internal::sync_wait_state state;
+		internal::start_sync_wait(state, task);
+
+		while (!state.done.load(std::memory_order_acquire))
+		{
+			if (!jobs.try_execute_one())
+			{
+				current_thread::yield();
+			}
+		}
+
+		return task.result();
+	}
+
+	template <typename T>
+	T sync_wait(job_system& jobs, task<T>&& task)
+	{
+		if constexpr (is_void_v<T>)
+		{
+			sync_wait(jobs, task);
+		}
+		else
+		{
+			return move(sync_wait(jobs, task));
+		}
+	}
+} // namespace rsl
@@ -0,0 +1,258 @@
+#include "task_graph.hpp"
+
+#include <algorithm>
+
+namespace rsl
+{
+	task_graph::~task_graph()
+	{
+		release_counters();
+	}
+
+	task_node task_graph::add_node(const task_func& func, const string_view name)
+	{
+		m_compiled = false;
+
+		node& entry = m_nodes.emplace_back();
+		entry.func = func;
+		entry.name = name;
+		return task_node{m_nodes.size() - 1ull};
+	}
+
+	void task_graph::add_edge(const task_node before, const task_node after)
+	{
+		rsl_assert_invalid_parameters(before.index < m_nodes.size() && after.index < m_nodes.size());
+		rsl_assert_invalid_parameters(before != after);
+
+		m_compiled = false;
+		m_edges.push_back(edge{.before = before.index, .after = after.index});
+	}
+
+	void task_graph::clear() noexcept
+	{
+		m_compiled = false;
+		m_nodes.clear();
+		m_edges.clear();
+		m_successors.clear();
+		m_order.clear();
+		m_roots.clear();
+		m_criticalPath.clear();
+		m_runTime = span_type{};
+		m_criticalPathTime = span_type{};
+	}
+
+	bool task_graph::compile()
+	{
+		m_compiled = false;
+
+		const size_type nodeCount = m_nodes.size();
+		for (node& entry : m_nodes)
+		{
+			entry.firstSuccessor = 0ull;
+			entry.successorCount = 0ull;
+			entry.dependencyCount = 0u;
+		}
+
+		// Successor lists are stored back to back, count them first so every node knows where its list starts.
+		for (const edge& e : m_edges)
+		{
+			m_nodes[e.before].successorCount++;
+			m_nodes[e.after].dependencyCount++;
+		}
+
+		size_type offset = 0ull;
+		for (node& entry : m_nodes)
+		{
+			entry.firstSuccessor = offset;
+			offset += entry.successorCount;
+			entry.successorCount = 0ull;
+		}
+
+		m_successors.resize(m_edges.size());
+		for (const edge& e : m_edges)
+		{
+			node& before = m_nodes[e.before];
+			m_successors[before.firstSuccessor + before.successorCount++] = e.after;
+		}
+
+		// Kahn's algorithm, m_order doubles as the queue of nodes whose dependencies are all ordered.
+		m_order.clear();
+		m_order.reserve(nodeCount);
+		m_roots.clear();
+
+		if (m_counterCount != nodeCount)
+		{
+			release_counters();
+			if (nodeCount != 0ull)
+			{
+				m_counters = static_cast<std::atomic<uint32>*>(
+					m_allocator->allocate(sizeof(std::atomic<uint32>) * nodeCount, alignof(std::atomic<uint32>))
+				);
+				rsl_assert_invalid_object(m_counters);
+				m_counterCount = nodeCount;
+			}
+		}
+
+		for (size_type i = 0ull; i < nodeCount; i++)
+		{
+			new (&m_counters[i]) std::atomic<uint32>(m_nodes[i].dependencyCount);
+			if (m_nodes[i].dependencyCount == 0u)
+			{
+				m_roots.push_back(i);
+				m_order.push_back(task_node{i});
+			}
+		}
+
+		for (size_type position = 0ull; position < m_order.size(); position++)
+		{
+			const node& entry = m_nodes[m_order[position].index];
+			for (size_type i = 0ull; i < entry.successorCount; i++)
+			{
+				const size_type successor = m_successors[entry.firstSuccessor + i];
+				if (m_counters[successor].fetch_sub(1u, std::memory_order_relaxed) == 1u)
+				{
+					m_order.push_back(task_node{successor});
+				}
+			}
+		}
+
+		if (m_order.size() != nodeCount)
+		{
+			return false;
+		}
+
+		m_criticalPath.clear();
+		m_criticalPath.reserve(nodeCount);
+
+		m_compiled = true;
+		return true;
+	}
+
+	void task_graph::run(job_system& jobs)
+	{
+		rsl_assert_invalid_operation(m_compiled);
+
+		for (size_type i = 0ull; i < m_nodes.size(); i++)
+		{
+			m_counters[i].store(m_nodes[i].dependencyCount, std::memory_order_relaxed);
+		}
+
+		const time::stopwatch<time64> watch;
+
+		// Every node becomes a child of an empty job, waiting on it waits on the whole graph.
+		m_jobs = &jobs;
+		m_runJob = jobs.create([]() {});
+		for (const size_type root : m_roots)
+		{
+			schedule_node(root);
+		}
+
+		jobs.run(m_runJob);
+		jobs.wait(m_runJob);
+
+		m_runTime = watch.end();
+		m_jobs = nullptr;
+		m_runJob = job_handle{};
+
+		update_critical_path();
+	}
+
+	array_view<const task_node> task_graph::topological_order() const noexcept
+	{
+		return array_view<const task_node>::from_buffer(m_order.data(), m_order.size());
+	}
+
+	string_view task_graph::node_name(const task_node node) const noexcept
+	{
+		rsl_assert_out_of_range(node.index < m_nodes.size());
+		return m_nodes[node.index].name;
+	}
+
+	task_graph::span_type task_graph::node_time(const task_node node) const noexcept
+	{
+		rsl_assert_out_of_range(node.index < m_nodes.size());
+		return m_nodes[node.index].duration;
+	}
+
+	array_view<const task_node> task_graph::critical_path() const noexcept
+	{
+		return array_view<const task_node>::from_buffer(m_criticalPath.data(), m_criticalPath.size());
+	}
+
+	void task_graph::schedule_node(const size_type index)
+	{
+		m_jobs->schedule_child(m_runJob, [this, index]() { execute_node(index); });
+	}
+
+	void task_graph::execute_node(const size_type index)
+	{
+		node& entry = m_nodes[index];
+
+		const time::stopwatch<time64> watch;
+		entry.func();
+		entry.duration = watch.end();
+
+		for (size_type i = 0ull; i < entry.successorCount; i++)
+		{
+			const size_type successor = m_successors[entry.firstSuccessor + i];
+			if (m_counters[successor].fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+			{
+				schedule_node(successor);
+			}
+		}
+	}
+
+	void task_graph::update_critical_path() noexcept
+	{
+		for (node& entry : m_nodes)
+		{
+			entry.pathTime = span_type{};
+			entry.pathPredecessor = npos;
+		}
+
+		// Longest path in a DAG, relax the successors of every node in topological order.
+		size_type last = npos;
+		for (const task_node ordered : m_order)
+		{
+			node& entry = m_nodes[ordered.index];
+			entry.pathTime.duration += entry.duration.duration;
+
+			if (last == npos || entry.pathTime.duration > m_nodes[last].pathTime.duration)
+			{
+				last = ordered.index;
+			}
+
+			for (size_type i = 0ull; i < entry.successorCount; i++)
+			{
+				node& successor = m_nodes[m_successors[entry.firstSuccessor + i]];
+				if (successor.pathPredecessor == npos || entry.pathTime.duration > successor.pathTime.duration)
+				{
+					successor.pathTime = entry.pathTime;
+					successor.pathPredecessor = ordered.index;
+				}
+			}
+		}
+
+		m_criticalPath.clear();
+		m_criticalPathTime = last == npos ? span_type{} : m_nodes[last].pathTime;
+
+		for (size_type index = last; index != npos; index = m_nodes[index].pathPredecessor)
+		{
+			m_criticalPath.push_back(task_node{index});
+		}
+
+		std::reverse(m_criticalPath.data(), m_criticalPath.data() + m_criticalPath.size());
+	}
+
+	void task_graph::release_counters() noexcept
+	{
+		if (m_counters)
+		{
+			m_allocator->deallocate(
+				m_counters, sizeof(std::atomic<uint32>) * m_counterCount, alignof(std::atomic<uint32>)
+			);
+			m_counters = nullptr;
+			m_counterCount = 0ull;
+		}
+	}
+} // namespace rsl
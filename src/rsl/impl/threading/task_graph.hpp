@@ -0,0 +1,156 @@
+#pragma once
+
+#include <atomic>
+
+#include "../containers/array.hpp"
+#include "../containers/delegate.hpp"
+#include "../containers/views.hpp"
+#include "../memory/allocator_context.hpp"
+#include "../time/stopwatch.hpp"
+#include "../util/primitives.hpp"
+#include "../util/type_traits.hpp"
+#include "job_system.hpp"
+
+/**
+ * @file task_graph.hpp
+ */
+
+namespace rsl
+{
+	/**@struct task_node
+	 * @brief Handle to a node in a task_graph.
+	 */
+	struct task_node
+	{
+		size_type index = npos;
+
+		[[nodiscard]] [[rythe_always_inline]] bool valid() const noexcept { return index != npos; }
+		[[nodiscard]] [[rythe_always_inline]] bool operator==(const task_node&) const noexcept = default;
+	};
+
+	/**@class task_graph
+	 * @brief Directed acyclic graph of tasks that gets compiled once and can then be run any amount of times. Compiling
+	 * flattens the edges into successor lists and counts the dependencies of every node, running resets those counts
+	 * and schedules a node on the job_system the moment its last dependency finishes, so independent branches never
+	 * wait on each other. Running a compiled graph doesn't allocate.
+	 * Every run measures how long each node took and finds the critical path, the chain of dependent nodes that took
+	 * the longest and with that bounds how fast the graph can run regardless of the amount of workers.
+	 * @note A graph can only run once at a time.
+	 */
+	class task_graph
+	{
+	public:
+		using task_func = delegate<void()>;
+		using span_type = time::span<time64>;
+
+		/**@param allocator Allocator used for the dependency counters.
+		 */
+		explicit task_graph(pmu_allocator& allocator = *allocator_context::globalAllocator) noexcept
+			: m_allocator(&allocator) {}
+
+		task_graph(const task_graph&) = delete;
+		task_graph(task_graph&&) = delete;
+		task_graph& operator=(const task_graph&) = delete;
+		task_graph& operator=(task_graph&&) = delete;
+
+		~task_graph();
+
+		/**@brief Adds a node, invalidates the compiled schedule.
+		 * @param name Name for timing output, needs to outlive the graph.
+		 */
+		task_node add_node(const task_func& func, string_view name = string_view{});
+
+		/**@brief Makes after wait for before, invalidates the compiled schedule.
+		 */
+		void add_edge(task_node before, task_node after);
+
+		/**@brief Removes all nodes and edges.
+		 */
+		void clear() noexcept;
+
+		/**@brief Orders the nodes topologically and builds the successor lists and dependency counts that runs use.
+		 * @returns False if the edges contain a cycle, the graph can't run in that case.
+		 */
+		[[nodiscard]] bool compile();
+
+		[[nodiscard]] [[rythe_always_inline]] bool is_compiled() const noexcept { return m_compiled; }
+
+		/**@brief Runs all nodes on the job_system and returns once all of them finished. The calling thread runs jobs
+		 * while it waits.
+		 */
+		void run(job_system& jobs);
+
+		[[nodiscard]] [[rythe_always_inline]] size_type node_count() const noexcept { return m_nodes.size(); }
+
+		/**@brief Nodes in an order where every node comes after all of its dependencies.
+		 */
+		[[nodiscard]] array_view<const task_node> topological_order() const noexcept;
+
+		[[nodiscard]] string_view node_name(task_node node) const noexcept;
+
+		/**@brief How long the node took during the last run.
+		 */
+		[[nodiscard]] span_type node_time(task_node node) const noexcept;
+
+		/**@brief Wall time of the last run, from scheduling the first nodes until the last node finished.
+		 */
+		[[nodiscard]] [[rythe_always_inline]] span_type last_run_time() const noexcept { return m_runTime; }
+
+		/**@brief Nodes on the critical path of the last run, in execution order.
+		 */
+		[[nodiscard]] array_view<const task_node> critical_path() const noexcept;
+
+		/**@brief Summed time of the nodes on the critical path of the last run. The difference with last_run_time() is
+		 * time spent waiting for workers or in scheduling overhead.
+		 */
+		[[nodiscard]] [[rythe_always_inline]] span_type critical_path_time() const noexcept
+		{
+			return m_criticalPathTime;
+		}
+
+	private:
+		struct node
+		{
+			task_func func;
+			string_view name;
+			size_type firstSuccessor = 0ull;
+			size_type successorCount = 0ull;
+			uint32 dependencyCount = 0u;
+			span_type duration;
+			// Longest chain of node times that ends with this node, and the node before it on that chain.
+			span_type pathTime;
+			size_type pathPredecessor = npos;
+		};
+
+		struct edge
+		{
+			size_type before;
+			size_type after;
+		};
+
+		void schedule_node(size_type index);
+		void execute_node(size_type index);
+		void update_critical_path() noexcept;
+		void release_counters() noexcept;
+
+		pmu_allocator* m_allocator;
+		dynamic_array<node> m_nodes;
+		dynamic_array<edge> m_edges;
+
+		// Compiled schedule.
+		dynamic_array<size_type> m_successors;
+		dynamic_array<task_node> m_order;
+		dynamic_array<size_type> m_roots;
+		std::atomic<uint32>* m_counters = nullptr;
+		size_type m_counterCount = 0ull;
+		bool m_compiled = false;
+
+		// State of the current run.
+		job_system* m_jobs = nullptr;
+		job_handle m_runJob;
+
+		span_type m_runTime;
+		span_type m_criticalPathTime;
+		dynamic_array<task_node> m_criticalPath;
+	};
+} // namespace rsl
@@ -0,0 +1,139 @@
+#include "task_timer.hpp"
+
+#include <algorithm>
+
+#include "../platform/platform.hpp"
+#include "current_thread.hpp"
+
+namespace rsl
+{
+	namespace
+	{
+		// Deadlines closer than this are slept on precisely. Futex timeouts are only as exact as the OS timers, so waits
+		// for later deadlines end this much early and the rest is slept on precisely as well.
+		constexpr auto precise_sleep_window = std::chrono::milliseconds(1);
+
+		// Stands in for "until a sleeper arrives".
+		constexpr auto no_timeout = sleep_awaitable::clock_type::duration::max();
+
+		constexpr auto later_deadline = [](const auto& lhs, const auto& rhs) { return lhs.deadline > rhs.deadline; };
+	} // namespace
+
+	void sleep_awaitable::await_suspend(const std::coroutine_handle<> handle) const
+	{
+		m_timer->add({.deadline = m_deadline, .handle = handle});
+	}
+
+	task_timer::task_timer(job_system* resumeOn, const size_type maxPending, pmu_allocator& allocator)
+		: m_jobs(resumeOn),
+		  m_incoming(maxPending)
+	{
+		m_thread = platform::create_thread(&timer_main, this, "rsl task timer"_sv, allocator);
+	}
+
+	task_timer::~task_timer()
+	{
+		m_running.store(false, std::memory_order_release);
+		m_wakeSignal.fetch_add(1u, std::memory_order_release);
+		platform::wake_one_on_address(m_wakeSignal);
+		m_thread.join();
+	}
+
+	void task_timer::add(const sleeper& entry)
+	{
+		while (!m_incoming.try_push(entry))
+		{
+			current_thread::yield();
+		}
+
+		// Pairs with the fence in wait_for_sleepers, either this sees the timer thread waiting or it sees the sleeper.
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (m_timerWaiting.load(std::memory_order_relaxed))
+		{
+			m_wakeSignal.fetch_add(1u, std::memory_order_release);
+			platform::wake_one_on_address(m_wakeSignal);
+		}
+	}
+
+	void task_timer::resume(const std::coroutine_handle<> handle)
+	{
+		if (m_jobs)
+		{
+			m_jobs->schedule([handle]() { handle.resume(); });
+		}
+		else
+		{
+			handle.resume();
+		}
+	}
+
+	void task_timer::wait_for_sleepers(const clock_type::duration timeout)
+	{
+		m_timerWaiting.store(true, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const uint32 signal = m_wakeSignal.load(std::memory_order_acquire);
+
+		// Sleepers added before the timer thread announced itself don't wake it.
+		if (m_incoming.size_approx() == 0ull && m_running.load(std::memory_order_acquire))
+		{
+			if (timeout == no_timeout)
+			{
+				platform::wait_on_address(m_wakeSignal, signal);
+			}
+			else
+			{
+				platform::wait_on_address(
+					m_wakeSignal, signal, std::chrono::duration_cast<std::chrono::nanoseconds>(timeout)
+				);
+			}
+		}
+
+		m_timerWaiting.store(false, std::memory_order_relaxed);
+	}
+
+	void task_timer::run()
+	{
+		while (m_running.load(std::memory_order_acquire))
+		{
+			sleeper entry;
+			while (m_incoming.try_pop(entry))
+			{
+				m_sleepers.push_back(entry);
+				std::push_heap(m_sleepers.data(), m_sleepers.data() + m_sleepers.size(), later_deadline);
+			}
+
+			const clock_type::time_point now = clock_type::now();
+			while (!m_sleepers.empty() && m_sleepers.front().deadline <= now)
+			{
+				std::pop_heap(m_sleepers.data(), m_sleepers.data() + m_sleepers.size(), later_deadline);
+				const std::coroutine_handle<> handle = m_sleepers.back().handle;
+				m_sleepers.pop_back();
+				resume(handle);
+			}
+
+			if (m_sleepers.empty())
+			{
+				wait_for_sleepers(no_timeout);
+				continue;
+			}
+
+			// New sleepers can only cut a wait short while it's on the futex, not during the precise sleep at the end.
+			const clock_type::duration untilDeadline = m_sleepers.front().deadline - clock_type::now();
+			if (untilDeadline > precise_sleep_window)
+			{
+				wait_for_sleepers(untilDeadline - precise_sleep_window);
+			}
+			else
+			{
+				using timer_point = time::point<time64, clock_type>;
+				current_thread::precise_sleep_until(timer_point{m_sleepers.front().deadline});
+			}
+		}
+	}
+
+	uint32 task_timer::timer_main(void* userData)
+	{
+		static_cast<task_timer*>(userData)->run();
+		return 0u;
+	}
+} // namespace rsl
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+
+#include "../containers/array.hpp"
+#include "../memory/allocator_context.hpp"
+#include "../time/time_point.hpp"
+#include "../time/time_span.hpp"
+#include "../util/primitives.hpp"
+#include "job_system.hpp"
+#include "mpmc_queue.hpp"
+#include "thread.hpp"
+
+/**
+ * @file task_timer.hpp
+ */
+
+namespace rsl
+{
+	class task_timer;
+
+	/**@class sleep_awaitable
+	 * @brief Suspends the awaiting coroutine until the deadline passed.
+	 */
+	class sleep_awaitable
+	{
+	public:
+		using clock_type = std::chrono::steady_clock;
+
+		sleep_awaitable(task_timer& timer, clock_type::time_point deadline) noexcept
+			: m_timer(&timer),
+			  m_deadline(deadline) {}
+
+		[[nodiscard]] bool await_ready() const noexcept { return clock_type::now() >= m_deadline; }
+		void await_suspend(std::coroutine_handle<> handle) const;
+		[[rythe_always_inline]] void await_resume() const noexcept {}
+
+	private:
+		task_timer* m_timer;
+		clock_type::time_point m_deadline;
+	};
+
+	/**@class task_timer
+	 * @brief Resumes sleeping coroutines from a background thread once their deadline passed, or schedules them on a
+	 * job_system if one was given. Deadlines are kept in a min-heap that only the timer thread touches, new sleepers
+	 * are handed over through a lock-free queue. Without sleepers the timer thread blocks until one arrives, otherwise
+	 * until the earliest deadline or a new sleeper, whichever comes first.
+	 * @note Coroutines that are still sleeping when the timer gets destroyed are never resumed.
+	 */
+	class task_timer
+	{
+	public:
+		using clock_type = sleep_awaitable::clock_type;
+
+		constexpr static size_type default_max_pending = 1024ull;
+
+		/**@brief Starts the timer thread.
+		 * @param resumeOn Job system to resume coroutines on, nullptr resumes them on the timer thread.
+		 * @param maxPending Amount of sleepers that can be handed to the timer thread at once, needs to be a power of 2.
+		 * @param allocator Allocator used for the timer thread.
+		 */
+		explicit task_timer(
+			job_system* resumeOn = nullptr, size_type maxPending = default_max_pending,
+			pmu_allocator& allocator = *allocator_context::globalAllocator
+		);
+
+		task_timer(const task_timer&) = delete;
+		task_timer(task_timer&&) = delete;
+		task_timer& operator=(const task_timer&) = delete;
+		task_timer& operator=(task_timer&&) = delete;
+
+		~task_timer();
+
+		/**@brief Sleeps until the point in time, `co_await timer.sleep_until(point);`.
+		 */
+		template <time::duration_rep Precision, time::clock_type ClockType>
+		[[nodiscard]] sleep_awaitable sleep_until(time::point<Precision, ClockType> point) noexcept;
+
+		/**@brief Sleeps for the duration, `co_await timer.sleep_for(span);`.
+		 */
+		template <time::duration_rep Precision>
+		[[nodiscard]] sleep_awaitable sleep_for(time::span<Precision> duration) noexcept;
+
+	private:
+		friend class sleep_awaitable;
+
+		struct sleeper
+		{
+			clock_type::time_point deadline;
+			std::coroutine_handle<> handle;
+		};
+
+		void add(const sleeper& entry);
+		void resume(std::coroutine_handle<> handle);
+		void wait_for_sleepers(clock_type::duration timeout);
+		void run();
+
+		static uint32 timer_main(void* userData);
+
+		job_system* m_jobs;
+		mpmc_queue<sleeper> m_incoming;
+		// Min-heap on deadline, owned by the timer thread.
+		dynamic_array<sleeper> m_sleepers;
+		std::atomic<bool> m_running{true};
+		// The timer thread waits for m_wakeSignal to change, add only bumps it while the timer thread is waiting.
+		std::atomic<uint32> m_wakeSignal{0u};
+		std::atomic<bool> m_timerWaiting{false};
+		thread m_thread;
+	};
+} // namespace rsl
+
+#include "task_timer.inl"
@@ -0,0 +1,30 @@
+#pragma once
+#include "task_timer.hpp"
+
+namespace rsl
+{
+	template <time::duration_rep Precision, time::clock_type ClockType>
+	sleep_awaitable task_timer::sleep_until(const time::point<Precision, ClockType> point) noexcept
+	{
+		if constexpr (is_same_v<ClockType, clock_type>)
+		{
+			return sleep_awaitable{*this, typename clock_type::time_point{point.duration}};
+		}
+		else
+		{
+			// Other clocks can't be compared against directly, convert to the time left instead.
+			const auto remaining = point.duration - ClockType::now().time_since_epoch();
+			return sleep_awaitable{
+				*this, clock_type::now() + std::chrono::duration_cast<clock_type::duration>(remaining)
+			};
+		}
+	}
+
+	template <time::duration_rep Precision>
+	sleep_awaitable task_timer::sleep_for(const time::span<Precision> duration) noexcept
+	{
+		return sleep_awaitable{
+			*this, clock_type::now() + std::chrono::duration_cast<clock_type::duration>(duration.duration)
+		};
+	}
+} // namespace rsl
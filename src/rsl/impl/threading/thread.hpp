@@ -1,4 +1,7 @@
 ﻿#pragma once
+
+#include "../util/primitives.hpp"
+
 #include "thread_id.hpp"
 
 namespace rsl
@@ -1,5 +1,7 @@
 ﻿#pragma once
 
+#include "../util/primitives.hpp"
+
 namespace rsl
 {
 	struct thread_id
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+
+#include "../memory/allocator_storage.hpp"
+#include "../util/assert.hpp"
+#include "../util/cache_aligned.hpp"
+#include "../util/primitives.hpp"
+
+/**
+ * @file work_stealing_deque.hpp
+ */
+
+namespace rsl
+{
+	/**@class work_stealing_deque
+	 * @brief Bounded Chase-Lev deque. The owning thread pushes and pops at the bottom in LIFO order, any other thread
+	 * can steal from the top in FIFO order. Only the last item is contended between the owner and thieves.
+	 * @tparam T Item type, needs to be trivially copyable since items are copied in and out of atomics. Usually a pointer.
+	 * @tparam Alloc Allocator used for the ring buffer.
+	 * @note Based on "Correct and Efficient Work-Stealing for Weak Memory Models" by Lê, Pop, Cohen and Zappa Nardelli.
+	 */
+	template <typename T, allocator_type Alloc = default_allocator>
+	class work_stealing_deque
+	{
+		static_assert(is_trivially_copyable_v<T>, "work_stealing_deque items need to be trivially copyable.");
+
+	public:
+		using value_type = T;
+		using allocator_storage_type = allocator_storage<Alloc>;
+		using allocator_t = Alloc;
+
+		/**@brief Creates a deque that can hold capacity items.
+		 * @param capacity Maximum amount of items in the deque, needs to be a power of 2.
+		 */
+		explicit work_stealing_deque(size_type capacity);
+		work_stealing_deque(size_type capacity, const allocator_storage_type& allocStorage);
+
+		work_stealing_deque(const work_stealing_deque&) = delete;
+		work_stealing_deque(work_stealing_deque&&) = delete;
+		work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+		work_stealing_deque& operator=(work_stealing_deque&&) = delete;
+
+		~work_stealing_deque();
+
+		/**@brief Pushes an item at the bottom. Owner only.
+		 * @returns False if the deque was full.
+		 */
+		[[nodiscard]] bool push(const value_type& value) noexcept;
+
+		/**@brief Pops the most recently pushed item. Owner only.
+		 * @returns False if the deque was empty or the last item was stolen.
+		 */
+		[[nodiscard]] bool pop(value_type& out) noexcept;
+
+		/**@brief Steals the oldest item. Safe to call from any thread.
+		 * @returns False if the deque was empty or another thread won the race for the item.
+		 */
+		[[nodiscard]] bool steal(value_type& out) noexcept;
+
+		/**@brief Approximate amount of items in the deque.
+		 */
+		[[nodiscard]] size_type size_approx() const noexcept;
+		[[nodiscard]] bool empty_approx() const noexcept { return size_approx() == 0ull; }
+
+		[[nodiscard]] [[rythe_always_inline]] size_type capacity() const noexcept { return m_mask + 1ull; }
+
+	private:
+		cache_aligned<std::atomic<int64>> m_top{0};
+		cache_aligned<std::atomic<int64>> m_bottom{0};
+
+		// Read only after construction, starts on the line after m_bottom.
+		allocator_storage_type m_alloc;
+		std::atomic<value_type>* m_buffer = nullptr;
+		size_type m_mask = 0ull;
+	};
+} // namespace rsl
+
+#include "work_stealing_deque.inl"
@@ -0,0 +1,98 @@
+#pragma once
+#include "work_stealing_deque.hpp"
+
+namespace rsl
+{
+	template <typename T, allocator_type Alloc>
+	work_stealing_deque<T, Alloc>::work_stealing_deque(const size_type capacity)
+		: work_stealing_deque(capacity, allocator_storage_type{}) {}
+
+	template <typename T, allocator_type Alloc>
+	work_stealing_deque<T, Alloc>::work_stealing_deque(const size_type capacity, const allocator_storage_type& allocStorage)
+		: m_alloc(allocStorage),
+		  m_mask(capacity - 1ull)
+	{
+		rsl_assert_invalid_parameters(capacity >= 2ull && (capacity & (capacity - 1ull)) == 0ull);
+
+		m_buffer = static_cast<std::atomic<value_type>*>(
+			m_alloc->allocate(capacity * sizeof(std::atomic<value_type>), alignof(std::atomic<value_type>))
+		);
+		rsl_assert_invalid_object(m_buffer);
+
+		for (size_type i = 0ull; i < capacity; i++)
+		{
+			new (&m_buffer[i]) std::atomic<value_type>();
+		}
+	}
+
+	template <typename T, allocator_type Alloc>
+	work_stealing_deque<T, Alloc>::~work_stealing_deque()
+	{
+		m_alloc->deallocate(m_buffer, capacity() * sizeof(std::atomic<value_type>), alignof(std::atomic<value_type>));
+	}
+
+	template <typename T, allocator_type Alloc>
+	bool work_stealing_deque<T, Alloc>::push(const value_type& value) noexcept
+	{
+		const int64 bottom = m_bottom->load(std::memory_order_relaxed);
+		const int64 top = m_top->load(std::memory_order_acquire);
+		if (static_cast<size_type>(bottom - top) > m_mask)
+		{
+			return false;
+		}
+
+		m_buffer[static_cast<size_type>(bottom) & m_mask].store(value, std::memory_order_relaxed);
+		m_bottom->store(bottom + 1, std::memory_order_release);
+		return true;
+	}
+
+	template <typename T, allocator_type Alloc>
+	bool work_stealing_deque<T, Alloc>::pop(value_type& out) noexcept
+	{
+		const int64 bottom = m_bottom->load(std::memory_order_relaxed) - 1;
+		m_bottom->store(bottom, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64 top = m_top->load(std::memory_order_relaxed);
+
+		if (top > bottom)
+		{
+			m_bottom->store(bottom + 1, std::memory_order_relaxed);
+			return false;
+		}
+
+		out = m_buffer[static_cast<size_type>(bottom) & m_mask].load(std::memory_order_relaxed);
+		if (top != bottom)
+		{
+			return true;
+		}
+
+		// Last item, race against thieves for it.
+		const bool won = m_top->compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+		m_bottom->store(bottom + 1, std::memory_order_relaxed);
+		return won;
+	}
+
+	template <typename T, allocator_type Alloc>
+	bool work_stealing_deque<T, Alloc>::steal(value_type& out) noexcept
+	{
+		int64 top = m_top->load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const int64 bottom = m_bottom->load(std::memory_order_acquire);
+
+		if (top >= bottom)
+		{
+			return false;
+		}
+
+		out = m_buffer[static_cast<size_type>(top) & m_mask].load(std::memory_order_relaxed);
+		return m_top->compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+	}
+
+	template <typename T, allocator_type Alloc>
+	size_type work_stealing_deque<T, Alloc>::size_approx() const noexcept
+	{
+		const int64 bottom = m_bottom->load(std::memory_order_relaxed);
+		const int64 top = m_top->load(std::memory_order_relaxed);
+		return bottom > top ? static_cast<size_type>(bottom - top) : 0ull;
+	}
+} // namespace rsl
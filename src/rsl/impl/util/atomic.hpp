@@ -0,0 +1,149 @@
+#pragma once
+
+#include <atomic>
+
+#include "assert.hpp"
+#include "common.hpp"
+#include "concepts.hpp"
+#include "primitives.hpp"
+
+/**
+ * @file atomic.hpp
+ */
+
+namespace rsl
+{
+	enum struct memory_order : uint8
+	{
+		relaxed,
+		acquire,
+		release,
+		acq_rel,
+		seq_cst,
+	};
+
+	namespace internal
+	{
+		[[nodiscard]] [[rythe_always_inline]] constexpr std::memory_order to_std_memory_order(memory_order order
+		) noexcept;
+
+		// Strongest order a failed compare exchange can use for the given success order.
+		[[nodiscard]] [[rythe_always_inline]] constexpr memory_order failure_memory_order(memory_order order
+		) noexcept;
+
+		template <typename T>
+		concept atomic_arithmetic = (integral_type<T> && !same_as<remove_cvr_t<T>, bool>) || floating_point_type<T> ||
+									is_pointer_v<T>;
+
+		template <typename T>
+		concept atomic_bitwise = integral_type<T> && !same_as<remove_cvr_t<T>, bool>;
+
+		template <typename T>
+		using atomic_difference_type = conditional_t<is_pointer_v<T>, diff_type, T>;
+
+		/**@class atomic_operations
+		 * @brief Operations shared by atomic and atomic_ref, Storage is the std type that does the actual work.
+		 */
+		template <typename T, typename Storage>
+		class atomic_operations
+		{
+		public:
+			using value_type = T;
+			using difference_type = atomic_difference_type<T>;
+
+			constexpr static bool is_always_lock_free = Storage::is_always_lock_free;
+
+			[[nodiscard]] [[rythe_always_inline]] bool is_lock_free() const noexcept { return m_storage.is_lock_free(); }
+
+			[[nodiscard]] [[rythe_always_inline]] T load(memory_order order) const noexcept;
+			[[rythe_always_inline]] void store(T value, memory_order order) noexcept;
+			[[rythe_always_inline]] T exchange(T value, memory_order order) noexcept;
+
+			/**@brief Replaces the value with desired if it equals expected, otherwise loads the current value into
+			 * expected. May fail spuriously, use it in loops.
+			 */
+			[[rythe_always_inline]] bool
+			compare_exchange_weak(T& expected, T desired, memory_order success, memory_order failure) noexcept;
+			[[rythe_always_inline]] bool compare_exchange_weak(T& expected, T desired, memory_order order) noexcept;
+
+			/**@brief Replaces the value with desired if it equals expected, otherwise loads the current value into
+			 * expected.
+			 */
+			[[rythe_always_inline]] bool
+			compare_exchange_strong(T& expected, T desired, memory_order success, memory_order failure) noexcept;
+			[[rythe_always_inline]] bool compare_exchange_strong(T& expected, T desired, memory_order order) noexcept;
+
+			[[rythe_always_inline]] T fetch_add(difference_type value, memory_order order) noexcept
+				requires atomic_arithmetic<T>;
+			[[rythe_always_inline]] T fetch_sub(difference_type value, memory_order order) noexcept
+				requires atomic_arithmetic<T>;
+			[[rythe_always_inline]] T fetch_and(T value, memory_order order) noexcept
+				requires atomic_bitwise<T>;
+			[[rythe_always_inline]] T fetch_or(T value, memory_order order) noexcept
+				requires atomic_bitwise<T>;
+			[[rythe_always_inline]] T fetch_xor(T value, memory_order order) noexcept
+				requires atomic_bitwise<T>;
+
+			/**@brief Blocks until the value no longer equals old, may return spuriously.
+			 */
+			[[rythe_always_inline]] void wait(T old, memory_order order) const noexcept;
+			[[rythe_always_inline]] void notify_one() noexcept { m_storage.notify_one(); }
+			[[rythe_always_inline]] void notify_all() noexcept { m_storage.notify_all(); }
+
+		protected:
+			template <typename... Args>
+			constexpr explicit atomic_operations(Args&&... args) noexcept
+				: m_storage(rsl::forward<Args>(args)...) {}
+
+			// mutable because std::atomic_ref only has const operations, std::atomic keeps its own const correctness.
+			mutable Storage m_storage;
+		};
+	} // namespace internal
+
+	/**@class atomic
+	 * @brief Atomic value where every operation names its memory order. There are no operators and no seq_cst
+	 * defaults, the ordering an operation needs is part of the code that uses it instead of an accident.
+	 */
+	template <typename T>
+	class atomic : public internal::atomic_operations<T, std::atomic<T>>
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "atomic requires a trivially copyable type");
+		using base = internal::atomic_operations<T, std::atomic<T>>;
+
+	public:
+		constexpr atomic() noexcept
+			: base(T{}) {}
+
+		constexpr explicit atomic(T value) noexcept
+			: base(value) {}
+
+		atomic(const atomic&) = delete;
+		atomic& operator=(const atomic&) = delete;
+	};
+
+	/**@class atomic_ref
+	 * @brief Atomic operations on an object that isn't atomic itself, every operation names its memory order.
+	 * @note While any atomic_ref to an object exists the object may only be accessed through atomic_refs.
+	 */
+	template <typename T>
+	class atomic_ref : public internal::atomic_operations<T, std::atomic_ref<T>>
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "atomic_ref requires a trivially copyable type");
+		using base = internal::atomic_operations<T, std::atomic_ref<T>>;
+
+	public:
+		constexpr static size_type required_alignment = std::atomic_ref<T>::required_alignment;
+
+		/**@param object Needs to be aligned to required_alignment, which can be stricter than alignof(T).
+		 */
+		[[rythe_always_inline]] explicit atomic_ref(T& object) noexcept;
+
+		atomic_ref(const atomic_ref&) noexcept = default;
+		atomic_ref& operator=(const atomic_ref&) = delete;
+	};
+
+	[[rythe_always_inline]] void atomic_thread_fence(memory_order order) noexcept;
+	[[rythe_always_inline]] void atomic_signal_fence(memory_order order) noexcept;
+} // namespace rsl
+
+#include "atomic.inl"
@@ -0,0 +1,149 @@
+#pragma once
+#include "atomic.hpp"
+
+namespace rsl
+{
+	namespace internal
+	{
+		constexpr std::memory_order to_std_memory_order(const memory_order order) noexcept
+		{
+			switch (order)
+			{
+				case memory_order::relaxed: return std::memory_order_relaxed;
+				case memory_order::acquire: return std::memory_order_acquire;
+				case memory_order::release: return std::memory_order_release;
+				case memory_order::acq_rel: return std::memory_order_acq_rel;
+				case memory_order::seq_cst: return std::memory_order_seq_cst;
+			}
+
+			return std::memory_order_seq_cst;
+		}
+
+		constexpr memory_order failure_memory_order(const memory_order order) noexcept
+		{
+			switch (order)
+			{
+				case memory_order::release: return memory_order::relaxed;
+				case memory_order::acq_rel: return memory_order::acquire;
+				default: return order;
+			}
+		}
+
+		template <typename T, typename Storage>
+		T atomic_operations<T, Storage>::load(const memory_order order) const noexcept
+		{
+			rsl_assert_invalid_parameters(order != memory_order::release && order != memory_order::acq_rel);
+			return m_storage.load(to_std_memory_order(order));
+		}
+
+		template <typename T, typename Storage>
+		void atomic_operations<T, Storage>::store(T value, const memory_order order) noexcept
+		{
+			rsl_assert_invalid_parameters(order != memory_order::acquire && order != memory_order::acq_rel);
+			m_storage.store(value, to_std_memory_order(order));
+		}
+
+		template <typename T, typename Storage>
+		T atomic_operations<T, Storage>::exchange(T value, const memory_order order) noexcept
+		{
+			return m_storage.exchange(value, to_std_memory_order(order));
+		}
+
+		template <typename T, typename Storage>
+		bool atomic_operations<T, Storage>::compare_exchange_weak(
+			T& expected, T desired, const memory_order success, const memory_order failure
+		) noexcept
+		{
+			rsl_assert_invalid_parameters(failure != memory_order::release && failure != memory_order::acq_rel);
+			return m_storage.compare_exchange_weak(
+				expected, desired, to_std_memory_order(success), to_std_memory_order(failure)
+			);
+		}
+
+		template <typename T, typename Storage>
+		bool atomic_operations<T, Storage>::compare_exchange_weak(
+			T& expected, T desired, const memory_order order
+		) noexcept
+		{
+			return compare_exchange_weak(expected, desired, order, failure_memory_order(order));
+		}
+
+		template <typename T, typename Storage>
+		bool atomic_operations<T, Storage>::compare_exchange_strong(
+			T& expected, T desired, const memory_order success, const memory_order failure
+		) noexcept
+		{
+			rsl_assert_invalid_parameters(failure != memory_order::release && failure != memory_order::acq_rel);
+			return m_storage.compare_exchange_strong(
+				expected, desired, to_std_memory_order(success), to_std_memory_order(failure)
+			);
+		}
+
+		template <typename T, typename Storage>
+		bool atomic_operations<T, Storage>::compare_exchange_strong(
+			T& expected, T desired, const memory_order order
+		) noexcept
+		{
+			return compare_exchange_strong(expected, desired, order, failure_memory_order(order));
+		}
+
+		template <typename T, typename Storage>
+		T atomic_operations<T, Storage>::fetch_add(const difference_type value, const memory_order order) noexcept
+			requires atomic_arithmetic<T>
+		{
+			return m_storage.fetch_add(value, to_std_memory_order(order));
+		}
+
+		template <typename T, typename Storage>
+		T atomic_operations<T, Storage>::fetch_sub(const difference_type value, const memory_order order) noexcept
+			requires atomic_arithmetic<T>
+		{
+			return m_storage.fetch_sub(value, to_std_memory_order(order));
+		}
+
+		template <typename T, typename Storage>
+		T atomic_operations<T, Storage>::fetch_and(T value, const memory_order order) noexcept
+			requires atomic_bitwise<T>
+		{
+			return m_storage.fetch_and(value, to_std_memory_order(order));
+		}
+
+		template <typename T, typename Storage>
+		T atomic_operations<T, Storage>::fetch_or(T value, const memory_order order) noexcept
+			requires atomic_bitwise<T>
+		{
+			return m_storage.fetch_or(value, to_std_memory_order(order));
+		}
+
+		template <typename T, typename Storage>
+		T atomic_operations<T, Storage>::fetch_xor(T value, const memory_order order) noexcept
+			requires atomic_bitwise<T>
+		{
+			return m_storage.fetch_xor(value, to_std_memory_order(order));
+		}
+
+		template <typename T, typename Storage>
+		void atomic_operations<T, Storage>::wait(T old, const memory_order order) const noexcept
+		{
+			rsl_assert_invalid_parameters(order != memory_order::release && order != memory_order::acq_rel);
+			m_storage.wait(old, to_std_memory_order(order));
+		}
+	} // namespace internal
+
+	template <typename T>
+	atomic_ref<T>::atomic_ref(T& object) noexcept
+		: base(object)
+	{
+		rsl_assert_alignment(&object, required_alignment);
+	}
+
+	inline void atomic_thread_fence(const memory_order order) noexcept
+	{
+		std::atomic_thread_fence(internal::to_std_memory_order(order));
+	}
+
+	inline void atomic_signal_fence(const memory_order order) noexcept
+	{
+		std::atomic_signal_fence(internal::to_std_memory_order(order));
+	}
+} // namespace rsl
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "common.hpp"
+#include "concepts.hpp"
+#include "primitives.hpp"
+
+/**
+ * @file cache_aligned.hpp
+ * @brief Layout helpers that keep data written by different threads on different cache lines, all based on
+ * cache_line_size. cpu_topology::cache_line_size_sufficient() checks the constant against the running machine.
+ */
+
+namespace rsl
+{
+	/**@class cache_aligned
+	 * @brief Starts T on a cache line and rounds its size up to whole cache lines, so nothing else shares a line with
+	 * it. Only holds when the storage honours the alignment, allocate arrays of these with alignof(cache_aligned<T>).
+	 */
+	template <typename T>
+	struct alignas(cache_line_size) cache_aligned
+	{
+		T value;
+
+		constexpr cache_aligned()
+			requires default_initializable<T>
+			: value() {}
+
+		template <typename... Args>
+			requires constructible_from<T, Args...>
+		constexpr explicit cache_aligned(Args&&... args) noexcept(is_nothrow_constructible_v<T, Args...>)
+			: value(rsl::forward<Args>(args)...) {}
+
+		[[nodiscard]] [[rythe_always_inline]] constexpr T& operator*() noexcept { return value; }
+		[[nodiscard]] [[rythe_always_inline]] constexpr const T& operator*() const noexcept { return value; }
+		[[nodiscard]] [[rythe_always_inline]] constexpr T* operator->() noexcept { return &value; }
+		[[nodiscard]] [[rythe_always_inline]] constexpr const T* operator->() const noexcept { return &value; }
+	};
+
+	/**@class padded
+	 * @brief Surrounds T with a full cache line of padding on both sides instead of aligning it. Costs more space than
+	 * cache_aligned but keeps neighbours off the lines T touches wherever it's placed, for storage that can't be
+	 * over-aligned.
+	 */
+	template <typename T>
+	struct padded
+	{
+	private:
+		byte m_paddingBefore[cache_line_size];
+
+	public:
+		T value;
+
+		constexpr padded()
+			requires default_initializable<T>
+			: value() {}
+
+		template <typename... Args>
+			requires constructible_from<T, Args...>
+		constexpr explicit padded(Args&&... args) noexcept(is_nothrow_constructible_v<T, Args...>)
+			: value(rsl::forward<Args>(args)...) {}
+
+		[[nodiscard]] [[rythe_always_inline]] constexpr T& operator*() noexcept { return value; }
+		[[nodiscard]] [[rythe_always_inline]] constexpr const T& operator*() const noexcept { return value; }
+		[[nodiscard]] [[rythe_always_inline]] constexpr T* operator->() noexcept { return &value; }
+		[[nodiscard]] [[rythe_always_inline]] constexpr const T* operator->() const noexcept { return &value; }
+
+	private:
+		byte m_paddingAfter[cache_line_size];
+	};
+} // namespace rsl
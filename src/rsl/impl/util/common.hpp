@@ -1536,9 +1536,12 @@ namespace rsl
 	namespace internal
 	{
 		template <size_type I, typename T, typename Type, typename... Types>
-		struct index_of_element_impl :
-			conditional_t<
-				is_same_v<T, Type>, integral_constant<size_type, I>, index_of_element_impl<I + 1, T, Types...>>
+		struct index_of_element_impl : index_of_element_impl<I + 1, T, Types...>
+		{
+		};
+
+		template <size_type I, typename T, typename... Types>
+		struct index_of_element_impl<I, T, T, Types...> : integral_constant<size_type, I>
 		{
 		};
 	} // namespace internal
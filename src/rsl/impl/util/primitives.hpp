@@ -37,6 +37,9 @@ namespace rsl
 	using ptr_type = std::uintptr_t;
 	using nullptr_type = std::nullptr_t;
 
+	// Assumed size of a cache line, data written by different threads should be at least this far apart.
+	constexpr size_type cache_line_size = 64ull;
+
 	using float32 = float;
 	using float64 = double;
 	// long double does not have good enough support on all compilers and platforms
@@ -0,0 +1,28 @@
+#include "type_index.hpp"
+
+#include <atomic>
+
+namespace rsl
+{
+	namespace
+	{
+		std::atomic<size_type>& type_index_counter() noexcept
+		{
+			static std::atomic<size_type> counter{0ull};
+			return counter;
+		}
+	} // namespace
+
+	namespace internal
+	{
+		size_type next_type_index() noexcept
+		{
+			return type_index_counter().fetch_add(1ull, std::memory_order_relaxed);
+		}
+	} // namespace internal
+
+	size_type registered_type_count() noexcept
+	{
+		return type_index_counter().load(std::memory_order_relaxed);
+	}
+} // namespace rsl
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "../defines.hpp"
+#include "primitives.hpp"
+#include "type_traits.hpp"
+
+/**
+ * @file type_index.hpp
+ */
+
+namespace rsl
+{
+	namespace internal
+	{
+		/**@brief Hands out the next free type index. Only meant to be called once per type by type_index.
+		 */
+		[[nodiscard]] size_type next_type_index() noexcept;
+
+		template <typename T>
+		[[nodiscard]] size_type type_index_of() noexcept
+		{
+			static const size_type index = next_type_index();
+			return index;
+		}
+	} // namespace internal
+
+	/**@brief Small sequential index of a type, assigned on first use and stable for the lifetime of the process.
+	 * @note Unlike type_id this isn't a compile time constant and differs between runs, don't serialize it.
+	 * @note Indices are handed out densely starting at 0, making them suitable to directly index into arrays.
+	 */
+	template <typename T>
+	[[nodiscard]] [[rythe_always_inline]] size_type type_index() noexcept
+	{
+		return internal::type_index_of<remove_cvr_t<T>>();
+	}
+
+	/**@brief Amount of types that have been assigned an index so far.
+	 */
+	[[nodiscard]] size_type registered_type_count() noexcept;
+} // namespace rsl
@@ -8,6 +8,7 @@
 	#include <intrin.h>
 	#pragma intrinsic(_BitScanForward64)
 	#pragma intrinsic(_BitScanReverse64)
+	#pragma intrinsic(__popcnt64)
 #endif
 
 namespace rsl
@@ -49,6 +50,20 @@ namespace rsl
 #endif
 	}
 
+	[[rythe_always_inline]] [[maybe_unused]] static size_type popcount(size_type mask) noexcept
+	{
+#if defined(RYTHE_MSVC)
+		return static_cast<size_type>(__popcnt64(mask));
+#elif defined(RYTHE_CLANG) || defined(RYTHE_GCC)
+		return static_cast<size_type>(__builtin_popcountll(mask));
+#else
+		mask = mask - ((mask >> 1) & 0x5555555555555555ull);
+		mask = (mask & 0x3333333333333333ull) + ((mask >> 2) & 0x3333333333333333ull);
+		mask = (mask + (mask >> 4)) & 0x0f0f0f0f0f0f0f0full;
+		return static_cast<size_type>((mask * 0x0101010101010101ull) >> 56);
+#endif
+	}
+
 	template <typename T, typename U>
 	constexpr T force_value_cast(U value)
 	{
@@ -0,0 +1,267 @@
+#define RYTHE_VALIDATE
+
+#include <rsl/logging>
+#include <rsl/threading>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	class collecting_sink final : public rsl::log::sink
+	{
+	public:
+		void log(const rsl::log::message& msg) override
+		{
+			if (blockWrites)
+			{
+				while (blockWrites.load())
+				{
+					std::this_thread::yield();
+				}
+			}
+
+			std::lock_guard guard(lock);
+			messages.emplace_back(msg.msg.data(), msg.msg.size());
+			threads.push_back(msg.threadId);
+		}
+
+		void flush() override { flushes++; }
+
+		std::vector<std::string> collected()
+		{
+			std::lock_guard guard(lock);
+			return messages;
+		}
+
+		std::atomic<bool> blockWrites{false};
+		std::atomic<rsl::size_type> flushes{0ull};
+
+	private:
+		std::mutex lock;
+		std::vector<std::string> messages;
+		std::vector<rsl::thread_id> threads;
+	};
+
+	void set_sink(rsl::log::basic_logger& logger, collecting_sink& sink)
+	{
+		rsl::log::sink* sinks[] = {&sink};
+		logger.set_sinks(rsl::array_view<rsl::log::sink*>::from_buffer(sinks, 1ull));
+	}
+} // namespace
+
+TEST_CASE("async_logger", "[logging][async_logger]")
+{
+	using namespace rsl;
+
+	collecting_sink sink;
+
+	SECTION("order and formatting")
+	{
+		log::async_logger logger("test"_sv, log::overflow_policy::block, 64ull, log::severity::info, log::severity::off);
+		set_sink(logger, sink);
+
+		logger.log(log::severity::debug, "filtered"_sv);
+		for (int i = 0; i < 200; i++)
+		{
+			logger.log(log::severity::info, "message {}"_sv, i);
+		}
+
+		const std::string longMessage(log::async_logger::inline_payload_capacity * 3ull, 'x');
+		logger.log(log::severity::warn, "{}"_sv, longMessage);
+		logger.flush();
+
+		const std::vector<std::string> messages = sink.collected();
+		REQUIRE(messages.size() == 201ull);
+		for (int i = 0; i < 200; i++)
+		{
+			REQUIRE(messages[static_cast<size_t>(i)] == "message " + std::to_string(i));
+		}
+		REQUIRE(messages.back() == longMessage);
+		REQUIRE(sink.flushes.load() >= 1ull);
+	}
+
+	SECTION("deferred formatting")
+	{
+		log::async_logger logger("test"_sv, log::overflow_policy::block, 64ull, log::severity::info, log::severity::off);
+		logger.defer_formatting(true);
+		set_sink(logger, sink);
+
+		const std::string longArgument(log::async_logger::inline_payload_capacity * 2ull, 'y');
+		{
+			// Arguments only need to live for the duration of the call.
+			std::string temporary = "temporary";
+			logger.log(log::severity::info, "{} {:.2f} {} {}"_sv, 42, 1.2345, true, temporary);
+			temporary = "overwritten";
+		}
+		logger.log(log::severity::info, "{:>4}|{}"_sv, 'c', longArgument);
+		logger.defer_formatting(false);
+		logger.log(log::severity::info, "eager {}"_sv, 7u);
+		logger.flush();
+
+		const std::vector<std::string> messages = sink.collected();
+		REQUIRE(messages.size() == 3ull);
+		REQUIRE(messages[0] == "42 1.23 true temporary");
+		REQUIRE(messages[1] == "   c|" + longArgument);
+		REQUIRE(messages[2] == "eager 7");
+	}
+
+	SECTION("flush severity")
+	{
+		log::async_logger logger("test"_sv, log::overflow_policy::block, 64ull, log::severity::info, log::severity::error);
+		set_sink(logger, sink);
+
+		logger.log(log::severity::error, "error"_sv);
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+		while (sink.flushes.load() == 0ull && std::chrono::steady_clock::now() < deadline)
+		{
+			std::this_thread::yield();
+		}
+		REQUIRE(sink.flushes.load() >= 1ull);
+	}
+
+	SECTION("drop")
+	{
+		log::async_logger logger("test"_sv, log::overflow_policy::drop, 8ull, log::severity::info, log::severity::off);
+		set_sink(logger, sink);
+
+		// Hold the writer thread inside the sink so the ring buffer fills up.
+		sink.blockWrites = true;
+		logger.log(log::severity::info, "first"_sv);
+		while (logger.dropped_count() == 0ull)
+		{
+			logger.log(log::severity::info, "filler"_sv);
+		}
+
+		const uint64 dropped = logger.dropped_count();
+		sink.blockWrites = false;
+		logger.flush();
+		REQUIRE(logger.dropped_count() == dropped);
+		REQUIRE(sink.collected().size() <= logger.capacity() + 1ull);
+	}
+
+	SECTION("grow")
+	{
+		log::async_logger logger("test"_sv, log::overflow_policy::grow, 8ull, log::severity::info, log::severity::off);
+		set_sink(logger, sink);
+
+		sink.blockWrites = true;
+		for (int i = 0; i < 100; i++)
+		{
+			logger.log(log::severity::info, "{}"_sv, i);
+		}
+		sink.blockWrites = false;
+		logger.flush();
+
+		const std::vector<std::string> messages = sink.collected();
+		REQUIRE(logger.dropped_count() == 0ull);
+		REQUIRE(messages.size() == 100ull);
+		for (int i = 0; i < 100; i++)
+		{
+			REQUIRE(messages[static_cast<size_t>(i)] == std::to_string(i));
+		}
+	}
+
+	SECTION("concurrent producers")
+	{
+		constexpr int threadCount = 4;
+		constexpr int iterations = 2000;
+
+		{
+			log::async_logger logger("test"_sv, log::overflow_policy::block, 16ull, log::severity::info, log::severity::off);
+			set_sink(logger, sink);
+
+			std::vector<std::thread> threads;
+			for (int t = 0; t < threadCount; t++)
+			{
+				threads.emplace_back(
+					[&logger, t]()
+					{
+						for (int i = 0; i < iterations; i++)
+						{
+							logger.log(log::severity::info, "{} {}"_sv, t, i);
+						}
+					}
+				);
+			}
+
+			for (std::thread& thread : threads)
+			{
+				thread.join();
+			}
+			// The destructor writes out whatever is still queued.
+		}
+
+		const std::vector<std::string> messages = sink.collected();
+		REQUIRE(messages.size() == static_cast<size_t>(threadCount * iterations));
+
+		// Messages from the same thread keep their order.
+		std::vector<int> next(threadCount, 0);
+		for (const std::string& message : messages)
+		{
+			const int thread = std::stoi(message);
+			const int index = std::stoi(message.substr(message.find(' ') + 1));
+			REQUIRE(index == next[static_cast<size_t>(thread)]);
+			next[static_cast<size_t>(thread)]++;
+		}
+	}
+}
+
+TEST_CASE("async_logger burst benchmark", "[.][benchmark][logging][async_logger]")
+{
+	using namespace rsl;
+
+	constexpr size_t burstSize = 4000ull;
+	constexpr size_t burstCount = 50ull;
+
+	collecting_sink sink;
+	log::async_logger asyncLogger(
+		"async"_sv, log::overflow_policy::block, log::async_logger::default_capacity, log::severity::info,
+		log::severity::off
+	);
+	set_sink(asyncLogger, sink);
+
+	collecting_sink syncSink;
+	log::synchronous_logger syncLogger("sync"_sv, log::severity::info, log::severity::off);
+	set_sink(syncLogger, syncSink);
+
+	const auto measure = [](log::basic_logger& logger, const char* name)
+	{
+		std::vector<double> latencies;
+		latencies.reserve(burstSize * burstCount);
+
+		for (size_t burst = 0ull; burst < burstCount; burst++)
+		{
+			for (size_t i = 0ull; i < burstSize; i++)
+			{
+				const auto start = std::chrono::steady_clock::now();
+				logger.log(log::severity::info, "burst {} message {} value {}"_sv, burst, i, 0.5 * static_cast<double>(i));
+				latencies.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+			}
+			logger.flush();
+		}
+
+		std::sort(latencies.begin(), latencies.end());
+		const auto at = [&latencies](const double fraction)
+		{ return latencies[static_cast<size_t>(fraction * static_cast<double>(latencies.size() - 1ull))]; };
+
+		std::printf(
+			"%s: p50 %.0f ns, p99 %.0f ns, p99.9 %.0f ns, max %.0f ns\n", name, at(0.5), at(0.99), at(0.999), latencies.back()
+		);
+	};
+
+	measure(syncLogger, "synchronous_logger");
+	measure(asyncLogger, "async_logger");
+	asyncLogger.defer_formatting(true);
+	measure(asyncLogger, "async_logger deferred");
+
+	REQUIRE(sink.collected().size() == burstSize * burstCount * 2ull);
+}
@@ -0,0 +1,224 @@
+#define RYTHE_VALIDATE
+
+#include <rsl/atomic>
+#include <rsl/threading>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	struct shared_counters
+	{
+		rsl::atomic<rsl::uint64> first;
+		rsl::atomic<rsl::uint64> second;
+	};
+
+	struct padded_counters
+	{
+		rsl::cache_aligned<rsl::atomic<rsl::uint64>> first;
+		rsl::cache_aligned<rsl::atomic<rsl::uint64>> second;
+	};
+
+	rsl::atomic<rsl::uint64>& counter_of(rsl::atomic<rsl::uint64>& counter)
+	{
+		return counter;
+	}
+
+	rsl::atomic<rsl::uint64>& counter_of(rsl::cache_aligned<rsl::atomic<rsl::uint64>>& counter)
+	{
+		return counter.value;
+	}
+
+	template <typename Counters>
+	double count_concurrently(Counters& counters, const rsl::uint64 iterations)
+	{
+		const auto start = std::chrono::steady_clock::now();
+
+		std::thread other(
+			[&counters, iterations]()
+			{
+				for (rsl::uint64 i = 0ull; i < iterations; i++)
+				{
+					counter_of(counters.second).fetch_add(1ull, rsl::memory_order::relaxed);
+				}
+			}
+		);
+
+		for (rsl::uint64 i = 0ull; i < iterations; i++)
+		{
+			counter_of(counters.first).fetch_add(1ull, rsl::memory_order::relaxed);
+		}
+
+		other.join();
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+} // namespace
+
+TEST_CASE("atomic", "[util][atomic]")
+{
+	using namespace rsl;
+
+	SECTION("operations")
+	{
+		atomic<uint32> value(5u);
+		REQUIRE(value.load(memory_order::relaxed) == 5u);
+
+		value.store(7u, memory_order::release);
+		REQUIRE(value.load(memory_order::acquire) == 7u);
+		REQUIRE(value.exchange(9u, memory_order::acq_rel) == 7u);
+		REQUIRE(value.fetch_add(1u, memory_order::relaxed) == 9u);
+		REQUIRE(value.fetch_sub(2u, memory_order::relaxed) == 10u);
+		REQUIRE(value.fetch_or(0x10u, memory_order::relaxed) == 8u);
+		REQUIRE(value.fetch_and(0x18u, memory_order::relaxed) == 0x18u);
+		REQUIRE(value.fetch_xor(0x08u, memory_order::relaxed) == 0x18u);
+		REQUIRE(value.load(memory_order::seq_cst) == 0x10u);
+
+		uint32 expected = 3u;
+		REQUIRE_FALSE(value.compare_exchange_strong(expected, 4u, memory_order::acq_rel));
+		REQUIRE(expected == 0x10u);
+		REQUIRE(value.compare_exchange_strong(expected, 4u, memory_order::acq_rel, memory_order::acquire));
+
+		while (!value.compare_exchange_weak(expected, 11u, memory_order::release))
+		{
+		}
+		REQUIRE(value.load(memory_order::relaxed) == 11u);
+
+		int values[4] = {1, 2, 3, 4};
+		atomic<int*> cursor(values);
+		REQUIRE(cursor.fetch_add(2, memory_order::relaxed) == values);
+		REQUIRE(*cursor.load(memory_order::relaxed) == 3);
+
+		atomic<bool> flag;
+		REQUIRE_FALSE(flag.load(memory_order::relaxed));
+		REQUIRE_FALSE(flag.exchange(true, memory_order::relaxed));
+
+		STATIC_REQUIRE(atomic<uint64>::is_always_lock_free);
+	}
+
+	SECTION("atomic_ref")
+	{
+		alignas(atomic_ref<uint64>::required_alignment) uint64 plain = 1ull;
+		{
+			atomic_ref<uint64> ref(plain);
+			REQUIRE(ref.fetch_add(2ull, memory_order::relaxed) == 1ull);
+
+			atomic_ref<uint64> copy = ref;
+			copy.store(10ull, memory_order::release);
+			REQUIRE(ref.load(memory_order::acquire) == 10ull);
+		}
+		REQUIRE(plain == 10ull);
+	}
+
+	SECTION("wait and notify")
+	{
+		atomic<uint32> ready(0u);
+
+		std::thread waker(
+			[&ready]()
+			{
+				ready.store(1u, memory_order::release);
+				ready.notify_all();
+			}
+		);
+
+		while (ready.load(memory_order::acquire) == 0u)
+		{
+			ready.wait(0u, memory_order::acquire);
+		}
+
+		waker.join();
+		REQUIRE(ready.load(memory_order::relaxed) == 1u);
+	}
+
+	SECTION("concurrent increments")
+	{
+		constexpr uint64 iterations = 100000ull;
+		atomic<uint64> counter;
+
+		std::vector<std::thread> threads;
+		for (size_type i = 0ull; i < 4ull; i++)
+		{
+			threads.emplace_back(
+				[&counter]()
+				{
+					for (uint64 j = 0ull; j < iterations; j++)
+					{
+						counter.fetch_add(1ull, memory_order::relaxed);
+					}
+				}
+			);
+		}
+
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+
+		REQUIRE(counter.load(memory_order::relaxed) == iterations * 4ull);
+	}
+}
+
+TEST_CASE("cache line layout", "[util][atomic]")
+{
+	using namespace rsl;
+
+	SECTION("cache_aligned")
+	{
+		STATIC_REQUIRE(alignof(cache_aligned<uint32>) == cache_line_size);
+		STATIC_REQUIRE(sizeof(cache_aligned<uint32>) == cache_line_size);
+		STATIC_REQUIRE(sizeof(cache_aligned<byte[cache_line_size + 1ull]>) == cache_line_size * 2ull);
+
+		cache_aligned<uint32> values[2];
+		values[0].value = 1u;
+		*values[1] = 2u;
+		REQUIRE(reinterpret_cast<ptr_type>(&values[1]) % cache_line_size == 0ull);
+		REQUIRE(*values[0] == 1u);
+		REQUIRE(values[1].value == 2u);
+
+		cache_aligned<atomic<uint32>> counter(3u);
+		REQUIRE(counter->load(memory_order::relaxed) == 3u);
+	}
+
+	SECTION("padded")
+	{
+		STATIC_REQUIRE(alignof(padded<uint32>) == alignof(uint32));
+		STATIC_REQUIRE(sizeof(padded<uint32>) >= sizeof(uint32) + cache_line_size * 2ull);
+
+		padded<uint32> values[2];
+		*values[0] = 1u;
+		values[1].value = 2u;
+		const auto first = reinterpret_cast<ptr_type>(&values[0].value);
+		const auto second = reinterpret_cast<ptr_type>(&values[1].value);
+		REQUIRE(second - (first + sizeof(uint32)) >= cache_line_size);
+		REQUIRE(first - reinterpret_cast<ptr_type>(&values[0]) >= cache_line_size);
+		REQUIRE(reinterpret_cast<ptr_type>(&values[1]) - (first + sizeof(uint32)) >= cache_line_size);
+		REQUIRE(values[0].value == 1u);
+	}
+
+	SECTION("runtime check")
+	{
+		const cpu_topology& topology = platform::get_cpu_topology();
+		REQUIRE(topology.cacheLineSize > 0ull);
+		REQUIRE(topology.cache_line_size_sufficient() == (topology.cacheLineSize <= cache_line_size));
+	}
+}
+
+TEST_CASE("false sharing benchmark", "[.][benchmark][atomic]")
+{
+	constexpr rsl::uint64 iterations = 20000000ull;
+
+	shared_counters shared;
+	padded_counters padded;
+
+	const double sharedTime = count_concurrently(shared, iterations);
+	const double paddedTime = count_concurrently(padded, iterations);
+
+	std::printf("shared line: %.2f ms, cache_aligned: %.2f ms\n", sharedTime, paddedTime);
+	REQUIRE(shared.first.load(rsl::memory_order::relaxed) == iterations);
+	REQUIRE((*padded.second).load(rsl::memory_order::relaxed) == iterations);
+}
@@ -0,0 +1,265 @@
+#define RYTHE_VALIDATE
+
+#include <rsl/heap_allocator>
+
+namespace
+{
+	class test_heap_allocator : private rsl::heap_allocator
+	{
+	public:
+		using value_type = void;
+		rsl::id_type id = 1012234;
+
+		using rsl::heap_allocator::heap_allocator;
+		explicit constexpr test_heap_allocator(rsl::id_type _id) noexcept
+			: id(_id)
+		{
+		}
+
+		using rsl::heap_allocator::allocate;
+		using rsl::heap_allocator::deallocate;
+		using rsl::heap_allocator::reallocate;
+		using rsl::heap_allocator::is_valid;
+	};
+} // namespace
+
+#define RSL_DEFAULT_ALLOCATOR_OVERRIDE test_heap_allocator
+#include <rsl/bitset>
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("static_bitset", "[containers]")
+{
+	using namespace rsl;
+
+	SECTION("single bits")
+	{
+		static_bitset<100> bits;
+		REQUIRE(bits.size() == 100);
+		REQUIRE(bits.word_count() == 2);
+		REQUIRE(bits.none());
+		REQUIRE(bits.find_first_set() == npos);
+
+		bits.set(0).set(63).set(64).set(99);
+		REQUIRE(bits.test(0));
+		REQUIRE(bits[63]);
+		REQUIRE(bits[64]);
+		REQUIRE(bits[99]);
+		REQUIRE(!bits[1]);
+		REQUIRE(bits.count() == 4);
+
+		bits.reset(63).flip(1).set(2, true).set(0, false);
+		REQUIRE(!bits[63]);
+		REQUIRE(bits[1]);
+		REQUIRE(bits[2]);
+		REQUIRE(!bits[0]);
+		REQUIRE(bits.count() == 4);
+	}
+
+	SECTION("all and flip")
+	{
+		static_bitset<70> bits;
+		bits.set_all();
+		REQUIRE(bits.all());
+		REQUIRE(bits.count() == 70);
+		REQUIRE(bits.find_first_unset() == npos);
+
+		bits.reset(69);
+		REQUIRE(!bits.all());
+		REQUIRE(bits.find_first_unset() == 69);
+
+		bits.flip_all();
+		REQUIRE(bits.count() == 1);
+		REQUIRE(bits.find_first_set() == 69);
+
+		auto inverted = ~bits;
+		REQUIRE(inverted.count() == 69);
+
+		bits.reset_all();
+		REQUIRE(bits.none());
+	}
+
+	SECTION("ranges")
+	{
+		static_bitset<300> bits;
+		bits.set_range(10, 5);
+		REQUIRE(bits.count() == 5);
+		REQUIRE(bits.find_first_set() == 10);
+		REQUIRE(!bits[15]);
+
+		bits.set_range(60, 200);
+		REQUIRE(bits.count() == 205);
+		REQUIRE(bits[60]);
+		REQUIRE(bits[259]);
+		REQUIRE(!bits[260]);
+
+		bits.reset_range(62, 130);
+		REQUIRE(bits.count() == 75);
+		REQUIRE(bits[61]);
+		REQUIRE(!bits[62]);
+		REQUIRE(!bits[191]);
+		REQUIRE(bits[192]);
+
+		bits.set_range(0, 300);
+		REQUIRE(bits.all());
+		bits.reset_range(0, 0);
+		REQUIRE(bits.all());
+	}
+
+	SECTION("scanning")
+	{
+		static_bitset<512> bits;
+		const size_type indices[] = {3, 64, 65, 200, 511};
+		for (size_type index : indices)
+		{
+			bits.set(index);
+		}
+
+		size_type i = 0;
+		for (size_type index = bits.find_first_set(); index != npos; index = bits.find_next_set(index))
+		{
+			REQUIRE(index == indices[i++]);
+		}
+		REQUIRE(i == 5);
+
+		i = 0;
+		bits.for_each_set([&](size_type index) { REQUIRE(index == indices[i++]); });
+		REQUIRE(i == 5);
+
+		REQUIRE(bits.find_next_set(511) == npos);
+		REQUIRE(bits.find_next_unset(2) == 4);
+		REQUIRE(bits.find_next_unset(63) == 66);
+	}
+
+	SECTION("set operations")
+	{
+		static_bitset<1000> a;
+		static_bitset<1000> b;
+		a.set_range(0, 600);
+		b.set_range(400, 600);
+
+		REQUIRE(a.intersects(b));
+		REQUIRE((a & b).count() == 200);
+		REQUIRE((a | b).count() == 1000);
+		REQUIRE((a ^ b).count() == 800);
+
+		static_bitset<1000> c = a;
+		c.and_not(b);
+		REQUIRE(c.count() == 400);
+		REQUIRE(c.find_first_set() == 0);
+		REQUIRE(c.find_first_unset() == 400);
+		REQUIRE(!c.intersects(b));
+
+		REQUIRE(c.is_subset_of(a));
+		REQUIRE(!a.is_subset_of(c));
+		REQUIRE(c != a);
+
+		c |= b;
+		REQUIRE(c.all());
+		c &= a;
+		REQUIRE(c == a);
+		c ^= a;
+		REQUIRE(c.none());
+	}
+}
+
+TEST_CASE("dynamic_bitset", "[containers]")
+{
+	using namespace rsl;
+
+	SECTION("construction")
+	{
+		dynamic_bitset empty;
+		REQUIRE(empty.size() == 0);
+		REQUIRE(empty.empty());
+		REQUIRE(empty.none());
+		REQUIRE(empty.all());
+		REQUIRE(empty.find_first_set() == npos);
+
+		dynamic_bitset ones(130, true);
+		REQUIRE(ones.size() == 130);
+		REQUIRE(ones.word_count() == 3);
+		REQUIRE(ones.count() == 130);
+		REQUIRE(ones.all());
+		REQUIRE(ones.get_allocator().id == 1012234);
+
+		test_heap_allocator alloc{1234};
+		basic_dynamic_bitset<test_heap_allocator> custom(10, false, alloc);
+		REQUIRE(custom.get_allocator().id == 1234);
+		REQUIRE(custom.none());
+	}
+
+	SECTION("resize")
+	{
+		dynamic_bitset bits(10, true);
+		bits.resize(100);
+		REQUIRE(bits.count() == 10);
+		bits.resize(200, true);
+		REQUIRE(bits.count() == 110);
+		REQUIRE(!bits[99]);
+		REQUIRE(bits[100]);
+
+		bits.resize(5);
+		REQUIRE(bits.count() == 5);
+		bits.resize(64, false);
+		REQUIRE(bits.count() == 5);
+		REQUIRE(bits.find_next_set(4) == npos);
+
+		bits.clear();
+		REQUIRE(bits.empty());
+	}
+
+	SECTION("push and pop")
+	{
+		dynamic_bitset bits;
+		for (size_type i = 0; i < 130; i++)
+		{
+			bits.push_back(i % 3 == 0);
+		}
+
+		REQUIRE(bits.size() == 130);
+		REQUIRE(bits.count() == 44);
+		REQUIRE(bits[129]);
+
+		bits.pop_back();
+		REQUIRE(bits.size() == 129);
+		REQUIRE(bits.word_count() == 3);
+		REQUIRE(bits.count() == 43);
+
+		bits.pop_back();
+		REQUIRE(bits.word_count() == 2);
+	}
+
+	SECTION("hybrid storage")
+	{
+		hybrid_bitset<128> bits(128, true);
+		REQUIRE(bits.capacity() == 128);
+		REQUIRE(bits.count() == 128);
+
+		bits.push_back(true);
+		REQUIRE(bits.capacity() > 128);
+		REQUIRE(bits.count() == 129);
+		REQUIRE(bits.get_allocator().id == 1012234);
+	}
+
+	SECTION("component masks")
+	{
+		dynamic_bitset entityMask(256);
+		dynamic_bitset queryMask(256);
+		entityMask.set(3).set(17).set(200);
+		queryMask.set(3).set(200);
+
+		REQUIRE(queryMask.is_subset_of(entityMask));
+		REQUIRE(queryMask.intersects(entityMask));
+
+		queryMask.set(4);
+		REQUIRE(!queryMask.is_subset_of(entityMask));
+
+		static_bitset<256> fixed;
+		fixed.set(17);
+		REQUIRE(entityMask.intersects(fixed));
+		entityMask.and_not(fixed);
+		REQUIRE(!entityMask[17]);
+		REQUIRE(entityMask.count() == 2);
+	}
+}
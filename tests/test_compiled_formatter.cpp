@@ -0,0 +1,144 @@
+#define RYTHE_VALIDATE
+
+#include <rsl/logging>
+#include <rsl/threading>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+
+namespace
+{
+	std::string format(rsl::log::formatter& formatter, const rsl::log::message& msg)
+	{
+		fmt::memory_buffer output;
+		formatter.format(msg, output);
+		return std::string(output.data(), output.size());
+	}
+
+	rsl::log::message make_message(const rsl::time::point32 timestamp)
+	{
+		using namespace rsl;
+
+		return log::message{
+			.loggerName = "test"_sv,
+			.threadId = current_thread::get_id(),
+			.timestamp = timestamp,
+			.sourceLocation = source_location::current(),
+			.severity = log::severity::warn,
+			.msg = "text {}"_sv,
+			.formatArgs = fmt::format_args{},
+			.formattedMsg = "text 1"_sv,
+		};
+	}
+} // namespace
+
+TEST_CASE("compiled_pattern_formatter", "[logging][formatter]")
+{
+	using namespace rsl;
+
+	const log::message msg = make_message(time::main_clock.current_point());
+
+	SECTION("fields")
+	{
+		log::compiled_pattern_formatter formatter("[{logger}] {severity}: {message} {{literal}} }}"_sv);
+		REQUIRE(format(formatter, msg) == "[test] warn: text 1 {literal} }");
+
+		formatter.set_pattern("{thread_id}|{line}"_sv);
+		REQUIRE(
+			format(formatter, msg) ==
+			std::to_string(msg.threadId.nativeId) + "|" + std::to_string(msg.sourceLocation.line())
+		);
+	}
+
+	SECTION("alignment")
+	{
+		log::compiled_pattern_formatter formatter("[{severity:<7}][{severity:>7}][{severity:^7}][{logger:2}]"_sv);
+		REQUIRE(format(formatter, msg) == "[warn   ][   warn][ warn  ][test]");
+	}
+
+	SECTION("thread names")
+	{
+		log::compiled_pattern_formatter formatter("{thread}"_sv);
+		current_thread::set_name("formatter test"_sv);
+		REQUIRE(format(formatter, msg) == "formatter test");
+	}
+
+	SECTION("wall clock")
+	{
+		// 2021-03-04 05:06:07.089123 UTC, only representable exactly when timestamps come from the system clock.
+		if constexpr (std::is_same_v<time::point32::clock_type, std::chrono::system_clock>)
+		{
+			time::point32 timestamp;
+			timestamp.duration = std::chrono::duration_cast<time::point32::duration_type>(
+				std::chrono::seconds(1614834367) + std::chrono::microseconds(89123)
+			);
+
+			log::compiled_pattern_formatter formatter("{time}.{ms} {us}"_sv);
+			REQUIRE(format(formatter, make_message(timestamp)) == "2021-03-04 05:06:07.089 089123");
+
+			// The cached second gets replaced once the time moves on.
+			timestamp.duration += std::chrono::duration_cast<time::point32::duration_type>(std::chrono::hours(25));
+			REQUIRE(format(formatter, make_message(timestamp)) == "2021-03-05 06:06:07.089 089123");
+		}
+
+		log::compiled_pattern_formatter formatter("{time}"_sv);
+		const std::string now = format(formatter, msg);
+		REQUIRE(now.size() == 19ull);
+		REQUIRE(now[4] == '-');
+		REQUIRE(now[10] == ' ');
+		REQUIRE(now[16] == ':');
+	}
+
+	SECTION("cache key")
+	{
+		log::compiled_pattern_formatter first("{message}"_sv);
+		log::compiled_pattern_formatter second("{message}"_sv);
+		log::compiled_pattern_formatter other("{logger}"_sv);
+		REQUIRE(first.cache_key() == second.cache_key());
+		REQUIRE(first.cache_key() != other.cache_key());
+	}
+}
+
+TEST_CASE("formatter benchmark", "[.][benchmark][logging][formatter]")
+{
+	using namespace rsl;
+
+	constexpr int iterations = 1000000;
+
+	current_thread::set_name("benchmark"_sv);
+	log::message msg = make_message(time::main_clock.current_point());
+
+	log::pattern_formatter patternFormatter(
+		"T+ {} [{}] [{}] : {}"_sv, log::genesis_flag_formatter{}, log::logger_name_formatter{},
+		log::thread_name_formatter_flag{}, log::message_text_formatter{}
+	);
+	log::compiled_pattern_formatter compiledFormatter("T+ {genesis} [{logger}] [{thread}] : {message}"_sv);
+	log::compiled_pattern_formatter wallClockFormatter(
+		"{time}.{ms} [{severity:^7}] [{thread}] {logger}: {message}"_sv
+	);
+
+	const auto measure = [&msg](log::formatter& formatter, const char* name)
+	{
+		fmt::memory_buffer output;
+		const auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < iterations; i++)
+		{
+			// A new timestamp per message, like real logging.
+			msg.timestamp.duration += std::chrono::microseconds(3);
+			output.clear();
+			formatter.format(msg, output);
+		}
+		const double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+		std::printf("%s: %.1f ns per message\n", name, elapsed / iterations);
+	};
+
+	measure(patternFormatter, "pattern_formatter");
+	measure(compiledFormatter, "compiled_pattern_formatter");
+	measure(wallClockFormatter, "compiled_pattern_formatter wall clock");
+
+	REQUIRE(format(compiledFormatter, msg).find(" [test] [benchmark] : text 1") != std::string::npos);
+}
@@ -107,3 +107,50 @@ TEST_CASE("dynamic_array", "[containers]")
 	SECTION("emplace") {}
 	SECTION("copy/move") {}
 }
+
+TEST_CASE("hybrid_array", "[containers]")
+{
+	using namespace rsl;
+
+	SECTION("construction")
+	{
+		rsl::hybrid_array<test1, 4> list{};
+		REQUIRE(list.get_allocator().id == 1012234);
+		REQUIRE(list.empty());
+		REQUIRE(list.capacity() >= 4);
+	}
+
+	SECTION("in place storage")
+	{
+		rsl::hybrid_array<test1, 4> list{};
+		list.emplace_back();
+		list.emplace_back(CONST2);
+		REQUIRE(list.size() == 2);
+		REQUIRE(list[0].value == CONST1);
+		REQUIRE(list[1].value == CONST2);
+
+		const auto* listBegin = reinterpret_cast<const rsl::byte*>(&list);
+		const auto* dataBegin = reinterpret_cast<const rsl::byte*>(list.data());
+		REQUIRE(dataBegin >= listBegin);
+		REQUIRE(dataBegin < listBegin + sizeof(list));
+	}
+
+	SECTION("grow beyond static capacity")
+	{
+		rsl::hybrid_array<test1, 4> list{};
+		for (int i = 0; i < 16; i++)
+		{
+			list.emplace_back(i);
+		}
+
+		REQUIRE(list.size() == 16);
+		for (int i = 0; i < 16; i++)
+		{
+			REQUIRE(list[static_cast<size_type>(i)].value == i);
+		}
+
+		list.resize(20);
+		REQUIRE(list.size() == 20);
+		REQUIRE(list[19].value == CONST1);
+	}
+}
@@ -0,0 +1,259 @@
+#define RYTHE_VALIDATE
+
+#include <rsl/heap_allocator>
+
+namespace
+{
+	class test_heap_allocator : private rsl::heap_allocator
+	{
+	public:
+		using value_type = void;
+		rsl::id_type id = 1012234;
+
+		using rsl::heap_allocator::heap_allocator;
+		explicit constexpr test_heap_allocator(rsl::id_type _id) noexcept
+			: id(_id)
+		{
+		}
+
+		using rsl::heap_allocator::allocate;
+		using rsl::heap_allocator::deallocate;
+		using rsl::heap_allocator::reallocate;
+		using rsl::heap_allocator::is_valid;
+	};
+} // namespace
+
+#define RSL_DEFAULT_ALLOCATOR_OVERRIDE test_heap_allocator
+#include <rsl/threading>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	struct tracked
+	{
+		std::atomic<int>* destroyed;
+		int value;
+
+		~tracked() { ++*destroyed; }
+	};
+
+	tracked* make_tracked(std::atomic<int>& destroyed, const int value)
+	{
+		rsl::pmu_allocator& allocator = *rsl::allocator_context::globalAllocator;
+		return new (allocator.allocate<tracked>(alignof(tracked))) tracked{&destroyed, value};
+	}
+
+	// Treiber stack whose popped nodes are retired instead of freed, readers may still be looking at them.
+	struct stack
+	{
+		struct node
+		{
+			int value;
+			node* next;
+		};
+
+		rsl::epoch_domain& domain;
+		std::atomic<node*> head{nullptr};
+
+		void push(const int value)
+		{
+			rsl::pmu_allocator& allocator = *rsl::allocator_context::globalAllocator;
+			node* n = new (allocator.allocate<node>(alignof(node))) node{value, head.load(std::memory_order_relaxed)};
+			while (!head.compare_exchange_weak(n->next, n, std::memory_order_release, std::memory_order_relaxed))
+			{
+			}
+		}
+
+		bool pop(int& value)
+		{
+			const rsl::epoch_guard guard = domain.pin();
+
+			node* n = head.load(std::memory_order_acquire);
+			while (n && !head.compare_exchange_weak(n, n->next, std::memory_order_acquire, std::memory_order_acquire))
+			{
+			}
+
+			if (!n)
+			{
+				return false;
+			}
+
+			value = n->value;
+			domain.retire(n, *rsl::allocator_context::globalAllocator);
+			return true;
+		}
+
+		~stack()
+		{
+			int value;
+			while (pop(value))
+			{
+			}
+		}
+	};
+} // namespace
+
+TEST_CASE("epoch_domain", "[threading]")
+{
+	using namespace rsl;
+
+	std::atomic<int> destroyed = 0;
+
+	SECTION("retire and collect")
+	{
+		epoch_domain domain;
+		for (int i = 0; i < 10; i++)
+		{
+			domain.retire(make_tracked(destroyed, i), *allocator_context::globalAllocator);
+		}
+		REQUIRE(destroyed == 0);
+
+		// Every collect can advance the epoch once, retired memory waits two epochs.
+		size_type freed = 0;
+		for (int i = 0; i < 3; i++)
+		{
+			freed += domain.collect();
+		}
+		REQUIRE(freed == 10);
+		REQUIRE(destroyed == 10);
+	}
+
+	SECTION("guards block reclamation")
+	{
+		epoch_domain domain;
+		{
+			const epoch_guard guard = domain.pin();
+			REQUIRE(guard.is_pinned());
+
+			{
+				// Nested guards don't unpin the outer one.
+				epoch_guard nested = domain.pin();
+				epoch_guard moved = rsl::move(nested);
+				REQUIRE(!nested.is_pinned());
+				REQUIRE(moved.is_pinned());
+			}
+
+			domain.retire(make_tracked(destroyed, 0), *allocator_context::globalAllocator);
+			for (int i = 0; i < 5; i++)
+			{
+				REQUIRE(domain.collect() == 0);
+			}
+			REQUIRE(destroyed == 0);
+		}
+
+		size_type freed = 0;
+		for (int i = 0; i < 3; i++)
+		{
+			freed += domain.collect();
+		}
+		REQUIRE(freed == 1);
+		REQUIRE(destroyed == 1);
+	}
+
+	SECTION("batches")
+	{
+		epoch_domain domain;
+		const int count = static_cast<int>(epoch_domain::batch_capacity) * 10;
+		for (int i = 0; i < count; i++)
+		{
+			domain.retire(make_tracked(destroyed, i), *allocator_context::globalAllocator);
+		}
+
+		// Full batches get freed along the way without calling collect.
+		REQUIRE(destroyed > 0);
+		REQUIRE(destroyed < count);
+	}
+
+	SECTION("exiting threads")
+	{
+		{
+			epoch_domain domain;
+			std::thread worker(
+				[&]()
+				{
+					const epoch_guard guard = domain.pin();
+					for (int i = 0; i < 5; i++)
+					{
+						domain.retire(make_tracked(destroyed, i), *allocator_context::globalAllocator);
+					}
+				}
+			);
+			worker.join();
+
+			// The record of the exited thread is reused along with what it retired.
+			std::thread next(
+				[&]()
+				{
+					for (int i = 0; i < 3; i++)
+					{
+						domain.collect();
+					}
+				}
+			);
+			next.join();
+			REQUIRE(destroyed == 5);
+
+			std::thread leftover(
+				[&]() { domain.retire(make_tracked(destroyed, 0), *allocator_context::globalAllocator); }
+			);
+			leftover.join();
+		}
+
+		// Destroying the domain frees what was still waiting.
+		REQUIRE(destroyed == 6);
+	}
+
+	SECTION("concurrent stack")
+	{
+		epoch_domain domain;
+		std::atomic<long long> popped = 0;
+		std::atomic<int> poppedCount = 0;
+		constexpr int threadCount = 4;
+		constexpr int perThread = 20000;
+
+		{
+			stack s{domain};
+			std::vector<std::thread> threads;
+			for (int t = 0; t < threadCount; t++)
+			{
+				threads.emplace_back(
+					[&, t]()
+					{
+						for (int i = 0; i < perThread; i++)
+						{
+							s.push(t * perThread + i);
+
+							int value;
+							if (s.pop(value))
+							{
+								popped += value;
+								++poppedCount;
+							}
+						}
+					}
+				);
+			}
+
+			for (auto& thread : threads)
+			{
+				thread.join();
+			}
+
+			int value;
+			while (s.pop(value))
+			{
+				popped += value;
+				++poppedCount;
+			}
+		}
+
+		constexpr long long total = static_cast<long long>(threadCount) * perThread;
+		REQUIRE(poppedCount == total);
+		REQUIRE(popped == total * (total - 1) / 2);
+	}
+}
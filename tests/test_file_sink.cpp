@@ -0,0 +1,231 @@
+#define RYTHE_VALIDATE
+
+#include <rsl/logging>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	struct log_directory
+	{
+		log_directory()
+			: path(std::filesystem::temp_directory_path() / "rsl_file_sink_test")
+		{
+			std::filesystem::remove_all(path);
+			std::filesystem::create_directories(path);
+		}
+
+		~log_directory() { std::filesystem::remove_all(path); }
+
+		std::string file(const char* name) const { return (path / name).string(); }
+
+		std::filesystem::path path;
+	};
+
+	std::vector<std::string> read_lines(const std::string& path)
+	{
+		std::ifstream file(path);
+		std::vector<std::string> lines;
+		for (std::string line; std::getline(file, line);)
+		{
+			lines.push_back(line);
+		}
+		return lines;
+	}
+
+	void set_sink(rsl::log::basic_logger& logger, rsl::log::sink& sink)
+	{
+		rsl::log::sink* sinks[] = {&sink};
+		logger.set_sinks(rsl::array_view<rsl::log::sink*>::from_buffer(sinks, 1ull));
+	}
+
+	rsl::string_view view_of(const std::string& str)
+	{
+		return rsl::string_view::from_buffer(str.data(), str.size());
+	}
+} // namespace
+
+TEST_CASE("file_sink", "[logging][file_sink]")
+{
+	using namespace rsl;
+
+	log_directory directory;
+	const std::string path = directory.file("test.log");
+
+	SECTION("buffered writes")
+	{
+		{
+			log::file_sink sink(view_of(path));
+			REQUIRE(sink.is_open());
+
+			log::logger logger("test"_sv, log::severity::info, log::severity::off);
+			set_sink(logger, sink);
+
+			for (int i = 0; i < 1000; i++)
+			{
+				logger.log(log::severity::info, "message {}"_sv, i);
+			}
+
+			// Everything still fits in the buffer.
+			REQUIRE(sink.write_count() == 0ull);
+			logger.flush();
+			REQUIRE(sink.write_count() == 1ull);
+
+			// Flushing an empty buffer doesn't write.
+			logger.flush();
+			REQUIRE(sink.write_count() == 1ull);
+		}
+
+		const std::vector<std::string> lines = read_lines(path);
+		REQUIRE(lines.size() == 1000ull);
+		for (int i = 0; i < 1000; i++)
+		{
+			REQUIRE(lines[static_cast<size_t>(i)] == "message " + std::to_string(i));
+		}
+	}
+
+	SECTION("messages larger than the buffer")
+	{
+		const std::string longMessage(300ull, 'x');
+		{
+			log::file_sink sink(view_of(path), log::file_sink_settings{.bufferSize = 64ull});
+			log::logger logger("test"_sv, log::severity::info, log::severity::off);
+			set_sink(logger, sink);
+
+			logger.log(log::severity::info, "short"_sv);
+			logger.log(log::severity::info, "{}"_sv, longMessage);
+
+			// The buffered line and the long message went out together.
+			REQUIRE(sink.write_count() == 1ull);
+			logger.log(log::severity::info, "after"_sv);
+		}
+
+		REQUIRE(read_lines(path) == std::vector<std::string>{"short", longMessage, "after"});
+	}
+
+	SECTION("appends to existing files")
+	{
+		for (int run = 0; run < 2; run++)
+		{
+			log::file_sink sink(view_of(path), log::file_sink_settings{.syncPolicy = log::fsync_policy::on_flush});
+			log::logger logger("test"_sv, log::severity::info, log::severity::off);
+			set_sink(logger, sink);
+			logger.log(log::severity::info, "run {}"_sv, run);
+		}
+
+		REQUIRE(read_lines(path) == std::vector<std::string>{"run 0", "run 1"});
+	}
+
+	SECTION("size based rotation")
+	{
+		constexpr int messageCount = 2000;
+		{
+			log::file_sink sink(
+				view_of(path),
+				log::file_sink_settings{
+					.bufferSize = 256ull,
+					.maxFileSize = 2048ull,
+					.maxFiles = 2ull,
+					.syncPolicy = log::fsync_policy::interval,
+					.syncInterval = std::chrono::milliseconds(1),
+				}
+			);
+			log::logger logger("test"_sv, log::severity::info, log::severity::off);
+			set_sink(logger, sink);
+
+			for (int i = 0; i < messageCount; i++)
+			{
+				logger.log(log::severity::info, "{:05}"_sv, i);
+				if (i % 100 == 0)
+				{
+					// Give the rotation thread a chance to keep up.
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}
+			}
+
+			REQUIRE(sink.rotation_count() > 0ull);
+		}
+
+		REQUIRE(std::filesystem::exists(path + ".1"));
+		REQUIRE(std::filesystem::exists(path + ".2"));
+		REQUIRE_FALSE(std::filesystem::exists(path + ".3"));
+
+		// Oldest to newest, the kept files hold the tail of the output without gaps.
+		std::vector<std::string> lines = read_lines(path + ".2");
+		for (const char* suffix : {".1", ""})
+		{
+			const std::vector<std::string> next = read_lines(path + suffix);
+			lines.insert(lines.end(), next.begin(), next.end());
+		}
+
+		REQUIRE_FALSE(lines.empty());
+		REQUIRE(std::stoi(lines.back()) == messageCount - 1);
+		const int first = std::stoi(lines.front());
+		for (size_t i = 0ull; i < lines.size(); i++)
+		{
+			REQUIRE(std::stoi(lines[i]) == first + static_cast<int>(i));
+		}
+	}
+
+	SECTION("time based rotation")
+	{
+		{
+			log::file_sink sink(
+				view_of(path), log::file_sink_settings{.rotationInterval = std::chrono::seconds(1), .maxFiles = 1ull}
+			);
+			log::logger logger("test"_sv, log::severity::info, log::severity::off);
+			set_sink(logger, sink);
+
+			logger.log(log::severity::info, "before"_sv);
+			logger.flush();
+
+			// Flushing picks up the new file once the rotation thread has it ready.
+			const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+			while (sink.rotation_count() == 0ull && std::chrono::steady_clock::now() < deadline)
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(10));
+				logger.flush();
+			}
+			REQUIRE(sink.rotation_count() == 1ull);
+
+			logger.log(log::severity::info, "after"_sv);
+		}
+
+		REQUIRE(read_lines(path + ".1") == std::vector<std::string>{"before"});
+		REQUIRE(read_lines(path) == std::vector<std::string>{"after"});
+	}
+
+#if RYTHE_PLATFORM_LINUX
+	SECTION("failed writes")
+	{
+		// Validated builds report every failed write with a soft assert, which would break into the debugger.
+		const asserts::assert_handler_function previousHandler = asserts::assert_handler;
+		asserts::assert_handler = [](string_view, string_view, size_type, string_view, bool, bool*) {};
+
+		{
+			// Every write to /dev/full fails with ENOSPC.
+			log::file_sink sink("/dev/full"_sv, log::file_sink_settings{.bufferSize = 64ull});
+			REQUIRE(sink.is_open());
+
+			log::logger logger("test"_sv, log::severity::info, log::severity::off);
+			set_sink(logger, sink);
+
+			logger.log(log::severity::info, "{}"_sv, std::string(100ull, 'x'));
+			logger.log(log::severity::info, "short"_sv);
+			logger.flush();
+
+			REQUIRE(sink.write_count() == 0ull);
+			REQUIRE(sink.failed_write_count() == 2ull);
+		}
+
+		asserts::assert_handler = previousHandler;
+	}
+#endif
+}
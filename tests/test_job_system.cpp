@@ -0,0 +1,283 @@
+#define RYTHE_VALIDATE
+
+#include <rsl/heap_allocator>
+
+namespace
+{
+	class test_heap_allocator : private rsl::heap_allocator
+	{
+	public:
+		using value_type = void;
+		rsl::id_type id = 1012234;
+
+		using rsl::heap_allocator::heap_allocator;
+		explicit constexpr test_heap_allocator(rsl::id_type _id) noexcept
+			: id(_id)
+		{
+		}
+
+		using rsl::heap_allocator::allocate;
+		using rsl::heap_allocator::deallocate;
+		using rsl::heap_allocator::reallocate;
+		using rsl::heap_allocator::is_valid;
+	};
+} // namespace
+
+#define RSL_DEFAULT_ALLOCATOR_OVERRIDE test_heap_allocator
+#include <rsl/threading>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	rsl::uint64 fibonacci(rsl::job_system& jobs, rsl::uint64 n)
+	{
+		if (n < 2)
+		{
+			return n;
+		}
+
+		rsl::uint64 a = 0;
+		rsl::uint64 b = 0;
+		const rsl::job_handle group = jobs.create([]() {});
+		jobs.schedule_child(group, [&]() { a = fibonacci(jobs, n - 1); });
+		jobs.schedule_child(group, [&]() { b = fibonacci(jobs, n - 2); });
+		jobs.run(group);
+		jobs.wait(group);
+
+		return a + b;
+	}
+} // namespace
+
+TEST_CASE("work_stealing_deque", "[threading]")
+{
+	using namespace rsl;
+
+	SECTION("owner")
+	{
+		work_stealing_deque<int*> deque(4);
+		int values[5] = {0, 1, 2, 3, 4};
+		for (int i = 0; i < 4; i++)
+		{
+			REQUIRE(deque.push(&values[i]));
+		}
+		REQUIRE(!deque.push(&values[4]));
+		REQUIRE(deque.size_approx() == 4);
+
+		int* out = nullptr;
+		REQUIRE(deque.steal(out));
+		REQUIRE(out == &values[0]);
+		REQUIRE(deque.pop(out));
+		REQUIRE(out == &values[3]);
+		REQUIRE(deque.pop(out));
+		REQUIRE(out == &values[2]);
+		REQUIRE(deque.pop(out));
+		REQUIRE(out == &values[1]);
+		REQUIRE(!deque.pop(out));
+		REQUIRE(!deque.steal(out));
+		REQUIRE(deque.empty_approx());
+	}
+
+	SECTION("thieves")
+	{
+		constexpr int itemCount = 100000;
+		std::vector<int> values(itemCount);
+		work_stealing_deque<int*> deque(1024);
+		std::atomic<int> taken = 0;
+		std::atomic<long long> sum = 0;
+
+		std::vector<std::thread> thieves;
+		for (int t = 0; t < 3; t++)
+		{
+			thieves.emplace_back(
+				[&]()
+				{
+					int* out;
+					while (taken.load() < itemCount)
+					{
+						if (deque.steal(out))
+						{
+							sum += *out;
+							++taken;
+						}
+						else
+						{
+							std::this_thread::yield();
+						}
+					}
+				}
+			);
+		}
+
+		for (int i = 0; i < itemCount; i++)
+		{
+			values[i] = i;
+			while (!deque.push(&values[i]))
+			{
+				int* out;
+				if (deque.pop(out))
+				{
+					sum += *out;
+					++taken;
+				}
+			}
+		}
+
+		int* out;
+		while (deque.pop(out))
+		{
+			sum += *out;
+			++taken;
+		}
+
+		for (auto& thief : thieves)
+		{
+			thief.join();
+		}
+
+		REQUIRE(taken.load() == itemCount);
+		REQUIRE(sum.load() == static_cast<long long>(itemCount) * (itemCount - 1) / 2);
+	}
+}
+
+TEST_CASE("job_system", "[threading]")
+{
+	using namespace rsl;
+
+	job_system jobs(3, 1024);
+	REQUIRE(jobs.worker_count() == 4);
+
+	SECTION("schedule and wait")
+	{
+		std::atomic<int> counter = 0;
+		std::vector<job_handle> handles;
+		for (int i = 0; i < 500; i++)
+		{
+			handles.push_back(jobs.schedule([&]() { ++counter; }));
+		}
+
+		for (const job_handle& handle : handles)
+		{
+			jobs.wait(handle);
+			REQUIRE(jobs.is_completed(handle));
+		}
+
+		REQUIRE(counter.load() == 500);
+		REQUIRE(!job_system::current_job().valid());
+	}
+
+	SECTION("parent and children")
+	{
+		std::atomic<int> counter = 0;
+		std::atomic<bool> parentRan = false;
+		const job_handle root = jobs.create([&]() { parentRan = true; });
+
+		for (int i = 0; i < 2000; i++)
+		{
+			jobs.schedule_child(root, [&]() { ++counter; });
+		}
+
+		REQUIRE(!jobs.is_completed(root));
+		jobs.run(root);
+		jobs.wait(root);
+
+		REQUIRE(parentRan.load());
+		REQUIRE(counter.load() == 2000);
+	}
+
+	SECTION("nested fork join")
+	{
+		rsl::uint64 result = 0;
+		jobs.wait(jobs.schedule([&]() { result = fibonacci(jobs, 18); }));
+		REQUIRE(result == 2584);
+	}
+
+	SECTION("large callables")
+	{
+		struct payload
+		{
+			rsl::uint64 values[32];
+		};
+
+		payload data{};
+		for (rsl::uint64 i = 0; i < 32; i++)
+		{
+			data.values[i] = i;
+		}
+
+		rsl::uint64 sum = 0;
+		jobs.wait(jobs.schedule(
+			[data, &sum]()
+			{
+				for (rsl::uint64 value : data.values)
+				{
+					sum += value;
+				}
+			}
+		));
+
+		REQUIRE(sum == 496);
+	}
+
+	SECTION("external threads")
+	{
+		std::atomic<int> counter = 0;
+		std::thread external(
+			[&]()
+			{
+				const job_handle root = jobs.create([]() {});
+				for (int i = 0; i < 100; i++)
+				{
+					jobs.schedule_child(root, [&]() { ++counter; });
+				}
+				jobs.run(root);
+				jobs.wait(root);
+			}
+		);
+
+		external.join();
+		REQUIRE(counter.load() == 100);
+	}
+
+	SECTION("parked workers")
+	{
+		// Long enough for every worker to run out of things to do and park.
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+		std::atomic<size_type> workerIndex = npos;
+		const job_handle handle = jobs.schedule([&]() { workerIndex = jobs.current_worker_index(); });
+
+		// Not waiting on the job, so only a worker that woke up can run it.
+		for (int i = 0; i < 1000 && !jobs.is_completed(handle); i++)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		REQUIRE(jobs.is_completed(handle));
+		REQUIRE(workerIndex.load() != 0ull);
+		REQUIRE(workerIndex.load() < jobs.worker_count());
+	}
+
+	SECTION("nested job_system")
+	{
+		REQUIRE(jobs.current_worker_index() == 0ull);
+
+		{
+			// The calling thread stays worker 0 of the first job_system.
+			job_system inner(0, 16);
+			REQUIRE(jobs.current_worker_index() == 0ull);
+			REQUIRE(inner.current_worker_index() == npos);
+
+			int result = 0;
+			inner.wait(inner.schedule([&]() { result = 42; }));
+			REQUIRE(result == 42);
+		}
+
+		REQUIRE(jobs.current_worker_index() == 0ull);
+	}
+}
@@ -0,0 +1,164 @@
+#define RYTHE_VALIDATE
+
+#include <rsl/logging>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+	int countedFormats = 0;
+
+	class counting_flag final : public rsl::log::flag_formatter
+	{
+	public:
+		void format(const rsl::log::message&, const rsl::time::point32, fmt::memory_buffer& dest) override
+		{
+			countedFormats++;
+			dest.push_back('>');
+		}
+	};
+
+	class recording_sink final : public rsl::log::sink
+	{
+	public:
+		void log(const rsl::log::message& msg) override
+		{
+			const rsl::string_view output = format(msg);
+			lines.emplace_back(output.data(), output.size());
+		}
+
+		void flush() override {}
+
+		std::vector<std::string> lines;
+	};
+} // namespace
+
+TEST_CASE("logger", "[logging]")
+{
+	using namespace rsl;
+
+	countedFormats = 0;
+
+	recording_sink plain;
+	recording_sink first;
+	recording_sink second;
+	recording_sink named;
+
+	first.set_formatter<log::pattern_formatter>("{} {}"_sv, counting_flag{}, log::message_text_formatter{});
+	second.set_formatter<log::pattern_formatter>("{} {}"_sv, counting_flag{}, log::message_text_formatter{});
+	named.set_formatter<log::pattern_formatter>(
+		"[{}] {} {}"_sv, log::logger_name_formatter{}, counting_flag{}, log::message_text_formatter{}
+	);
+
+	log::sink* sinks[] = {&plain, &first, &second, &named};
+	log::logger logger("test"_sv, log::severity::info, log::severity::off);
+	logger.set_sinks(array_view<log::sink*>::from_buffer(sinks, 4ull));
+
+	logger.log(log::severity::debug, "filtered {}"_sv, 0);
+	logger.log(log::severity::info, "value {} of {}"_sv, 1, 2);
+	logger.log(log::severity::warn, "plain"_sv);
+
+	REQUIRE(plain.lines == std::vector<std::string>{"value 1 of 2", "plain"});
+	REQUIRE(first.lines == std::vector<std::string>{"> value 1 of 2", "> plain"});
+	REQUIRE(second.lines == first.lines);
+	REQUIRE(named.lines == std::vector<std::string>{"[test] > value 1 of 2", "[test] > plain"});
+
+	// Both sinks with the same pattern share one decoration, the other pattern gets its own.
+	REQUIRE(countedFormats == 4);
+}
+
+TEST_CASE("deferred format", "[logging]")
+{
+	using namespace rsl;
+
+	const char* cstring = "cstring";
+	int value = 3;
+	const auto args = fmt::make_format_args(
+		value, 4u, -5ll, 6ull, false, 'x', 1.5f, 2.25, cstring, fmt::string_view("view"), static_cast<const void*>(nullptr)
+	);
+
+	fmt::memory_buffer encoded;
+	log::encode_format_args(args, encoded);
+
+	fmt::memory_buffer text;
+	const string_view format = "{} {} {} {} {} {} {} {} {} {} {}"_sv;
+	log::format_deferred(format, string_view::from_buffer(encoded.data(), encoded.size()), text);
+
+	const std::string expected = fmt::vformat(fmt::string_view(format.data(), format.size()), args);
+	REQUIRE(std::string(text.data(), text.size()) == expected);
+	REQUIRE(expected == "3 4 -5 6 false x 1.5 2.25 cstring view 0x0");
+}
+
+TEST_CASE("severity stripping", "[logging]")
+{
+	using namespace rsl;
+
+	recording_sink sink;
+	log::sink* sinks[] = {&sink};
+	log::logger logger("test"_sv, log::severity::warn, log::severity::off);
+	logger.set_sinks(array_view<log::sink*>::from_buffer(sinks, 1ull));
+
+	int evaluated = 0;
+	const auto argument = [&evaluated]()
+	{
+		evaluated++;
+		return evaluated;
+	};
+
+	REQUIRE_FALSE(logger.should_log(log::severity::info));
+	REQUIRE(logger.should_log(log::severity::error));
+	REQUIRE_FALSE(logger.should_log(log::severity::off));
+
+	// Filtered at runtime, the arguments are never evaluated.
+	rsl_log_to(logger, log::severity::info, "filtered {}"_sv, argument());
+	REQUIRE(evaluated == 0);
+
+	rsl_log_to(logger, log::severity::error, "logged {}"_sv, argument());
+	REQUIRE(evaluated == 1);
+	REQUIRE(sink.lines == std::vector<std::string>{"logged 1"});
+
+	// Below the compiled severity the call doesn't exist at all.
+	rsl_log_trace("stripped {}", argument());
+	if constexpr (log::severity::trace < log::compiled_severity)
+	{
+		REQUIRE(evaluated == 1);
+	}
+	else
+	{
+		REQUIRE(evaluated == 2);
+	}
+}
+
+TEST_CASE("runtime filter", "[logging]")
+{
+	using namespace rsl;
+
+#if !defined(RYTHE_LOG_TRACE) && !defined(RYTHE_LOG_DEBUG) && !defined(RYTHE_LOG_INFO) && !defined(RYTHE_LOG_WARN) &&      \
+	!defined(RYTHE_LOG_ERROR) && !defined(RYTHE_LOG_FATAL)
+	// Without a RYTHE_LOG_* define nothing is stripped, so filter can still enable trace output in any build.
+	static_assert(log::compiled_severity == log::severity::trace);
+
+	int evaluated = 0;
+	rsl_log_trace("kept {}", ++evaluated);
+	rsl_log_debug("kept {}", ++evaluated);
+	REQUIRE(evaluated == 2);
+#endif
+
+	auto& context = logging_context::get();
+	const logger_ptr previous = context.logger;
+	setDefaultLogger(context.consoleLogger);
+
+	log::filter(log::severity::trace);
+	REQUIRE(context.logger->level() == spdlog::level::trace);
+	REQUIRE(context.undecoratedLogger->level() == spdlog::level::trace);
+	log::trace("trace {}", 1);
+	log::debug("debug {}", 2);
+
+	log::filter(log::severity::info);
+	REQUIRE(context.logger->level() == spdlog::level::info);
+
+	setDefaultLogger(previous);
+}
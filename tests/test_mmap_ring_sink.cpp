@@ -0,0 +1,225 @@
+#define RYTHE_VALIDATE
+
+#include <rsl/logging>
+#include <rsl/threading>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#if RYTHE_PLATFORM_LINUX
+	#include <sys/wait.h>
+	#include <unistd.h>
+#endif
+
+namespace
+{
+	struct ring_file
+	{
+		ring_file()
+			: path((std::filesystem::temp_directory_path() / "rsl_mmap_ring_test.ring").string())
+		{
+			std::filesystem::remove(path);
+		}
+
+		~ring_file() { std::filesystem::remove(path); }
+
+		rsl::string_view view() const { return rsl::string_view::from_buffer(path.data(), path.size()); }
+
+		std::string path;
+	};
+
+	struct read_back
+	{
+		std::vector<rsl::uint64> sequences;
+		std::vector<std::string> messages;
+	};
+
+	read_back read_ring(const ring_file& file)
+	{
+		rsl::log::mmap_ring_reader reader(file.view());
+		REQUIRE(reader.is_open());
+
+		read_back result;
+		rsl::log::mmap_ring_record record;
+		fmt::memory_buffer text;
+		while (reader.next(record))
+		{
+			text.clear();
+			record.format_to(text);
+			result.sequences.push_back(record.sequence);
+			result.messages.emplace_back(text.data(), text.size());
+		}
+		return result;
+	}
+
+	void set_sink(rsl::log::basic_logger& logger, rsl::log::sink& sink)
+	{
+		rsl::log::sink* sinks[] = {&sink};
+		logger.set_sinks(rsl::array_view<rsl::log::sink*>::from_buffer(sinks, 1ull));
+	}
+} // namespace
+
+TEST_CASE("mmap_ring_sink", "[logging][mmap_ring_sink]")
+{
+	using namespace rsl;
+
+	ring_file file;
+
+	SECTION("wraps around and keeps the newest records")
+	{
+		constexpr int messageCount = 5000;
+		{
+			log::mmap_ring_sink sink(file.view(), 4096ull);
+			REQUIRE(sink.is_open());
+
+			log::logger logger("test"_sv, log::severity::info, log::severity::off);
+			set_sink(logger, sink);
+
+			for (int i = 0; i < messageCount; i++)
+			{
+				// Varying lengths so laps end at different offsets.
+				logger.log(log::severity::info, "message {} {}"_sv, i, std::string(static_cast<size_t>(i % 37), '.'));
+			}
+		}
+
+		const read_back ring = read_ring(file);
+		REQUIRE(ring.messages.size() > 10ull);
+		REQUIRE(ring.sequences.back() == static_cast<uint64>(messageCount));
+
+		const int first = messageCount - static_cast<int>(ring.messages.size());
+		for (size_t i = 0ull; i < ring.messages.size(); i++)
+		{
+			const int index = first + static_cast<int>(i);
+			REQUIRE(ring.sequences[i] == static_cast<uint64>(index + 1));
+			REQUIRE(ring.messages[i] == "message " + std::to_string(index) + " " + std::string(static_cast<size_t>(index % 37), '.'));
+		}
+	}
+
+	SECTION("binary records")
+	{
+		{
+			log::mmap_ring_sink sink(file.view(), 4096ull);
+			sink.store_binary(true);
+
+			log::logger logger("test"_sv, log::severity::info, log::severity::off);
+			set_sink(logger, sink);
+
+			logger.log(log::severity::info, "{} + {} = {:.1f}"_sv, 1, 2u, 3.0);
+			logger.log(log::severity::warn, "no arguments {{}}"_sv);
+		}
+		const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::system_clock::now().time_since_epoch()
+		);
+
+		log::mmap_ring_reader reader(file.view());
+		log::mmap_ring_record record;
+		fmt::memory_buffer text;
+
+		REQUIRE(reader.next(record));
+		REQUIRE(record.kind == log::mmap_record_kind::binary);
+		REQUIRE(record.severity == log::severity::info);
+		REQUIRE(record.threadId == current_thread::get_id());
+		REQUIRE(record.timestamp <= (now + std::chrono::seconds(1)).count());
+		REQUIRE(record.timestamp > (now - std::chrono::seconds(10)).count());
+		record.format_to(text);
+		REQUIRE(std::string(text.data(), text.size()) == "1 + 2 = 3.0");
+
+		REQUIRE(reader.next(record));
+		REQUIRE(record.kind == log::mmap_record_kind::text);
+		REQUIRE(record.severity == log::severity::warn);
+		REQUIRE(std::string_view(record.payload.data(), record.payload.size()) == "no arguments {}");
+
+		REQUIRE_FALSE(reader.next(record));
+	}
+
+	SECTION("continues an existing ring")
+	{
+		for (int run = 0; run < 3; run++)
+		{
+			log::mmap_ring_sink sink(file.view(), 4096ull);
+			log::logger logger("test"_sv, log::severity::info, log::severity::off);
+			set_sink(logger, sink);
+			logger.log(log::severity::info, "run {}"_sv, run);
+		}
+
+		const read_back ring = read_ring(file);
+		REQUIRE(ring.messages == std::vector<std::string>{"run 0", "run 1", "run 2"});
+		REQUIRE(ring.sequences == std::vector<uint64>{1ull, 2ull, 3ull});
+
+		// A different capacity starts over.
+		{
+			log::mmap_ring_sink sink(file.view(), 8192ull);
+		}
+		REQUIRE(read_ring(file).messages.empty());
+	}
+
+#if RYTHE_PLATFORM_LINUX
+	SECTION("survives the process dying")
+	{
+		const pid_t child = fork();
+		REQUIRE(child >= 0);
+		if (child == 0)
+		{
+			log::mmap_ring_sink sink(file.view(), 4096ull);
+			log::logger logger("test"_sv, log::severity::info, log::severity::off);
+			set_sink(logger, sink);
+
+			for (int i = 0; i < 10; i++)
+			{
+				logger.log(log::severity::info, "last words {}"_sv, i);
+			}
+			// No destructors, no flushes.
+			_exit(0);
+		}
+
+		int status = 0;
+		waitpid(child, &status, 0);
+
+		const read_back ring = read_ring(file);
+		REQUIRE(ring.messages.size() == 10ull);
+		REQUIRE(ring.messages.back() == "last words 9");
+	}
+#endif
+
+	SECTION("missing or foreign files")
+	{
+		REQUIRE_FALSE(log::mmap_ring_reader(file.view()).is_open());
+
+		std::FILE* foreign = std::fopen(file.path.c_str(), "wb");
+		std::fputs("not a ring", foreign);
+		std::fclose(foreign);
+		REQUIRE_FALSE(log::mmap_ring_reader(file.view()).is_open());
+	}
+}
+
+TEST_CASE("mmap_ring_sink benchmark", "[.][benchmark][logging][mmap_ring_sink]")
+{
+	using namespace rsl;
+
+	constexpr int messageCount = 1000000;
+
+	ring_file file;
+	log::mmap_ring_sink sink(file.view());
+	log::logger logger("bench"_sv, log::severity::trace, log::severity::off);
+	set_sink(logger, sink);
+
+	const auto measure = [&logger](const char* name)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < messageCount; i++)
+		{
+			logger.log(log::severity::trace, "trace {} value {}"_sv, i, 0.5 * static_cast<double>(i));
+		}
+		const double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+		std::printf("%s: %.0f ns per message\n", name, elapsed / messageCount);
+	};
+
+	measure("mmap_ring_sink text");
+	sink.store_binary(true);
+	measure("mmap_ring_sink binary");
+}
@@ -0,0 +1,200 @@
+#define RYTHE_VALIDATE
+
+#include <rsl/heap_allocator>
+
+namespace
+{
+	class test_heap_allocator : private rsl::heap_allocator
+	{
+	public:
+		using value_type = void;
+		rsl::id_type id = 1012234;
+
+		using rsl::heap_allocator::heap_allocator;
+		explicit constexpr test_heap_allocator(rsl::id_type _id) noexcept
+			: id(_id)
+		{
+		}
+
+		using rsl::heap_allocator::allocate;
+		using rsl::heap_allocator::deallocate;
+		using rsl::heap_allocator::reallocate;
+		using rsl::heap_allocator::is_valid;
+	};
+} // namespace
+
+#define RSL_DEFAULT_ALLOCATOR_OVERRIDE test_heap_allocator
+#include <rsl/threading>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+TEST_CASE("parallel algorithms", "[threading]")
+{
+	using namespace rsl;
+
+	job_system jobs(3, 1024);
+
+	SECTION("parallel_for")
+	{
+		std::vector<int> values(100000, 1);
+		auto view = array_view<int>::from_buffer(values.data(), values.size());
+
+		parallel_for(jobs, view, [](int& value) { value *= 3; });
+		REQUIRE(std::all_of(values.begin(), values.end(), [](const int value) { return value == 3; }));
+
+		// Every element exactly once, also when the grain size doesn't divide the range.
+		std::vector<std::atomic<int>> visits(1001);
+		auto visitView = array_view<std::atomic<int>>::from_buffer(visits.data(), visits.size());
+		parallel_for(jobs, visitView, [](std::atomic<int>& count) { ++count; }, 7);
+		REQUIRE(std::all_of(visits.begin(), visits.end(), [](const std::atomic<int>& count) { return count.load() == 1; }));
+
+		int empty = 0;
+		parallel_for(jobs, array_view<int>::from_buffer(&empty, 0), [](int& value) { value = 1; });
+		REQUIRE(empty == 0);
+
+		iterator_view<int> iterView(values.data(), values.size());
+		parallel_for(jobs, iterView, [](int& value) { value = 5; }, 100);
+		REQUIRE(std::all_of(values.begin(), values.end(), [](const int value) { return value == 5; }));
+	}
+
+	SECTION("parallel_reduce")
+	{
+		std::vector<rsl::uint64> values(250000);
+		for (size_t i = 0; i < values.size(); i++)
+		{
+			values[i] = i;
+		}
+		auto view = array_view<rsl::uint64>::from_buffer(values.data(), values.size());
+		const auto add = [](const rsl::uint64 lhs, const rsl::uint64 rhs) { return lhs + rhs; };
+
+		const rsl::uint64 expected = static_cast<rsl::uint64>(values.size()) * (values.size() - 1) / 2;
+		REQUIRE(parallel_reduce(jobs, view, rsl::uint64{0}, add) == expected);
+		REQUIRE(parallel_reduce(jobs, view, rsl::uint64{0}, add, 13) == expected);
+		REQUIRE(parallel_reduce(jobs, view.subview(0, 10), rsl::uint64{0}, add) == 45);
+		REQUIRE(parallel_reduce(jobs, view.subview(0, 0), rsl::uint64{7}, add) == 7);
+
+		const auto max = [](const rsl::uint64 lhs, const rsl::uint64 rhs) { return lhs > rhs ? lhs : rhs; };
+		REQUIRE(parallel_reduce(jobs, view, rsl::uint64{0}, max) == values.size() - 1);
+	}
+
+	SECTION("parallel_sort")
+	{
+		std::mt19937 rng(1234);
+		for (const size_t count : {size_t{0}, size_t{1}, size_t{100}, size_t{5000}, size_t{100003}})
+		{
+			std::vector<int> values(count);
+			for (int& value : values)
+			{
+				value = static_cast<int>(rng() % 1000);
+			}
+			std::vector<int> expected = values;
+			std::sort(expected.begin(), expected.end());
+
+			parallel_sort(jobs, array_view<int>::from_buffer(values.data(), values.size()), std::less<>{}, 16);
+			REQUIRE(values == expected);
+		}
+
+		std::vector<int> values(50000);
+		for (int& value : values)
+		{
+			value = static_cast<int>(rng());
+		}
+		std::vector<int> expected = values;
+		std::sort(expected.begin(), expected.end(), std::greater<>{});
+
+		parallel_sort(jobs, array_view<int>::from_buffer(values.data(), values.size()), std::greater<>{});
+		REQUIRE(values == expected);
+
+		// Elements that aren't trivially copyable get moved through the scratch buffer and back.
+		std::vector<std::string> strings(3000);
+		for (std::string& str : strings)
+		{
+			str = std::to_string(rng()) + " is long enough to not fit in the small string buffer";
+		}
+		std::vector<std::string> expectedStrings = strings;
+		std::sort(expectedStrings.begin(), expectedStrings.end());
+
+		parallel_sort(jobs, array_view<std::string>::from_buffer(strings.data(), strings.size()), std::less<>{}, 100);
+		REQUIRE(strings == expectedStrings);
+	}
+
+	SECTION("shared job_system")
+	{
+		std::vector<int> values(10000);
+		for (size_t i = 0; i < values.size(); i++)
+		{
+			values[i] = static_cast<int>(values.size() - i);
+		}
+		auto view = array_view<int>::from_buffer(values.data(), values.size());
+
+		parallel_sort(view);
+		REQUIRE(std::is_sorted(values.begin(), values.end()));
+
+		parallel_for(view, [](int& value) { value = 2; });
+		REQUIRE(parallel_reduce(view, 0, [](const int lhs, const int rhs) { return lhs + rhs; }) == 20000);
+	}
+}
+
+TEST_CASE("parallel algorithms benchmark", "[.][benchmark]")
+{
+	using namespace rsl;
+
+	job_system& jobs = job_system::shared();
+
+	constexpr size_t count = 4000000;
+	std::vector<float> values(count);
+	std::mt19937 rng(42);
+	std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+	for (float& value : values)
+	{
+		value = distribution(rng);
+	}
+	auto view = array_view<float>::from_buffer(values.data(), values.size());
+
+	const auto time = [](auto&& func)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		func();
+		const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+		return elapsed.count();
+	};
+
+	double serialSum = 0.0;
+	const double serialReduce = time(
+		[&]()
+		{
+			for (const float value : values)
+			{
+				serialSum += value;
+			}
+		}
+	);
+
+	double parallelSum = 0.0;
+	const double parallelReduce = time(
+		[&]() { parallelSum = parallel_reduce(jobs, view, 0.0, [](const double lhs, const double rhs) { return lhs + rhs; }); }
+	);
+
+	std::printf(
+		"reduce %zu floats, %zu workers: serial %.2f ms, parallel %.2f ms (sums %.1f, %.1f)\n", count, jobs.worker_count(),
+		serialReduce, parallelReduce, serialSum, parallelSum
+	);
+
+	std::vector<float> copy = values;
+	const double serialSort = time([&]() { std::sort(copy.begin(), copy.end()); });
+	const double parallelSort = time([&]() { parallel_sort(jobs, view); });
+	REQUIRE(values == copy);
+
+	std::printf(
+		"sort %zu floats, %zu workers: std::sort %.2f ms, parallel_sort %.2f ms\n", count, jobs.worker_count(),
+		serialSort, parallelSort
+	);
+}
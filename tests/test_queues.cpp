@@ -0,0 +1,508 @@
+#define RYTHE_VALIDATE
+
+#include <rsl/heap_allocator>
+
+namespace
+{
+	class test_heap_allocator : private rsl::heap_allocator
+	{
+	public:
+		using value_type = void;
+		rsl::id_type id = 1012234;
+
+		using rsl::heap_allocator::heap_allocator;
+		explicit constexpr test_heap_allocator(rsl::id_type _id) noexcept
+			: id(_id)
+		{
+		}
+
+		using rsl::heap_allocator::allocate;
+		using rsl::heap_allocator::deallocate;
+		using rsl::heap_allocator::reallocate;
+		using rsl::heap_allocator::is_valid;
+	};
+} // namespace
+
+#define RSL_DEFAULT_ALLOCATOR_OVERRIDE test_heap_allocator
+#include <rsl/threading>
+#include <rsl/time>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	struct counted
+	{
+		static inline std::atomic<int> alive = 0;
+		int value = 0;
+
+		counted() { ++alive; }
+		counted(int v)
+			: value(v)
+		{
+			++alive;
+		}
+		counted(const counted& other)
+			: value(other.value)
+		{
+			++alive;
+		}
+		counted(counted&& other) noexcept
+			: value(other.value)
+		{
+			++alive;
+		}
+		counted& operator=(const counted&) = default;
+		counted& operator=(counted&&) noexcept = default;
+		~counted() { --alive; }
+	};
+
+	struct move_only
+	{
+		int value = 0;
+
+		move_only() = default;
+		move_only(int v)
+			: value(v)
+		{
+		}
+		move_only(const move_only&) = delete;
+		move_only(move_only&& other) noexcept
+			: value(other.value)
+		{
+			other.value = 0;
+		}
+		move_only& operator=(const move_only&) = delete;
+		move_only& operator=(move_only&& other) noexcept
+		{
+			value = other.value;
+			other.value = 0;
+			return *this;
+		}
+	};
+} // namespace
+
+TEST_CASE("spsc_queue", "[threading]")
+{
+	using namespace rsl;
+
+	SECTION("construction")
+	{
+		{
+			rsl::spsc_queue<int, 8> queue{};
+			REQUIRE(queue.get_allocator().id == 1012234);
+			REQUIRE(queue.empty());
+			REQUIRE(queue.capacity() == 8);
+		}
+		{
+			test_heap_allocator alloc{1234};
+			rsl::spsc_queue<int, 8, test_heap_allocator> queue{alloc};
+			REQUIRE(queue.get_allocator().id == 1234);
+		}
+	}
+
+	SECTION("push and pop")
+	{
+		rsl::spsc_queue<int, 4> queue{};
+		REQUIRE(queue.try_push(1));
+		REQUIRE(queue.try_push(2));
+		REQUIRE(queue.try_emplace(3));
+		REQUIRE(queue.try_push(4));
+		REQUIRE(!queue.try_push(5));
+		REQUIRE(queue.size() == 4);
+
+		int value = 0;
+		for (int i = 1; i <= 4; i++)
+		{
+			REQUIRE(queue.try_pop(value));
+			REQUIRE(value == i);
+		}
+
+		REQUIRE(!queue.try_pop(value));
+		REQUIRE(queue.empty());
+	}
+
+	SECTION("bulk")
+	{
+		rsl::spsc_queue<int, 8> queue{};
+		int input[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+		REQUIRE(queue.try_push_bulk(array_view<int>::from_array(input)) == 8);
+		REQUIRE(queue.try_push_bulk(array_view<int>::from_array(input)) == 0);
+
+		int output[5] = {};
+		REQUIRE(queue.try_pop_bulk(array_view<int>::from_array(output)) == 5);
+		REQUIRE(output[0] == 0);
+		REQUIRE(output[4] == 4);
+		REQUIRE(queue.try_pop_bulk(array_view<int>::from_array(output)) == 3);
+		REQUIRE(output[2] == 7);
+		REQUIRE(queue.try_pop_bulk(array_view<int>::from_array(output)) == 0);
+	}
+
+	SECTION("move only and lifetime")
+	{
+		{
+			rsl::spsc_queue<move_only, 4> queue{};
+			REQUIRE(queue.try_push(move_only{42}));
+			move_only out;
+			REQUIRE(queue.try_pop(out));
+			REQUIRE(out.value == 42);
+		}
+		{
+			rsl::spsc_queue<counted, 8> queue{};
+			for (int i = 0; i < 5; i++)
+			{
+				REQUIRE(queue.try_emplace(i));
+			}
+
+			counted out;
+			REQUIRE(queue.try_pop(out));
+			REQUIRE(counted::alive == 5);
+		}
+
+		REQUIRE(counted::alive == 0);
+	}
+
+	SECTION("threaded")
+	{
+		constexpr int itemCount = 100000;
+		rsl::spsc_queue<int, 64> queue{};
+
+		std::thread producer(
+			[&]()
+			{
+				for (int i = 0; i < itemCount; i++)
+				{
+					while (!queue.try_push(i))
+					{
+						std::this_thread::yield();
+					}
+				}
+			}
+		);
+
+		bool inOrder = true;
+		int expected = 0;
+		while (expected < itemCount)
+		{
+			int value;
+			if (queue.try_pop(value))
+			{
+				inOrder &= value == expected;
+				expected++;
+			}
+		}
+
+		producer.join();
+		REQUIRE(inOrder);
+		REQUIRE(queue.empty());
+	}
+}
+
+TEST_CASE("mpmc_queue", "[threading]")
+{
+	using namespace rsl;
+
+	SECTION("construction")
+	{
+		{
+			rsl::mpmc_queue<int> queue{16};
+			REQUIRE(queue.get_allocator().id == 1012234);
+			REQUIRE(queue.capacity() == 16);
+			REQUIRE(queue.size_approx() == 0);
+		}
+		{
+			test_heap_allocator alloc{1234};
+			rsl::mpmc_queue<int, test_heap_allocator> queue{16, alloc};
+			REQUIRE(queue.get_allocator().id == 1234);
+		}
+	}
+
+	SECTION("push and pop")
+	{
+		rsl::mpmc_queue<int> queue{4};
+		for (int i = 0; i < 4; i++)
+		{
+			REQUIRE(queue.try_push(i));
+		}
+
+		REQUIRE(!queue.try_push(4));
+
+		int value = 0;
+		for (int i = 0; i < 4; i++)
+		{
+			REQUIRE(queue.try_pop(value));
+			REQUIRE(value == i);
+		}
+
+		REQUIRE(!queue.try_pop(value));
+	}
+
+	SECTION("move only and lifetime")
+	{
+		{
+			rsl::mpmc_queue<move_only> queue{4};
+			REQUIRE(queue.try_push(move_only{7}));
+			move_only out;
+			REQUIRE(queue.try_pop(out));
+			REQUIRE(out.value == 7);
+		}
+		{
+			rsl::mpmc_queue<counted> queue{8};
+			for (int i = 0; i < 3; i++)
+			{
+				REQUIRE(queue.try_emplace(i));
+			}
+		}
+
+		REQUIRE(counted::alive == 0);
+	}
+
+	SECTION("threaded")
+	{
+		constexpr int producerCount = 4;
+		constexpr int consumerCount = 4;
+		constexpr int itemsPerProducer = 20000;
+
+		rsl::mpmc_queue<int> queue{256};
+		std::atomic<long long> sum = 0;
+		std::atomic<int> consumed = 0;
+
+		std::vector<std::thread> threads;
+		for (int p = 0; p < producerCount; p++)
+		{
+			threads.emplace_back(
+				[&]()
+				{
+					for (int i = 1; i <= itemsPerProducer; i++)
+					{
+						while (!queue.try_push(i))
+						{
+							std::this_thread::yield();
+						}
+					}
+				}
+			);
+		}
+
+		for (int c = 0; c < consumerCount; c++)
+		{
+			threads.emplace_back(
+				[&]()
+				{
+					int value;
+					while (consumed.load() < producerCount * itemsPerProducer)
+					{
+						if (queue.try_pop(value))
+						{
+							sum += value;
+							++consumed;
+						}
+					}
+				}
+			);
+		}
+
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+
+		constexpr long long expectedSum = static_cast<long long>(itemsPerProducer) * (itemsPerProducer + 1) / 2 * producerCount;
+		REQUIRE(consumed.load() == producerCount * itemsPerProducer);
+		REQUIRE(sum.load() == expectedSum);
+	}
+}
+
+// Hidden by default, run with: test_executable "[benchmark]"
+TEST_CASE("queue benchmark", "[.][benchmark][threading]")
+{
+	using namespace rsl;
+
+	constexpr rsl::size_type itemCount = 2000000;
+	const int maxThreads = static_cast<int>(std::thread::hardware_concurrency() / 2u) > 1 ? static_cast<int>(std::thread::hardware_concurrency() / 2u) : 1;
+
+	{
+		rsl::spsc_queue<rsl::uint64, 1024> queue{};
+		time::stopwatch<time64> watch;
+
+		std::thread producer(
+			[&]()
+			{
+				for (rsl::uint64 i = 0; i < itemCount; i++)
+				{
+					while (!queue.try_push(i))
+					{
+						std::this_thread::yield();
+					}
+				}
+			}
+		);
+
+		rsl::uint64 value;
+		for (rsl::size_type i = 0; i < itemCount; i++)
+		{
+			while (!queue.try_pop(value))
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		producer.join();
+		const auto elapsed = watch.elapsed_time();
+		std::printf("spsc_queue single: %.1f Mops/s\n", static_cast<double>(itemCount) / elapsed.microseconds<time64>());
+	}
+
+	{
+		rsl::spsc_queue<rsl::uint64, 1024> queue{};
+		time::stopwatch<time64> watch;
+
+		std::thread producer(
+			[&]()
+			{
+				rsl::uint64 batch[64];
+				for (rsl::uint64 i = 0; i < itemCount; i += 64)
+				{
+					for (rsl::uint64 j = 0; j < 64; j++)
+					{
+						batch[j] = i + j;
+					}
+
+					rsl::size_type pushed = 0;
+					while (pushed < 64)
+					{
+						pushed += queue.try_push_bulk(array_view<rsl::uint64>::from_buffer(batch + pushed, 64 - pushed));
+						if (pushed < 64)
+						{
+							std::this_thread::yield();
+						}
+					}
+				}
+			}
+		);
+
+		rsl::uint64 batch[64];
+		rsl::size_type received = 0;
+		while (received < itemCount)
+		{
+			const rsl::size_type count = queue.try_pop_bulk(array_view<rsl::uint64>::from_array(batch));
+			if (count == 0)
+			{
+				std::this_thread::yield();
+			}
+
+			received += count;
+		}
+
+		producer.join();
+		const auto elapsed = watch.elapsed_time();
+		std::printf("spsc_queue bulk(64): %.1f Mops/s\n", static_cast<double>(itemCount) / elapsed.microseconds<time64>());
+	}
+
+	{
+		constexpr rsl::size_type roundTrips = 100000;
+		rsl::spsc_queue<rsl::uint64, 2> ping{};
+		rsl::spsc_queue<rsl::uint64, 2> pong{};
+
+		std::thread echo(
+			[&]()
+			{
+				rsl::uint64 value;
+				for (rsl::size_type i = 0; i < roundTrips; i++)
+				{
+					while (!ping.try_pop(value))
+					{
+						std::this_thread::yield();
+					}
+					while (!pong.try_push(value))
+					{
+						std::this_thread::yield();
+					}
+				}
+			}
+		);
+
+		time::stopwatch<time64> watch;
+		rsl::uint64 value;
+		for (rsl::size_type i = 0; i < roundTrips; i++)
+		{
+			while (!ping.try_push(i))
+			{
+				std::this_thread::yield();
+			}
+			while (!pong.try_pop(value))
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		const auto elapsed = watch.elapsed_time();
+		echo.join();
+		std::printf("spsc_queue round trip latency: %.0f ns\n", elapsed.nanoseconds<time64>() / static_cast<double>(roundTrips));
+	}
+
+	for (int producers = 1; producers <= maxThreads; producers *= 2)
+	{
+		for (int consumers = 1; consumers <= maxThreads; consumers *= 2)
+		{
+			rsl::mpmc_queue<rsl::uint64> queue{1024};
+			std::atomic<rsl::size_type> consumed = 0;
+			const rsl::size_type perProducer = itemCount / static_cast<rsl::size_type>(producers);
+			const rsl::size_type total = perProducer * static_cast<rsl::size_type>(producers);
+
+			time::stopwatch<time64> watch;
+			std::vector<std::thread> threads;
+			for (int p = 0; p < producers; p++)
+			{
+				threads.emplace_back(
+					[&]()
+					{
+						for (rsl::uint64 i = 0; i < perProducer; i++)
+						{
+							while (!queue.try_push(i))
+							{
+								std::this_thread::yield();
+							}
+						}
+					}
+				);
+			}
+
+			for (int c = 0; c < consumers; c++)
+			{
+				threads.emplace_back(
+					[&]()
+					{
+						rsl::uint64 value;
+						while (consumed.load(std::memory_order_relaxed) < total)
+						{
+							if (queue.try_pop(value))
+							{
+								consumed.fetch_add(1, std::memory_order_relaxed);
+							}
+							else
+							{
+								std::this_thread::yield();
+							}
+						}
+					}
+				);
+			}
+
+			for (auto& thread : threads)
+			{
+				thread.join();
+			}
+
+			const auto elapsed = watch.elapsed_time();
+			std::printf(
+				"mpmc_queue %dP/%dC: %.1f Mops/s\n", producers, consumers, static_cast<double>(total) / elapsed.microseconds<time64>()
+			);
+		}
+	}
+
+	SUCCEED();
+}
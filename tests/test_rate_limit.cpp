@@ -0,0 +1,210 @@
+#define RYTHE_VALIDATE
+
+#include <rsl/logging>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace
+{
+	class recording_sink final : public rsl::log::sink
+	{
+	public:
+		void log(const rsl::log::message& msg) override
+		{
+			const rsl::string_view output = format(msg);
+			lines.emplace_back(output.data(), output.size());
+		}
+
+		void flush() override {}
+
+		std::vector<std::string> lines;
+	};
+} // namespace
+
+TEST_CASE("callsite_limiter", "[logging][rate_limit]")
+{
+	using namespace rsl;
+
+	uint64 suppressed = 0ull;
+
+	SECTION("token bucket")
+	{
+		log::callsite_limiter<log::token_bucket> limiter({.messagesPerSecond = 10.0, .burst = 3u}, source_location::current());
+
+		// A burst of 3, then one every 100ms.
+		REQUIRE(limiter.admit(0ll, suppressed));
+		REQUIRE(limiter.admit(0ll, suppressed));
+		REQUIRE(limiter.admit(0ll, suppressed));
+		REQUIRE_FALSE(limiter.admit(0ll, suppressed));
+		REQUIRE_FALSE(limiter.admit(50000000ll, suppressed));
+
+		REQUIRE(limiter.admit(100000000ll, suppressed));
+		REQUIRE(suppressed == 2ull);
+		REQUIRE_FALSE(limiter.admit(150000000ll, suppressed));
+
+		// Refills completely after a quiet period.
+		REQUIRE(limiter.admit(10000000000ll, suppressed));
+		REQUIRE(suppressed == 1ull);
+		REQUIRE(limiter.admit(10000000000ll, suppressed));
+		REQUIRE(limiter.admit(10000000000ll, suppressed));
+		REQUIRE(suppressed == 0ull);
+		REQUIRE_FALSE(limiter.admit(10000000000ll, suppressed));
+		REQUIRE(limiter.suppressed_count() == 4ull);
+	}
+
+	SECTION("first n every kth")
+	{
+		log::callsite_limiter<log::first_n_every_kth> limiter({.first = 3ull, .every = 4ull}, source_location::current());
+
+		std::vector<int> passed;
+		for (int i = 0; i < 20; i++)
+		{
+			if (limiter.admit(suppressed))
+			{
+				passed.push_back(i);
+			}
+		}
+
+		REQUIRE(passed == std::vector<int>{0, 1, 2, 6, 10, 14, 18});
+		REQUIRE(limiter.suppressed_count() == 13ull);
+
+		log::callsite_limiter<log::first_n_every_kth> onlyFirst({.first = 1ull, .every = 0ull}, source_location::current());
+		REQUIRE(onlyFirst.admit(suppressed));
+		REQUIRE_FALSE(onlyFirst.admit(suppressed));
+		REQUIRE_FALSE(onlyFirst.admit(suppressed));
+	}
+
+	SECTION("sampled")
+	{
+		log::callsite_limiter<log::sampled> never({.probability = 0.0}, source_location::current());
+		log::callsite_limiter<log::sampled> always({.probability = 1.0}, source_location::current());
+		log::callsite_limiter<log::sampled> quarter({.probability = 0.25}, source_location::current());
+
+		int quarterPassed = 0;
+		for (int i = 0; i < 10000; i++)
+		{
+			REQUIRE_FALSE(never.admit(suppressed));
+			REQUIRE(always.admit(suppressed));
+			quarterPassed += quarter.admit(suppressed) ? 1 : 0;
+		}
+
+		REQUIRE(never.suppressed_count() == 10000ull);
+		REQUIRE(always.suppressed_count() == 0ull);
+		REQUIRE(quarterPassed > 2000);
+		REQUIRE(quarterPassed < 3000);
+	}
+}
+
+TEST_CASE("rsl_log_limited", "[logging][rate_limit]")
+{
+	using namespace rsl;
+
+	recording_sink sink;
+	log::sink* sinks[] = {&sink};
+	log::logger logger("test"_sv, log::severity::info, log::severity::off);
+	logger.set_sinks(array_view<log::sink*>::from_buffer(sinks, 1ull));
+
+	uint32 line = 0u;
+	for (int i = 0; i < 10; i++)
+	{
+		// Filtered messages don't count towards the limit.
+		rsl_log_limited(logger, log::severity::debug, (log::first_n_every_kth{1ull, 4ull}), "filtered {}"_sv, i);
+
+		line = source_location::current().line() + 1u;
+		rsl_log_limited(logger, log::severity::error, (log::first_n_every_kth{1ull, 4ull}), "storm {}"_sv, i);
+	}
+
+	const std::string summary = "3 similar messages suppressed at " __FILE__ ":" + std::to_string(line);
+	REQUIRE(sink.lines == std::vector<std::string>{"storm 0", "storm 4", summary, "storm 8", summary});
+}
+
+TEST_CASE("rsl_log_limited storm that stops", "[logging][rate_limit]")
+{
+	using namespace rsl;
+
+	recording_sink sink;
+	log::sink* sinks[] = {&sink};
+
+	std::vector<uint32> lines;
+	const auto storm = [&lines](log::basic_logger& logger, const int count)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			lines.push_back(source_location::current().line() + 1u);
+			rsl_log_limited(logger, log::severity::error, (log::first_n_every_kth{1ull, 0ull}), "storm {}"_sv, i);
+		}
+		for (int i = 0; i < count; i++)
+		{
+			lines.push_back(source_location::current().line() + 1u);
+			rsl_log_limited(logger, log::severity::warn, log::sampled{0.0}, "sampled {}"_sv, i);
+		}
+	};
+	const auto summary = [&lines](const uint64 count, const size_type index)
+	{ return std::to_string(count) + " similar messages suppressed at " __FILE__ ":" + std::to_string(lines[index]); };
+
+	{
+		log::logger logger("test"_sv, log::severity::info, log::severity::off);
+		logger.set_sinks(array_view<log::sink*>::from_buffer(sinks, 1ull));
+
+		storm(logger, 10);
+		REQUIRE(sink.lines == std::vector<std::string>{"storm 0"});
+
+		// Nothing gets through anymore, the suppressions only show up once the logger is flushed.
+		logger.flush();
+		REQUIRE(sink.lines == std::vector<std::string>{"storm 0", summary(9ull, 0ull), summary(10ull, 10ull)});
+
+		logger.flush();
+		REQUIRE(sink.lines.size() == 3ull);
+	}
+
+	// The callsites get tracked again by the next logger.
+	sink.lines.clear();
+	lines.clear();
+	{
+		log::async_logger logger("async"_sv, log::overflow_policy::block, 64ull, log::severity::info, log::severity::off);
+		logger.set_sinks(array_view<log::sink*>::from_buffer(sinks, 1ull));
+
+		storm(logger, 3);
+		logger.flush();
+		REQUIRE(sink.lines == std::vector<std::string>{summary(3ull, 0ull), summary(3ull, 3ull)});
+	}
+}
+
+TEST_CASE("rate limit benchmark", "[.][benchmark][logging][rate_limit]")
+{
+	using namespace rsl;
+
+	constexpr int messageCount = 10000000;
+
+	log::logger logger("bench"_sv, log::severity::trace, log::severity::off);
+
+	const auto measure = [](const char* name, auto&& statement)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < messageCount; i++)
+		{
+			statement(i);
+		}
+		const double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+		std::printf("%s: %.1f ns per statement\n", name, elapsed / messageCount);
+	};
+
+	// Everything after the first message gets suppressed, which is what an error storm costs.
+	measure(
+		"token bucket",
+		[&logger](int i) { rsl_log_limited(logger, log::severity::error, (log::token_bucket{1.0, 1u}), "{}"_sv, i); }
+	);
+	measure(
+		"first n every kth",
+		[&logger](int i)
+		{ rsl_log_limited(logger, log::severity::error, (log::first_n_every_kth{1ull, 0ull}), "{}"_sv, i); }
+	);
+	measure(
+		"sampled", [&logger](int i) { rsl_log_limited(logger, log::severity::error, log::sampled{0.0}, "{}"_sv, i); }
+	);
+}
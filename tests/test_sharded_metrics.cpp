@@ -0,0 +1,257 @@
+#define RYTHE_VALIDATE
+
+#include <rsl/threading>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	template <typename Func>
+	void run_on_threads(const rsl::size_type threadCount, Func&& func)
+	{
+		std::vector<std::thread> threads;
+		for (rsl::size_type i = 0ull; i < threadCount; i++)
+		{
+			threads.emplace_back(func);
+		}
+
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+	}
+
+	bool has_name(const rsl::string_view name, const std::string_view expected)
+	{
+		return std::string_view(name.data(), name.size()) == expected;
+	}
+
+	const rsl::counter_sample* find_counter(const rsl::metrics_snapshot& snapshot, const std::string_view name)
+	{
+		for (const rsl::counter_sample& sample : snapshot.counters)
+		{
+			if (has_name(sample.name, name))
+			{
+				return &sample;
+			}
+		}
+
+		return nullptr;
+	}
+} // namespace
+
+TEST_CASE("thread index", "[threading][metrics]")
+{
+	using namespace rsl;
+
+	const size_type mainIndex = current_thread::get_index();
+	REQUIRE(current_thread::get_index() == mainIndex);
+
+	size_type otherIndex = npos;
+	std::thread other([&otherIndex]() { otherIndex = current_thread::get_index(); });
+	other.join();
+	REQUIRE(otherIndex != mainIndex);
+
+	// The index of a thread that exited gets handed out again.
+	size_type reusedIndex = npos;
+	std::thread reused([&reusedIndex]() { reusedIndex = current_thread::get_index(); });
+	reused.join();
+	REQUIRE(reusedIndex == otherIndex);
+}
+
+TEST_CASE("sharded_counter", "[threading][metrics]")
+{
+	using namespace rsl;
+
+	SECTION("single thread")
+	{
+		sharded_counter counter;
+		REQUIRE(counter.value() == 0);
+
+		counter.increment();
+		counter.add(41);
+		counter.add(-2);
+		REQUIRE(counter.value() == 40);
+	}
+
+	SECTION("more threads than shards")
+	{
+		constexpr int64 iterations = 20000;
+		sharded_counter counter(string_view{}, 2ull);
+		REQUIRE(counter.shard_count() == 2ull);
+
+		run_on_threads(
+			6ull,
+			[&counter]()
+			{
+				for (int64 i = 0; i < iterations; i++)
+				{
+					counter.increment();
+				}
+			}
+		);
+
+		REQUIRE(counter.value() == iterations * 6);
+	}
+
+	SECTION("concurrent adds")
+	{
+		constexpr int64 iterations = 50000;
+		sharded_counter counter;
+
+		run_on_threads(
+			8ull,
+			[&counter]()
+			{
+				for (int64 i = 0; i < iterations; i++)
+				{
+					counter.increment();
+				}
+			}
+		);
+
+		REQUIRE(counter.value() == iterations * 8);
+	}
+}
+
+TEST_CASE("sharded_histogram", "[threading][metrics]")
+{
+	using namespace rsl;
+
+	SECTION("buckets")
+	{
+		STATIC_REQUIRE(histogram_snapshot::bucket_of(0ull) == 0ull);
+		STATIC_REQUIRE(histogram_snapshot::bucket_of(1ull) == 1ull);
+		STATIC_REQUIRE(histogram_snapshot::bucket_of(3ull) == 2ull);
+		STATIC_REQUIRE(histogram_snapshot::bucket_of(4ull) == 3ull);
+		STATIC_REQUIRE(histogram_snapshot::bucket_of(~0ull) == 64ull);
+		STATIC_REQUIRE(histogram_snapshot::bucket_upper_bound(3ull) == 7ull);
+
+		sharded_histogram histogram;
+		for (uint64 value = 0ull; value < 100ull; value++)
+		{
+			histogram.record(value);
+		}
+		histogram.record(1000ull);
+
+		const histogram_snapshot snapshot = histogram.snapshot();
+		REQUIRE(snapshot.count == 101ull);
+		REQUIRE(snapshot.sum == 4950ull + 1000ull);
+		REQUIRE(snapshot.max == 1000ull);
+		REQUIRE(snapshot.buckets[0] == 1ull);
+		REQUIRE(snapshot.buckets[histogram_snapshot::bucket_of(1000ull)] == 1ull);
+
+		REQUIRE(snapshot.percentile(0.5) == 63ull);
+		REQUIRE(snapshot.percentile(0.99) == 127ull);
+		REQUIRE(snapshot.percentile(1.0) == 1000ull);
+		REQUIRE(snapshot.mean() > 58.0);
+		REQUIRE(snapshot.mean() < 60.0);
+	}
+
+	SECTION("concurrent records")
+	{
+		constexpr uint64 iterations = 20000ull;
+		sharded_histogram histogram(string_view{}, 2ull);
+
+		run_on_threads(
+			6ull,
+			[&histogram]()
+			{
+				for (uint64 i = 0ull; i < iterations; i++)
+				{
+					histogram.record(i);
+				}
+			}
+		);
+
+		const histogram_snapshot snapshot = histogram.snapshot();
+		REQUIRE(snapshot.count == iterations * 6ull);
+		REQUIRE(snapshot.sum == (iterations * (iterations - 1ull) / 2ull) * 6ull);
+		REQUIRE(snapshot.max == iterations - 1ull);
+	}
+}
+
+TEST_CASE("metrics_registry", "[threading][metrics]")
+{
+	using namespace rsl;
+
+	metrics_snapshot snapshot;
+	{
+		sharded_counter allocations("test.allocations"_sv);
+		sharded_counter unnamed;
+		sharded_histogram latency("test.latency"_sv);
+
+		allocations.add(3);
+		unnamed.add(5);
+		latency.record(12ull);
+
+		metrics_registry::snapshot(snapshot);
+		const counter_sample* sample = find_counter(snapshot, "test.allocations");
+		REQUIRE(sample);
+		REQUIRE(sample->value == 3);
+
+		bool foundLatency = false;
+		for (const histogram_sample& histogram : snapshot.histograms)
+		{
+			if (has_name(histogram.name, "test.latency"))
+			{
+				foundLatency = true;
+				REQUIRE(histogram.snapshot.count == 1ull);
+				REQUIRE(histogram.snapshot.max == 12ull);
+			}
+		}
+		REQUIRE(foundLatency);
+	}
+
+	metrics_registry::snapshot(snapshot);
+	REQUIRE_FALSE(find_counter(snapshot, "test.allocations"));
+	REQUIRE(snapshot.histograms.empty());
+}
+
+TEST_CASE("sharded_counter benchmark", "[.][benchmark][metrics]")
+{
+	using namespace rsl;
+
+	constexpr size_type threadCount = 4ull;
+	constexpr int64 iterations = 5000000;
+
+	std::atomic<int64> single{0};
+	auto start = std::chrono::steady_clock::now();
+	run_on_threads(
+		threadCount,
+		[&single]()
+		{
+			for (int64 i = 0; i < iterations; i++)
+			{
+				single.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+	);
+	const double singleTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	sharded_counter sharded;
+	start = std::chrono::steady_clock::now();
+	run_on_threads(
+		threadCount,
+		[&sharded]()
+		{
+			for (int64 i = 0; i < iterations; i++)
+			{
+				sharded.increment();
+			}
+		}
+	);
+	const double shardedTime =
+		std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	std::printf("single atomic: %.2f ms, sharded_counter: %.2f ms\n", singleTime, shardedTime);
+	REQUIRE(single.load() == iterations * static_cast<int64>(threadCount));
+	REQUIRE(sharded.value() == iterations * static_cast<int64>(threadCount));
+}
@@ -0,0 +1,188 @@
+#define RYTHE_VALIDATE
+
+#include <rsl/heap_allocator>
+
+namespace
+{
+	class test_heap_allocator : private rsl::heap_allocator
+	{
+	public:
+		using value_type = void;
+		rsl::id_type id = 1012234;
+
+		using rsl::heap_allocator::heap_allocator;
+		explicit constexpr test_heap_allocator(rsl::id_type _id) noexcept
+			: id(_id)
+		{
+		}
+
+		using rsl::heap_allocator::allocate;
+		using rsl::heap_allocator::deallocate;
+		using rsl::heap_allocator::reallocate;
+		using rsl::heap_allocator::is_valid;
+	};
+} // namespace
+
+#define RSL_DEFAULT_ALLOCATOR_OVERRIDE test_heap_allocator
+#include <rsl/soa_array>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+	struct tracked
+	{
+		static inline int alive = 0;
+		int value = 0;
+
+		tracked() { ++alive; }
+		tracked(int v)
+			: value(v)
+		{
+			++alive;
+		}
+		tracked(const tracked& other)
+			: value(other.value)
+		{
+			++alive;
+		}
+		tracked(tracked&& other) noexcept
+			: value(other.value)
+		{
+			++alive;
+		}
+		tracked& operator=(const tracked&) = default;
+		tracked& operator=(tracked&&) noexcept = default;
+		~tracked() { --alive; }
+	};
+} // namespace
+
+TEST_CASE("soa_array", "[containers]")
+{
+	using namespace rsl;
+
+	SECTION("construction")
+	{
+		{
+			rsl::soa_array<float, int> arr{};
+			REQUIRE(arr.get_allocator().id == 1012234);
+			REQUIRE(arr.empty());
+			REQUIRE(arr.capacity() == 0);
+		}
+		{
+			test_heap_allocator alloc{1234};
+			rsl::basic_soa_array<test_heap_allocator, float, int> arr{alloc};
+			REQUIRE(arr.get_allocator().id == 1234);
+		}
+	}
+
+	SECTION("push_back and views")
+	{
+		rsl::soa_array<float, int, double> arr{};
+		for (int i = 0; i < 100; i++)
+		{
+			arr.push_back(static_cast<float>(i), i * 2, static_cast<double>(i) * 0.5);
+		}
+
+		REQUIRE(arr.size() == 100);
+		REQUIRE(arr.capacity() >= 100);
+
+		auto floats = arr.view<float>();
+		auto ints = arr.view<1>();
+		auto doubles = arr.view<double>();
+		REQUIRE(floats.size() == 100);
+		REQUIRE(ints.size() == 100);
+		REQUIRE(doubles.size() == 100);
+
+		REQUIRE(reinterpret_cast<ptr_type>(floats.data()) % decltype(arr)::column_alignment == 0);
+		REQUIRE(reinterpret_cast<ptr_type>(ints.data()) % decltype(arr)::column_alignment == 0);
+		REQUIRE(reinterpret_cast<ptr_type>(doubles.data()) % decltype(arr)::column_alignment == 0);
+
+		for (int i = 0; i < 100; i++)
+		{
+			const size_type idx = static_cast<size_type>(i);
+			REQUIRE(floats[idx] == static_cast<float>(i));
+			REQUIRE(ints[idx] == i * 2);
+			REQUIRE(doubles[idx] == static_cast<double>(i) * 0.5);
+		}
+	}
+
+	SECTION("row iteration")
+	{
+		rsl::soa_array<float, float, int> arr{};
+		for (int i = 0; i < 10; i++)
+		{
+			arr.emplace_back(static_cast<float>(i), static_cast<float>(-i), i);
+		}
+
+		int count = 0;
+		for (auto [x, y, id] : arr)
+		{
+			REQUIRE(x == static_cast<float>(id));
+			REQUIRE(y == -x);
+			x += 1.f;
+			count++;
+		}
+
+		REQUIRE(count == 10);
+		REQUIRE(arr.at<0>(3) == 4.f);
+
+		const auto& constArr = arr;
+		for (auto row : constArr)
+		{
+			REQUIRE(row.get<int>() == static_cast<int>(row.index()));
+		}
+	}
+
+	SECTION("erase_swap")
+	{
+		rsl::soa_array<int, float> arr{};
+		for (int i = 0; i < 5; i++)
+		{
+			arr.push_back(i, static_cast<float>(i));
+		}
+
+		arr.erase_swap(1);
+		REQUIRE(arr.size() == 4);
+		REQUIRE(arr.at<0>(1) == 4);
+		REQUIRE(arr.at<1>(1) == 4.f);
+
+		arr.erase_swap(3);
+		REQUIRE(arr.size() == 3);
+		REQUIRE(arr.at<int>(0) == 0);
+		REQUIRE(arr.at<int>(2) == 2);
+	}
+
+	SECTION("lifetime")
+	{
+		{
+			rsl::soa_array<tracked, int> arr{};
+			for (int i = 0; i < 20; i++)
+			{
+				arr.emplace_back(i, i);
+			}
+
+			REQUIRE(tracked::alive == 20);
+
+			arr.erase_swap(0);
+			REQUIRE(tracked::alive == 19);
+			REQUIRE(arr.at<tracked>(0).value == 19);
+
+			rsl::soa_array<tracked, int> copy = arr;
+			REQUIRE(tracked::alive == 38);
+			REQUIRE(copy.at<int>(0) == 19);
+
+			rsl::soa_array<tracked, int> moved = rsl::move(copy);
+			REQUIRE(tracked::alive == 38);
+			REQUIRE(copy.empty());
+
+			moved.resize(25);
+			REQUIRE(tracked::alive == 44);
+
+			arr.clear();
+			REQUIRE(tracked::alive == 25);
+		}
+
+		REQUIRE(tracked::alive == 0);
+	}
+}
@@ -0,0 +1,231 @@
+#define RYTHE_VALIDATE
+
+#include <rsl/heap_allocator>
+
+namespace
+{
+	class test_heap_allocator : private rsl::heap_allocator
+	{
+	public:
+		using value_type = void;
+		rsl::id_type id = 1012234;
+
+		using rsl::heap_allocator::heap_allocator;
+		explicit constexpr test_heap_allocator(rsl::id_type _id) noexcept
+			: id(_id)
+		{
+		}
+
+		using rsl::heap_allocator::allocate;
+		using rsl::heap_allocator::deallocate;
+		using rsl::heap_allocator::reallocate;
+		using rsl::heap_allocator::is_valid;
+	};
+} // namespace
+
+#define RSL_DEFAULT_ALLOCATOR_OVERRIDE test_heap_allocator
+
+#include <rsl/sparse_set>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+	constexpr rsl::uint32 id1 = 3;
+	constexpr rsl::uint32 id2 = 4097;
+	constexpr rsl::uint32 id3 = 123456;
+	constexpr rsl::uint32 id4 = 7;
+
+	constexpr float key1 = 1.23456f;
+	constexpr float key2 = 2.34567f;
+	constexpr float key3 = 3.45678f;
+	constexpr float key4 = 4.56789f;
+} // namespace
+
+TEST_CASE("sparse_set", "[containers]")
+{
+	using namespace rsl;
+
+	SECTION("construction")
+	{
+		{
+			sparse_set<uint32> set{};
+			REQUIRE(set.get_allocator().id == 1012234);
+			REQUIRE(set.empty());
+			REQUIRE(set.page_count() == 0);
+		}
+		{
+			test_heap_allocator alloc{1234};
+			sparse_set<uint32> set{alloc};
+			REQUIRE(set.get_allocator().id == 1234);
+		}
+	}
+
+	SECTION("insert")
+	{
+		sparse_set<uint32> set{};
+
+		{
+			auto [index, inserted] = set.insert(id1);
+			REQUIRE(index == 0);
+			REQUIRE(inserted);
+		}
+
+		{
+			auto [index, inserted] = set.insert(id1);
+			REQUIRE(index == 0);
+			REQUIRE(!inserted);
+		}
+
+		set.insert(id2);
+		set.insert(id3);
+
+		REQUIRE(set.size() == 3);
+		REQUIRE(set.contains(id1));
+		REQUIRE(set.contains(id2));
+		REQUIRE(set.contains(id3));
+		REQUIRE(!set.contains(id4));
+		REQUIRE(set.index_of(id3) == 2);
+		REQUIRE(set.index_of(id4) == npos);
+		REQUIRE(*set.find(id2) == id2);
+		REQUIRE(set.find(id4) == set.end());
+
+		// Only the pages that contain an id should have been allocated.
+		REQUIRE(set.page_count() == 3);
+
+		set.clear();
+
+		REQUIRE(set.empty());
+		REQUIRE(!set.contains(id1));
+		REQUIRE(!set.contains(id2));
+		REQUIRE(!set.contains(id3));
+		REQUIRE(set.page_count() == 3);
+
+		set.reset();
+		REQUIRE(set.page_count() == 0);
+	}
+
+	SECTION("erase")
+	{
+		sparse_set<uint32> set{};
+		set.insert(id1);
+		set.insert(id2);
+		set.insert(id3);
+
+		REQUIRE(set.erase(id1) == 1);
+		REQUIRE(set.erase(id1) == 0);
+		REQUIRE(set.erase(id4) == 0);
+
+		REQUIRE(set.size() == 2);
+		REQUIRE(!set.contains(id1));
+		REQUIRE(set[0] == id3);
+		REQUIRE(set.index_of(id3) == 0);
+		REQUIRE(set.index_of(id2) == 1);
+
+		REQUIRE(set.erase(id2) == 1);
+		REQUIRE(set.erase(id3) == 1);
+		REQUIRE(set.empty());
+	}
+
+	SECTION("copy")
+	{
+		sparse_set<uint32> set{};
+		set.insert(id1);
+		set.insert(id3);
+
+		sparse_set<uint32> copy = set;
+		copy.erase(id1);
+
+		REQUIRE(set.contains(id1));
+		REQUIRE(!copy.contains(id1));
+		REQUIRE(copy.contains(id3));
+		REQUIRE(copy.index_of(id3) == 0);
+	}
+}
+
+TEST_CASE("hashed_sparse_set", "[containers]")
+{
+	using namespace rsl;
+
+	SECTION("construction")
+	{
+		{
+			hashed_sparse_set<float32> set{};
+			REQUIRE(set.get_allocator().id == 1012234);
+			REQUIRE(set.empty());
+		}
+		{
+			test_heap_allocator alloc{1234};
+			hashed_sparse_set<float32> set{alloc};
+			REQUIRE(set.get_allocator().id == 1234);
+		}
+	}
+
+	SECTION("insert")
+	{
+		hashed_sparse_set<float32> set{};
+
+		{
+			auto [iter, inserted] = set.insert(key1);
+			REQUIRE(*iter == key1);
+			REQUIRE(inserted);
+		}
+
+		{
+			auto [iter, inserted] = set.insert(key1);
+			REQUIRE(*iter == key1);
+			REQUIRE(!inserted);
+		}
+
+		set.emplace(key2);
+		set.insert(key3);
+
+		REQUIRE(set.size() == 3);
+		REQUIRE(set.contains(key1));
+		REQUIRE(set.contains(key2));
+		REQUIRE(set.contains(key3));
+		REQUIRE(!set.contains(key4));
+		REQUIRE(set.index_of(key3) == 2);
+		REQUIRE(set.find(key4) == set.end());
+
+		set.clear();
+
+		REQUIRE(set.empty());
+		REQUIRE(!set.contains(key1));
+	}
+
+	SECTION("erase")
+	{
+		hashed_sparse_set<float32> set{};
+		set.insert(key1);
+		set.insert(key2);
+		set.insert(key3);
+
+		REQUIRE(set.erase(key1) == 1);
+		REQUIRE(set.erase(key1) == 0);
+
+		REQUIRE(set.size() == 2);
+		REQUIRE(set[0] == key3);
+		REQUIRE(set.index_of(key3) == 0);
+		REQUIRE(set.index_of(key2) == 1);
+	}
+
+	SECTION("equality")
+	{
+		hashed_sparse_set<float32> lhs{};
+		lhs.insert(key1);
+		lhs.insert(key2);
+
+		hashed_sparse_set<float32> rhs{};
+		rhs.insert(key2);
+		rhs.insert(key1);
+
+		REQUIRE(lhs == rhs);
+		REQUIRE(lhs.contains(rhs));
+
+		rhs.insert(key3);
+		REQUIRE(lhs != rhs);
+		REQUIRE(rhs.contains(lhs));
+		REQUIRE(!lhs.contains(rhs));
+	}
+}
@@ -0,0 +1,307 @@
+#define RYTHE_VALIDATE
+
+#include <rsl/logging>
+#include <rsl/threading>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace
+{
+	class recording_sink final : public rsl::log::sink
+	{
+	public:
+		void log(const rsl::log::message& msg) override
+		{
+			const rsl::string_view output = format(msg);
+			lines.emplace_back(output.data(), output.size());
+		}
+
+		void flush() override {}
+
+		std::vector<std::string> lines;
+	};
+
+	class null_sink final : public rsl::log::sink
+	{
+	public:
+		void log(const rsl::log::message& msg) override { bytes += format(msg).size(); }
+
+		void flush() override {}
+
+		rsl::size_type bytes = 0ull;
+	};
+
+	void set_sink(rsl::log::basic_logger& logger, rsl::log::sink& sink)
+	{
+		rsl::log::sink* sinks[] = {&sink};
+		logger.set_sinks(rsl::array_view<rsl::log::sink*>::from_buffer(sinks, 1ull));
+	}
+
+	// Everything after the timestamp, which changes with every run.
+	std::string without_time(const std::string& line)
+	{
+		REQUIRE(line.rfind(R"({"time":)", 0) == 0ull);
+		const size_t severity = line.find(R"(,"severity")");
+		REQUIRE(severity != std::string::npos);
+		for (size_t i = 8ull; i < severity; i++)
+		{
+			REQUIRE(line[i] >= '0');
+			REQUIRE(line[i] <= '9');
+		}
+		return line.substr(severity);
+	}
+} // namespace
+
+TEST_CASE("fields", "[logging][structured]")
+{
+	using namespace rsl;
+
+	const dynamic_string owned = dynamic_string::from_view("owned"_sv);
+	const log::field fields[] = {
+		{"flag"_sv, true},
+		{"negative"_sv, -1234567},
+		{"min"_sv, std::numeric_limits<int64>::min()},
+		{"max"_sv, std::numeric_limits<uint64>::max()},
+		{"small"_sv, static_cast<uint8>(7u)},
+		{"ratio"_sv, 0.25},
+		{"view"_sv, "text"_sv},
+		{"cstring"_sv, "quote \" backslash \\ newline \n tab \t bell \a"},
+		{"owned"_sv, owned},
+	};
+
+	fmt::memory_buffer encoded;
+	log::encode_fields(array_view<const log::field>::from_buffer(fields, std::size(fields)), encoded);
+
+	log::field_reader reader(string_view::from_buffer(encoded.data(), encoded.size()));
+	log::field entry(string_view{}, false);
+
+	REQUIRE(reader.next(entry));
+	REQUIRE(entry.type == log::field_type::boolean);
+	REQUIRE(entry.boolean);
+
+	REQUIRE(reader.next(entry));
+	REQUIRE(entry.type == log::field_type::signed_integer);
+	REQUIRE(entry.signedInteger == -1234567);
+
+	REQUIRE(reader.next(entry));
+	REQUIRE(entry.signedInteger == std::numeric_limits<int64>::min());
+
+	REQUIRE(reader.next(entry));
+	REQUIRE(entry.type == log::field_type::unsigned_integer);
+	REQUIRE(entry.unsignedInteger == std::numeric_limits<uint64>::max());
+
+	REQUIRE(reader.next(entry));
+	REQUIRE(entry.unsignedInteger == 7ull);
+	REQUIRE(std::string_view(entry.key.data(), entry.key.size()) == "small");
+
+	REQUIRE(reader.next(entry));
+	REQUIRE(entry.type == log::field_type::floating_point);
+	REQUIRE(entry.floatingPoint == 0.25);
+
+	for (const char* expected : {"text", "quote \" backslash \\ newline \n tab \t bell \a", "owned"})
+	{
+		REQUIRE(reader.next(entry));
+		REQUIRE(entry.type == log::field_type::string);
+		REQUIRE(std::string_view(entry.text.data(), entry.text.size()) == expected);
+	}
+
+	REQUIRE_FALSE(reader.next(entry));
+	REQUIRE(reader.empty());
+
+	// Small values stay small, a type byte, the key length, the key and a single byte varint.
+	fmt::memory_buffer small;
+	const log::field smallField("id"_sv, -3);
+	log::encode_fields(array_view<const log::field>::from_buffer(&smallField, 1ull), small);
+	REQUIRE(small.size() == 5ull);
+
+	// Truncated data ends the fields instead of reading past them.
+	log::field_reader truncated(string_view::from_buffer(encoded.data(), encoded.size() - 3ull));
+	int count = 0;
+	while (truncated.next(entry))
+	{
+		count++;
+	}
+	REQUIRE(count == 8);
+}
+
+TEST_CASE("json_formatter", "[logging][structured]")
+{
+	using namespace rsl;
+
+	recording_sink sink;
+	sink.set_formatter<log::json_formatter>();
+
+	log::logger logger("game"_sv, log::severity::info, log::severity::off);
+	set_sink(logger, sink);
+
+	logger.log_fields(
+		log::severity::error, "asset failed to load"_sv,
+		{{"asset"_sv, "rock.png"}, {"attempt"_sv, 3}, {"retry"_sv, false}, {"load time"_sv, 1.5}}
+	);
+	logger.log(log::severity::warn, "no \"fields\" {}"_sv, 1);
+	logger.log_fields(log::severity::info, "literal {} braces"_sv, {{"bad"_sv, 0.0 / 0.0}});
+	logger.log_fields(log::severity::debug, "filtered"_sv, {{"value"_sv, 1}});
+	logger.log_fields(log::severity::info, "no fields { }"_sv, {});
+
+	REQUIRE(sink.lines.size() == 4ull);
+
+	const std::string thread = std::to_string(current_thread::get_id().nativeId);
+	REQUIRE(
+		without_time(sink.lines[0]) == R"(,"severity":"error","logger":"game","thread":)" + thread +
+										   R"(,"message":"asset failed to load","fields":{"asset":"rock.png","attempt":3,)"
+										   R"("retry":false,"load time":1.5}})"
+	);
+	REQUIRE(
+		without_time(sink.lines[1]) ==
+		R"(,"severity":"warn","logger":"game","thread":)" + thread + R"(,"message":"no \"fields\" 1"})"
+	);
+	REQUIRE(
+		without_time(sink.lines[2]) == R"(,"severity":"info","logger":"game","thread":)" + thread +
+										   R"(,"message":"literal {} braces","fields":{"bad":null}})"
+	);
+
+	fmt::memory_buffer escaped;
+	log::append_json_string("a\"b\\c\nd\x01"_sv, escaped);
+	REQUIRE(std::string(escaped.data(), escaped.size()) == R"("a\"b\\c\nd\u0001")");
+}
+
+TEST_CASE("structured async_logger", "[logging][structured]")
+{
+	using namespace rsl;
+
+	recording_sink sink;
+	sink.set_formatter<log::json_formatter>();
+
+	{
+		log::async_logger logger("async"_sv, log::overflow_policy::block, 64ull, log::severity::info, log::severity::off);
+		logger.defer_formatting(true);
+		set_sink(logger, sink);
+
+		const std::string large(300ull, 'x');
+		logger.log_fields(log::severity::info, "inline"_sv, {{"id"_sv, 1}});
+		logger.log_fields(
+			log::severity::info, "spilled"_sv,
+			{{"id"_sv, 2}, {"payload"_sv, string_view::from_buffer(large.data(), large.size())}}
+		);
+		logger.log(log::severity::info, "deferred {}"_sv, 3);
+		logger.log_fields(log::severity::info, "unbalanced {"_sv, {});
+		logger.flush();
+
+		REQUIRE(sink.lines.size() == 4ull);
+		REQUIRE(sink.lines[0].find(R"("message":"inline","fields":{"id":1}})") != std::string::npos);
+		REQUIRE(
+			sink.lines[1].find(R"("message":"spilled","fields":{"id":2,"payload":")" + large + R"("}})") !=
+			std::string::npos
+		);
+		REQUIRE(sink.lines[2].find(R"("message":"deferred 3"})") != std::string::npos);
+		REQUIRE(sink.lines[3].find(R"("message":"unbalanced {"})") != std::string::npos);
+	}
+}
+
+TEST_CASE("structured mmap_ring_sink", "[logging][structured]")
+{
+	using namespace rsl;
+
+	const std::string path = (std::filesystem::temp_directory_path() / "rsl_structured_test.ring").string();
+	std::filesystem::remove(path);
+	const string_view pathView = string_view::from_buffer(path.data(), path.size());
+
+	{
+		log::mmap_ring_sink sink(pathView, 4096ull);
+		log::logger logger("ring"_sv, log::severity::info, log::severity::off);
+		set_sink(logger, sink);
+
+		logger.log_fields(log::severity::warn, "frame spike"_sv, {{"frame"_sv, 1200u}, {"ms"_sv, 48.5}});
+		logger.log(log::severity::info, "plain"_sv);
+	}
+
+	{
+		log::mmap_ring_reader reader(pathView);
+		log::mmap_ring_record record;
+
+		REQUIRE(reader.next(record));
+		REQUIRE(record.kind == log::mmap_record_kind::structured);
+		REQUIRE(record.severity == log::severity::warn);
+
+		fmt::memory_buffer text;
+		record.format_to(text);
+		REQUIRE(std::string(text.data(), text.size()) == "frame spike");
+
+		log::field_reader fields = record.fields();
+		log::field entry(string_view{}, false);
+		REQUIRE(fields.next(entry));
+		REQUIRE(std::string_view(entry.key.data(), entry.key.size()) == "frame");
+		REQUIRE(entry.unsignedInteger == 1200ull);
+		REQUIRE(fields.next(entry));
+		REQUIRE(entry.floatingPoint == 48.5);
+		REQUIRE_FALSE(fields.next(entry));
+
+		REQUIRE(reader.next(record));
+		REQUIRE(record.kind == log::mmap_record_kind::text);
+		REQUIRE(record.fields().empty());
+	}
+
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("structured logging benchmark", "[.][benchmark][logging][structured]")
+{
+	using namespace rsl;
+
+	constexpr int messageCount = 1000000;
+
+	null_sink sink;
+	log::logger logger("bench"_sv, log::severity::trace, log::severity::off);
+	set_sink(logger, sink);
+
+	const auto measure = [](const char* name, auto&& statement)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < messageCount; i++)
+		{
+			statement(i);
+		}
+		const double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+		std::printf("%s: %.0f ns per message\n", name, elapsed / messageCount);
+	};
+
+	measure(
+		"interpolated text",
+		[&logger](int i)
+		{
+			logger.log(
+				log::severity::trace, "asset {} failed to load, attempt {} after {} ms"_sv, "rock.png", i,
+				0.5 * static_cast<double>(i)
+			);
+		}
+	);
+	measure(
+		"fields",
+		[&logger](int i)
+		{
+			logger.log_fields(
+				log::severity::trace, "asset failed to load"_sv,
+				{{"asset"_sv, "rock.png"}, {"attempt"_sv, i}, {"ms"_sv, 0.5 * static_cast<double>(i)}}
+			);
+		}
+	);
+
+	sink.set_formatter<log::json_formatter>();
+	measure(
+		"fields as json",
+		[&logger](int i)
+		{
+			logger.log_fields(
+				log::severity::trace, "asset failed to load"_sv,
+				{{"asset"_sv, "rock.png"}, {"attempt"_sv, i}, {"ms"_sv, 0.5 * static_cast<double>(i)}}
+			);
+		}
+	);
+}
@@ -0,0 +1,400 @@
+#define RYTHE_VALIDATE
+
+#include <rsl/heap_allocator>
+
+namespace
+{
+	class test_heap_allocator : private rsl::heap_allocator
+	{
+	public:
+		using value_type = void;
+		rsl::id_type id = 1012234;
+
+		using rsl::heap_allocator::heap_allocator;
+		explicit constexpr test_heap_allocator(rsl::id_type _id) noexcept
+			: id(_id)
+		{
+		}
+
+		using rsl::heap_allocator::allocate;
+		using rsl::heap_allocator::deallocate;
+		using rsl::heap_allocator::reallocate;
+		using rsl::heap_allocator::is_valid;
+	};
+} // namespace
+
+#define RSL_DEFAULT_ALLOCATOR_OVERRIDE test_heap_allocator
+#include <rsl/threading>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <semaphore>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	template <typename Func>
+	void run_threads(const int threadCount, Func&& func)
+	{
+		std::vector<std::thread> threads;
+		for (int i = 0; i < threadCount; i++)
+		{
+			threads.emplace_back(func, i);
+		}
+
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+	}
+
+	template <typename Mutex>
+	double contended_lock_benchmark(const int threadCount, const int iterations)
+	{
+		Mutex mutex;
+		rsl::uint64 counter = 0;
+
+		const auto start = std::chrono::steady_clock::now();
+		run_threads(
+			threadCount,
+			[&](int)
+			{
+				for (int i = 0; i < iterations; i++)
+				{
+					std::lock_guard guard(mutex);
+					counter++;
+				}
+			}
+		);
+		const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+		REQUIRE(counter == static_cast<rsl::uint64>(threadCount) * iterations);
+		return elapsed.count() / (static_cast<double>(threadCount) * iterations);
+	}
+
+	template <typename SharedMutex>
+	double read_mostly_benchmark(const int threadCount, const int iterations)
+	{
+		SharedMutex mutex;
+		rsl::uint64 value = 0;
+		std::atomic<rsl::uint64> sum = 0;
+
+		const auto start = std::chrono::steady_clock::now();
+		run_threads(
+			threadCount,
+			[&](int)
+			{
+				rsl::uint64 localSum = 0;
+				for (int i = 0; i < iterations; i++)
+				{
+					if (i % 64 == 0)
+					{
+						std::lock_guard guard(mutex);
+						value++;
+					}
+					else
+					{
+						std::shared_lock guard(mutex);
+						localSum += value;
+					}
+				}
+				sum += localSum;
+			}
+		);
+		const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+		return elapsed.count() / (static_cast<double>(threadCount) * iterations);
+	}
+
+	template <typename Semaphore>
+	double ping_pong_benchmark(const int iterations)
+	{
+		Semaphore ping(0);
+		Semaphore pong(0);
+
+		const auto start = std::chrono::steady_clock::now();
+		std::thread other(
+			[&]()
+			{
+				for (int i = 0; i < iterations; i++)
+				{
+					ping.acquire();
+					pong.release();
+				}
+			}
+		);
+
+		for (int i = 0; i < iterations; i++)
+		{
+			ping.release();
+			pong.acquire();
+		}
+		other.join();
+		const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+		return elapsed.count() / iterations;
+	}
+} // namespace
+
+TEST_CASE("mutex", "[threading]")
+{
+	using namespace rsl;
+
+	SECTION("single thread")
+	{
+		mutex m;
+		REQUIRE(m.try_lock());
+		REQUIRE(!m.try_lock());
+		m.unlock();
+
+		m.lock();
+		REQUIRE(!m.try_lock());
+		m.unlock();
+		REQUIRE(m.try_lock());
+		m.unlock();
+	}
+
+	SECTION("contended")
+	{
+		mutex m;
+		uint64 counter = 0;
+		run_threads(
+			4,
+			[&](int)
+			{
+				for (int i = 0; i < 20000; i++)
+				{
+					std::lock_guard guard(m);
+					counter++;
+				}
+			}
+		);
+		REQUIRE(counter == 80000);
+	}
+}
+
+TEST_CASE("shared_mutex", "[threading]")
+{
+	using namespace rsl;
+
+	SECTION("single thread")
+	{
+		shared_mutex m;
+		REQUIRE(m.try_lock_shared());
+		REQUIRE(m.try_lock_shared());
+		REQUIRE(!m.try_lock());
+		m.unlock_shared();
+		m.unlock_shared();
+
+		REQUIRE(m.try_lock());
+		REQUIRE(!m.try_lock_shared());
+		REQUIRE(!m.try_lock());
+		m.unlock();
+		REQUIRE(m.try_lock_shared());
+		m.unlock_shared();
+	}
+
+	SECTION("readers and writers")
+	{
+		shared_mutex m;
+		uint64 a = 0;
+		uint64 b = 0;
+		std::atomic<bool> torn = false;
+
+		run_threads(
+			4,
+			[&](const int index)
+			{
+				for (int i = 0; i < 10000; i++)
+				{
+					if ((i + index) % 8 == 0)
+					{
+						std::lock_guard guard(m);
+						a++;
+						b++;
+					}
+					else
+					{
+						std::shared_lock guard(m);
+						if (a != b)
+						{
+							torn = true;
+						}
+					}
+				}
+			}
+		);
+
+		REQUIRE(!torn);
+		REQUIRE(a == 5000);
+		REQUIRE(b == 5000);
+	}
+}
+
+TEST_CASE("semaphore", "[threading]")
+{
+	using namespace rsl;
+
+	SECTION("counting")
+	{
+		semaphore s(2);
+		REQUIRE(s.try_acquire());
+		REQUIRE(s.try_acquire());
+		REQUIRE(!s.try_acquire());
+		s.release(3);
+		REQUIRE(s.count_approx() == 3);
+	}
+
+	SECTION("producer consumer")
+	{
+		semaphore items;
+		std::atomic<int> consumed = 0;
+
+		std::thread consumer(
+			[&]()
+			{
+				for (int i = 0; i < 10000; i++)
+				{
+					items.acquire();
+					consumed++;
+				}
+			}
+		);
+
+		for (int i = 0; i < 10000; i++)
+		{
+			items.release();
+		}
+		consumer.join();
+
+		REQUIRE(consumed == 10000);
+		REQUIRE(!items.try_acquire());
+	}
+}
+
+TEST_CASE("latch and barrier", "[threading]")
+{
+	using namespace rsl;
+
+	SECTION("latch")
+	{
+		latch done(4);
+		std::atomic<int> arrived = 0;
+		std::atomic<bool> early = false;
+		REQUIRE(!done.try_wait());
+
+		run_threads(
+			4,
+			[&](int)
+			{
+				arrived++;
+				done.arrive_and_wait();
+				if (arrived != 4)
+				{
+					early = true;
+				}
+			}
+		);
+		REQUIRE(!early);
+		REQUIRE(done.try_wait());
+	}
+
+	SECTION("barrier")
+	{
+		constexpr int threadCount = 4;
+		constexpr int phaseCount = 200;
+
+		barrier sync(threadCount);
+		std::atomic<int> counters[phaseCount] = {};
+		std::atomic<bool> ahead = false;
+
+		run_threads(
+			threadCount,
+			[&](int)
+			{
+				for (int phase = 0; phase < phaseCount; phase++)
+				{
+					counters[phase]++;
+					sync.arrive_and_wait();
+					if (counters[phase] != threadCount)
+					{
+						ahead = true;
+					}
+				}
+			}
+		);
+
+		REQUIRE(!ahead);
+	}
+}
+
+TEST_CASE("event", "[threading]")
+{
+	using namespace rsl;
+
+	event e;
+	REQUIRE(!e.is_set());
+	e.set();
+	REQUIRE(e.is_set());
+	e.wait();
+	e.reset();
+	REQUIRE(!e.is_set());
+
+	std::atomic<int> woken = 0;
+	std::vector<std::thread> waiters;
+	for (int i = 0; i < 3; i++)
+	{
+		waiters.emplace_back(
+			[&]()
+			{
+				e.wait();
+				woken++;
+			}
+		);
+	}
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	REQUIRE(woken == 0);
+	e.set();
+
+	for (auto& thread : waiters)
+	{
+		thread.join();
+	}
+	REQUIRE(woken == 3);
+}
+
+TEST_CASE("synchronization contention benchmark", "[.][benchmark]")
+{
+	constexpr int iterations = 200000;
+	const int threadCount = static_cast<int>(std::max(2u, std::thread::hardware_concurrency()));
+
+	std::printf(
+		"mutex, %d threads: rsl %.1f ns/lock, std %.1f ns/lock\n", threadCount,
+		contended_lock_benchmark<rsl::mutex>(threadCount, iterations),
+		contended_lock_benchmark<std::mutex>(threadCount, iterations)
+	);
+
+	std::printf(
+		"shared_mutex, %d threads, 1/64 writes: rsl %.1f ns/op, std %.1f ns/op\n", threadCount,
+		read_mostly_benchmark<rsl::shared_mutex>(threadCount, iterations),
+		read_mostly_benchmark<std::shared_mutex>(threadCount, iterations)
+	);
+
+	std::printf(
+		"semaphore ping-pong: rsl %.1f ns/round trip, std %.1f ns/round trip\n",
+		ping_pong_benchmark<rsl::semaphore>(iterations / 10),
+		ping_pong_benchmark<std::counting_semaphore<>>(iterations / 10)
+	);
+
+	std::printf(
+		"sizeof: rsl::mutex %zu, std::mutex %zu, rsl::shared_mutex %zu, std::shared_mutex %zu\n", sizeof(rsl::mutex),
+		sizeof(std::mutex), sizeof(rsl::shared_mutex), sizeof(std::shared_mutex)
+	);
+}
@@ -0,0 +1,258 @@
+#define RYTHE_VALIDATE
+
+#include <rsl/heap_allocator>
+
+namespace
+{
+	class test_heap_allocator : private rsl::heap_allocator
+	{
+	public:
+		using value_type = void;
+		rsl::id_type id = 1012234;
+
+		using rsl::heap_allocator::heap_allocator;
+		explicit constexpr test_heap_allocator(rsl::id_type _id) noexcept
+			: id(_id)
+		{
+		}
+
+		using rsl::heap_allocator::allocate;
+		using rsl::heap_allocator::deallocate;
+		using rsl::heap_allocator::reallocate;
+		using rsl::heap_allocator::is_valid;
+	};
+} // namespace
+
+#define RSL_DEFAULT_ALLOCATOR_OVERRIDE test_heap_allocator
+#include <rsl/threading>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <thread>
+
+namespace
+{
+	class counting_allocator final : public rsl::pmu_allocator
+	{
+	public:
+		std::atomic<rsl::size_type> allocations{0};
+		std::atomic<rsl::size_type> deallocations{0};
+
+		[[nodiscard]] void* allocate(const rsl::size_type size) noexcept override
+		{
+			allocations++;
+			return rsl::allocator_context::globalAllocator->allocate(size);
+		}
+
+		[[nodiscard]] void* allocate(const rsl::size_type size, const rsl::size_type alignment) noexcept override
+		{
+			allocations++;
+			return rsl::allocator_context::globalAllocator->allocate(size, alignment);
+		}
+
+		[[nodiscard]] void*
+		reallocate(void* ptr, const rsl::size_type oldSize, const rsl::size_type newSize) noexcept override
+		{
+			return rsl::allocator_context::globalAllocator->reallocate(ptr, oldSize, newSize);
+		}
+
+		[[nodiscard]] void* reallocate(
+			void* ptr, const rsl::size_type oldSize, const rsl::size_type newSize, const rsl::size_type alignment
+		) noexcept override
+		{
+			return rsl::allocator_context::globalAllocator->reallocate(ptr, oldSize, newSize, alignment);
+		}
+
+		void deallocate(void* ptr, const rsl::size_type size) noexcept override
+		{
+			deallocations++;
+			rsl::allocator_context::globalAllocator->deallocate(ptr, size);
+		}
+
+		void deallocate(void* ptr, const rsl::size_type size, const rsl::size_type alignment) noexcept override
+		{
+			deallocations++;
+			rsl::allocator_context::globalAllocator->deallocate(ptr, size, alignment);
+		}
+	};
+
+	rsl::task<int> value_task(const int value)
+	{
+		co_return value;
+	}
+
+	rsl::task<int> sum_task(const int count)
+	{
+		int sum = 0;
+		for (int i = 0; i < count; i++)
+		{
+			sum += co_await value_task(i);
+		}
+		co_return sum;
+	}
+
+	rsl::task<int> arena_task(std::allocator_arg_t, rsl::pmu_allocator&, const int value)
+	{
+		co_return value * 2;
+	}
+
+	rsl::task<> increment_task(int& value)
+	{
+		value++;
+		co_return;
+	}
+
+	rsl::task<bool> pool_job_task(rsl::job_system& jobs)
+	{
+		const bool wasJob = rsl::job_system::current_job().valid();
+		co_await rsl::resume_on(jobs);
+		co_return !wasJob && rsl::job_system::current_job().valid();
+	}
+
+	rsl::task<int> sleeping_task(rsl::task_timer& timer, const int milliseconds, const int value)
+	{
+		co_await timer.sleep_for(rsl::time::span<float>(milliseconds / 1000.f));
+		co_return value;
+	}
+
+	rsl::task<int> when_all_task(rsl::job_system& jobs)
+	{
+		rsl::task<int> a = []() -> rsl::task<int> { co_return 1; }();
+		rsl::task<int> b = [](rsl::job_system& j) -> rsl::task<int>
+		{
+			co_await rsl::resume_on(j);
+			co_return 2;
+		}(jobs);
+		rsl::task<> c = []() -> rsl::task<> { co_return; }();
+
+		co_await rsl::when_all(a, b, c);
+		REQUIRE(c.is_done());
+		co_return a.result() + b.result();
+	}
+
+	rsl::task<int> sleep_until_task(rsl::task_timer& timer, const rsl::time::point64 deadline)
+	{
+		co_await timer.sleep_until(deadline);
+		co_return 4;
+	}
+
+	struct manual_gate
+	{
+		std::coroutine_handle<> waiting;
+
+		[[nodiscard]] bool await_ready() const noexcept { return false; }
+		void await_suspend(const std::coroutine_handle<> handle) noexcept { waiting = handle; }
+		void await_resume() const noexcept {}
+	};
+
+	rsl::task<int> gated_task(manual_gate& gate)
+	{
+		co_await gate;
+		co_return 1;
+	}
+
+	rsl::task<rsl::size_type> when_any_task(rsl::task<int>& slow, rsl::task<int>& fast)
+	{
+		co_return co_await rsl::when_any(slow, fast);
+	}
+} // namespace
+
+TEST_CASE("task", "[threading]")
+{
+	using namespace rsl;
+
+	SECTION("lazy start")
+	{
+		int value = 0;
+		task<> t = increment_task(value);
+		REQUIRE(t.valid());
+		REQUIRE(!t.is_done());
+		REQUIRE(value == 0);
+
+		sync_wait(t);
+		REQUIRE(t.is_done());
+		REQUIRE(value == 1);
+	}
+
+	SECTION("results")
+	{
+		REQUIRE(sync_wait(value_task(42)) == 42);
+		REQUIRE(sync_wait(sum_task(10)) == 45);
+
+		task<int> t = value_task(7);
+		REQUIRE(sync_wait(t) == 7);
+		REQUIRE(t.result() == 7);
+	}
+
+	SECTION("symmetric transfer")
+	{
+		// Chains of co_await hand over to each other instead of nesting resumes on optimized builds.
+		REQUIRE(sync_wait(sum_task(10000)) == 49995000);
+	}
+
+	SECTION("custom allocator")
+	{
+		counting_allocator allocator;
+		{
+			task<int> t = arena_task(std::allocator_arg, allocator, 21);
+			REQUIRE(allocator.allocations == 1);
+			REQUIRE(sync_wait(t) == 42);
+		}
+		REQUIRE(allocator.deallocations == 1);
+	}
+
+	SECTION("resume on job system")
+	{
+		job_system jobs(2);
+		REQUIRE(sync_wait(jobs, pool_job_task(jobs)));
+		REQUIRE(sync_wait(jobs, when_all_task(jobs)) == 3);
+	}
+
+	SECTION("sleep")
+	{
+		task_timer timer;
+		const auto start = std::chrono::steady_clock::now();
+		REQUIRE(sync_wait(sleeping_task(timer, 5, 3)) == 3);
+		REQUIRE(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(5));
+
+		const time::point64 now{std::chrono::high_resolution_clock::now()};
+		const time::point64 deadline{now.duration + std::chrono::milliseconds(2)};
+		REQUIRE(sync_wait(sleep_until_task(timer, deadline)) == 4);
+		REQUIRE(time::point64{std::chrono::high_resolution_clock::now()}.duration >= deadline.duration);
+	}
+
+	SECTION("earlier sleeper")
+	{
+		task_timer timer;
+		int longResult = 0;
+		std::thread longSleeper([&timer, &longResult]() { longResult = sync_wait(sleeping_task(timer, 200, 1)); });
+
+		// Lets the timer thread start waiting for the long deadline, the next sleeper has to cut that wait short.
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		const auto start = std::chrono::steady_clock::now();
+		REQUIRE(sync_wait(sleeping_task(timer, 5, 2)) == 2);
+		REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(150));
+
+		longSleeper.join();
+		REQUIRE(longResult == 1);
+	}
+
+	SECTION("when_any")
+	{
+		manual_gate gate;
+		task<int> slow = gated_task(gate);
+		task<int> fast = value_task(2);
+
+		REQUIRE(sync_wait(when_any_task(slow, fast)) == 1ull);
+		REQUIRE(fast.is_done());
+		REQUIRE(fast.result() == 2);
+		REQUIRE(!slow.is_done());
+
+		gate.waiting.resume();
+		REQUIRE(slow.is_done());
+		REQUIRE(slow.result() == 1);
+	}
+}
@@ -0,0 +1,227 @@
+#define RYTHE_VALIDATE
+
+#include <rsl/threading>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	struct system_stub
+	{
+		std::atomic<int>* clock = nullptr;
+		int stamp = -1;
+		int runs = 0;
+		std::chrono::microseconds work{0};
+
+		void update()
+		{
+			if (work.count() > 0)
+			{
+				std::this_thread::sleep_for(work);
+			}
+			stamp = clock->fetch_add(1);
+			runs++;
+		}
+	};
+
+	rsl::task_graph::task_func make_func(system_stub& stub)
+	{
+		return rsl::task_graph::task_func::create<system_stub, &system_stub::update>(stub);
+	}
+} // namespace
+
+TEST_CASE("task_graph", "[threading]")
+{
+	using namespace rsl;
+
+	job_system jobs(3, 1024);
+	std::atomic<int> clock = 0;
+
+	SECTION("dependencies")
+	{
+		// input -> physics -> render
+		//       -> audio   ---^
+		std::vector<system_stub> stubs(4);
+		for (system_stub& stub : stubs)
+		{
+			stub.clock = &clock;
+		}
+
+		task_graph graph;
+		const task_node input = graph.add_node(make_func(stubs[0]), "input"_sv);
+		const task_node physics = graph.add_node(make_func(stubs[1]), "physics"_sv);
+		const task_node audio = graph.add_node(make_func(stubs[2]), "audio"_sv);
+		const task_node render = graph.add_node(make_func(stubs[3]), "render"_sv);
+		graph.add_edge(input, physics);
+		graph.add_edge(input, audio);
+		graph.add_edge(physics, render);
+		graph.add_edge(audio, render);
+
+		REQUIRE(!graph.is_compiled());
+		REQUIRE(graph.compile());
+		REQUIRE(graph.node_count() == 4);
+		REQUIRE(graph.topological_order().size() == 4);
+		REQUIRE(graph.topological_order()[0] == input);
+		REQUIRE(graph.topological_order()[3] == render);
+		string_view name = graph.node_name(physics);
+		REQUIRE((name == "physics"_sv));
+
+		for (int frame = 0; frame < 100; frame++)
+		{
+			graph.run(jobs);
+
+			REQUIRE(stubs[0].stamp < stubs[1].stamp);
+			REQUIRE(stubs[0].stamp < stubs[2].stamp);
+			REQUIRE(stubs[1].stamp < stubs[3].stamp);
+			REQUIRE(stubs[2].stamp < stubs[3].stamp);
+		}
+
+		for (const system_stub& stub : stubs)
+		{
+			REQUIRE(stub.runs == 100);
+		}
+	}
+
+	SECTION("wide graph")
+	{
+		constexpr size_t layerSize = 64;
+		std::vector<system_stub> stubs(layerSize * 3);
+		for (system_stub& stub : stubs)
+		{
+			stub.clock = &clock;
+		}
+
+		// Three layers where every node waits on two nodes of the previous layer.
+		task_graph graph;
+		std::vector<task_node> nodes;
+		for (size_t i = 0; i < stubs.size(); i++)
+		{
+			nodes.push_back(graph.add_node(make_func(stubs[i])));
+			if (i >= layerSize)
+			{
+				const size_t layerStart = (i / layerSize - 1) * layerSize;
+				graph.add_edge(nodes[layerStart + i % layerSize], nodes[i]);
+				graph.add_edge(nodes[layerStart + (i + 1) % layerSize], nodes[i]);
+			}
+		}
+		REQUIRE(graph.compile());
+
+		for (int frame = 0; frame < 10; frame++)
+		{
+			graph.run(jobs);
+		}
+
+		for (size_t i = layerSize; i < stubs.size(); i++)
+		{
+			const size_t layerStart = (i / layerSize - 1) * layerSize;
+			REQUIRE(stubs[i].runs == 10);
+			REQUIRE(stubs[layerStart + i % layerSize].stamp < stubs[i].stamp);
+			REQUIRE(stubs[layerStart + (i + 1) % layerSize].stamp < stubs[i].stamp);
+		}
+	}
+
+	SECTION("cycles")
+	{
+		system_stub stub{.clock = &clock};
+
+		task_graph graph;
+		const task_node a = graph.add_node(make_func(stub));
+		const task_node b = graph.add_node(make_func(stub));
+		const task_node c = graph.add_node(make_func(stub));
+		graph.add_edge(a, b);
+		graph.add_edge(b, c);
+		graph.add_edge(c, b);
+		REQUIRE(!graph.compile());
+
+		graph.clear();
+		REQUIRE(graph.node_count() == 0);
+		REQUIRE(graph.compile());
+		graph.run(jobs);
+		REQUIRE(graph.critical_path().empty());
+	}
+
+	SECTION("critical path")
+	{
+		// fast and slow both feed into end, the path through slow is the critical one.
+		std::vector<system_stub> stubs(4);
+		for (system_stub& stub : stubs)
+		{
+			stub.clock = &clock;
+		}
+		stubs[2].work = std::chrono::microseconds(20000);
+
+		task_graph graph;
+		const task_node start = graph.add_node(make_func(stubs[0]), "start"_sv);
+		const task_node fast = graph.add_node(make_func(stubs[1]), "fast"_sv);
+		const task_node slow = graph.add_node(make_func(stubs[2]), "slow"_sv);
+		const task_node end = graph.add_node(make_func(stubs[3]), "end"_sv);
+		graph.add_edge(start, fast);
+		graph.add_edge(start, slow);
+		graph.add_edge(fast, end);
+		graph.add_edge(slow, end);
+		REQUIRE(graph.compile());
+
+		graph.run(jobs);
+
+		const auto path = graph.critical_path();
+		REQUIRE(path.size() == 3);
+		REQUIRE(path[0] == start);
+		REQUIRE(path[1] == slow);
+		REQUIRE(path[2] == end);
+
+		REQUIRE(graph.node_time(slow).milliseconds<float>() >= 19.0f);
+		REQUIRE(graph.critical_path_time().duration >= graph.node_time(slow).duration);
+		REQUIRE(graph.last_run_time().duration >= graph.critical_path_time().duration);
+	}
+}
+
+TEST_CASE("task_graph benchmark", "[.][benchmark]")
+{
+	using namespace rsl;
+
+	job_system jobs;
+	std::atomic<int> clock = 0;
+
+	// A frame of 8 phases with 32 independent systems each, the graph only orders systems that depend on each other
+	// where a phase barrier would make every system wait on the slowest one of the previous phase.
+	constexpr size_t phaseCount = 8;
+	constexpr size_t phaseSize = 32;
+	std::vector<system_stub> stubs(phaseCount * phaseSize);
+	for (size_t i = 0; i < stubs.size(); i++)
+	{
+		stubs[i].clock = &clock;
+		stubs[i].work = std::chrono::microseconds(i % 7 == 0 ? 200 : 20);
+	}
+
+	task_graph graph;
+	std::vector<task_node> nodes;
+	for (size_t i = 0; i < stubs.size(); i++)
+	{
+		nodes.push_back(graph.add_node(make_func(stubs[i])));
+		if (i >= phaseSize)
+		{
+			graph.add_edge(nodes[i - phaseSize], nodes[i]);
+		}
+	}
+	REQUIRE(graph.compile());
+
+	constexpr int frameCount = 20;
+	double totalMs = 0.0;
+	for (int frame = 0; frame < frameCount; frame++)
+	{
+		graph.run(jobs);
+		totalMs += graph.last_run_time().milliseconds<double>();
+	}
+
+	std::printf(
+		"task_graph, %zu nodes, %zu workers: %.3f ms per frame, critical path %.3f ms over %zu nodes\n", stubs.size(),
+		jobs.worker_count(), totalMs / frameCount, graph.critical_path_time().milliseconds<double>(),
+		graph.critical_path().size()
+	);
+}
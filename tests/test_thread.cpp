@@ -0,0 +1,323 @@
+#define RYTHE_VALIDATE
+
+#include <rsl/heap_allocator>
+
+namespace
+{
+	class test_heap_allocator : private rsl::heap_allocator
+	{
+	public:
+		using value_type = void;
+		rsl::id_type id = 1012234;
+
+		using rsl::heap_allocator::heap_allocator;
+		explicit constexpr test_heap_allocator(rsl::id_type _id) noexcept
+			: id(_id)
+		{
+		}
+
+		using rsl::heap_allocator::allocate;
+		using rsl::heap_allocator::deallocate;
+		using rsl::heap_allocator::reallocate;
+		using rsl::heap_allocator::is_valid;
+	};
+} // namespace
+
+#define RSL_DEFAULT_ALLOCATOR_OVERRIDE test_heap_allocator
+#include <rsl/threading>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace
+{
+	struct thread_test_data
+	{
+		std::atomic<bool> release = false;
+		std::atomic<rsl::id_type> observedId = 0;
+		char observedName[64] = {};
+		rsl::size_type observedNameLength = 0;
+	};
+
+	rsl::uint32 thread_test_function(void* userData)
+	{
+		thread_test_data& data = *static_cast<thread_test_data*>(userData);
+
+		const rsl::string_view name = rsl::current_thread::get_name();
+		for (rsl::size_type i = 0; i < name.size(); i++)
+		{
+			data.observedName[i] = name[i];
+		}
+		data.observedNameLength = name.size();
+		data.observedId.store(rsl::current_thread::get_id().nativeId);
+
+		while (!data.release.load())
+		{
+			rsl::current_thread::yield();
+		}
+
+		return 42u;
+	}
+
+	using steady_clock = std::chrono::steady_clock;
+
+	// Wakes up every period and returns how late each wake-up was, in microseconds.
+	template <typename Sleep>
+	std::vector<double> measure_wakeups(const rsl::size_type count, const std::chrono::microseconds period, Sleep&& sleep)
+	{
+		std::vector<double> lateness;
+		lateness.reserve(count);
+
+		steady_clock::time_point deadline = steady_clock::now();
+		for (rsl::size_type i = 0; i < count; i++)
+		{
+			deadline += period;
+			sleep(rsl::time::point<rsl::time64, steady_clock>{deadline});
+			lateness.push_back(std::chrono::duration<double, std::micro>(steady_clock::now() - deadline).count());
+		}
+
+		return lateness;
+	}
+
+	void report_wakeups(const char* name, std::vector<double> lateness)
+	{
+		std::sort(lateness.begin(), lateness.end());
+
+		double sum = 0.0;
+		for (const double value : lateness)
+		{
+			sum += value;
+		}
+
+		std::printf(
+			"%s: mean %.1f us, p50 %.1f us, p99 %.1f us, max %.1f us\n", name, sum / static_cast<double>(lateness.size()),
+			lateness[lateness.size() / 2], lateness[lateness.size() * 99 / 100], lateness.back()
+		);
+	}
+
+	bool equals(rsl::string_view lhs, rsl::string_view rhs)
+	{
+		if (lhs.size() != rhs.size())
+		{
+			return false;
+		}
+
+		for (rsl::size_type i = 0; i < lhs.size(); i++)
+		{
+			if (lhs[i] != rhs[i])
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	rsl::uint32 named_thread_function(void*)
+	{
+		using rsl::operator""_sv;
+		return equals(rsl::current_thread::get_name(), "short lived"_sv) ? 1u : 0u;
+	}
+} // namespace
+
+TEST_CASE("thread", "[threading]")
+{
+	using namespace rsl;
+
+	SECTION("create and join")
+	{
+		thread_test_data data;
+		thread worker = platform::create_thread(&thread_test_function, &data, "rsl test worker"_sv);
+		REQUIRE(worker);
+
+		const thread_id workerId = worker.get_id();
+		REQUIRE(workerId != current_thread::get_id());
+
+		while (data.observedId.load() == 0)
+		{
+			current_thread::yield();
+		}
+
+		REQUIRE(workerId.nativeId == data.observedId.load());
+		REQUIRE(equals(string_view::from_buffer(data.observedName, data.observedNameLength), "rsl test worker"_sv));
+		REQUIRE(equals(platform::get_thread_name(worker), "rsl test worker"_sv));
+		REQUIRE(worker);
+
+		data.release.store(true);
+		REQUIRE(worker.join() == 42u);
+	}
+
+	SECTION("names")
+	{
+		const string_view longName = "a thread name that is longer than the native limit"_sv;
+		current_thread::set_name(longName);
+		REQUIRE(equals(current_thread::get_name(), longName));
+
+		current_thread::set_name("main"_sv);
+		REQUIRE(equals(current_thread::get_name(), "main"_sv));
+
+		thread_test_data data;
+		thread worker = platform::create_thread(&thread_test_function, &data);
+		platform::set_thread_name(worker, "renamed"_sv);
+		REQUIRE(equals(platform::get_thread_name(worker.get_id()), "renamed"_sv));
+
+		data.release.store(true);
+		REQUIRE(worker.join() == 42u);
+	}
+
+	SECTION("name slots")
+	{
+		// Looking up names doesn't use up slots, and threads give theirs back when they exit.
+		for (id_type id = 1ull; id <= 4096ull; id++)
+		{
+			const std::string expected = std::to_string(id << 32ull);
+			REQUIRE(equals(
+				platform::get_thread_name(thread_id{id << 32ull}), string_view::from_buffer(expected.data(), expected.size())
+			));
+		}
+
+		uint32 named = 0u;
+		for (size_type i = 0ull; i < 2048ull; i++)
+		{
+			thread worker = platform::create_thread(&named_thread_function, nullptr, "short lived"_sv);
+			named += worker.join();
+		}
+		REQUIRE(named == 2048u);
+	}
+}
+
+TEST_CASE("thread placement", "[threading]")
+{
+	using namespace rsl;
+
+	SECTION("affinity and priority")
+	{
+		cpu_mask mask;
+		mask.set(0);
+		REQUIRE(platform::set_thread_affinity(current_thread::get_id(), mask));
+#if RYTHE_PLATFORM_LINUX
+		// Follows affinity changes instead of remembering the first answer.
+		REQUIRE(platform::hardware_concurrency() == 1u);
+#endif
+
+		thread_test_data data;
+		thread worker = platform::create_thread(&thread_test_function, &data);
+		REQUIRE(platform::set_thread_affinity(worker, mask));
+		REQUIRE(platform::set_thread_priority(worker, thread_priority::below_normal));
+
+		data.release.store(true);
+		REQUIRE(worker.join() == 42u);
+
+		cpu_mask all;
+		for (size_type cpu = 0; cpu < max_cpu_count; cpu++)
+		{
+			all.set(cpu);
+		}
+		REQUIRE(platform::set_thread_affinity(current_thread::get_id(), all));
+	}
+
+	SECTION("topology")
+	{
+		const cpu_topology& topology = platform::get_cpu_topology();
+		REQUIRE(&topology == &platform::get_cpu_topology());
+
+		REQUIRE(platform::hardware_concurrency() >= 1u);
+		REQUIRE(topology.logicalCpuCount >= 1u);
+		REQUIRE(topology.packageCount >= 1u);
+		REQUIRE(topology.physical_core_count() >= 1u);
+		REQUIRE(topology.physical_core_count() <= topology.logicalCpuCount);
+		REQUIRE(topology.cacheLineSize >= 16u);
+
+		size_type siblingCount = 0;
+		for (const cpu_core_info& core : topology.cores)
+		{
+			REQUIRE(core.logicalCpus.any());
+			siblingCount += core.logicalCpus.count();
+		}
+		REQUIRE(siblingCount == topology.logicalCpuCount);
+		REQUIRE(topology.one_cpu_per_core().count() == topology.physical_core_count());
+
+		for (size_type i = 1; i < topology.caches.size(); i++)
+		{
+			REQUIRE(topology.caches[i - 1].level <= topology.caches[i].level);
+		}
+	}
+}
+
+TEST_CASE("sleep", "[threading]")
+{
+	using namespace rsl;
+
+	SECTION("sleep_for")
+	{
+		const steady_clock::time_point start = steady_clock::now();
+		current_thread::sleep_for(time::span<time64>(std::chrono::microseconds(300)));
+		REQUIRE(steady_clock::now() - start >= std::chrono::microseconds(300));
+
+		// Durations in the past return right away.
+		current_thread::sleep_for(time::span<time64>(std::chrono::microseconds(-300)));
+	}
+
+	SECTION("sleep_until")
+	{
+		const steady_clock::time_point deadline = steady_clock::now() + std::chrono::microseconds(300);
+		current_thread::sleep_until(time::point<time64, steady_clock>{deadline});
+		REQUIRE(steady_clock::now() >= deadline);
+
+		// Points on other clocks get converted to the time left.
+		const auto systemDeadline = time::stopwatch<time64>::current_point();
+		current_thread::sleep_until(systemDeadline);
+	}
+
+	SECTION("precise sleep")
+	{
+		for (size_type i = 0; i < 20; i++)
+		{
+			const steady_clock::time_point deadline = steady_clock::now() + std::chrono::microseconds(500);
+			current_thread::precise_sleep_until(time::point<time64, steady_clock>{deadline});
+			REQUIRE(steady_clock::now() >= deadline);
+		}
+
+		const steady_clock::time_point start = steady_clock::now();
+		current_thread::precise_sleep_for(time::span<time64>(std::chrono::microseconds(200)));
+		REQUIRE(steady_clock::now() - start >= std::chrono::microseconds(200));
+
+		const auto margin = current_thread::precise_sleep_margin().duration;
+		REQUIRE(margin >= std::chrono::microseconds(20));
+		REQUIRE(margin <= std::chrono::milliseconds(20));
+	}
+}
+
+TEST_CASE("sleep jitter benchmark", "[.][benchmark][threading]")
+{
+	using namespace rsl;
+
+	constexpr size_type wakeups = 2000;
+	constexpr std::chrono::microseconds period(500);
+
+	report_wakeups(
+		"sleep_until", measure_wakeups(
+						   wakeups, period,
+						   [](const time::point<time64, steady_clock> deadline) { current_thread::sleep_until(deadline); }
+					   )
+	);
+
+	report_wakeups(
+		"precise_sleep_until",
+		measure_wakeups(
+			wakeups, period,
+			[](const time::point<time64, steady_clock> deadline) { current_thread::precise_sleep_until(deadline); }
+		)
+	);
+
+	std::printf(
+		"precise sleep margin: %.1f us\n",
+		std::chrono::duration<double, std::micro>(current_thread::precise_sleep_margin().duration).count()
+	);
+}
@@ -88,6 +88,11 @@ TEST_CASE("type_map", "[containers]")
 
 		constexpr id_type id = type_id<test1>();
 		REQUIRE(id != 0u);
+
+		const size_type index = type_index<test1>();
+		REQUIRE(index == type_index<const test1&>());
+		REQUIRE(index != type_index<test2>());
+		REQUIRE(index < registered_type_count());
 	}
 	SECTION("construction")
 	{
@@ -185,7 +190,26 @@ TEST_CASE("type_map", "[containers]")
 	}
 
 	SECTION("get") {}
-	SECTION("erase") {}
+	SECTION("erase")
+	{
+		rsl::type_map map{};
+		map.emplace<test1>();
+		map.emplace<test3>(CONST5);
+		REQUIRE(map.size() == 2);
+
+		map.erase<test1>();
+		REQUIRE(map.size() == 1);
+		REQUIRE(!map.has<test1>());
+		REQUIRE(map.get<test3>().value == CONST5);
+
+		map.erase<test1>();
+		map.erase<test4>();
+		REQUIRE(map.size() == 1);
+
+		map.erase<test3>();
+		REQUIRE(map.empty());
+		REQUIRE(map.try_get<test3>() == nullptr);
+	}
 	SECTION("get_or_emplace") {}
 	SECTION("emplace_or_replace") {}
 }